@@ -0,0 +1,100 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Continuous ADC sampling for the analog devices (UV sensor). The ADC converts all registered pins in turn in
+// continuous (DMA) mode, a reader task demultiplexes the conversions into an oversampled, decimated queue per pin
+// (see core/AdcDemultiplexer.hpp) and the devices pull the values in their loop(): no analogRead() and no conversion
+// time in the loop, up to 16 bit resolution by oversampling.
+// Only the pins of ADC1 (32 ... 39) can be sampled by DMA, ADC2 is used by WiFi. On the ESP32 the DMA runs over I2S 0,
+// so the audio streamer uses I2S 1.
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#if defined(USE_UV)
+#ifndef __ADC_SERVICE_HPP__
+#define __ADC_SERVICE_HPP__
+
+#include "core/AdcDemultiplexer.hpp"
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define ADC_SERVICE_SAMPLE_FREQUENCY 20000 // conversions per second of all pins together (the minimum of the ESP32)
+#define ADC_SERVICE_FRAME_SIZE 512         // bytes per adc_digi_read_bytes() of the reader task, 256 conversions
+#define ADC_SERVICE_BUFFER_SIZE 2048       // DMA ring buffer of the driver
+#define ADC_SERVICE_TASK_CORE 0            // the Arduino loop runs on core 1
+#define ADC_SERVICE_TASK_PRIORITY 2        // higher than the Arduino loop task, lower than the audio capture task
+
+namespace IotZoo
+{
+    class AdcService
+    {
+      public:
+        static constexpr int InvalidChannel = -1;
+
+        ~AdcService();
+
+        /// @brief Registers an analog pin, before begin(). Every pin is converted ADC_SERVICE_SAMPLE_FREQUENCY / pin count
+        /// times per second, 4^oversamplingBits * decimation conversions are one value.
+        /// @return The channel to read from, InvalidChannel if the pin is not on ADC1 or could not be added.
+        int addPin(uint8_t pin, uint8_t oversamplingBits = 4, uint16_t decimation = 4);
+
+        /// @brief Starts the continuous conversion of the registered pins and the reader task. Nothing to do without pins.
+        bool begin();
+
+        bool isStarted() const
+        {
+            return nullptr != taskHandle;
+        }
+
+        /// @brief Reads up to count values of the channel, the oldest first.
+        size_t read(int channel, uint16_t* values, size_t count)
+        {
+            return InvalidChannel == channel ? 0 : demultiplexer.read(static_cast<uint8_t>(channel), values, count);
+        }
+
+        /// @brief Reads all values of the channel and keeps the newest.
+        bool readLatest(int channel, uint16_t& value)
+        {
+            return InvalidChannel != channel && demultiplexer.readLatest(static_cast<uint8_t>(channel), value);
+        }
+
+        /// @brief The value of the full scale input voltage, e.g. 65520 with 4 oversampling bits.
+        uint32_t getFullScale(int channel) const
+        {
+            return InvalidChannel == channel ? 0 : demultiplexer.getFullScale(static_cast<uint8_t>(channel));
+        }
+
+        /// @brief Count of DMA buffer overflows: the reader task did not keep up and conversions were dropped.
+        uint32_t getOverflows() const
+        {
+            return overflows;
+        }
+
+      protected:
+        /// @brief FreeRTOS task function of the reader task.
+        static void readerTask(void* parameter);
+
+        /// @brief Runs in the reader task: waits for the DMA frames and demultiplexes them.
+        void demultiplex();
+
+        AdcDemultiplexer demultiplexer;
+        TaskHandle_t     taskHandle = nullptr;
+
+        volatile uint32_t overflows = 0;
+
+        // reader task only
+        uint8_t buffer[ADC_SERVICE_FRAME_SIZE];
+    };
+} // namespace IotZoo
+
+#endif // __ADC_SERVICE_HPP__
+#endif // defined(USE_UV)
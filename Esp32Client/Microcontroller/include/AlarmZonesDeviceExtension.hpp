@@ -15,6 +15,7 @@
 #include "Arduino.h"
 #include "pocos/Topic.hpp"
 #include "DeviceBase.hpp"
+#include "core/AlarmZoneMap.hpp"
 
 namespace IotZoo
 {
@@ -42,9 +43,24 @@ namespace IotZoo
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const;
 
       protected:
-        uint getAlarmLevel(const String& subject);
+        /// @brief Settings key of the zone map, e.g. "alarmZones8x8". One map per matrix size.
+        String getSettingsKey() const;
+
+        /// @brief Loads the zone map from the settings. Without a stored map the built-in map of the matrix size is used.
+        void loadZoneMap();
+
+        /// @brief {"brightness":4,"millisUntilTurnOff":60000,"levels":[{"keyword":"person","color":"#FF0000"}],"zones":{"garten":[42,2,52,2]}}
+        /// zones: name -> pairs of start index and length. Without "levels" the built-in levels are used.
+        bool parseZoneMap(const String& json);
+
+        /// @brief Saves the zone map, so new zones do not need a firmware update.
+        void onZoneMapReceived(const String& json);
 
         void onAlarmReceived(const String& subject);
+
+        AlarmZoneMap zoneMap;
+        uint8_t      brightness         = 4;
+        uint32_t     millisUntilTurnOff = 60000;
     };
 } // namespace IotZoo
 
@@ -11,9 +11,13 @@
 #ifdef USE_AUDIO_STREAMER
 
 #include "DeviceBase.hpp"
+#include "core/AudioLevel.hpp"
+#include "core/SpscRingBuffer.hpp"
 
 #include <Arduino.h>
 #include <driver/i2s.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 namespace IotZoo
 {
@@ -25,6 +29,12 @@ namespace IotZoo
 #define SAMPLE_RATE 16000
 #define CHUNK_SIZE (int)(SAMPLE_RATE * 0.5) // memory is rare! more than 0.8 is not possible
 
+#define AUDIO_CAPTURE_BLOCK_SIZE 256   // samples per i2s_read() of the capture task
+#define AUDIO_RING_BUFFER_SIZE 8192    // samples (512 ms), must be a power of two
+#define AUDIO_CAPTURE_TASK_CORE 0      // the Arduino loop runs on core 1
+#define AUDIO_CAPTURE_TASK_PRIORITY 3  // higher than the Arduino loop task
+#define AUDIO_I2S_PORT I2S_NUM_1       // I2S 0 runs the continuous ADC (AdcService)
+
     enum AudioStreamerFeatures
     {
         Undefined         = 0,
@@ -39,19 +49,23 @@ namespace IotZoo
         AudioStreamer(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, u8_t features, u16_t minRms,
                       uint8_t pinSd = I2S_SD, uint8_t pinWs = I2S_WS, uint8_t pinSck = I2S_SCK);
 
-        void loop();
+        ~AudioStreamer() override;
+
+        /// @brief Drains the samples captured in the background and publishes complete chunks.
+        void loop() override;
 
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const;
 
         void onMqttConnectionEstablished() override;
 
       protected:
-        // 0 dB = maximum digital volume
-        // -10 dB = strong, good
-        // -20 dB = usable
-        // -40 dB = barely usable
-        // -60 dB = noise
-        double rmsToDecibel(double rms, double fullScale = 32768.0);
+        /// @brief FreeRTOS task function of the capture task.
+        static void captureTask(void* parameter);
+
+        /// @brief Runs in the capture task: reads from I2S (blocking) and writes the PCM samples into the ring buffer.
+        void capture();
+
+        void publishChunk();
 
       private:
         i2s_config_t i2sConfig = {
@@ -66,13 +80,26 @@ namespace IotZoo
             .use_apll             = false,
         };
 
-        size_t           bufferIndex = 0;
         i2s_pin_config_t pinConfig;
-        int32_t          i2sBuffer[CHUNK_SIZE];
-        int16_t          pcm16Buffer[CHUNK_SIZE];
-        int16_t          chunkBuffer[CHUNK_SIZE];
         u8_t             features;
         u16_t            minRms;
+
+        // capture task only
+        TaskHandle_t captureTaskHandle = nullptr;
+        int32_t      i2sBuffer[AUDIO_CAPTURE_BLOCK_SIZE];
+        int16_t      pcm16Buffer[AUDIO_CAPTURE_BLOCK_SIZE];
+
+        SpscRingBuffer<int16_t, AUDIO_RING_BUFFER_SIZE> ringBuffer;
+
+        // loop only
+        size_t         bufferIndex = 0;
+        int16_t        chunkBuffer[CHUNK_SIZE];
+        RmsAccumulator rmsAccumulator;
+        uint32_t       reportedOverruns = 0;
+
+        TopicId topicIdPcm               = InvalidTopicId;
+        TopicId topicIdSoundLevelRms     = InvalidTopicId;
+        TopicId topicIdSoundLevelDecibel = InvalidTopicId;
     };
 
 } // namespace IotZoo
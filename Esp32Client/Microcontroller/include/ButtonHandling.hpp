@@ -24,6 +24,8 @@ namespace IotZoo
     class ButtonHandling : public DeviceHandlingBase
     {
     public:
+        ButtonHandling();
+
         /// @brief Let the user know what the device can do.
         /// @param topics
         void addMqttTopicsToRegister(std::vector<Topic> *const topics) const override;
@@ -31,11 +33,11 @@ namespace IotZoo
         /// @brief The MQTT connection is established. Now subscribe to the topics. An existing MQTT connection is a prerequisite for a subscription.
         /// @param mqttClient
         /// @param baseTopic
-        void onMqttConnectionEstablished();
+        void onMqttConnectionEstablished(MqttClient* mqttClient, const String& baseTopic) override;
 
         void addDevice(int deviceIndex, Settings* const settings, MqttClient* mqttClient, const String &baseTopic, u_int8_t buttonPin);
 
-        void loop();
+        void loop() override;
     };
 }
 
@@ -90,6 +90,24 @@ namespace IotZoo
         char* keyMap = nullptr;
 
         Keypad* customKeypad;
+
+        enum KeyTopic
+        {
+            KeyTopicState    = 0, // payload: PRESSED, HOLD or RELEASED
+            KeyTopicPressed  = 1,
+            KeyTopicHold     = 2,
+            KeyTopicReleased = 3,
+            KeyTopicCount    = 4,
+        };
+
+        // Interned topics per key, built once in the constructor.
+        TopicId topicIdsKey[4 * 4][KeyTopicCount];
+
+        /// @return Index of the key in hexaKeys (row * 4 + col), -1 if unknown.
+        int getKeyIndex(char keyChar) const;
+
+        /// @brief Publishes the state of the key and millis() to the topic of the state.
+        void publishKeyState(char keyChar, const char* state, KeyTopic keyTopic);
     };
 } // namespace IotZoo
 
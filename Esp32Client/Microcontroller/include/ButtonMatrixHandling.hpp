@@ -19,16 +19,18 @@
 
 namespace IotZoo
 {
-    class ButtonMatrixHandling : DeviceHandlingBase
+    class ButtonMatrixHandling : public DeviceHandlingBase
     {
       public:
+        ButtonMatrixHandling();
+
         /// @brief Let the user know what the device can do.
         /// @param topics
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const override;
 
         void AddDevice(ButtonMatrix* const buttonMatrix);
 
-        void loop();
+        void loop() override;
 
       protected:
         vector<ButtonMatrix> buttonMatrixVector;
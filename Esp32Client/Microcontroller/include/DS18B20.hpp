@@ -15,26 +15,42 @@
 #define __DS18B20_HPP__
 
 #include "DeviceBase.hpp"
+#include "core/DS18B20Poller.hpp"
 
 #include <DallasTemperature.h>
 #include <OneWire.h>
-#include <list>
 
 namespace IotZoo
 {
-    class DS18B20 : DeviceBase
+    /// @brief The OneWire bus of the DallasTemperature library, without waiting for the conversion.
+    class DallasTemperatureBus : public OneWireTemperatureBus
     {
-      protected:
-        OneWire*           oneWire                  = nullptr;
-        DallasTemperature* dallasTemperatureSensors = nullptr;
+      public:
+        explicit DallasTemperatureBus(DallasTemperature* dallasTemperature) : dallasTemperature(dallasTemperature)
+        {
+        }
+
+        size_t search(RomAddress* addresses, size_t capacity) override;
 
-        int numberOfDevices = 0;
-        int interval        = 0; // 0 = ASAP
+        bool setResolution(uint8_t resolution) override;
 
-        // function to print a device address
-        void printDeviceAddress(DeviceAddress deviceAddress);
+        bool startConversion() override;
 
-        long lastPublishedTemperatureMillis = millis();
+        bool readCelsius(const RomAddress& address, float& celsius) override;
+
+      protected:
+        DallasTemperature* dallasTemperature;
+    };
+
+    class DS18B20 : public DeviceBase
+    {
+      protected:
+        OneWire*              oneWire                  = nullptr;
+        DallasTemperature*    dallasTemperatureSensors = nullptr;
+        DallasTemperatureBus* bus                      = nullptr;
+        DS18B20Poller*        poller                   = nullptr;
+
+        std::vector<PublishChannel> channelsCelsius; // one channel per found sensor, named by the ROM address.
 
       public:
         // @param resolution resolution of a device to 9, 10, 11, or 12 bits.
@@ -48,31 +64,24 @@ namespace IotZoo
         /// @param topics
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const;
 
-        void loop();
-
-        std::vector<float> requestTemperatures();
+        /// @brief Starts a conversion when the interval elapsed and publishes the temperatures when it is complete. Never waits.
+        void loop() override;
 
         /// @brief Sets the interval at which the temperature is sent
         /// @param interval in milliseconds
         void setInterval(int intervalMs)
         {
-            this->interval = intervalMs;
+            poller->setIntervalMillis(intervalMs > 0 ? intervalMs : 0);
         }
 
         int getInterval() const
         {
-            return interval;
+            return poller->getIntervalMillis();
         }
 
-        long getLastPublishedTemperatureMillis() const
-        {
-            return lastPublishedTemperatureMillis;
-        }
-
-        void setLastPublishedTemperatureMillis(long lastPublishedMillis)
-        {
-            lastPublishedTemperatureMillis = lastPublishedMillis;
-        }
+      protected:
+        /// @brief e.g. iotzoo/esp32/08:D1:F9:E0:31:78/ds18b20_manager/0/sensor/28FF641E8516034B/celsius
+        String getTopicCelsius(const RomAddress& address) const;
     };
 } // namespace IotZoo
 #endif // __DS18B20_HPP__
@@ -17,6 +17,12 @@ namespace IotZoo
 #define USE_REST_SERVER // Do not uncomment, otherwise you cannot configure the microcontroller out of the IOTZOO UI over REST. To use MQTT for
                         // configuration is the better way because then the IOTZOO Client und the ESP32 can be in different networks. But, if the
                         // MQTTBroker settings in the ESP32 are wrong, then there is a chance to correct this over REST.
+#define USE_PROFILER    // Run time statistics of every device loop and MQTT callback. Published with the alive message and
+                        // served at http://<ip>/profile.
+#define USE_STORE_AND_FORWARD // Messages published while the MQTT broker is not reachable are stored (RAM, then the spiffs partition)
+                              // and replayed after the reconnect.
+#define USE_WILDCARD_SUBSCRIPTION // One subscription per sub-tree below the base topic instead of one per topic, dispatched
+                                  // locally. Only sub-trees the device does not publish to, so the own messages are not echoed.
 
 // --------------------------------------------------------------------------------------------------------------------
 // Comment feature(s) out if you run out of memory.
@@ -32,6 +38,7 @@ namespace IotZoo
 #define USE_WS2818      // NeoPixel | Default Pins: DIN: 22
 #ifdef USE_WS2818
 // #define USE_WS2818_PIXEL_MATRIX
+#define USE_WS2818_RMT // Non-blocking output over the RMT peripheral. One RMT channel per strip, max. 8 strips in parallel.
 #endif
 
 #define USE_AUDIO_STREAMER // INMP441 microphone Default Pins: I2S_WS: 22, I2S_SCK: 15, I2S_SD: 35
@@ -65,6 +72,7 @@ namespace IotZoo
 #undef USE_MQTT   // Conflicts with USE_BLE_HEART_RATE_SENSOR, because of to much memory consumption.
 #define USE_MQTT2 // PubSubLibrary instead of EspMQTTClient to save memory.
 #endif
+
 } // namespace IotZoo
 
 // #define ERASE_FLASH
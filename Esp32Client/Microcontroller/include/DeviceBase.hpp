@@ -21,6 +21,7 @@
 #endif
 #include <ArduinoJson.h>
 #include "./pocos/Topic.hpp"
+#include "core/PublishPolicy.hpp"
 #ifdef ARDUINO_ESP32_DEV
 #include "Settings.hpp"
 #endif
@@ -49,9 +50,9 @@ namespace IotZoo
             return deviceIndex;
         }
 
+        /// @brief Periodic work of the device. Is only called if the loop interval is > 0.
         virtual void loop()
         {
-            Serial.println("do override loop!");
         }
 
         /// @brief Let the user know what the device can do.
@@ -72,7 +73,6 @@ namespace IotZoo
         ///        This method is a suitable point to erase a display or stop something.
         virtual void onIotZooClientUnavailable()
         {
-            Serial.println("do override onIotZooClientUnavailable!");
         }
 
         String getBaseTopic() const
@@ -94,7 +94,36 @@ namespace IotZoo
         {
             return mqttClient;
         }
+
+        Settings* getSettings() const
+        {
+            return settings;
+        }
+
+        /// @brief How often loop() has to be called by the scheduler. 0 = the device has nothing to do periodically.
+        uint32_t getLoopIntervalMillis() const
+        {
+            return loopIntervalMillis;
+        }
+
+        void setLoopIntervalMillis(uint32_t intervalMillis)
+        {
+            loopIntervalMillis = intervalMillis;
+        }
         
+        /// @brief Sets a publish policy parameter of the channels of the device, e.g. "DeadbandAbsolute" for all channels or
+        /// "humidity.DeadbandAbsolute" for one channel. See core/PublishPolicy.hpp.
+        /// @return true if a channel uses the parameter.
+        bool setPublishPolicyParameter(const char* name, float value)
+        {
+            bool used = false;
+            for (PublishChannel* channel : publishChannels)
+            {
+                used = channel->policy.setParameter(channel->name.c_str(), name, value) || used;
+            }
+            return used;
+        }
+
         void publishError(const String& errMsg)
         {
             String topic = getBaseTopic() + "/error";
@@ -122,12 +151,38 @@ namespace IotZoo
         }
 
       protected:
+        /// @brief The channel gets the publish policy parameters of the device configuration. It has to outlive the device.
+        void addPublishChannel(PublishChannel& channel)
+        {
+            publishChannels.push_back(&channel);
+        }
+
+        /// @brief Publishes the value to the topic of the channel, if the publish policy of the channel lets it through.
+        /// @return true if the value was published.
+        bool publishIfDue(PublishChannel& channel, float value, unsigned int decimalPlaces)
+        {
+            if (!channel.policy.update(value, millis()))
+            {
+                return false;
+            }
+            if (!mqttClient->publish(channel.topicId, String(value, decimalPlaces)))
+            {
+                // Dropped, e.g. the queue is full: the next sample is published instead of waiting for the deadband.
+                channel.policy.reset();
+                return false;
+            }
+            return true;
+        }
+
+        std::vector<PublishChannel*> publishChannels;
+
         MqttClient* mqttClient  = nullptr;
         Settings*   settings    = nullptr;
         int         deviceIndex = -1;
         String      deviceName;
         String      baseTopic;
         bool        mqttCallbacksAreRegistered = false;
+        uint32_t    loopIntervalMillis         = 0;
     };
 
 } // namespace IotZoo
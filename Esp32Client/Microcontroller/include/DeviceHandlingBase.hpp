@@ -44,7 +44,16 @@ namespace IotZoo
         ///        This method is a suitable point to erase a display or stop something.
         virtual void onIotZooClientUnavailable()
         {
-            Serial.println("override onIotZooClientUnavailable!");
+        }
+
+        /// @brief Is called once after all configured devices are added.
+        virtual void setup()
+        {
+        }
+
+        /// @brief Periodic work of the handled devices. Is only called if the loop interval is > 0.
+        virtual void loop()
+        {
         }
 
         /// @brief Let the user know what the device can do.
@@ -57,13 +66,24 @@ namespace IotZoo
         /// @param baseTopic
         virtual void onMqttConnectionEstablished(MqttClient* mqttClient, const String& baseTopic)
         {
-            Serial.println("override onMqttConnectionEstablished!");
+        }
+
+        /// @brief How often loop() has to be called by the scheduler. 0 = nothing to do periodically.
+        uint32_t getLoopIntervalMillis() const
+        {
+            return loopIntervalMillis;
+        }
+
+        void setLoopIntervalMillis(uint32_t intervalMillis)
+        {
+            loopIntervalMillis = intervalMillis;
         }
 
       protected:
         MqttClient* mqttClient             = nullptr;
         Settings*   settings               = nullptr;
         bool        callbacksAreRegistered = false;
+        uint32_t    loopIntervalMillis     = 0;
     };
 } // namespace IotZoo
 #endif // __DEVICE_HANDLING_BASE_HPP__
\ No newline at end of file
@@ -0,0 +1,57 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// A data partition of the ESP32 flash for the telemetry log (see core/TelemetryLog.hpp). The firmware does not mount a
+// file system, so the spiffs partition of the default partition table is used as raw flash.
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#ifdef USE_STORE_AND_FORWARD
+#ifndef __ESP_FLASH_PARTITION_HPP__
+#define __ESP_FLASH_PARTITION_HPP__
+
+#include "core/FlashPartition.hpp"
+
+#include <esp_partition.h>
+#include <esp_spi_flash.h> // SPI_FLASH_SEC_SIZE
+
+namespace IotZoo
+{
+    class EspFlashPartition : public FlashPartition
+    {
+      public:
+        /// @brief Finds the partition.
+        /// @param maxSize Only the first maxSize bytes are used.
+        /// @return false if there is no such partition.
+        bool begin(esp_partition_subtype_t subtype, const char* label, size_t maxSize);
+
+        size_t getSize() const override
+        {
+            return size;
+        }
+
+        size_t getSectorSize() const override
+        {
+            return SPI_FLASH_SEC_SIZE;
+        }
+
+        bool read(size_t offset, void* data, size_t length) override;
+
+        bool write(size_t offset, const void* data, size_t length) override;
+
+        bool eraseSector(size_t offset) override;
+
+      protected:
+        const esp_partition_t* partition = nullptr;
+        size_t                 size      = 0;
+    };
+} // namespace IotZoo
+
+#endif // __ESP_FLASH_PARTITION_HPP__
+#endif // USE_STORE_AND_FORWARD
@@ -15,7 +15,10 @@
 
 #pragma once
 
+#include "AdcService.hpp"
 #include "DeviceBase.hpp"
+#include "core/Log.hpp"
+#include "core/WindowAggregator.hpp"
 
 namespace IotZoo
 {
@@ -23,8 +26,8 @@ namespace IotZoo
     {
       public:
         UvSensorGUVAS12SD(int deviceIndex, IotZoo::Settings* const settings, IotZoo::MqttClient* const mqttClient, const String& baseTopic,
-                          uint8_t pinAdc)
-            : DeviceBase(deviceIndex, settings, mqttClient, baseTopic)
+                          AdcService* const adcService, uint8_t pinAdc, uint16_t sampleIntervalMillis = 100, uint32_t windowMillis = 10000)
+            : DeviceBase(deviceIndex, settings, mqttClient, baseTopic), adcService(adcService), aggregator(windowMillis)
         {
             this->pinAdc = pinAdc;
             if (pinAdc == 0)
@@ -33,10 +36,22 @@ namespace IotZoo
                 Serial.println("Warning: pinAdc was 0, set to default pin 35.");
             }
 
-            analogSetPinAttenuation(this->pinAdc, ADC_11db);
-            analogReadResolution(12); // 0..4095
+            analogSetPinAttenuation(this->pinAdc, ADC_11db); // analogRead() 0..4095 if the pin is not sampled by the ADC service
+            if (nullptr != adcService)
+            {
+                adcChannel = adcService->addPin(this->pinAdc);
+            }
+            loopIntervalMillis = sampleIntervalMillis;
 
-            Serial.println("Constructor UV Sensor pinAdc: " + String(pinAdc));
+            channelUvIndex.name                               = "uv";
+            channelUvIndex.topicId                            = mqttClient->addTopic(getBaseTopic() + "/uv/" + String(deviceIndex));
+            channelUvIndex.policy.parameters.deadbandAbsolute = 0.1f;
+            channelUvIndex.policy.parameters.maxAgeMillis     = 600000;
+            addPublishChannel(channelUvIndex);
+            topicIdStatistics = mqttClient->addTopic(getBaseTopic() + "/uv/" + String(deviceIndex) + "/stats");
+
+            Serial.println("Constructor UV Sensor pinAdc: " + String(pinAdc) + ", sampleIntervalMillis: " + String(sampleIntervalMillis) +
+                           ", windowMillis: " + String(windowMillis));
         }
 
         ~UvSensorGUVAS12SD() override
@@ -49,31 +64,63 @@ namespace IotZoo
         void addMqttTopicsToRegister(std::vector<IotZoo::Topic>* const topics) const override
         {
             topics->emplace_back(getBaseTopic() + "/uv/" + String(deviceIndex), "3.4", MessageDirection::IotZooClientInbound);
+            topics->emplace_back(getBaseTopic() + "/uv/" + String(deviceIndex) + "/stats",
+                                 "{\"mean\":3.421,\"min\":3.104,\"max\":3.902,\"stddev\":0.213,\"count\":100}",
+                                 MessageDirection::IotZooClientInbound);
         }
 
+        /// @brief Called by the scheduler every sample interval. The samples of a window are aggregated: the summary is
+        /// published per window, the mean only if it changed beyond the deadband.
         void loop() override
         {
-            if (millis() - lastLoopMillis > 5000)
+            AggregateSummary summary;
+            bool             windowCompleted = false;
+            uint32_t         now             = millis();
+            if (AdcService::InvalidChannel == adcChannel || !adcService->isStarted())
             {
-                float analogSignal = analogRead(pinAdc);
-                float voltage      = analogSignal * 3.3 / 4095.0;
-                uvIndex            = voltage / 0.1;
-
-                Serial.print("Signal: ");
-                Serial.println(analogSignal);
-                Serial.print("Volt: ");
-                Serial.println(voltage, 3);
-                Serial.print("UV-Index: ");
-                Serial.println(uvIndex);
-                mqttClient->publish(getBaseTopic() + "/uv/" + String(deviceIndex), String(uvIndex, 3U));
-                lastLoopMillis = millis();
+                windowCompleted = aggregator.add(toUvIndex(analogRead(pinAdc), 4095), now, summary);
             }
+            else
+            {
+                // The oversampled values since the last loop, converted by the ADC service in the background.
+                uint16_t values[16];
+                size_t   count;
+                uint32_t fullScale = adcService->getFullScale(adcChannel);
+                while ((count = adcService->read(adcChannel, values, 16)) > 0)
+                {
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        windowCompleted |= aggregator.add(toUvIndex(values[i], fullScale), now, summary);
+                    }
+                }
+            }
+            if (!windowCompleted)
+            {
+                return;
+            }
+            char json[128];
+            if (summary.toJson(json, sizeof(json), 3U) > 0)
+            {
+                LOG_DEBUG(LogModuleSensors, "UV-Index: " + String(json));
+                mqttClient->publish(topicIdStatistics, json);
+            }
+            publishIfDue(channelUvIndex, summary.mean, 3U);
         }
 
       protected:
-        uint8_t       pinAdc;
-        float         uvIndex;
-        unsigned long lastLoopMillis = 0;
+        /// @brief The sensor outputs 0.1 V per UV index, the ADC measures 0 ... 3.3 V.
+        static float toUvIndex(uint32_t value, uint32_t fullScale)
+        {
+            float voltage = value * 3.3f / fullScale;
+            return voltage / 0.1f;
+        }
+
+        AdcService* const adcService;
+        int              adcChannel = AdcService::InvalidChannel;
+        uint8_t          pinAdc;
+        WindowAggregator aggregator;
+        PublishChannel   channelUvIndex;
+        TopicId          topicIdStatistics = InvalidTopicId;
     };
 
 } // namespace IotZoo
@@ -17,8 +17,10 @@
 
 #include "DeviceBase.hpp"
 #include "TinyGPSPlus.h"
-
-#include <SoftwareSerial.h>
+#include "UartReader.hpp"
+#include "core/GpsTracking.hpp"
+#include "core/NmeaFramer.hpp"
+#include "core/SpscRingBuffer.hpp"
 
 namespace IotZoo
 {
@@ -28,21 +30,60 @@ namespace IotZoo
         uint8_t pinRx;
         uint8_t pinTx;
 
-        TinyGPSPlus     gps;
-        SoftwareSerial* softwareSerial;
+        TinyGPSPlus gps;
+        UartReader* uart = nullptr;
+        NmeaFramer  framer; // decoder task only.
+
+        SpscRingBuffer<NmeaSentence, 16> sentences; // from the decoder task to loop(), ~10 sentences per second.
+        uint32_t                         reportedOverruns = 0;
+
+        PositionFilter    positionFilter;
+        Geofences         geofences; // stored in the settings under getGeofencesSettingsKey().
+        TrackBatch        trackBatch;
+        std::vector<char> trackBuffer;
+        unsigned long     millisLastWarning = 0;
+
+        static constexpr size_t MaxTrackBatchSize = 100;
+
+        TopicId topicIdPosition = InvalidTopicId;
+        TopicId topicIdGeofence = InvalidTopicId;
+        TopicId topicIdTrack    = InvalidTopicId;
+        String  topicGeofences;
 
       public:
-        Gps(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic,
-          uint8_t pinRx, uint8_t pinTx, uint32_t baud = 9600);
+        /// @param trackBatchSize 0: every fix that passes the filter is published on its own. Otherwise the fixes are collected and
+        /// published delta encoded on the track topic, when trackBatchSize fixes are collected.
+        Gps(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, uint8_t pinRx, uint8_t pinTx,
+            uint32_t baud = 9600, const PositionFilterParameters& filterParameters = PositionFilterParameters(), size_t trackBatchSize = 0);
         ~Gps() override;
 
         /// @brief Let the user know what the device can do.
         /// @param topics
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const;
 
+        /// @brief Subscribes the geofences topic.
+        void onMqttConnectionEstablished() override;
+
+        /// @brief Decodes the sentences received since the last call. A new fix is checked against the geofences and
+        /// published, if it moved, turned or the heartbeat is due.
         void loop() override;
 
-        void smartDelay(unsigned long ms);
+      protected:
+        /// @brief Runs in the decoder task of the UART: splits the received bytes into sentences and queues them for loop().
+        static void onUartData(void* context, const uint8_t* data, size_t length);
+
+        /// @brief One set of geofences per GPS device, e.g. "gpsGeofences0".
+        String getGeofencesSettingsKey() const;
+
+        /// @brief {"hysteresisMeters":15,"fences":[{"name":"home","lat":52.63,"lon":9.61,"radius":100},
+        /// {"name":"field","points":[[52.631,9.612],[52.631,9.615],[52.633,9.615]]}]}
+        bool parseGeofences(const String& json);
+
+        void onFix();
+
+        void publishPosition(PublishReason reason);
+
+        void publishTrackBatch();
     };
 } // namespace IotZoo
 
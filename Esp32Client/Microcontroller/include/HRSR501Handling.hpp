@@ -19,7 +19,7 @@
 
 namespace IotZoo
 {
-    class HRSR501Handling : DeviceHandlingBase
+    class HRSR501Handling : public DeviceHandlingBase
     {
       public:
         HRSR501Handling();
@@ -32,7 +32,7 @@ namespace IotZoo
         /// @param topics
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const override;
 
-        void loop();
+        void loop() override;
     };
 } // namespace IotZoo
 
@@ -25,7 +25,7 @@ namespace IotZoo
   public:
     HW040Handling();
 
-    void setup();
+    void setup() override;
 
     /// @brief Let the user know what the device can do.
     /// @param topics
@@ -34,7 +34,7 @@ namespace IotZoo
     /// @brief The MQTT connection is established. Now subscribe to the topics. An existing MQTT connection is a prerequisite for a subscription.
     /// @param mqttClient
     /// @param baseTopic
-    void onMqttConnectionEstablished(MqttClient *mqttClient, const String &baseTopic);
+    void onMqttConnectionEstablished(MqttClient *mqttClient, const String &baseTopic) override;
 
     void addDevice(int deviceIndex, Settings* const settings, MqttClient *mqttClient, const String &baseTopic,
                    int boundaryMinValue,
@@ -46,7 +46,7 @@ namespace IotZoo
                    uint8_t encoderBPin,
                    int encoderButtonPin,
                    int encoderVccPin);
-    void loop();
+    void loop() override;
   };
 }
 
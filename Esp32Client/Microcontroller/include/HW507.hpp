@@ -14,6 +14,7 @@
 #ifdef USE_HW507
 #include "DHT.h"
 #include "DeviceBase.hpp"
+#include "core/WindowAggregator.hpp"
 #include <Arduino.h>
 
 namespace IotZoo
@@ -50,8 +51,17 @@ namespace IotZoo
       private:
         DHT*    dht        = nullptr;
         uint8_t deviceType = DHT11;
-        ulong lastMillis = millis();
-        ulong intervalMs = 10000;
+        ulong intervalMs = 10000; // aggregation window, sampled as fast as the sensor allows.
+
+        WindowAggregator aggregator;
+        PublishChannel   channelHumidity;
+        TopicId          topicIdStatistics = InvalidTopicId;
+
+        /// @brief A DHT11 delivers a new value every second, a DHT22 every 2 seconds.
+        static uint16_t getMinSampleIntervalMillis(uint8_t deviceType)
+        {
+            return deviceType == DHT22 ? 2000 : 1000;
+        }
     };
 } // namespace IotZoo
 
@@ -15,11 +15,25 @@
 
 #include "Defines.hpp"
 #include "EspmqttClient.h"
+#include "core/BinarySubscriptions.hpp"
+#include "core/PublishQueue.hpp"
+#include "core/TopicTable.hpp"
+#ifdef USE_PROFILER
+#include "core/LoopProfiler.hpp"
+#endif
+#ifdef USE_STORE_AND_FORWARD
+#include "core/StoreAndForward.hpp"
+#endif
+#ifdef USE_WILDCARD_SUBSCRIPTION
+#include "core/TopicRouter.hpp"
+#endif
 
 #include <Arduino.h>
 
 namespace IotZoo
 {
+    using BinaryMessageReceivedCallback = std::function<void(const uint8_t* payload, size_t length)>;
+
     class MqttClient
     {
       protected:
@@ -34,13 +48,76 @@ namespace IotZoo
         void enableLastWillMessage(const String& topic, const String& message,
                                    const bool retain = false); // Must be set before the first loop() call.
 
+        /// @brief Queues the message, loop() sends it. Messages too large for the queue are sent immediately.
+        /// @return false if the message was dropped.
         bool publish(const String& topic, const String& payload, bool retain = false);
 
+        /// @brief Binary streams (e.g. audio) are sent immediately, they do not fit into the queue.
         bool publish(const String& topic, const uint8_t* payload, unsigned int payloadLength, boolean retained = false)
         {
+            notePublished(topic.c_str());
             return printSuccess(mqttClient->publish(topic.c_str(), payload, payloadLength, retained));
         }
 
+        /// @brief Interns the topic. Publishing by topic id avoids building the topic String on every publish.
+        /// @return The same id for the same topic.
+        TopicId addTopic(const String& topic)
+        {
+            notePublished(topic.c_str());
+            return topics.add(topic.c_str());
+        }
+
+        /// @brief Interns baseTopic + suffix, e.g. addTopic(baseTopic, "/error").
+        TopicId addTopic(const String& baseTopic, const char* suffix)
+        {
+            TopicId topicId = topics.add(baseTopic.c_str(), suffix);
+            notePublished(topics.get(topicId));
+            return topicId;
+        }
+
+        const char* getTopic(TopicId topicId) const
+        {
+            return topics.get(topicId);
+        }
+
+        /// @brief Publishes to an interned topic. An unknown topic id is not published.
+        bool publish(TopicId topicId, const String& payload, bool retain = false);
+
+        bool publish(TopicId topicId, const uint8_t* payload, unsigned int payloadLength, boolean retained = false);
+
+        /// @brief Messages to topics containing the pattern (e.g. "/celsius") are telemetry: only the latest value per
+        /// topic is queued and it may be dropped if the queue is full. All other messages are events.
+        void addTelemetryTopicPattern(const char* pattern)
+        {
+            telemetryTopicPatterns.emplace_back(pattern);
+        }
+
+        /// @brief Max. time loop() spends sending queued messages.
+        void setPublishBudgetMicros(uint32_t budgetMicros)
+        {
+            publishBudgetMicros = budgetMicros;
+        }
+
+        /// @brief Queue depth, drop and coalesce counters.
+        const PublishQueue& getPublishQueue() const
+        {
+            return publishQueue;
+        }
+
+#ifdef USE_STORE_AND_FORWARD
+        /// @brief Messages published while the broker is not reachable are stored and replayed after the reconnect, in
+        /// order, to <topic>/stored. The stored topic lags behind the live one until the replay is done.
+        void setStoreAndForward(StoreAndForward* storeAndForward)
+        {
+            this->storeAndForward = storeAndForward;
+        }
+
+        const StoreAndForward* getStoreAndForward() const
+        {
+            return storeAndForward;
+        }
+#endif
+
         /// @brief
         /// @param topic
         /// @param messageReceivedCallback
@@ -50,8 +127,27 @@ namespace IotZoo
 
         bool subscribe(const String& topic, MessageReceivedCallbackWithTopic messageReceivedCallback, uint8_t qos = 0);
 
+        /// @brief Binary payloads, e.g. pixel frames. The payload is taken from the PubSubClient callback with its
+        /// length, before EspMQTTClient converts it into a String that ends at the first zero byte.
+        bool subscribeBinary(const String& topic, BinaryMessageReceivedCallback messageReceivedCallback, uint8_t qos = 0);
+
         bool unsubscribe(const String& topic);
 
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        /// @brief Topics below the prefix are not subscribed one by one: the client subscribes the sub-trees below the
+        /// prefix the microcontroller does not publish to, e.g. prefix/ws2818/#, and dispatches the received messages by
+        /// the topic. Removes the handlers subscribed before.
+        void setWildcardPrefix(const String& prefix);
+#endif
+
+#ifdef USE_PROFILER
+        /// @brief Callbacks of subscriptions made afterwards are measured, one probe per topic.
+        void setProfiler(LoopProfiler* profiler)
+        {
+            this->profiler = profiler;
+        }
+#endif
+
         unsigned int getConnectionEstablishedCount() const;
 
         bool isConnected() const;
@@ -62,7 +158,54 @@ namespace IotZoo
         void loop();
 
       protected:
+        static constexpr size_t PublishQueueCapacity = 24;
+
         bool printSuccess(bool ok);
+
+        PublishClass getPublishClass(const char* topic) const;
+
+        bool enqueue(const char* topic, const uint8_t* payload, unsigned int payloadLength, bool retain);
+
+        bool publishNow(const char* topic, const uint8_t* payload, unsigned int payloadLength, bool retain);
+
+#ifdef USE_STORE_AND_FORWARD
+        /// @brief Publishes a replayed message to <topic>/stored, not retained, the payload wrapped with the time it was stored.
+        bool publishStored(const StoredMessage& message);
+#endif
+
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        /// @brief Adds the handler to the router if the topic is below the wildcard prefix.
+        /// @return false if the topic has to be subscribed on its own, e.g. qos 1 or a topic with a wildcard.
+        bool route(const String& topic, const MessageReceivedCallbackWithTopic& messageReceivedCallback, uint8_t qos);
+
+        /// @brief Subscribes the filters of the router which are not subscribed yet and unsubscribes the outdated ones.
+        void subscribeRouted();
+#endif
+
+        /// @brief Called for every topic the microcontroller publishes. With USE_WILDCARD_SUBSCRIPTION the filters are
+        /// renewed in loop() if the broker would send the topic back.
+        void notePublished(const char* topic);
+
+        /// @brief Delivers the messages of the binary topics raw, the others to EspMQTTClient.
+        void onMessageReceived(char* topic, uint8_t* payload, unsigned int length);
+
+        TopicTable          topics;
+        BinarySubscriptions binarySubscriptions;
+        PublishQueue        publishQueue{PublishQueueCapacity};
+        std::vector<String> telemetryTopicPatterns;
+        uint32_t            publishBudgetMicros = 5000;
+
+#ifdef USE_PROFILER
+        LoopProfiler* profiler = nullptr;
+#endif
+#ifdef USE_STORE_AND_FORWARD
+        StoreAndForward* storeAndForward = nullptr;
+#endif
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        TopicRouter<MessageReceivedCallbackWithTopic> router;
+        std::vector<String>                           routedSubscriptions;   // filters subscribed in the current connection.
+        bool                                          routerChanged = false; // handlers or published topics added.
+#endif
     };
 } // namespace IotZoo
 #endif
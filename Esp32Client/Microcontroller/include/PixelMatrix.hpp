@@ -56,6 +56,10 @@ namespace IotZoo
             return numberOfLedsPerRow;
         }
 
+      protected:
+        /// @brief numberOfLedsPerColumn rows of numberOfLedsPerRow LEDs, wired in a zigzag.
+        PixelBuffer getPixelBuffer() const override;
+
       private:
         PixelMatrixExtensions      pixelMatrixExtensions     = PixelMatrixExtensions::None;
         AlarmZonesDeviceExtension* alarmZonesDeviceExtension = nullptr;
@@ -18,23 +18,18 @@
 // Includes
 // --------------------------------------------------------------------------------------------------------------------
 #include "DeviceBase.hpp"
+#include "UartReader.hpp"
+#include "core/OccupancyZones.hpp"
+#include "core/Rd03DParser.hpp"
+#include "core/SpscRingBuffer.hpp"
+#include "core/TargetTracker.hpp"
 
 #include <Arduino.h>
+#include <ArduinoJson.h>
 
 namespace IotZoo
 {
-    struct Target
-    {
-      public:
-        int16_t  x                             = 0;
-        int16_t  y                             = 0;
-        int16_t  speedCentimetersPerSecond     = 0;
-        uint16_t distanceResolutionMillimeters = 0;
-        int16_t  distanceMillimeters           = 0;
-        float    angle                         = 0;
-    };
-
-    class Rd03D : DeviceBase
+    class Rd03D : public DeviceBase
     {
       protected:
         uint8_t   pinRx;
@@ -43,37 +38,47 @@ namespace IotZoo
         uint16_t  maxDistanceMillimeters;
         bool      multiTargetMode;
 
-        uint8_t serialBuffer[64]     = {0};
-        int     serialBufferCount    = 0;
-        int     serialBufferCountTmp = 0;
+        UartReader*    uart = nullptr;
+        Rd03DParser    parser;  // decoder task only.
+        TargetTracker  tracker; // smoothed targets with stable ids, instead of the slots of the radar.
+        OccupancyZones zones;   // stored in the settings under SettingsKeyZones.
+
+        SpscRingBuffer<Rd03DFrame, 8> frames; // from the decoder task to loop(), 10 frames per second.
+        uint32_t                      reportedOverruns = 0;
+
+        static constexpr const char* SettingsKeyZones = "rd03dZones";
+
+        static constexpr size_t TargetCount = Rd03DFrame::TargetCount;
+
+        /// @brief A track is published again if it moved more than this since it was published.
+        static constexpr float MinChangeMillimeters = 50;
 
-        Target target1;
-        Target target2;
-        Target target3;
+        struct PublishedTrack
+        {
+            uint16_t id = 0; // 0 = none
+            float    x  = 0;
+            float    y  = 0;
+        };
+
+        uint16_t       publishIntervalMillis = 500;
+        uint32_t       millisLastPublish     = 0;
+        PublishedTrack publishedTracks[TargetCount];
 
         bool currentIsMovingStatus = false;
 
-        bool target1IsMoving = false;
-        bool target2IsMoving = false;
-        bool target3IsMoving = false;
+        bool     targetIsMoving[TargetCount]    = {false, false, false};
+        uint32_t millisTargetMoved[TargetCount] = {0, 0, 0};
 
         u_int8_t countOfPeopleInRange    = 0;
         u_int8_t oldCountOfPeopleInRange = 0;
 
-        long millisTarget1Moved;
-        long millisTarget2Moved;
-        long millisTarget3Moved;
-
-        String topicDistanceTarget1;
-        String topicDistanceTarget2;
-        String topicDistanceTarget3;
-
-        String topicMovementChangeTarget1;
-        String topicMovementChangeTarget2;
-        String topicMovementChangeTarget3;
+        String topicDistanceTarget[TargetCount];
+        String topicMovementChangeTarget[TargetCount];
 
         String topicMovementDetected;
         String topicCountOfDetectedPeopleInRange;
+        String topicTracks;
+        String topicZones;
 
       protected:
         // Target Detection Commands
@@ -82,20 +87,36 @@ namespace IotZoo
 
         void setup();
 
-        Target getTarget(uint8_t targetIndex);
+        /// @brief Runs in the decoder task of the UART: parses the received bytes and queues the frames for loop().
+        static void onUartData(void* context, const uint8_t* data, size_t length);
+
+        /// @brief 3 targets in multi target mode, otherwise 1.
+        size_t getTargetCount() const
+        {
+            return multiTargetMode ? TargetCount : 1;
+        }
 
         /// @brief publishes if a movement was detected or not.
         void publishMovementStatus();
 
-        /// @brief Processes the received data.
-        /// @return true, if at least one target was found; otherwise false.
-        bool processData();
+        /// @brief Passes the targets in range of a decoded frame to the tracker.
+        void onFrame(const Rd03DFrame& frame);
 
-        String serializeTarget(const Target& target);
+        /// @brief Publishes the tracks that appeared, disappeared or moved since the last publish.
+        void publishTracks();
+
+        /// @brief {"zones":[{"name":"couch","dwellMillis":10000,"points":[[-2000,1000],[0,1000],[0,2000],[-2000,2000]]}]}
+        /// Points in mm: x to the right of the radar, y away from it. Names without '/', '+' and '#', see OccupancyZones.
+        bool parseZones(const String& json);
+
+        /// @brief Publishes the enter, dwell and exit events and the occupancy of the zone.
+        void onZoneEvent(const ZoneEvent& event);
+
+        void serializeTrack(const Track& track, JsonObject json) const;
 
       public:
         Rd03D(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, uint8_t pinRx, uint8_t pinTx,
-              u_int16_t timeoutMillis, u_int16_t maxDistanceMillimeters, bool multiTargetMode);
+              u_int16_t timeoutMillis, u_int16_t maxDistanceMillimeters, bool multiTargetMode, u_int16_t publishIntervalMillis = 500);
 
         ~Rd03D() override;
 
@@ -103,6 +124,9 @@ namespace IotZoo
         /// @param topics
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const override;
 
+        /// @brief Subscribes the zones topic.
+        void onMqttConnectionEstablished() override;
+
         void loop() override;
     };
 } // namespace IotZoo
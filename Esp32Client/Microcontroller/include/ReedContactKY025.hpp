@@ -19,7 +19,7 @@
 
 namespace IotZoo
 {
-    class KY025 : DeviceBase
+    class KY025 : public DeviceBase
     {
       public:
         KY025(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, u16_t intervalMs, u8_t pinData);
@@ -31,7 +31,8 @@ namespace IotZoo
       private:      
         u16_t intervalMs;
 
-        unsigned long lastLoopMillis = 0;
+        PublishChannel channelPpm;
+        TopicId        topicIdCounter = InvalidTopicId;
     };
 } // namespace IotZoo
 
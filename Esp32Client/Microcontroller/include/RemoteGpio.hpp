@@ -18,7 +18,7 @@
 
 namespace IotZoo
 {
-    class RemoteGpio : DeviceBase
+    class RemoteGpio : public DeviceBase
     {
       protected:
         int pinGpio = -1;
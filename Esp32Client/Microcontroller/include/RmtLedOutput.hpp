@@ -0,0 +1,65 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Connect WS2812, WS2818 Leds with microcontrollers in a simple way.
+// --------------------------------------------------------------------------------------------------------------------
+// Non-blocking LED output over the RMT peripheral. The pixels are composed in the buffer of the Adafruit_NeoPixel
+// (front buffer), show() copies them into the transmit buffer (back buffer) and returns while the RMT sends them.
+// Every strip gets its own RMT channel, so the strips are sent in parallel.
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#ifdef USE_WS2818_RMT
+#ifndef __RMT_LED_OUTPUT_HPP__
+#define __RMT_LED_OUTPUT_HPP__
+
+#include <Arduino.h>
+#include <driver/rmt.h>
+
+namespace IotZoo
+{
+    class RmtLedOutput
+    {
+      public:
+        RmtLedOutput(uint8_t pin, size_t byteCount);
+
+        ~RmtLedOutput();
+
+        /// @brief Allocates a free RMT channel and installs the driver.
+        /// @return false if all RMT channels are in use, show() does nothing then.
+        bool begin();
+
+        /// @brief true while the previous frame (including the reset pulse) is sent.
+        bool isBusy() const;
+
+        /// @brief Copies the pixels into the transmit buffer and starts sending them.
+        /// @return false if the previous frame is still sent. Call again later, the pixels are not copied.
+        bool show(const uint8_t* pixels);
+
+        bool isStarted() const
+        {
+            return channel != RMT_CHANNEL_MAX;
+        }
+
+      protected:
+        /// @brief Called by the RMT driver (in the interrupt) to refill its memory block.
+        static void IRAM_ATTR translate(const void* source, rmt_item32_t* items, size_t sourceSize, size_t wantedItems, size_t* translatedSize,
+                                        size_t* itemCount);
+
+        static uint8_t usedChannels; // bit mask of the channels used by any strip.
+
+        uint8_t       pin;
+        size_t        byteCount;
+        uint8_t*      transmitBuffer = nullptr;
+        rmt_channel_t channel        = RMT_CHANNEL_MAX;
+        uint32_t      startMicros    = 0;
+        uint32_t      frameMicros    = 0;
+    };
+} // namespace IotZoo
+
+#endif // __RMT_LED_OUTPUT_HPP__
+#endif // USE_WS2818_RMT
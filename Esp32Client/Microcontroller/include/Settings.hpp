@@ -11,6 +11,8 @@
 #ifndef __SETTINGS_HPP__
 #define __SETTINGS_HPP__
 
+#include "core/SettingsCache.hpp"
+
 // To save data permanently in the flash.
 #include <Preferences.h>
 
@@ -62,6 +64,67 @@ namespace IotZoo
 
     */
 
+    /// @brief The Preferences (NVS) of the ESP32 as storage of the settings cache.
+    class PreferencesStorage : public SettingsStorage
+    {
+      public:
+        explicit PreferencesStorage(const char* namespaceName) : namespaceName(namespaceName)
+        {
+        }
+
+        bool begin(bool readOnly) override
+        {
+            return preferences.begin(namespaceName, readOnly);
+        }
+
+        void end() override
+        {
+            preferences.end();
+        }
+
+        bool isKey(const char* key) override
+        {
+            return preferences.isKey(key);
+        }
+
+        std::string getString(const char* key) override
+        {
+            String value = preferences.getString(key, "");
+            return std::string(value.c_str(), value.length());
+        }
+
+        int32_t getLong(const char* key) override
+        {
+            return preferences.getLong(key, 0);
+        }
+
+        uint16_t getUShort(const char* key) override
+        {
+            return preferences.getUShort(key, 0);
+        }
+
+        size_t putString(const char* key, const std::string& value) override
+        {
+            return preferences.putString(key, value.c_str());
+        }
+
+        size_t putLong(const char* key, int32_t value) override
+        {
+            return preferences.putLong(key, value);
+        }
+
+        size_t putUShort(const char* key, uint16_t value) override
+        {
+            return preferences.putUShort(key, value);
+        }
+
+      protected:
+        const char* namespaceName;
+        Preferences preferences;
+    };
+
+    /// @brief The settings are loaded into RAM once at the start. Reads do not touch the flash, changes are written
+    /// back lazily by flushIfDue() and flush().
     class Settings
     {
         const String ProjectNameKey      = "ProjectName";
@@ -112,8 +175,23 @@ namespace IotZoo
 
         void setIntervalTemperatureSensorsMillis(long interval);
 
+        /// @brief Writes all changes to the flash. Call it before a restart.
+        /// @return Count of written keys.
+        size_t flush();
+
+        /// @brief Writes the changes to the flash if the last change is older than the write-back delay. Several
+        /// changes in a row result in one flash write.
+        /// @return Count of written keys.
+        size_t flushIfDue();
+
       protected:
-        Preferences preferences;
+        static std::string toStdString(const String& value)
+        {
+            return std::string(value.c_str(), value.length());
+        }
+
+        PreferencesStorage storage{NamespaceNameConfig};
+        SettingsCache      cache{&storage};
     };
 } // namespace IotZoo
 
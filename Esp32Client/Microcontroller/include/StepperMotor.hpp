@@ -15,6 +15,7 @@
 
 #include "ArduinoJson.h"
 #include "DeviceBase.hpp"
+#include "core/Log.hpp"
 
 #include <StepperControl.h>
 
@@ -75,7 +76,7 @@ namespace IotZoo
         int    actionId;
     };
 
-    class StepperMotor : DeviceBase
+    class StepperMotor : public DeviceBase
     {
       public:
         StepperMotor(int deviceIndex, Settings* const settings, MqttClient* mqttClient, const String& baseTopic, u_int8_t pin1, u_int8_t pin2,
@@ -85,7 +86,7 @@ namespace IotZoo
 
         void stop()
         {
-            Serial.println("aborting stepper " + getBaseTopic());
+            LOG_DEBUG(LogModuleActuators, "aborting stepper " + getBaseTopic());
             stepperControl->RemoveAllActions();
             stepperActions.clear();
         }
@@ -112,7 +113,7 @@ namespace IotZoo
 
         static void actionEnded()
         {
-            Serial.println("ended");
+            LOG_DEBUG(LogModuleActuators, "ended");
         }
 
         void loop() override;
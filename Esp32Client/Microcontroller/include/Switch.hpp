@@ -25,6 +25,8 @@ namespace IotZoo
         bool    isButtonPressed       = false;
         bool    oldIsButtonPressed    = false;
         bool    buttonStateHasChanged = false;
+        TopicId topicIdOn             = InvalidTopicId;
+        TopicId topicIdOff            = InvalidTopicId;
 
       public:
         Switch(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, uint8_t pin);
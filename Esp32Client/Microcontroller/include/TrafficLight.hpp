@@ -18,7 +18,7 @@
 
 namespace IotZoo
 {
-    class TrafficLight : DeviceBase
+    class TrafficLight : public DeviceBase
     {
       private:
         u_int8_t pinRedLed    = 0;
@@ -0,0 +1,98 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Event driven UART input for serial devices (Rd-03D, GPS). The ESP-IDF UART driver moves the received bytes from the
+// hardware FIFO into its ring buffer in the interrupt and posts an event: when the FIFO is full, after an idle gap of
+// a few characters or when the pattern character (e.g. the <LF> of an NMEA sentence) is received. A decoder task per
+// device waits for these events and passes the received bytes to the decoder of the device. The decoder hands complete
+// frames to the loop() of the device, e.g. through a SpscRingBuffer, so loop() never waits for serial input.
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#if defined(USE_GPS) || defined(USE_RD_03D)
+#ifndef __UART_READER_HPP__
+#define __UART_READER_HPP__
+
+#include <Arduino.h>
+#include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+#define UART_READER_RX_BUFFER_SIZE 1024   // ring buffer of the driver
+#define UART_READER_EVENT_QUEUE_SIZE 16   // events of the driver
+#define UART_READER_BLOCK_SIZE 128        // bytes per uart_read_bytes() of the decoder task
+#define UART_READER_RX_TIMEOUT_SYMBOLS 4  // idle gap in characters that ends a burst, e.g. a Rd-03D frame
+#define UART_READER_TASK_CORE 0           // the Arduino loop runs on core 1
+#define UART_READER_TASK_PRIORITY 2       // higher than the Arduino loop task, lower than the audio capture task
+
+namespace IotZoo
+{
+    class UartReader
+    {
+      public:
+        /// @brief Called in the decoder task with the received bytes.
+        using DataCallback = void (*)(void* context, const uint8_t* data, size_t length);
+
+        static constexpr int NoPattern = -1;
+
+        UartReader(uint8_t pinRx, uint8_t pinTx, uint32_t baud);
+
+        ~UartReader();
+
+        /// @brief Allocates a free UART (UART 0 is the console), installs the driver and starts the decoder task.
+        /// @param pattern A character that ends a frame, e.g. '\n'. The decoder task is woken up as soon as it is received.
+        /// @return false if all UARTs are in use or the task could not be created.
+        bool begin(DataCallback onData, void* context, const char* taskName, int pattern = NoPattern);
+
+        /// @brief Queues the bytes in the TX FIFO of the UART, e.g. commands to the device.
+        int write(const uint8_t* data, size_t length);
+
+        bool isStarted() const
+        {
+            return port != UART_NUM_MAX;
+        }
+
+        /// @brief Count of FIFO or ring buffer overflows, the received bytes were dropped then.
+        uint32_t getOverflows() const
+        {
+            return overflows;
+        }
+
+      protected:
+        /// @brief FreeRTOS task function of the decoder task.
+        static void decoderTask(void* parameter);
+
+        /// @brief Runs in the decoder task: waits for the events of the driver and passes the received bytes on.
+        void decode();
+
+        /// @brief Reads all bytes in the ring buffer of the driver.
+        void readAll();
+
+        static uint8_t usedPorts; // bit mask of the UARTs used by any device.
+
+        uint8_t       pinRx;
+        uint8_t       pinTx;
+        uint32_t      baud;
+        int           pattern    = NoPattern;
+        uart_port_t   port       = UART_NUM_MAX;
+        QueueHandle_t eventQueue = nullptr;
+        TaskHandle_t  taskHandle = nullptr;
+        DataCallback  onData     = nullptr;
+        void*         context    = nullptr;
+
+        volatile uint32_t overflows = 0;
+
+        // decoder task only
+        uint8_t buffer[UART_READER_BLOCK_SIZE];
+    };
+} // namespace IotZoo
+
+#endif // __UART_READER_HPP__
+#endif // defined(USE_GPS) || defined(USE_RD_03D)
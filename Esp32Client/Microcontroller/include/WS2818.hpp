@@ -16,25 +16,34 @@
 #define __WS2818_HPP__
 
 #include "DeviceBase.hpp"
+#include "core/ExpiryHeap.hpp"
+#include "core/LedEffect.hpp"
+#include "core/PixelFrame.hpp"
+#ifdef USE_WS2818_RMT
+#include "RmtLedOutput.hpp"
+#endif
 
 #include <Adafruit_NeoPixel.h>
 #include <ArduinoJson.h>
 
 namespace IotZoo
 {
-    struct PixelProperty
-    {
-        int           PixelId            = 0;
-        unsigned long MillisUntilTurnOff = 0;
-    };
-
     class WS2818 : public DeviceBase
     {
       protected:
-        Adafruit_NeoPixel*    pixels = nullptr;
-        int                   dioPin;
-        uint                  numberOfLeds;
-        vector<PixelProperty> pixelProperties;
+        Adafruit_NeoPixel* pixels    = nullptr;
+        neoPixelType       pixelType = NEO_GRB + NEO_KHZ800;
+        int                dioPin;
+        uint               numberOfLeds;
+        ExpiryHeap         turnOffTimers; // by pixel index, only the pixels with millisUntilTurnOff > 0.
+        bool               dirty = false; // the LED buffer differs from the LEDs.
+        LedEffect          effect;
+#ifdef USE_WS2818_RMT
+        RmtLedOutput* rmtOutput = nullptr; // nullptr: no free RMT channel, show() of the Adafruit_NeoPixel is used.
+#endif
+
+        /// @brief The LED buffer of the Adafruit_NeoPixel and the wiring. A strip is one row.
+        virtual PixelBuffer getPixelBuffer() const;
 
       public:
         WS2818(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, uint pin, uint numberOfLeds);
@@ -49,8 +58,18 @@ namespace IotZoo
         /// @param json
         void setPixelColor(const String& json);
 
+        /// @brief Loads the preset from the settings: a setPixelColor or a setEffect JSON.
         void setPixelsByPreset(const String& presetName);
 
+        /// @brief Starts an animation, rendered by loop(). setPixelColor, setFrame and the "none" effect stop it.
+        /// Example: iotzoo/esp32/08:D1:F9:E0:31:78/neo/0/setEffect
+        /// {"effect":"chase","color":"#FF0000","color2":"#000010","periodMillis":2000,"index":0,"count":30,"length":5,"fps":30}
+        void setEffect(const String& json);
+
+        /// @brief Binary frame (see core/PixelFrame.hpp), copied straight into the LED buffer.
+        /// Example: iotzoo/esp32/08:D1:F9:E0:31:78/neo/0/setFrame
+        void setFrame(const uint8_t* frame, size_t length);
+
         /// @brief Let the user know what the device can do.
         /// @param topics
         void addMqttTopicsToRegister(std::vector<Topic>* const topics) const override;
@@ -67,6 +86,11 @@ namespace IotZoo
         void setPixelColor(uint32_t color, uint16_t index, uint8_t brightness = 20, uint64_t millisUntilTurnOff = 0);
         void setPixelColor(uint32_t color, uint16_t startIndex, uint16_t length, uint8_t brightness = 20, uint64_t millisUntilTurnOff = 0);
 
+        /// @brief Sends the LED buffer to the LEDs, if it has changed. show() blocks the interrupts for ~30 µs per LED.
+        /// With USE_WS2818_RMT the RMT sends the LED buffer in the background. While the previous frame is sent, the
+        /// buffer stays dirty and is sent by a later call.
+        void showIfDirty();
+
         Adafruit_NeoPixel* getPixels() const
         {
             return pixels;
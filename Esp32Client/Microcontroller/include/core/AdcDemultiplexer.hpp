@@ -0,0 +1,102 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Demultiplexes the conversions of the ESP32 ADC in continuous (DMA) mode into one queue per channel. The DMA buffer
+// holds 2 byte records (12 bit value, 4 bit channel) of all channels of the pattern in turn. Every channel sums up
+// 4^oversamplingBits raw values into one value with oversamplingBits bits more resolution (the noise of the ADC
+// dithers the least significant bit), then averages decimation of these values into one output value.
+// write() runs in the reader task, read() in loop(): the queues are SpscRingBuffers.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __ADC_DEMULTIPLEXER_HPP__
+#define __ADC_DEMULTIPLEXER_HPP__
+
+#include "core/SpscRingBuffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    class AdcDemultiplexer
+    {
+      public:
+        static constexpr size_t   MaxChannels         = 8;    // ADC1 of the ESP32
+        static constexpr size_t   QueueSize           = 64;   // output values per channel
+        static constexpr uint8_t  RawBits             = 12;
+        static constexpr uint8_t  MaxOversamplingBits = 4;    // 256 raw values, 16 bit
+        static constexpr uint16_t MaxDecimation       = 1024; // the sum fits into 32 bit
+
+        /// @brief Adds a channel. Not thread safe: call it before the reader task is started.
+        /// @param channel ADC channel as in the records, 0 ... 15.
+        /// @param oversamplingBits 0 ... MaxOversamplingBits
+        /// @param decimation 1 ... MaxDecimation oversampled values are averaged into one output value.
+        /// @return false if the channel is known, MaxChannels are added or a parameter is out of range.
+        bool addChannel(uint8_t channel, uint8_t oversamplingBits, uint16_t decimation = 1);
+
+        bool hasChannel(uint8_t channel) const
+        {
+            return channel < ChannelSlots && slots[channel] >= 0;
+        }
+
+        size_t getChannelCount() const
+        {
+            return channelCount;
+        }
+
+        /// @brief Reader task: demultiplexes the records (little endian, bit 0 ... 11 value, bit 12 ... 15 channel).
+        /// An odd last byte is ignored.
+        void write(const uint8_t* data, size_t length);
+
+        /// @brief Reader task: one raw conversion.
+        void writeSample(uint8_t channel, uint16_t raw);
+
+        /// @brief loop(): reads up to count output values of the channel, the oldest first.
+        /// @return Count of read values.
+        size_t read(uint8_t channel, uint16_t* values, size_t count);
+
+        /// @brief loop(): reads all output values of the channel and keeps the newest.
+        /// @return false if there was no new value.
+        bool readLatest(uint8_t channel, uint16_t& value);
+
+        /// @brief The output value of the full scale raw value 4095, e.g. 65520 with 4 oversampling bits.
+        uint32_t getFullScale(uint8_t channel) const;
+
+        /// @brief Count of output values dropped because loop() did not read them in time.
+        uint32_t getOverruns(uint8_t channel) const;
+
+        /// @brief Count of records of channels which are not added.
+        uint32_t getUnknownRecords() const
+        {
+            return unknownRecords.load(std::memory_order_relaxed);
+        }
+
+      protected:
+        static constexpr size_t ChannelSlots = 16;
+
+        struct Channel
+        {
+            uint8_t                             adcChannel       = 0;
+            uint8_t                             oversamplingBits = 0;
+            uint16_t                            decimation       = 1;
+            uint32_t                            samplesPerOutput = 1;
+            uint32_t                            sum              = 0; // reader task only
+            uint32_t                            sampleCount      = 0; // reader task only
+            SpscRingBuffer<uint16_t, QueueSize> queue;
+        };
+
+        Channel               channels[MaxChannels];
+        size_t                channelCount        = 0;
+        int8_t                slots[ChannelSlots] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+        std::atomic<uint32_t> unknownRecords{0};
+    };
+} // namespace IotZoo
+
+#endif // __ADC_DEMULTIPLEXER_HPP__
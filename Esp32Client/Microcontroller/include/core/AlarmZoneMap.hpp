@@ -0,0 +1,85 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Maps an alarm subject (e.g. "Person detected: Garten") to a color and the LEDs of a zone. The level keywords and
+// the zone names are found in one pass over the subject; the first level and the first zone in the order they were
+// added win. Every zone is a precomputed list of pixel runs.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __ALARM_ZONE_MAP_HPP__
+#define __ALARM_ZONE_MAP_HPP__
+
+#include "core/KeywordMatcher.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IotZoo
+{
+    /// @brief length LEDs starting at startIndex.
+    struct PixelRun
+    {
+        uint16_t startIndex = 0;
+        uint16_t length     = 0;
+    };
+
+    struct Alarm
+    {
+        int             level    = -1; // index of the level keyword
+        int             zone     = -1; // index of the zone, -1 if the subject names no zone.
+        uint32_t        color    = 0;  // 0x00RRGGBB
+        const PixelRun* runs     = nullptr;
+        size_t          runCount = 0;
+    };
+
+    class AlarmZoneMap
+    {
+      public:
+        static constexpr size_t MaxLevels = 16;
+        static constexpr size_t MaxZones  = KeywordMatcher::MaxKeywords - MaxLevels;
+
+        void clear();
+
+        /// @brief Adds a level, e.g. addLevel("person", 0xFF0000). Levels added first have priority.
+        bool addLevel(const char* keyword, uint32_t color);
+
+        /// @brief Adds a zone. The following addRun() calls belong to it.
+        bool addZone(const char* name);
+
+        bool addRun(uint16_t startIndex, uint16_t length);
+
+        /// @brief Builds the matcher. Call it after adding the levels and the zones.
+        void build();
+
+        /// @return false if the subject contains no level keyword.
+        bool lookup(const char* subject, size_t length, Alarm& alarm) const;
+
+        size_t getLevelCount() const
+        {
+            return levelKeywords.size();
+        }
+
+        size_t getZoneCount() const
+        {
+            return zoneNames.size();
+        }
+
+      protected:
+        std::vector<std::string> levelKeywords;
+        std::vector<uint32_t>    levelColors;
+        std::vector<std::string> zoneNames;
+        std::vector<PixelRun>    runs;
+        std::vector<uint16_t>    zoneFirstRun; // zone -> index into runs; runs of the zone end at the next entry.
+        KeywordMatcher           matcher;      // ids: the levels, then the zones.
+    };
+} // namespace IotZoo
+
+#endif // __ALARM_ZONE_MAP_HPP__
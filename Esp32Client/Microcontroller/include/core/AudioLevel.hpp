@@ -0,0 +1,57 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Sound level of 16 bit PCM samples (RMS and dBFS).
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __AUDIO_LEVEL_HPP__
+#define __AUDIO_LEVEL_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    /// @brief Accumulates the RMS over blocks of samples, so a chunk can be processed piece by piece while it is drained
+    /// from the ring buffer.
+    class RmsAccumulator
+    {
+      public:
+        void add(const int16_t* samples, size_t count);
+
+        double getRms() const;
+
+        size_t getSampleCount() const
+        {
+            return sampleCount;
+        }
+
+        void reset()
+        {
+            sumOfSquares = 0;
+            sampleCount  = 0;
+        }
+
+      protected:
+        // 2^31 squares of 2^30 fit into 64 bit.
+        uint64_t sumOfSquares = 0;
+        size_t   sampleCount  = 0;
+    };
+
+    double calculateRms(const int16_t* samples, size_t count);
+
+    // 0 dB = maximum digital volume
+    // -10 dB = strong, good
+    // -20 dB = usable
+    // -40 dB = barely usable
+    // -60 dB = noise
+    double rmsToDecibel(double rms, double fullScale = 32768.0);
+} // namespace IotZoo
+
+#endif // __AUDIO_LEVEL_HPP__
@@ -0,0 +1,62 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Topics with binary payloads, e.g. pixel frames. The MQTT client hands the payload of a received message to this
+// table before the message is converted into a String, which would end at the first zero byte. Messages of other topics
+// are not taken.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __BINARY_SUBSCRIPTIONS_HPP__
+#define __BINARY_SUBSCRIPTIONS_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace IotZoo
+{
+    class BinarySubscriptions
+    {
+      public:
+        using Handler = std::function<void(const uint8_t* payload, size_t length)>;
+
+        /// @brief The handler of a topic added again is replaced, e.g. on a reconnect.
+        /// @return false if the topic is empty.
+        bool add(const char* topic, const Handler& handler);
+
+        /// @return false if the topic has no handler.
+        bool remove(const char* topic);
+
+        /// @brief Passes the payload unchanged, zero bytes included, to the handler of the topic.
+        /// @return false if the topic is no binary topic: the message is left to the String callbacks.
+        bool dispatch(const char* topic, const uint8_t* payload, size_t length) const;
+
+        size_t size() const
+        {
+            return entries.size();
+        }
+
+      protected:
+        struct Entry
+        {
+            uint32_t    hash; // FNV-1a of the topic, compared first.
+            std::string topic;
+            Handler     handler;
+        };
+
+        /// @return -1 if the topic has no handler.
+        int32_t find(const char* topic) const;
+
+        std::vector<Entry> entries; // a few topics, e.g. setFrame of every LED strip.
+    };
+} // namespace IotZoo
+
+#endif // __BINARY_SUBSCRIPTIONS_HPP__
@@ -0,0 +1,147 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Non-blocking temperature conversion of the DS18B20 sensors on a OneWire bus:
+//
+// Idle        the interval elapsed -> one Convert T command for all sensors, returns immediately.
+// Converting  the conversion time of the resolution elapsed (94 ms at 9 bit ... 750 ms at 12 bit) -> read every
+//             sensor by its ROM address -> Idle.
+//
+// The sensors are searched once. They are sorted by ROM address and identified by it, so a sensor keeps its topic when
+// another sensor is added to the bus. The bus is an interface: DallasTemperature on the device, a fake in the tests.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __DS18B20_POLLER_HPP__
+#define __DS18B20_POLLER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace IotZoo
+{
+    struct RomAddress
+    {
+        uint8_t bytes[8] = {};
+
+        /// @brief 16 hex digits, e.g. "28FF641E8516034B". buffer: at least 17 chars.
+        void toHex(char* buffer) const;
+
+        bool operator<(const RomAddress& other) const;
+        bool operator==(const RomAddress& other) const;
+    };
+
+    class OneWireTemperatureBus
+    {
+      public:
+        virtual ~OneWireTemperatureBus() = default;
+
+        /// @brief Searches the sensors on the bus.
+        /// @return The count of found sensors, at most capacity are stored.
+        virtual size_t search(RomAddress* addresses, size_t capacity) = 0;
+
+        virtual bool setResolution(uint8_t resolution) = 0;
+
+        /// @brief Starts the conversion of all sensors, without waiting for it.
+        virtual bool startConversion() = 0;
+
+        /// @return false if the sensor did not answer or the CRC of the scratchpad was wrong.
+        virtual bool readCelsius(const RomAddress& address, float& celsius) = 0;
+    };
+
+    struct TemperatureReading
+    {
+        size_t            sensor;
+        const RomAddress& address;
+        float             celsius;
+        bool              valid;
+    };
+
+    enum class ConversionState : uint8_t
+    {
+        Idle,
+        Converting,
+    };
+
+    class DS18B20Poller
+    {
+      public:
+        static constexpr size_t MaxSensors = 64;
+
+        using ReadingCallback = void (*)(void* context, const TemperatureReading& reading);
+
+        /// @param resolution 9 ... 12 bits.
+        /// @param intervalMillis from the start of one conversion to the start of the next one.
+        DS18B20Poller(OneWireTemperatureBus& bus, uint8_t resolution, uint32_t intervalMillis);
+
+        /// @brief Searches the sensors and sets their resolution.
+        /// @return The count of sensors.
+        size_t begin();
+
+        /// @brief Advances the state machine, never waits. Reports the reading of every sensor when a conversion is complete.
+        /// @return true if a conversion was completed.
+        bool loop(uint32_t nowMillis, ReadingCallback onReading, void* context);
+
+        /// @brief Same as above, with a lambda: loop(now, [&](const TemperatureReading& reading) { ... }).
+        template <typename OnReading> bool loop(uint32_t nowMillis, OnReading&& onReading)
+        {
+            using Function = std::remove_reference_t<OnReading>;
+            return loop(
+                nowMillis, [](void* context, const TemperatureReading& reading) { (*static_cast<Function*>(context))(reading); },
+                const_cast<void*>(static_cast<const void*>(&onReading)));
+        }
+
+        /// @brief Max. conversion time of the DS18B20 at the resolution.
+        static uint32_t getConversionMillis(uint8_t resolution);
+
+        void setIntervalMillis(uint32_t intervalMillis)
+        {
+            this->intervalMillis = intervalMillis;
+        }
+
+        uint32_t getIntervalMillis() const
+        {
+            return intervalMillis;
+        }
+
+        size_t getSensorCount() const
+        {
+            return addresses.size();
+        }
+
+        const RomAddress& getAddress(size_t sensor) const
+        {
+            return addresses[sensor];
+        }
+
+        ConversionState getState() const
+        {
+            return state;
+        }
+
+        /// @brief Conversions the bus did not accept, e.g. no sensor answered the reset pulse.
+        uint32_t getBusErrors() const
+        {
+            return busErrors;
+        }
+
+      protected:
+        OneWireTemperatureBus&  bus;
+        std::vector<RomAddress> addresses;
+        uint8_t                 resolution;
+        uint32_t                intervalMillis;
+        ConversionState         state                 = ConversionState::Idle;
+        bool                    started               = false; // the first conversion starts at once.
+        uint32_t                conversionStartMillis = 0;
+        uint32_t                busErrors             = 0;
+    };
+} // namespace IotZoo
+
+#endif // __DS18B20_POLLER_HPP__
@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Registry of the instantiated devices and the table of device factories. Templates, so they do not depend on
+// DeviceBase/Arduino and can be tested on the host.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __DEVICE_REGISTRY_HPP__
+#define __DEVICE_REGISTRY_HPP__
+
+#include "core/Fnv1a.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace IotZoo
+{
+    /// @brief Compact array of the configured devices. Each lifecycle phase (connection established, register topics,
+    /// client unavailable, loop) iterates over it once, so the cost depends on the active devices only and not on the
+    /// compiled in features.
+    /// @tparam TDevice e.g. DeviceBase or DeviceHandlingBase. The registry does not own the devices.
+    template <typename TDevice> class DeviceRegistry
+    {
+      public:
+        using const_iterator = typename std::vector<TDevice*>::const_iterator;
+
+        /// @brief Adds a device. nullptr and devices which are already registered are ignored.
+        /// @param name e.g. the device type. Must outlive the registry (string literal).
+        /// @return true if the device was added.
+        bool add(TDevice* const device, const char* name = "")
+        {
+            if (nullptr == device || contains(device))
+            {
+                return false;
+            }
+            devices.push_back(device);
+            names.push_back(name);
+            return true;
+        }
+
+        bool contains(const TDevice* const device) const
+        {
+            for (TDevice* registeredDevice : devices)
+            {
+                if (registeredDevice == device)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// @brief Calls function(device) for every registered device.
+        template <typename TFunction> void forEach(TFunction function) const
+        {
+            for (TDevice* device : devices)
+            {
+                function(device);
+            }
+        }
+
+        size_t size() const
+        {
+            return devices.size();
+        }
+
+        TDevice* operator[](size_t index) const
+        {
+            return devices[index];
+        }
+
+        const char* getName(size_t index) const
+        {
+            return names[index];
+        }
+
+        const_iterator begin() const
+        {
+            return devices.begin();
+        }
+
+        const_iterator end() const
+        {
+            return devices.end();
+        }
+
+        /// @brief Devices are added once after the start, so reserve the memory once.
+        void reserve(size_t capacity)
+        {
+            devices.reserve(capacity);
+            names.reserve(capacity);
+        }
+
+      protected:
+        std::vector<TDevice*>    devices; // contiguous, this is what the lifecycle phases iterate.
+        std::vector<const char*> names;
+    };
+
+    /// @brief Maps the device type of the configuration (e.g. "DS18B20") to the function which creates the device.
+    /// Only the compiled in device types are added, so an unknown device type is not supported by this firmware.
+    /// @tparam TConfiguration Configuration of one device.
+    template <typename TConfiguration> class DeviceFactoryTable
+    {
+      public:
+        /// @return true if the device was created and registered.
+        using Factory = bool (*)(const TConfiguration& configuration);
+
+        /// @param deviceType Must outlive the table (string literal).
+        void add(const char* deviceType, Factory factory)
+        {
+            entries.push_back(Entry{fnv1a(deviceType), deviceType, factory});
+        }
+
+        /// @brief Creates the device with the factory of the device type.
+        /// @return false if the device type is unknown or the factory failed.
+        bool create(const char* deviceType, const TConfiguration& configuration) const
+        {
+            const Entry* entry = find(deviceType);
+            if (nullptr == entry)
+            {
+                return false;
+            }
+            return entry->factory(configuration);
+        }
+
+        bool isSupported(const char* deviceType) const
+        {
+            return nullptr != find(deviceType);
+        }
+
+        size_t size() const
+        {
+            return entries.size();
+        }
+
+      protected:
+        struct Entry
+        {
+            uint32_t    typeId; // FNV-1a of deviceType, compared first.
+            const char* deviceType;
+            Factory     factory;
+        };
+
+        const Entry* find(const char* deviceType) const
+        {
+            uint32_t typeId = fnv1a(deviceType);
+            for (const Entry& entry : entries)
+            {
+                if (entry.typeId == typeId && strcmp(entry.deviceType, deviceType) == 0)
+                {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        std::vector<Entry> entries;
+    };
+} // namespace IotZoo
+
+#endif // __DEVICE_REGISTRY_HPP__
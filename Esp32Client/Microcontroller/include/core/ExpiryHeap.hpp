@@ -0,0 +1,75 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Indexed min-heap of deadlines, e.g. when a LED has to be turned off. Every id (0 .. capacity - 1) has at most one
+// deadline, scheduling it again moves it. The deadlines are compared wrap safe (millis() overflows after 49 days),
+// so they must be less than 24 days apart.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __EXPIRY_HEAP_HPP__
+#define __EXPIRY_HEAP_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace IotZoo
+{
+    class ExpiryHeap
+    {
+      public:
+        static constexpr int32_t NoId = -1;
+
+        explicit ExpiryHeap(size_t capacity = 0);
+
+        /// @brief Ids 0 .. capacity - 1. Removes all deadlines.
+        void resize(size_t capacity);
+
+        /// @brief Sets or moves the deadline of the id.
+        void schedule(uint16_t id, uint32_t deadlineMillis);
+
+        void cancel(uint16_t id);
+
+        bool isScheduled(uint16_t id) const
+        {
+            return id < positions.size() && positions[id] != NotScheduled;
+        }
+
+        /// @return The id with the earliest deadline if it is due (removed from the heap), otherwise NoId.
+        int32_t popExpired(uint32_t nowMillis);
+
+        /// @return Milliseconds until the earliest deadline, 0 if due, UINT32_MAX if empty.
+        uint32_t millisUntilNext(uint32_t nowMillis) const;
+
+        size_t size() const
+        {
+            return heap.size();
+        }
+
+        /// @brief a is before b, correct across the overflow of millis().
+        static bool isBefore(uint32_t a, uint32_t b)
+        {
+            return static_cast<int32_t>(a - b) < 0;
+        }
+
+      protected:
+        static constexpr uint16_t NotScheduled = 0xFFFF;
+
+        void remove(uint16_t position);
+        void siftUp(uint16_t position);
+        void siftDown(uint16_t position);
+        void place(uint16_t position, uint16_t id);
+
+        std::vector<uint16_t> heap;      // ids, earliest deadline first
+        std::vector<uint32_t> deadlines; // by id
+        std::vector<uint16_t> positions; // by id, position in heap or NotScheduled
+    };
+} // namespace IotZoo
+
+#endif // __EXPIRY_HEAP_HPP__
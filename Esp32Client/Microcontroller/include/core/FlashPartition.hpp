@@ -0,0 +1,88 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// A region of NOR flash as seen by the telemetry log: erased in sectors (all bits 1), a write can only clear bits.
+// On the ESP32 it is a data partition (EspFlashPartition), on the host a file (FilePartition), so the log format and
+// the replay can be tested on Linux.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __FLASH_PARTITION_HPP__
+#define __FLASH_PARTITION_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace IotZoo
+{
+    class FlashPartition
+    {
+      public:
+        virtual ~FlashPartition() = default;
+
+        /// @brief Usable size in bytes, a multiple of the sector size.
+        virtual size_t getSize() const = 0;
+
+        virtual size_t getSectorSize() const = 0;
+
+        virtual bool read(size_t offset, void* data, size_t length) = 0;
+
+        /// @brief Clears the bits which are 0 in data. Bits which are 0 already stay 0.
+        virtual bool write(size_t offset, const void* data, size_t length) = 0;
+
+        /// @brief Sets all bits of the sector at offset to 1.
+        virtual bool eraseSector(size_t offset) = 0;
+    };
+
+    /// @brief A file as flash partition, e.g. for the host tests. Emulates the NOR flash: a write ANDs the data.
+    class FilePartition : public FlashPartition
+    {
+      public:
+        /// @brief Opens the file, creates it as erased flash if it does not exist or has a different size.
+        FilePartition(const char* path, size_t size, size_t sectorSize = 4096);
+
+        ~FilePartition() override;
+
+        bool isOpen() const
+        {
+            return nullptr != file;
+        }
+
+        size_t getSize() const override
+        {
+            return size;
+        }
+
+        size_t getSectorSize() const override
+        {
+            return sectorSize;
+        }
+
+        bool read(size_t offset, void* data, size_t length) override;
+
+        bool write(size_t offset, const void* data, size_t length) override;
+
+        bool eraseSector(size_t offset) override;
+
+        /// @brief Erase count of the sector, to check the wear levelling.
+        uint32_t getEraseCount(size_t sector) const
+        {
+            return sector < eraseCounts.size() ? eraseCounts[sector] : 0;
+        }
+
+      protected:
+        FILE*                 file = nullptr;
+        size_t                size;
+        size_t                sectorSize;
+        std::vector<uint32_t> eraseCounts;
+    };
+} // namespace IotZoo
+
+#endif // __FLASH_PARTITION_HPP__
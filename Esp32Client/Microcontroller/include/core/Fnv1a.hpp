@@ -0,0 +1,44 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// 32 bit FNV-1a hash. Cheap, good enough to turn short strings (device types, topics) into ids.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __FNV1A_HPP__
+#define __FNV1A_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    static constexpr uint32_t Fnv1aOffsetBasis = 2166136261u;
+    static constexpr uint32_t Fnv1aPrime       = 16777619u;
+
+    constexpr uint32_t fnv1a(const char* text, uint32_t hash = Fnv1aOffsetBasis)
+    {
+        while (*text != '\0')
+        {
+            hash = (hash ^ static_cast<uint8_t>(*text)) * Fnv1aPrime;
+            text++;
+        }
+        return hash;
+    }
+
+    inline uint32_t fnv1a(const uint8_t* data, size_t length, uint32_t hash = Fnv1aOffsetBasis)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            hash = (hash ^ data[i]) * Fnv1aPrime;
+        }
+        return hash;
+    }
+} // namespace IotZoo
+
+#endif // __FNV1A_HPP__
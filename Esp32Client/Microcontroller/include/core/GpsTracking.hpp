@@ -0,0 +1,221 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Decides which GPS fixes are worth a publish and turns them into compact messages:
+//
+// PositionFilter  publishes a fix if it moved more than minDistanceMeters, the course changed more than
+//                 minHeadingDegrees while moving, or maxIntervalMillis elapsed (heartbeat). Never faster than
+//                 minIntervalMillis.
+// Geofences       circles and polygons, reports enter and exit. An exit needs hysteresisMeters distance to the border,
+//                 so the noise of the fix at the border does not produce a series of events.
+// TrackBatch      collects fixes and serializes them delta encoded: {"t":[t0,dt,...],"lat":[lat0,dlat,...],"lon":[...]}
+//                 with seconds and 1e-5 degrees (~1 m). The receiver restores the values by summing up.
+//
+// Distances use the equirectangular projection around the points: the differences of latitude and longitude are
+// taken in double, the rest in float (the FPU of the ESP32 is single precision). Accurate to 0.1 % below 10 km.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __GPS_TRACKING_HPP__
+#define __GPS_TRACKING_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace IotZoo
+{
+    struct GeoPoint
+    {
+        double latitude  = 0; // degrees
+        double longitude = 0;
+    };
+
+    class GeoMath
+    {
+      public:
+        static constexpr float EarthRadiusMeters = 6371000.0f;
+
+        /// @brief Offset of the point from the origin in meters: x to the east, y to the north.
+        static void toLocalMeters(const GeoPoint& origin, float cosLatitude, const GeoPoint& point, float& x, float& y);
+
+        static float distanceMeters(const GeoPoint& a, const GeoPoint& b);
+
+        /// @brief Absolute difference of two courses in degrees, 0 ... 180.
+        static float headingDifference(float a, float b);
+    };
+
+    struct PositionFilterParameters
+    {
+        float    minDistanceMeters       = 25;
+        float    minHeadingDegrees       = 30;
+        float    minSpeedMetersPerSecond = 1.0f; // below this the course of the fix is noise.
+        uint32_t minIntervalMillis       = 1000;
+        uint32_t maxIntervalMillis       = 300000;
+    };
+
+    enum class PublishReason : uint8_t
+    {
+        None,
+        First,
+        Distance,
+        Heading,
+        Heartbeat,
+    };
+
+    class PositionFilter
+    {
+      public:
+        PositionFilterParameters parameters;
+
+        /// @brief Compares the fix with the last published fix. If it is to be published, it becomes the last published fix.
+        PublishReason update(const GeoPoint& position, float courseDegrees, float speedMetersPerSecond, uint32_t nowMillis);
+
+        void reset()
+        {
+            hasPublished = false;
+        }
+
+        static const char* getReasonName(PublishReason reason);
+
+      protected:
+        bool     hasPublished = false;
+        GeoPoint publishedPosition;
+        float    publishedCourse = 0;
+        uint32_t publishedMillis = 0;
+    };
+
+    enum class GeofenceEventType : uint8_t
+    {
+        Enter,
+        Exit,
+    };
+
+    struct GeofenceEvent
+    {
+        GeofenceEventType type;
+        uint8_t           fence;
+    };
+
+    class Geofences
+    {
+      public:
+        static constexpr size_t MaxFences   = 16;
+        static constexpr size_t MaxVertices = 16;
+
+        using EventCallback = void (*)(void* context, const GeofenceEvent& event);
+
+        float hysteresisMeters = 15;
+
+        void clear();
+
+        bool addCircle(const char* name, const GeoPoint& center, float radiusMeters);
+
+        /// @brief Adds a simple polygon, the vertices in order.
+        /// @return false if there are MaxFences fences or the polygon has less than 3 or more than MaxVertices vertices.
+        bool addPolygon(const char* name, const GeoPoint* vertices, size_t count);
+
+        /// @brief Reports the fences entered or left since the last call. The first fix inside of a fence is an Enter.
+        void update(const GeoPoint& position, EventCallback onEvent, void* context);
+
+        /// @brief Same as above, with a lambda: update(position, [&](const GeofenceEvent& event) { ... }).
+        template <typename OnEvent> void update(const GeoPoint& position, OnEvent&& onEvent)
+        {
+            using Function = std::remove_reference_t<OnEvent>;
+            update(
+                position, [](void* context, const GeofenceEvent& event) { (*static_cast<Function*>(context))(event); },
+                const_cast<void*>(static_cast<const void*>(&onEvent)));
+        }
+
+        /// @brief Signed distance to the border in meters: negative inside.
+        float getSignedDistance(size_t fence, const GeoPoint& position) const;
+
+        size_t getFenceCount() const
+        {
+            return fences.size();
+        }
+
+        const char* getName(size_t fence) const
+        {
+            return fences[fence].name.c_str();
+        }
+
+        bool isInside(size_t fence) const
+        {
+            return fences[fence].inside;
+        }
+
+        static const char* getEventName(GeofenceEventType type);
+
+      protected:
+        struct Fence
+        {
+            std::string name;
+            GeoPoint    origin; // the center of a circle, the first vertex of a polygon.
+            float       cosLatitude;
+            float       radiusMeters; // circle only
+            float       x[MaxVertices]; // polygon only, meters from the origin
+            float       y[MaxVertices];
+            uint8_t     vertexCount; // 0 = circle
+            bool        inside;
+        };
+
+        std::vector<Fence> fences;
+    };
+
+    struct TrackPoint
+    {
+        uint32_t timeSeconds; // e.g. seconds since midnight UTC or since the start
+        int32_t  latitudeE5;  // 1e-5 degrees
+        int32_t  longitudeE5;
+    };
+
+    class TrackBatch
+    {
+      public:
+        explicit TrackBatch(size_t capacity = 0);
+
+        void setCapacity(size_t capacity);
+
+        /// @brief Adds the point, quantized to 1e-5 degrees.
+        /// @return true if the batch is full now and should be serialized.
+        bool add(const GeoPoint& position, uint32_t timeSeconds);
+
+        /// @brief {"t":[t0,dt,...],"lat":[lat0,dlat,...],"lon":[lon0,dlon,...]}
+        /// @return The length without the terminating zero, 0 if the buffer is too small.
+        size_t serialize(char* buffer, size_t size) const;
+
+        void clear()
+        {
+            points.clear();
+        }
+
+        size_t size() const
+        {
+            return points.size();
+        }
+
+        size_t capacity() const
+        {
+            return maxPoints;
+        }
+
+        const TrackPoint& operator[](size_t index) const
+        {
+            return points[index];
+        }
+
+      protected:
+        std::vector<TrackPoint> points;
+        size_t                  maxPoints = 0;
+    };
+} // namespace IotZoo
+
+#endif // __GPS_TRACKING_HPP__
@@ -0,0 +1,62 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Finds all keywords in a text in a single pass (Aho-Corasick). The automaton is a dense transition table over the
+// characters of the keywords, so every character of the text costs one table lookup, independent of the number of
+// keywords. ASCII letters are matched case insensitive.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __KEYWORD_MATCHER_HPP__
+#define __KEYWORD_MATCHER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IotZoo
+{
+    class KeywordMatcher
+    {
+      public:
+        static constexpr size_t MaxKeywords = 64;
+
+        void clear();
+
+        /// @brief The keyword gets the next id, starting at 0. build() has to be called afterwards.
+        /// @return The id, -1 if the keyword is empty or MaxKeywords are reached.
+        int add(const char* keyword);
+
+        /// @brief Builds the automaton from the added keywords.
+        void build();
+
+        /// @return Bit id is set if the keyword with the id occurs in the text.
+        uint64_t match(const char* text, size_t length) const;
+
+        size_t getKeywordCount() const
+        {
+            return keywords.size();
+        }
+
+        /// @brief States of the automaton, for the memory estimation: states * symbols * 2 + states * 8 bytes.
+        size_t getStateCount() const
+        {
+            return outputs.size();
+        }
+
+      protected:
+        std::vector<std::string> keywords;
+        uint8_t                  symbols[256] = {}; // character -> symbol, 0 = not part of any keyword.
+        uint16_t                 symbolCount  = 1;
+        std::vector<uint16_t>    transitions; // state * symbolCount + symbol -> state
+        std::vector<uint64_t>    outputs;     // state -> keywords ending here
+    };
+} // namespace IotZoo
+
+#endif // __KEYWORD_MATCHER_HPP__
@@ -0,0 +1,110 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// LED animations rendered on the microcontroller. One MQTT message starts an effect, the frames are computed from the
+// time since the start, so a late frame does not slow the animation down.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __LED_EFFECT_HPP__
+#define __LED_EFFECT_HPP__
+
+#include "core/PixelFrame.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    enum class LedEffectType : uint8_t
+    {
+        None,
+        Fade,    // color to color2 within periodMillis, then stays at color2.
+        Chase,   // length pixels in color run over color2, one round per periodMillis.
+        Rainbow, // the hue wheel over the pixels, turns once per periodMillis.
+        Breathe, // color fades in and out, once per periodMillis.
+        Blink,   // color for the first half of periodMillis, color2 for the second half.
+        Scroll,  // pixel matrix: the sprite in color runs from right to left over color2, one pass per periodMillis.
+    };
+
+    struct LedEffectParameters
+    {
+        static constexpr size_t MaxSpriteColumns = 64;
+
+        LedEffectType type            = LedEffectType::None;
+        uint32_t      color           = 0xFFFFFF; // 0x00RRGGBB
+        uint32_t      color2          = 0;
+        uint32_t      periodMillis    = 1000;
+        uint16_t      startIndex      = 0; // strip effects: first pixel
+        uint16_t      count           = 0; // strip effects: number of pixels, 0 = up to the end.
+        uint16_t      length          = 3; // chase: lit pixels
+        uint8_t       framesPerSecond = 30;
+        // Scroll: one byte per column, bit 0 is the top row.
+        uint8_t sprite[MaxSpriteColumns] = {};
+        uint8_t spriteColumns            = 0;
+    };
+
+    class LedEffect
+    {
+      public:
+        static constexpr uint8_t MaxFramesPerSecond = 50;
+
+        /// @brief Starts the effect with the first frame at nowMillis.
+        void start(const LedEffectParameters& parameters, uint32_t nowMillis);
+
+        void stop()
+        {
+            parameters.type = LedEffectType::None;
+        }
+
+        bool isRunning() const
+        {
+            return LedEffectType::None != parameters.type;
+        }
+
+        const LedEffectParameters& getParameters() const
+        {
+            return parameters;
+        }
+
+        /// @brief Renders the frame, if the next frame is due. A fade stops after its last frame.
+        /// @return true if the buffer was changed.
+        bool loop(const PixelBuffer& buffer, uint32_t nowMillis);
+
+        /// @brief Renders the frame at nowMillis into the buffer.
+        void render(const PixelBuffer& buffer, uint32_t nowMillis) const;
+
+        /// @brief 1..MaxFramesPerSecond, e.g. the "fps" of a setEffect message before it is stored as uint8_t.
+        static uint8_t clampFramesPerSecond(uint32_t framesPerSecond)
+        {
+            return framesPerSecond < 1 ? 1 : framesPerSecond > MaxFramesPerSecond ? MaxFramesPerSecond : static_cast<uint8_t>(framesPerSecond);
+        }
+
+        /// @brief "fade", "chase", "rainbow", "breathe", "blink", "scroll"; None if unknown.
+        static LedEffectType parseType(const char* name);
+
+        static const char* getTypeName(LedEffectType type);
+
+        /// @brief "3C4281A5A581423C": two hex digits per column.
+        /// @return false if the text is not hex or longer than MaxSpriteColumns columns.
+        static bool parseSprite(const char* text, LedEffectParameters& parameters);
+
+        /// @brief Hue 0..65535 around the color wheel, full saturation and value.
+        static uint32_t hueToColor(uint16_t hue);
+
+        /// @brief Mixes a and b, weight 0 = a, 256 = b.
+        static uint32_t blend(uint32_t a, uint32_t b, uint16_t weight);
+
+      protected:
+        LedEffectParameters parameters;
+        uint32_t            startMillis     = 0;
+        uint32_t            nextFrameMillis = 0;
+    };
+} // namespace IotZoo
+
+#endif // __LED_EFFECT_HPP__
@@ -0,0 +1,96 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Logging with compile time levels and per module masks. A disabled log statement is discarded by the compiler,
+// including the String concatenation of its message.
+//
+// Build flags:
+//   -DIOTZOO_PRODUCTION            errors and warnings only (see env:esp32dev_production in platformio.ini).
+//   -DIOTZOO_LOG_LEVEL=3           0 = off, 1 = error, 2 = warning, 3 = info, 4 = debug, 5 = verbose.
+//   -DIOTZOO_LOG_MODULES=0x0003    bit mask of the modules to log, e.g. LogModuleMain | LogModuleMqtt.
+//
+// Usage:
+//   LOG_DEBUG(LogModuleMqtt, "Subscribing topic: " + topic);
+//   if constexpr (IOTZOO_LOG_ENABLED(LogModuleWs2818, LogLevelVerbose)) { ... several prints ... }
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __LOG_HPP__
+#define __LOG_HPP__
+
+#include <cstdint>
+
+namespace IotZoo
+{
+    static constexpr uint8_t LogLevelOff     = 0;
+    static constexpr uint8_t LogLevelError   = 1;
+    static constexpr uint8_t LogLevelWarning = 2;
+    static constexpr uint8_t LogLevelInfo    = 3;
+    static constexpr uint8_t LogLevelDebug   = 4;
+    static constexpr uint8_t LogLevelVerbose = 5;
+
+    static constexpr uint32_t LogModuleMain      = 1u << 0;
+    static constexpr uint32_t LogModuleMqtt      = 1u << 1;
+    static constexpr uint32_t LogModuleSettings  = 1u << 2;
+    static constexpr uint32_t LogModuleWs2818    = 1u << 3;
+    static constexpr uint32_t LogModuleAudio     = 1u << 4;
+    static constexpr uint32_t LogModuleSensors   = 1u << 5;
+    static constexpr uint32_t LogModuleDisplays  = 1u << 6;
+    static constexpr uint32_t LogModuleActuators = 1u << 7;
+    static constexpr uint32_t LogModuleAll       = 0xFFFFFFFFu;
+} // namespace IotZoo
+
+#ifndef IOTZOO_LOG_LEVEL
+#ifdef IOTZOO_PRODUCTION
+#define IOTZOO_LOG_LEVEL 2 // LogLevelWarning
+#else
+#define IOTZOO_LOG_LEVEL 4 // LogLevelDebug
+#endif
+#endif
+
+#ifndef IOTZOO_LOG_MODULES
+#define IOTZOO_LOG_MODULES 0xFFFFFFFFu // LogModuleAll
+#endif
+
+// Output of the log statements. Host tests define their own before including this file.
+#ifndef IOTZOO_LOG_PRINT
+#define IOTZOO_LOG_PRINT(message) Serial.print(message)
+#endif
+#ifndef IOTZOO_LOG_PRINTLN
+#define IOTZOO_LOG_PRINTLN(message) Serial.println(message)
+#endif
+
+/// @brief Constant expression, usable with if constexpr to discard a whole block of log statements.
+#define IOTZOO_LOG_ENABLED(module, level) ((level) <= IOTZOO_LOG_LEVEL && 0u != ((module) & (IOTZOO_LOG_MODULES)))
+
+#define IOTZOO_LOG(module, level, message)                                                                                  \
+    do                                                                                                                      \
+    {                                                                                                                       \
+        if constexpr (IOTZOO_LOG_ENABLED(module, level))                                                                    \
+        {                                                                                                                   \
+            IOTZOO_LOG_PRINTLN(message);                                                                                    \
+        }                                                                                                                   \
+    } while (0)
+
+/// @brief Without line break, to compose a line out of several statements.
+#define LOG_PRINT(module, level, message)                                                                                   \
+    do                                                                                                                      \
+    {                                                                                                                       \
+        if constexpr (IOTZOO_LOG_ENABLED(module, level))                                                                    \
+        {                                                                                                                   \
+            IOTZOO_LOG_PRINT(message);                                                                                      \
+        }                                                                                                                   \
+    } while (0)
+
+#define LOG_ERROR(module, message) IOTZOO_LOG(module, ::IotZoo::LogLevelError, message)
+#define LOG_WARNING(module, message) IOTZOO_LOG(module, ::IotZoo::LogLevelWarning, message)
+#define LOG_INFO(module, message) IOTZOO_LOG(module, ::IotZoo::LogLevelInfo, message)
+#define LOG_DEBUG(module, message) IOTZOO_LOG(module, ::IotZoo::LogLevelDebug, message)
+#define LOG_VERBOSE(module, message) IOTZOO_LOG(module, ::IotZoo::LogLevelVerbose, message)
+
+#endif // __LOG_HPP__
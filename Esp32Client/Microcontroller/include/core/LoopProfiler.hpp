@@ -0,0 +1,112 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Run time statistics (count, min, avg, max, p99) per probe, e.g. per device loop() or per MQTT callback. The caller
+// measures the CPU cycles (ESP.getCycleCount()) and records them. No allocation after a probe has been added.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __LOOP_PROFILER_HPP__
+#define __LOOP_PROFILER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IotZoo
+{
+    /// @brief Fixed size log-linear histogram of cycle counts: 4 buckets per power of two, so a percentile is at most
+    /// 25 % too high. 124 buckets cover the whole uint32_t range.
+    class CycleHistogram
+    {
+      public:
+        static constexpr size_t SubBuckets = 4;
+        static constexpr size_t Buckets    = 124;
+
+        void add(uint32_t cycles);
+
+        /// @brief Upper bound of the bucket which contains the given percentile.
+        /// @param percentile 0 < percentile <= 100
+        /// @return 0 if the histogram is empty.
+        uint32_t getPercentile(float percentile) const;
+
+        void clear();
+
+        static size_t getBucketIndex(uint32_t cycles);
+
+        static uint32_t getBucketUpperBound(size_t bucketIndex);
+
+      protected:
+        /// @brief A full bucket halves all buckets. The shape of the distribution is kept, old values fade out.
+        void halve();
+
+        uint16_t counts[Buckets]{};
+        uint32_t totalCount = 0;
+    };
+
+    class LoopProfiler
+    {
+      public:
+        static constexpr int InvalidProbeId = -1;
+
+        struct Statistics
+        {
+            uint32_t count     = 0;
+            uint32_t minCycles = 0;
+            uint32_t avgCycles = 0;
+            uint32_t maxCycles = 0;
+            uint32_t p99Cycles = 0;
+        };
+
+        /// @brief Adds a probe. A probe with the same name is reused (e.g. resubscription after a reconnect).
+        /// @return probe id
+        int addProbe(const std::string& name);
+
+        /// @brief Records one run of the probe.
+        /// @param cycles Duration in CPU cycles.
+        void record(int probeId, uint32_t cycles);
+
+        Statistics getStatistics(int probeId) const;
+
+        const char* getProbeName(int probeId) const;
+
+        size_t getProbeCount() const
+        {
+            return probes.size();
+        }
+
+        /// @brief Clears the statistics, the probes are kept.
+        void reset();
+
+        static float cyclesToMicros(uint32_t cycles, uint32_t cpuFrequencyMHz)
+        {
+            return cpuFrequencyMHz > 0 ? static_cast<float>(cycles) / cpuFrequencyMHz : 0;
+        }
+
+      protected:
+        struct Probe
+        {
+            std::string    name;
+            uint32_t       count       = 0;
+            uint32_t       minCycles   = UINT32_MAX;
+            uint32_t       maxCycles   = 0;
+            uint64_t       totalCycles = 0;
+            CycleHistogram histogram;
+        };
+
+        bool isValid(int probeId) const
+        {
+            return probeId >= 0 && static_cast<size_t>(probeId) < probes.size();
+        }
+
+        std::vector<Probe> probes;
+    };
+} // namespace IotZoo
+
+#endif // __LOOP_PROFILER_HPP__
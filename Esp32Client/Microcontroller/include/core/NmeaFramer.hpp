@@ -0,0 +1,88 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Splits the byte stream of a GPS receiver into NMEA 0183 sentences and checks their checksum.
+//
+// $GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47<CR><LF>
+//
+// A sentence starts with '$' (or '!'), ends with <LF> and has at most 82 characters including <CR><LF>. The checksum
+// is the XOR of the characters between the start character and '*'. Sentences without or with a wrong checksum,
+// overlong sentences and the bytes between the sentences are dropped and counted.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __NMEA_FRAMER_HPP__
+#define __NMEA_FRAMER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace IotZoo
+{
+    struct NmeaSentence
+    {
+        static constexpr size_t MaxLength = 80; // without <CR><LF>
+
+        char    text[MaxLength + 1]; // zero terminated, without <CR><LF>
+        uint8_t length;
+    };
+
+    class NmeaFramer
+    {
+      public:
+        using SentenceCallback = void (*)(void* context, const NmeaSentence& sentence);
+
+        /// @brief Passes every complete sentence with a valid checksum to the callback.
+        /// @return The count of complete sentences.
+        size_t write(const uint8_t* data, size_t length, SentenceCallback onSentence, void* context);
+
+        /// @brief Same as above, with a lambda: write(data, length, [&](const NmeaSentence& sentence) { ... }).
+        template <typename OnSentence> size_t write(const uint8_t* data, size_t length, OnSentence&& onSentence)
+        {
+            using Function = std::remove_reference_t<OnSentence>;
+            return write(
+                data, length, [](void* context, const NmeaSentence& sentence) { (*static_cast<Function*>(context))(sentence); },
+                const_cast<void*>(static_cast<const void*>(&onSentence)));
+        }
+
+        /// @brief Checks the "*hh" at the end of the sentence.
+        static bool hasValidChecksum(const char* text, size_t length);
+
+        uint32_t getSentenceCount() const
+        {
+            return sentenceCount;
+        }
+
+        uint32_t getChecksumErrors() const
+        {
+            return checksumErrors;
+        }
+
+        uint32_t getOverlongSentences() const
+        {
+            return overlongSentences;
+        }
+
+        /// @brief Bytes outside of a sentence, e.g. after a restart of the receiver.
+        uint32_t getSkippedBytes() const
+        {
+            return skippedBytes;
+        }
+
+      protected:
+        NmeaSentence sentence          = {};
+        bool         inSentence        = false;
+        uint32_t     sentenceCount     = 0;
+        uint32_t     checksumErrors    = 0;
+        uint32_t     overlongSentences = 0;
+        uint32_t     skippedBytes      = 0;
+    };
+} // namespace IotZoo
+
+#endif // __NMEA_FRAMER_HPP__
@@ -0,0 +1,152 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Polygon zones in radar coordinates (mm). Tells which tracked targets are inside of which zone and reports only the
+// changes: a target enters, dwells (stays longer than the dwell time) or exits a zone.
+// The point in polygon test is integer only: every edge is precomputed with its inverse slope in 16.16 fixed point.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __OCCUPANCY_ZONES_HPP__
+#define __OCCUPANCY_ZONES_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace IotZoo
+{
+    struct ZonePoint
+    {
+        int16_t x = 0; // mm
+        int16_t y = 0;
+    };
+
+    struct TrackPosition
+    {
+        uint16_t id = 0;
+        int16_t  x  = 0; // mm
+        int16_t  y  = 0;
+    };
+
+    enum class ZoneEventType : uint8_t
+    {
+        Enter,
+        Dwell,
+        Exit,
+    };
+
+    struct ZoneEvent
+    {
+        ZoneEventType type;
+        uint8_t       zone;
+        uint16_t      trackId;
+        uint8_t       occupancy;   // targets in the zone after the event
+        uint32_t      dwellMillis; // time in the zone, 0 for Enter
+    };
+
+    class OccupancyZones
+    {
+      public:
+        static constexpr size_t MaxZones          = 16;
+        static constexpr size_t MaxVertices       = 12;
+        static constexpr size_t MaxTargetsPerZone = 4;
+        static constexpr size_t MaxNameLength     = 32;
+
+        using EventCallback = void (*)(void* context, const ZoneEvent& event);
+
+        void clear();
+
+        /// @brief Adds a simple polygon (convex or not), the vertices in order.
+        /// @param dwellMillis A Dwell event is reported once if a target stays longer, 0 = no Dwell event.
+        /// @return false if there are MaxZones zones, the name is invalid (see isValidName) or the polygon has less than 3
+        /// or more than MaxVertices vertices.
+        bool addZone(const char* name, const ZonePoint* vertices, size_t count, uint32_t dwellMillis);
+
+        /// @brief Compares the targets with the targets in the zones of the last call and reports the changes.
+        /// A target that is missing in tracks has left all zones.
+        void update(const TrackPosition* tracks, size_t count, uint32_t nowMillis, EventCallback onEvent, void* context);
+
+        /// @brief Same as above, with a lambda: update(tracks, count, now, [&](const ZoneEvent& event) { ... }).
+        template <typename OnEvent> void update(const TrackPosition* tracks, size_t count, uint32_t nowMillis, OnEvent&& onEvent)
+        {
+            using Function = std::remove_reference_t<OnEvent>;
+            update(
+                tracks, count, nowMillis, [](void* context, const ZoneEvent& event) { (*static_cast<Function*>(context))(event); },
+                const_cast<void*>(static_cast<const void*>(&onEvent)));
+        }
+
+        /// @brief Reports an Exit for every target in a zone and empties the zones, e.g. before the zones are replaced.
+        void exitAll(uint32_t nowMillis, EventCallback onEvent, void* context);
+
+        /// @brief Same as above, with a lambda.
+        template <typename OnEvent> void exitAll(uint32_t nowMillis, OnEvent&& onEvent)
+        {
+            using Function = std::remove_reference_t<OnEvent>;
+            exitAll(
+                nowMillis, [](void* context, const ZoneEvent& event) { (*static_cast<Function*>(context))(event); },
+                const_cast<void*>(static_cast<const void*>(&onEvent)));
+        }
+
+        bool contains(size_t zone, int16_t x, int16_t y) const;
+
+        size_t getZoneCount() const
+        {
+            return zones.size();
+        }
+
+        const char* getName(size_t zone) const
+        {
+            return zones[zone].name.c_str();
+        }
+
+        uint8_t getOccupancy(size_t zone) const
+        {
+            return zones[zone].occupantCount;
+        }
+
+        static const char* getEventName(ZoneEventType type);
+
+        /// @brief The name is a level of the MQTT topic of the zone: 1..MaxNameLength characters, no '/', '+', '#' and
+        /// no control characters.
+        static bool isValidName(const char* name);
+
+      protected:
+        struct Edge
+        {
+            int32_t x0;
+            int32_t y0;
+            int32_t y1;
+            int64_t inverseSlope; // dx / dy, 16.16 fixed point (64 bit: a flat edge has a steep inverse slope)
+        };
+
+        struct Occupant
+        {
+            uint16_t trackId;
+            bool     dwellReported;
+            uint32_t enterMillis;
+        };
+
+        struct Zone
+        {
+            std::string name;
+            Edge        edges[MaxVertices];
+            uint8_t     edgeCount;
+            int16_t     minX, minY, maxX, maxY; // bounding box: most targets are rejected without an edge test.
+            uint32_t    dwellMillis;
+            Occupant    occupants[MaxTargetsPerZone];
+            uint8_t     occupantCount;
+        };
+
+        std::vector<Zone> zones;
+    };
+} // namespace IotZoo
+
+#endif // __OCCUPANCY_ZONES_HPP__
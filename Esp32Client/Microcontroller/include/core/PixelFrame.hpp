@@ -0,0 +1,101 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Binary frames for LED strips and pixel matrices: a 12 byte header followed by the pixels of a rectangle, row by row.
+// The pixels are written straight into the LED buffer (e.g. Adafruit_NeoPixel::getPixels()).
+//
+// Offset  Size  (little endian)
+//  0      1     format: 0 = RGB888 (3 bytes/pixel), 1 = RGB565 (2 bytes/pixel), 2 = palette (1 byte/pixel)
+//  1      1     flags: bit 0 = do not show yet (more parts of the frame follow)
+//  2      1     brightness, 0 = unchanged
+//  3      1     reserved, 0
+//  4      2     x
+//  6      2     y
+//  8      2     width
+// 10      2     height
+// 12            palette only: 2 bytes count of colors (1..256) + count * RGB888
+//               pixels
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __PIXEL_FRAME_HPP__
+#define __PIXEL_FRAME_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    enum class PixelFrameFormat : uint8_t
+    {
+        Rgb888  = 0,
+        Rgb565  = 1,
+        Palette = 2,
+    };
+
+    struct PixelFrameHeader
+    {
+        PixelFrameFormat format     = PixelFrameFormat::Rgb888;
+        uint8_t          flags      = 0;
+        uint8_t          brightness = 0;
+        uint16_t         x          = 0;
+        uint16_t         y          = 0;
+        uint16_t         width      = 0;
+        uint16_t         height     = 0;
+    };
+
+    /// @brief The LED buffer and how the LEDs are wired.
+    struct PixelBuffer
+    {
+        uint8_t* data            = nullptr;
+        uint16_t columns         = 0;
+        uint16_t rows            = 1;
+        bool     serpentine      = false; // every second row runs backwards.
+        uint8_t  bytesPerPixel   = 3;
+        uint8_t  redOffset       = 1; // NEO_GRB
+        uint8_t  greenOffset     = 0;
+        uint8_t  blueOffset      = 2;
+        uint16_t brightnessScale = 256; // value * brightnessScale / 256, like Adafruit_NeoPixel::setPixelColor().
+    };
+
+    class PixelFrame
+    {
+      public:
+        static constexpr size_t  HeaderSize    = 12;
+        static constexpr uint8_t FlagDoNotShow = 0x01;
+
+        enum class Error : uint8_t
+        {
+            None,
+            TooShort,
+            UnknownFormat,
+            OutOfRange,     // the rectangle does not fit into the LEDs.
+            LengthMismatch, // e.g. a truncated frame.
+            InvalidPalette,
+        };
+
+        static Error readHeader(const uint8_t* frame, size_t length, PixelFrameHeader& header);
+
+        /// @brief Validates the complete frame first, so an invalid frame does not change any LED.
+        static Error apply(const uint8_t* frame, size_t length, const PixelBuffer& buffer, PixelFrameHeader& header);
+
+        /// @brief Position of the LED in the strip.
+        static uint32_t getLedIndex(const PixelBuffer& buffer, uint16_t x, uint16_t y)
+        {
+            uint32_t column = (buffer.serpentine && (y & 1)) ? buffer.columns - 1 - x : x;
+            return static_cast<uint32_t>(y) * buffer.columns + column;
+        }
+
+        /// @brief Writes the color (0x00RRGGBB) to the LED, scaled by the brightness of the buffer.
+        static void setPixel(const PixelBuffer& buffer, uint32_t ledIndex, uint32_t color);
+
+        static const char* getErrorText(Error error);
+    };
+} // namespace IotZoo
+
+#endif // __PIXEL_FRAME_HPP__
@@ -0,0 +1,70 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Streaming parser of the setPixelColor JSON. Walks the "pixels" array token by token and reports every range as
+// soon as it is read: no document, no heap, constant stack, no limit on the message size.
+//
+// {"brightness":10,"color":"#FFFF00","millisUntilTurnOff":0,
+//  "pixels":[{"color":"#10E084","index":0,"length":10,"millisUntilTurnOff":2000},{"r":255,"g":0,"b":125,"index":30}]}
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __PIXEL_JSON_PARSER_HPP__
+#define __PIXEL_JSON_PARSER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace IotZoo
+{
+    /// @brief length pixels starting at startIndex get the same color.
+    struct PixelRange
+    {
+        uint32_t color              = 0; // 0x00RRGGBB
+        uint16_t startIndex         = 0;
+        uint16_t length             = 1;
+        uint8_t  brightness         = 2; // 0 = leave the brightness unchanged.
+        uint64_t millisUntilTurnOff = 0; // 0 = stay on.
+    };
+
+    class PixelJsonParser
+    {
+      public:
+        enum class Error : uint8_t
+        {
+            None,
+            Syntax,
+            PixelsMissing,
+            ColorMissing, // neither the pixel nor the message has a color.
+            InvalidColor,
+        };
+
+        using RangeCallback = void (*)(void* context, const PixelRange& range);
+
+        /// @brief The properties outside of "pixels" (brightness, color, r/g/b, millisUntilTurnOff) are the defaults
+        /// of every range. They may appear before or after "pixels". Ranges read before an error are already reported.
+        static Error parse(const char* json, size_t length, RangeCallback onRange, void* context);
+
+        /// @brief Same as above, with a lambda: parse(json, length, [&](const PixelRange& range) { ... }).
+        template <typename OnRange> static Error parse(const char* json, size_t length, OnRange&& onRange)
+        {
+            using Function = std::remove_reference_t<OnRange>;
+            return parse(
+                json, length, [](void* context, const PixelRange& range) { (*static_cast<Function*>(context))(range); },
+                const_cast<void*>(static_cast<const void*>(&onRange)));
+        }
+
+        /// @brief "#10E084" or "10E084" to 0x0010E084.
+        static bool parseColor(const char* text, size_t length, uint32_t& color);
+
+        static const char* getErrorText(Error error);
+    };
+} // namespace IotZoo
+
+#endif // __PIXEL_JSON_PARSER_HPP__
@@ -0,0 +1,94 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Decides whether a new value of a periodic sensor is worth a publish:
+//
+// - the first value
+// - the value moved by at least the absolute or the relative deadband since the last published value; without a
+//   deadband any change
+// - the last publish is older than maxAgeMillis (heartbeat), even if the value did not change
+//
+// and never sooner than minIntervalMillis after the last publish. A suppressed value is not queued: the next sample is
+// compared again. The parameters are set per channel from the PropertyValues of the device configuration, e.g.
+// "DeadbandAbsolute" for all channels of the device or "humidity.DeadbandAbsolute" for one channel.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __PUBLISH_POLICY_HPP__
+#define __PUBLISH_POLICY_HPP__
+
+#include "core/TopicTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace IotZoo
+{
+    struct PublishPolicyParameters
+    {
+        float    deadbandAbsolute  = 0; // 0 = off
+        float    deadbandPercent   = 0; // of the last published value, 0 = off
+        uint32_t minIntervalMillis = 0; // rate limit, 0 = off
+        uint32_t maxAgeMillis      = 0; // heartbeat, 0 = off
+    };
+
+    class PublishPolicy
+    {
+      public:
+        PublishPolicyParameters parameters;
+
+        PublishPolicy() = default;
+
+        explicit PublishPolicy(const PublishPolicyParameters& parameters) : parameters(parameters)
+        {
+        }
+
+        /// @brief Compares the value with the last published value. If it is to be published, it becomes the last published value.
+        /// @return true if the value has to be published now.
+        bool update(float value, uint32_t nowMillis);
+
+        /// @brief The next value is published, e.g. after the sensor failed.
+        void reset()
+        {
+            hasPublished = false;
+        }
+
+        /// @brief Sets a parameter by its property name: DeadbandAbsolute, DeadbandPercent, MinPublishIntervalMillis or
+        /// MaxPublishIntervalMillis. The name may be prefixed by the channel, e.g. "humidity.DeadbandAbsolute".
+        /// @return false if the name is unknown or belongs to another channel.
+        bool setParameter(const char* channel, const char* name, float value);
+
+        float getPublishedValue() const
+        {
+            return publishedValue;
+        }
+
+        /// @brief Values which were not published.
+        uint32_t getSuppressedCount() const
+        {
+            return suppressedCount;
+        }
+
+      protected:
+        bool     hasPublished    = false;
+        float    publishedValue  = 0;
+        uint32_t publishedMillis = 0;
+        uint32_t suppressedCount = 0;
+    };
+
+    /// @brief A published value of a device, e.g. the humidity of the HW507.
+    struct PublishChannel
+    {
+        std::string   name; // prefix of the property names of this channel.
+        TopicId       topicId = InvalidTopicId;
+        PublishPolicy policy;
+    };
+} // namespace IotZoo
+
+#endif // __PUBLISH_POLICY_HPP__
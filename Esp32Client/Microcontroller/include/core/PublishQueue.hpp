@@ -0,0 +1,122 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Bounded queue of outgoing MQTT messages. The devices only enqueue, the main loop drains the queue within a time
+// budget, so a slow broker does not block every device loop. All slots are allocated once in the constructor.
+// Not thread safe: enqueue and drain from the loop task.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __PUBLISH_QUEUE_HPP__
+#define __PUBLISH_QUEUE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace IotZoo
+{
+    enum class PublishClass : uint8_t
+    {
+        Event,     // e.g. button pressed: every message is sent, never coalesced or dropped.
+        Telemetry, // e.g. a temperature: only the latest value of a topic is queued, may be dropped if the queue is full.
+    };
+
+    class PublishQueue
+    {
+      public:
+        static constexpr size_t MaxTopicLength   = 127;
+        static constexpr size_t MaxPayloadLength = 255;
+
+        enum class Result : uint8_t
+        {
+            Queued,
+            Coalesced, // replaced the queued value of the same telemetry topic.
+            Dropped,   // the queue is full of events (event) or the message was dropped (telemetry).
+            TooLarge,  // topic or payload exceed the slot size, publish directly.
+        };
+
+        /// @return true if the message was sent. false stops draining, the message stays queued.
+        using Sender = std::function<bool(const char* topic, const uint8_t* payload, size_t length, bool retain)>;
+
+        /// @brief Current time in microseconds.
+        using Clock = std::function<uint32_t()>;
+
+        explicit PublishQueue(size_t capacity);
+
+        Result push(const char* topic, const uint8_t* payload, size_t length, bool retain, PublishClass publishClass);
+
+        /// @brief Sends the queued messages in the order they were queued, until the queue is empty, the sender fails
+        /// or the budget is used up. At least one message is sent per call.
+        /// @return Count of sent messages.
+        size_t drain(const Sender& send, const Clock& micros, uint32_t budgetMicros);
+
+        size_t size() const
+        {
+            return count;
+        }
+
+        size_t capacity() const
+        {
+            return slots.size();
+        }
+
+        size_t getHighWaterMark() const
+        {
+            return highWaterMark;
+        }
+
+        uint32_t getCoalesced() const
+        {
+            return coalesced;
+        }
+
+        uint32_t getDroppedTelemetry() const
+        {
+            return droppedTelemetry;
+        }
+
+        uint32_t getDroppedEvents() const
+        {
+            return droppedEvents;
+        }
+
+      protected:
+        struct Slot
+        {
+            bool         used          = false;
+            bool         retain        = false;
+            PublishClass publishClass  = PublishClass::Event;
+            uint32_t     sequence      = 0; // order of the messages
+            uint32_t     topicHash     = 0;
+            uint16_t     payloadLength = 0;
+            char         topic[MaxTopicLength + 1];
+            uint8_t      payload[MaxPayloadLength];
+        };
+
+        Slot* findTelemetry(const char* topic, uint32_t topicHash);
+
+        Slot* findFree();
+
+        /// @param telemetryOnly true: the oldest telemetry message.
+        Slot* findOldest(bool telemetryOnly);
+
+        void release(Slot& slot);
+
+        std::vector<Slot> slots;
+        size_t            count            = 0;
+        size_t            highWaterMark    = 0;
+        uint32_t          nextSequence     = 0;
+        uint32_t          coalesced        = 0;
+        uint32_t          droppedTelemetry = 0;
+        uint32_t          droppedEvents    = 0;
+    };
+} // namespace IotZoo
+
+#endif // __PUBLISH_QUEUE_HPP__
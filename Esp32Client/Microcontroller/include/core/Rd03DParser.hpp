@@ -0,0 +1,130 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Frame parser of the Rd-03D radar. The received bytes are collected in a ring buffer, the frames are decoded in place.
+//
+// AA FF 03 00                header
+// 3 x 8 bytes                targets: x, y, speed, distance resolution as uint16 little endian
+// 55 CC                      trailer
+//
+// x, y and speed: bit 15 set = positive, the other 15 bits are the absolute value (mm, cm/s).
+// A frame with a wrong trailer is dropped and the parser searches the next header right after the bad header.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __RD03D_PARSER_HPP__
+#define __RD03D_PARSER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace IotZoo
+{
+    struct Target
+    {
+      public:
+        int16_t  x                             = 0;
+        int16_t  y                             = 0;
+        int16_t  speedCentimetersPerSecond     = 0;
+        uint16_t distanceResolutionMillimeters = 0;
+        int16_t  distanceMillimeters           = 0;
+        float    angle                         = 0;
+    };
+
+    struct Rd03DFrame
+    {
+        static constexpr size_t TargetCount = 3;
+
+        Target targets[TargetCount];
+    };
+
+    class Rd03DParser
+    {
+      public:
+        static constexpr size_t FrameSize   = 30;
+        static constexpr size_t HeaderSize  = 4;
+        static constexpr size_t TrailerSize = 2;
+        static constexpr size_t BufferSize  = 256; // power of two, 8 frames.
+
+        using FrameCallback = void (*)(void* context, const Rd03DFrame& frame);
+
+        /// @brief The free space behind the received bytes, to read the UART into.
+        /// @param length Contiguous free bytes, 0 if the buffer is full.
+        uint8_t* getWriteBuffer(size_t& length);
+
+        /// @brief length bytes were written to getWriteBuffer().
+        void commitWrite(size_t length);
+
+        /// @brief Copies the bytes into the buffer.
+        /// @return The count of copied bytes, less than length if the buffer is full.
+        size_t write(const uint8_t* data, size_t length);
+
+        /// @brief Decodes all complete frames. An incomplete frame stays in the buffer.
+        /// @return The count of decoded frames.
+        size_t parse(FrameCallback onFrame, void* context);
+
+        /// @brief Same as above, with a lambda: parse([&](const Rd03DFrame& frame) { ... }).
+        template <typename OnFrame> size_t parse(OnFrame&& onFrame)
+        {
+            using Function = std::remove_reference_t<OnFrame>;
+            return parse([](void* context, const Rd03DFrame& frame) { (*static_cast<Function*>(context))(frame); },
+                         const_cast<void*>(static_cast<const void*>(&onFrame)));
+        }
+
+        size_t available() const
+        {
+            return head - tail;
+        }
+
+        uint32_t getFrameCount() const
+        {
+            return frameCount;
+        }
+
+        /// @brief Bytes skipped while searching a header.
+        uint32_t getSkippedBytes() const
+        {
+            return skippedBytes;
+        }
+
+        /// @brief Frames with a header, but without the trailer.
+        uint32_t getBadFrames() const
+        {
+            return badFrames;
+        }
+
+        /// @brief Signed magnitude of the Rd-03D: bit 15 set = positive.
+        static int16_t decodeSigned(uint16_t raw)
+        {
+            return (raw & 0x8000) ? static_cast<int16_t>(raw & 0x7FFF) : static_cast<int16_t>(-static_cast<int16_t>(raw & 0x7FFF));
+        }
+
+      protected:
+        uint8_t at(size_t offset) const
+        {
+            return buffer[(tail + offset) & (BufferSize - 1)];
+        }
+
+        uint16_t readUInt16(size_t offset) const
+        {
+            return static_cast<uint16_t>(at(offset) | (at(offset + 1) << 8));
+        }
+
+        void decodeFrame(Rd03DFrame& frame) const;
+
+        uint8_t  buffer[BufferSize];
+        size_t   head         = 0; // free running, the index is masked.
+        size_t   tail         = 0;
+        uint32_t frameCount   = 0;
+        uint32_t skippedBytes = 0;
+        uint32_t badFrames    = 0;
+    };
+} // namespace IotZoo
+
+#endif // __RD03D_PARSER_HPP__
@@ -0,0 +1,82 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Deadline driven cooperative scheduler. Plain C++ (no Arduino dependency), so it can be tested on the host with a
+// fake clock. The caller passes the current time in milliseconds.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __SCHEDULER_HPP__
+#define __SCHEDULER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace IotZoo
+{
+    class Scheduler
+    {
+      public:
+        using TaskCallback = std::function<void()>;
+
+        static constexpr int InvalidTaskId = -1;
+
+        /// @brief Adds a periodic task. The task is due immediately.
+        /// @param name Name of the task. Must outlive the scheduler (string literal).
+        /// @param intervalMillis 0 = run on every pass.
+        /// @return task id
+        int addTask(const char* name, uint32_t intervalMillis, TaskCallback callback, uint32_t nowMillis);
+
+        void setInterval(int taskId, uint32_t intervalMillis);
+
+        uint32_t getInterval(int taskId) const;
+
+        const char* getTaskName(int taskId) const;
+
+        /// @brief The task is due on the next pass, regardless of its deadline.
+        void wakeUp(int taskId, uint32_t nowMillis);
+
+        /// @brief Runs all tasks whose deadline has been reached.
+        /// @return Count of executed tasks.
+        size_t runDueTasks(uint32_t nowMillis);
+
+        /// @brief Time until the earliest deadline. 0 if a task is already due.
+        uint32_t millisUntilNextDeadline(uint32_t nowMillis) const;
+
+        size_t getTaskCount() const
+        {
+            return tasks.size();
+        }
+
+      protected:
+        struct Task
+        {
+            const char*  name           = "";
+            uint32_t     intervalMillis = 0;
+            uint32_t     nextWakeMillis = 0;
+            TaskCallback callback;
+        };
+
+        /// @brief Wrap-safe comparison, millis() overflows after ~49 days.
+        static bool isDue(uint32_t nowMillis, uint32_t deadlineMillis)
+        {
+            return static_cast<int32_t>(nowMillis - deadlineMillis) >= 0;
+        }
+
+        bool isValid(int taskId) const
+        {
+            return taskId >= 0 && static_cast<size_t>(taskId) < tasks.size();
+        }
+
+        std::vector<Task> tasks;
+    };
+} // namespace IotZoo
+
+#endif // __SCHEDULER_HPP__
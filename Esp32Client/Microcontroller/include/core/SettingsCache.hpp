@@ -0,0 +1,132 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// In RAM write-back cache of the settings. Reads are served from RAM, changes are written to the flash (NVS) lazily:
+// several changes of a key within the write-back delay are coalesced to one flash write.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __SETTINGS_CACHE_HPP__
+#define __SETTINGS_CACHE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IotZoo
+{
+    /// @brief Persistent key value storage, same shape as the Arduino Preferences class. begin() opens the namespace,
+    /// end() closes it. All other methods require an open namespace.
+    class SettingsStorage
+    {
+      public:
+        virtual ~SettingsStorage() = default;
+
+        virtual bool begin(bool readOnly) = 0;
+
+        virtual void end() = 0;
+
+        virtual bool isKey(const char* key) = 0;
+
+        virtual std::string getString(const char* key) = 0;
+
+        virtual int32_t getLong(const char* key) = 0;
+
+        virtual uint16_t getUShort(const char* key) = 0;
+
+        /// @return Count of written bytes, 0 on error.
+        virtual size_t putString(const char* key, const std::string& value) = 0;
+
+        virtual size_t putLong(const char* key, int32_t value) = 0;
+
+        virtual size_t putUShort(const char* key, uint16_t value) = 0;
+    };
+
+    class SettingsCache
+    {
+      public:
+        enum class ValueType : uint8_t
+        {
+            String,
+            Long,
+            UShort,
+        };
+
+        /// @brief Changes are written to the flash at the earliest this time after the last change.
+        static constexpr uint32_t DefaultWriteBackDelayMillis = 2000;
+
+        /// @param storage Not owned, must outlive the cache.
+        explicit SettingsCache(SettingsStorage* storage, uint32_t writeBackDelayMillis = DefaultWriteBackDelayMillis);
+
+        /// @brief Reads the keys from the flash within one begin()/end(). Unknown keys are read on first access.
+        void load(const std::vector<std::pair<const char*, ValueType>>& keys);
+
+        std::string getString(const char* key, const std::string& fallbackValue);
+
+        int32_t getLong(const char* key, int32_t fallbackValue);
+
+        uint16_t getUShort(const char* key, uint16_t fallbackValue);
+
+        /// @brief Changes the value in RAM. The flash is written by flush() or flushIfDue().
+        void putString(const char* key, const std::string& value, uint32_t nowMillis);
+
+        void putLong(const char* key, int32_t value, uint32_t nowMillis);
+
+        void putUShort(const char* key, uint16_t value, uint32_t nowMillis);
+
+        /// @brief Writes all changed keys within one begin()/end(), e.g. before a restart.
+        /// @return Count of keys written to the flash.
+        size_t flush();
+
+        /// @brief Writes the changed keys if the last change is older than the write-back delay.
+        /// @return Count of keys written to the flash.
+        size_t flushIfDue(uint32_t nowMillis);
+
+        size_t getDirtyCount() const;
+
+        /// @brief Count of failed flash writes since the start.
+        uint32_t getWriteErrors() const
+        {
+            return writeErrors;
+        }
+
+      protected:
+        struct Entry
+        {
+            std::string key;
+            uint32_t    hash        = 0;
+            ValueType   type        = ValueType::String;
+            bool        exists      = false; // false: the key is neither in the flash nor set.
+            bool        dirty       = false; // changed in RAM, not yet written to the flash.
+            std::string stringValue;
+            int32_t     numberValue = 0; // Long and UShort
+        };
+
+        /// @return The entry of the key, read from the flash if it is not cached yet.
+        Entry& getEntry(const char* key, ValueType type);
+
+        Entry* find(const char* key, uint32_t hash);
+
+        /// @brief Storage must be open.
+        void read(Entry& entry);
+
+        /// @brief Storage must be open for writing.
+        bool write(const Entry& entry);
+
+        Entry& markDirty(Entry& entry, uint32_t nowMillis);
+
+        SettingsStorage*   storage;
+        uint32_t           writeBackDelayMillis;
+        uint32_t           lastChangeMillis = 0;
+        uint32_t           writeErrors      = 0;
+        std::vector<Entry> entries;
+    };
+} // namespace IotZoo
+
+#endif // __SETTINGS_CACHE_HPP__
@@ -0,0 +1,98 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Lock-free single producer / single consumer ring buffer. One task writes (e.g. the audio capture task), one task
+// reads (e.g. the main loop). No mutex, no heap after construction.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __SPSC_RING_BUFFER_HPP__
+#define __SPSC_RING_BUFFER_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    /// @tparam T trivially copyable element type
+    /// @tparam Capacity count of elements, must be a power of two.
+    template <typename T, size_t Capacity> class SpscRingBuffer
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+      public:
+        /// @brief Producer side. Writes as many elements as there is space for.
+        /// @return Count of written elements. The rest is dropped and counted as overrun.
+        size_t push(const T* data, size_t count)
+        {
+            const size_t head  = this->head.load(std::memory_order_relaxed);
+            const size_t tail  = this->tail.load(std::memory_order_acquire);
+            size_t       space = Capacity - (head - tail);
+            size_t       n     = count < space ? count : space;
+
+            for (size_t i = 0; i < n; i++)
+            {
+                buffer[(head + i) & Mask] = data[i];
+            }
+            this->head.store(head + n, std::memory_order_release);
+
+            if (n < count)
+            {
+                overruns.fetch_add(count - n, std::memory_order_relaxed);
+            }
+            return n;
+        }
+
+        /// @brief Consumer side. Reads up to count elements.
+        /// @return Count of read elements.
+        size_t pop(T* data, size_t count)
+        {
+            const size_t tail      = this->tail.load(std::memory_order_relaxed);
+            const size_t head      = this->head.load(std::memory_order_acquire);
+            size_t       available = head - tail;
+            size_t       n         = count < available ? count : available;
+
+            for (size_t i = 0; i < n; i++)
+            {
+                data[i] = buffer[(tail + i) & Mask];
+            }
+            this->tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        /// @brief Count of elements which can be read. Exact on the consumer side, a lower bound on the producer side.
+        size_t size() const
+        {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+
+        static constexpr size_t capacity()
+        {
+            return Capacity;
+        }
+
+        /// @brief Count of elements dropped by push() because the consumer was too slow.
+        uint32_t getOverruns() const
+        {
+            return overruns.load(std::memory_order_relaxed);
+        }
+
+      protected:
+        static constexpr size_t Mask = Capacity - 1;
+
+        T buffer[Capacity];
+
+        // Free running indexes. Producer and consumer each own one of them.
+        std::atomic<size_t>   head{0};
+        std::atomic<size_t>   tail{0};
+        std::atomic<uint32_t> overruns{0};
+    };
+} // namespace IotZoo
+
+#endif // __SPSC_RING_BUFFER_HPP__
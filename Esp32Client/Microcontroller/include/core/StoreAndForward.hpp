@@ -0,0 +1,116 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Store and forward of MQTT messages while the broker is not reachable. A short outage (e.g. a WiFi reconnect) is
+// bridged in RAM, without writing the flash. A longer one, or more messages than the RAM holds, go to the telemetry log
+// in the flash. After the reconnect the messages are replayed in the order they were stored, the oldest (in the flash)
+// first, rate limited, so the backlog does not flood the broker and leaves room for the live messages.
+// Not thread safe: store and loop from the loop task.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __STORE_AND_FORWARD_HPP__
+#define __STORE_AND_FORWARD_HPP__
+
+#include "core/TelemetryLog.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace IotZoo
+{
+    struct StoreAndForwardParameters
+    {
+        size_t   ramCapacity             = 16;    // messages held in RAM
+        uint32_t ramHoldMillis           = 10000; // an outage longer than this writes the RAM into the flash.
+        float    replayMessagesPerSecond = 20;
+        uint16_t replayBurst             = 5;
+    };
+
+    class StoreAndForward
+    {
+      public:
+        /// @return true if the message was sent. false stops the replay, the message is sent again later.
+        using Sender = bool (*)(void* context, const StoredMessage& message);
+
+        /// @param log nullptr: RAM only, the oldest message is dropped if the RAM is full.
+        StoreAndForward(TelemetryLog* log, const StoreAndForwardParameters& parameters = StoreAndForwardParameters());
+
+        /// @brief Stores a message published while the broker is not reachable.
+        /// @return false if the topic or the payload is too large or the message could not be stored.
+        bool store(const char* topic, const uint8_t* payload, size_t length, bool retain, uint32_t nowMillis);
+
+        /// @brief Connected: replays the stored messages within the rate limit. Disconnected: moves the RAM into the flash
+        /// when the outage lasts longer than ramHoldMillis.
+        /// @return Count of replayed messages.
+        size_t loop(bool connected, uint32_t nowMillis, Sender send, void* context);
+
+        /// @brief Same as above, with a lambda: loop(connected, now, [&](const StoredMessage& message) { ... }).
+        template <typename Send> size_t loop(bool connected, uint32_t nowMillis, Send&& send)
+        {
+            using Function = std::remove_reference_t<Send>;
+            return loop(
+                connected, nowMillis, [](void* context, const StoredMessage& message) { return (*static_cast<Function*>(context))(message); },
+                const_cast<void*>(static_cast<const void*>(&send)));
+        }
+
+        /// @brief Count of messages not replayed yet, in RAM and in the flash.
+        size_t getPendingCount() const
+        {
+            return ramCount + (nullptr != log ? log->getPendingCount() : 0);
+        }
+
+        size_t getRamCount() const
+        {
+            return ramCount;
+        }
+
+        /// @brief Count of messages lost: the RAM was full without a log or the log could not be written.
+        uint32_t getDropped() const
+        {
+            return dropped;
+        }
+
+        /// @brief Count of messages written into the flash.
+        uint32_t getSpilled() const
+        {
+            return spilled;
+        }
+
+        uint32_t getReplayed() const
+        {
+            return replayed;
+        }
+
+      protected:
+        /// @brief Moves the oldest message from the RAM into the flash (or drops it without a log).
+        void spillOldest();
+
+        StoredMessage& getRamMessage(size_t index)
+        {
+            return ram[(ramHead + index) % ram.size()];
+        }
+
+        TelemetryLog*              log;
+        StoreAndForwardParameters  parameters;
+        std::vector<StoredMessage> ram; // ring, allocated once.
+        size_t                     ramHead           = 0;
+        size_t                     ramCount          = 0;
+        bool                       outage            = false;
+        uint32_t                   outageStartMillis = 0;
+        float                      replayTokens      = 0; // token bucket of the replay rate limit
+        uint32_t                   millisLastReplay  = 0;
+        uint32_t                   dropped           = 0;
+        uint32_t                   spilled           = 0;
+        uint32_t                   replayed          = 0;
+    };
+} // namespace IotZoo
+
+#endif // __STORE_AND_FORWARD_HPP__
@@ -0,0 +1,97 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Tracks the targets of a radar over the frames: a constant velocity Kalman filter per track (x and y filtered
+// independently), the optimal assignment of the measurements to the tracks, and hysteresis for the birth and the
+// death of a track. A track keeps its id for its lifetime, no matter in which slot the radar reports it.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __TARGET_TRACKER_HPP__
+#define __TARGET_TRACKER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    struct TrackerParameters
+    {
+        float   measurementNoiseMillimeters = 120;  // standard deviation of a measured position
+        float   accelerationNoise           = 1500; // mm/s², how fast a person may change the velocity
+        float   gateMillimeters             = 800;  // max. distance of a measurement to the predicted position of a track
+        uint8_t hitsToConfirm               = 3;    // a track is reported after this count of frames in a row
+        uint8_t missesToDelete              = 5;    // a confirmed track is deleted after this count of frames without a measurement
+    };
+
+    /// @brief Kalman filter of position and velocity along one axis.
+    struct AxisFilter
+    {
+        float position = 0; // mm
+        float velocity = 0; // mm/s
+        float p00      = 0; // covariance
+        float p01      = 0;
+        float p11      = 0;
+
+        void reset(float measuredPosition, float measurementVariance);
+
+        void predict(float seconds, float accelerationVariance);
+
+        void update(float measuredPosition, float measurementVariance);
+    };
+
+    struct Track
+    {
+        uint16_t   id        = 0;
+        bool       active    = false;
+        bool       confirmed = false;
+        uint8_t    hits      = 0; // frames in a row with a measurement
+        uint8_t    misses    = 0; // frames in a row without a measurement
+        uint32_t   millis    = 0; // time of the filter state
+        AxisFilter x;
+        AxisFilter y;
+    };
+
+    class TargetTracker
+    {
+      public:
+        static constexpr size_t MaxTracks       = 6;
+        static constexpr size_t MaxMeasurements = 3;
+
+        struct Measurement
+        {
+            float x = 0; // mm
+            float y = 0;
+        };
+
+        explicit TargetTracker(const TrackerParameters& parameters = TrackerParameters());
+
+        /// @brief A frame: predicts the tracks to nowMillis, assigns the measurements, creates and deletes tracks.
+        /// @param count At most MaxMeasurements, more are ignored.
+        void update(const Measurement* measurements, size_t count, uint32_t nowMillis);
+
+        /// @brief The confirmed tracks, ordered by id.
+        /// @return The count of tracks written to tracks.
+        size_t getConfirmedTracks(const Track** tracks, size_t capacity) const;
+
+        size_t getConfirmedTrackCount() const;
+
+        void clear();
+
+      protected:
+        /// @brief Finds the assignment with the least sum of squared distances. Measurements outside of the gate of
+        /// every track stay unassigned. Exhaustive: at most (MaxTracks + 1) ^ MaxMeasurements combinations.
+        void associate(const Measurement* measurements, size_t count, int* assignment) const;
+
+        TrackerParameters parameters;
+        Track             tracks[MaxTracks];
+        uint16_t          nextId = 1;
+    };
+} // namespace IotZoo
+
+#endif // __TARGET_TRACKER_HPP__
@@ -0,0 +1,180 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Append-only log of MQTT messages in a flash partition, written while the broker is not reachable and replayed in
+// order afterwards. The sectors are used as a ring: the write position moves from sector to sector and erases the next
+// sector when it gets there, so every sector is erased equally often (wear levelling) and the oldest messages are
+// evicted first when the log is full.
+//
+// Sector: | magic | sequence | record | record | ... | free (0xFF) |
+// Record: | length 2 | state 1 | flags 1 | topic length 1 | 0xFF 3 | timestamp 4 | checksum 4 | topic | payload, padded |
+//
+// The topic is stored as text, so a message is replayed to its topic after a restart even if no device publishes to
+// the topic any more. The padding aligns the next record to 4 bytes. The state is changed by clearing bits only:
+// written (0xFF) -> committed (0xFE) -> sent (0xFC). A record torn by a reset is not committed or has a wrong checksum
+// and is skipped. begin() finds the write and the replay position again.
+// Not thread safe: append and replay from the loop task.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __TELEMETRY_LOG_HPP__
+#define __TELEMETRY_LOG_HPP__
+
+#include "core/FlashPartition.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    struct StoredMessage
+    {
+        static constexpr size_t MaxTopicLength   = 255;
+        static constexpr size_t MaxPayloadLength = 255;
+
+        uint32_t timestamp   = 0;     // millis() when the message was stored
+        bool     restored    = false; // stored before the restart: the timestamp is one of the previous run.
+        bool     retain      = false;
+        uint8_t  topicLength = 0;
+        uint16_t length      = 0;
+        char     topic[MaxTopicLength + 1]; // terminated by '\0'
+        uint8_t  payload[MaxPayloadLength];
+
+        /// @brief Copies the topic.
+        /// @return false if the topic is empty or longer than MaxTopicLength.
+        bool setTopic(const char* topic);
+    };
+
+    class TelemetryLog
+    {
+      public:
+        static constexpr uint32_t Magic = 0x324C5A49; // "IZL2", sectors of an older format are not read.
+
+        explicit TelemetryLog(FlashPartition& partition) : partition(partition)
+        {
+        }
+
+        /// @brief Finds the write position and the oldest message not sent yet, formats an empty partition.
+        /// @return false if the partition has less than 2 sectors or cannot be read.
+        bool begin();
+
+        /// @brief Appends the message. Erases the next sector if the current one is full: its messages are evicted.
+        bool append(const StoredMessage& message);
+
+        /// @brief The oldest message not sent yet.
+        /// @return false if all messages are sent.
+        bool peek(StoredMessage& message);
+
+        /// @brief Marks the message of the last peek() as sent.
+        void markSent();
+
+        /// @brief Count of messages not sent yet.
+        size_t getPendingCount() const
+        {
+            return pendingCount;
+        }
+
+        /// @brief Count of messages not sent yet which were stored before begin().
+        size_t getRestoredCount() const
+        {
+            return restoredCount;
+        }
+
+        /// @brief Count of messages erased before they were sent, because the log was full.
+        uint32_t getEvicted() const
+        {
+            return evicted;
+        }
+
+        /// @brief Count of torn or corrupted records which were skipped.
+        uint32_t getCorrupted() const
+        {
+            return corrupted;
+        }
+
+      protected:
+        static constexpr uint8_t  StateCommitted = 0xFE;
+        static constexpr uint8_t  StateSent      = 0xFC;
+        static constexpr uint8_t  FlagRetain     = 0x01;
+        static constexpr uint16_t FreeLength     = 0xFFFF;
+
+        struct SectorHeader
+        {
+            uint32_t magic;
+            uint32_t sequence;
+        };
+
+        struct RecordHeader
+        {
+            uint16_t length;
+            uint8_t  state;
+            uint8_t  flags;
+            uint8_t  topicLength;
+            uint8_t  reserved[3];
+            uint32_t timestamp;
+            uint32_t checksum;
+        };
+
+        static_assert(sizeof(RecordHeader) == 16, "The record header is part of the log format.");
+
+        static size_t getRecordSize(const RecordHeader& header)
+        {
+            return sizeof(RecordHeader) + ((header.topicLength + header.length + 3u) & ~3u);
+        }
+
+        /// @brief Header of a record, not of the free space or of garbage.
+        static bool isRecord(const RecordHeader& header)
+        {
+            return FreeLength != header.length && header.length <= StoredMessage::MaxPayloadLength && header.topicLength > 0;
+        }
+
+        static uint32_t getChecksum(const RecordHeader& header, const char* topic, const uint8_t* payload);
+
+        size_t getSectorCount() const
+        {
+            return partition.getSize() / partition.getSectorSize();
+        }
+
+        /// @brief The sector of a read or write position. A position is behind the sector header, at most at the end of
+        /// the sector, never at the start.
+        size_t getSector(size_t offset) const
+        {
+            return (offset - 1) / partition.getSectorSize();
+        }
+
+        size_t getSectorEnd(size_t offset) const
+        {
+            return (getSector(offset) + 1) * partition.getSectorSize();
+        }
+
+        bool readSectorHeader(size_t sector, SectorHeader& header);
+
+        /// @brief Moves offset to the next record header, over the end of a sector and invalid sectors.
+        /// @return false at the write position.
+        bool seek(size_t& offset, RecordHeader& header);
+
+        /// @brief Reads the topic and the payload and validates the record at offset.
+        bool readRecord(size_t offset, const RecordHeader& header, StoredMessage& message);
+
+        /// @brief Erases the next sector and continues writing there.
+        bool advanceWriteSector();
+
+        FlashPartition& partition;
+        size_t          writeOffset   = 0;
+        uint32_t        writeSequence = 0;
+        size_t          readOffset    = 0;
+        size_t          peekedOffset  = SIZE_MAX; // the record of the last peek()
+        size_t          peekedSize    = 0;
+        size_t          pendingCount  = 0;
+        size_t          restoredCount = 0; // the oldest restoredCount pending messages were stored before begin().
+        uint32_t        evicted       = 0;
+        uint32_t        corrupted     = 0;
+    };
+} // namespace IotZoo
+
+#endif // __TELEMETRY_LOG_HPP__
@@ -0,0 +1,333 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Local dispatch of incoming MQTT messages. The microcontroller subscribes a few topic filters below a prefix (the base
+// topic) instead of a topic per handler, the router finds the handler of a received topic by the suffix behind the
+// prefix: a hash table (FNV-1a of the suffix, open addressing) with one string compare, so the dispatch is O(topic
+// length) for any count of handlers. Topics the prefix does not cover are not routed.
+//
+// The broker sends every message back which matches a subscription, also the ones the microcontroller published itself.
+// So the filters cover inbound sub-trees only: a handler gets the shortest sub-tree (<prefix>/ws2818/#) which contains
+// no published topic, or its own topic if there is none. A published topic which shows up later below a filter renews
+// the filters. Only a topic which is published and has a handler is received back, as with a subscription of its own.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __TOPIC_ROUTER_HPP__
+#define __TOPIC_ROUTER_HPP__
+
+#include "core/Fnv1a.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace IotZoo
+{
+    /// @brief Hash table of topic suffixes: FNV-1a, open addressing, load factor <= 0.5.
+    template <typename Value> class SuffixTable
+    {
+      public:
+        /// @return nullptr if the suffix is not in the table.
+        Value* find(const char* suffix, size_t length)
+        {
+            int32_t index = findEntry(suffix, length, fnv1a(reinterpret_cast<const uint8_t*>(suffix), length));
+            return index < 0 ? nullptr : &entries[index].value;
+        }
+
+        /// @brief Adds the suffix or replaces its value.
+        /// @return true if the suffix was added.
+        bool insert(const char* suffix, size_t length, const Value& value)
+        {
+            uint32_t hash  = fnv1a(reinterpret_cast<const uint8_t*>(suffix), length);
+            int32_t  index = findEntry(suffix, length, hash);
+            if (index >= 0)
+            {
+                entries[index].value = value;
+                return false;
+            }
+            entries.push_back({hash, std::string(suffix, length), value});
+            if (entries.size() * 2 > buckets.size())
+            {
+                rebuild();
+            }
+            else
+            {
+                insertBucket(entries.size() - 1);
+            }
+            return true;
+        }
+
+        /// @return false if the suffix is not in the table.
+        bool erase(const char* suffix, size_t length)
+        {
+            int32_t index = findEntry(suffix, length, fnv1a(reinterpret_cast<const uint8_t*>(suffix), length));
+            if (index < 0)
+            {
+                return false;
+            }
+            entries[index] = entries.back();
+            entries.pop_back();
+            rebuild();
+            return true;
+        }
+
+        void clear()
+        {
+            entries.clear();
+            buckets.clear();
+        }
+
+        size_t size() const
+        {
+            return entries.size();
+        }
+
+        const std::string& getSuffix(size_t index) const
+        {
+            return entries[index].suffix;
+        }
+
+      protected:
+        struct Entry
+        {
+            uint32_t    hash;
+            std::string suffix; // e.g. "/tm1637_4/0/number"
+            Value       value;
+        };
+
+        int32_t findEntry(const char* suffix, size_t length, uint32_t hash) const
+        {
+            if (buckets.empty())
+            {
+                return -1;
+            }
+            const size_t mask = buckets.size() - 1;
+            for (size_t bucket = hash & mask;; bucket = (bucket + 1) & mask)
+            {
+                int32_t index = buckets[bucket];
+                if (index < 0)
+                {
+                    return -1;
+                }
+                const Entry& entry = entries[index];
+                if (entry.hash == hash && entry.suffix.length() == length && 0 == memcmp(entry.suffix.data(), suffix, length))
+                {
+                    return index;
+                }
+            }
+        }
+
+        void insertBucket(size_t index)
+        {
+            const size_t mask = buckets.size() - 1;
+            size_t       bucket;
+            for (bucket = entries[index].hash & mask; buckets[bucket] >= 0; bucket = (bucket + 1) & mask)
+            {
+            }
+            buckets[bucket] = static_cast<int32_t>(index);
+        }
+
+        void rebuild()
+        {
+            size_t capacity = 8;
+            while (capacity < entries.size() * 2)
+            {
+                capacity *= 2;
+            }
+            buckets.assign(capacity, -1);
+            for (size_t index = 0; index < entries.size(); index++)
+            {
+                insertBucket(index);
+            }
+        }
+
+        std::vector<Entry>   entries;
+        std::vector<int32_t> buckets; // index into entries, -1 = empty. A power of two.
+    };
+
+    /// @tparam Handler e.g. a std::function, called by the owner of the router with the received message.
+    template <typename Handler> class TopicRouter
+    {
+      public:
+        /// @brief e.g. the base topic. Removes all handlers, published topics and filters.
+        void setPrefix(const char* prefix)
+        {
+            this->prefix = prefix;
+            handlers.clear();
+            published.clear();
+            filters.clear();
+        }
+
+        const std::string& getPrefix() const
+        {
+            return prefix;
+        }
+
+        /// @return true if the topic is below the prefix and has no wildcard.
+        bool isRoutable(const char* topic) const
+        {
+            size_t length = strlen(topic);
+            if (prefix.empty() || length <= prefix.length() + 1 || 0 != prefix.compare(0, prefix.length(), topic, prefix.length()) ||
+                '/' != topic[prefix.length()])
+            {
+                return false;
+            }
+            return nullptr == strpbrk(topic + prefix.length(), "+#");
+        }
+
+        /// @brief Adds the handler of the topic. The handler of a topic added again is replaced, e.g. on a reconnect.
+        /// @return false if the topic is not routable.
+        bool add(const char* topic, const Handler& handler)
+        {
+            if (!isRoutable(topic))
+            {
+                return false;
+            }
+            const char* suffix = topic + prefix.length();
+            handlers.insert(suffix, strlen(suffix), handler);
+            return true;
+        }
+
+        /// @return false if the topic has no handler.
+        bool remove(const char* topic)
+        {
+            if (!isRoutable(topic))
+            {
+                return false;
+            }
+            const char* suffix = topic + prefix.length();
+            return handlers.erase(suffix, strlen(suffix));
+        }
+
+        /// @brief The handler of a received topic.
+        /// @return nullptr if there is none, e.g. a topic of the sub-tree of a filter without a handler.
+        Handler* find(const char* topic, size_t length)
+        {
+            if (length <= prefix.length() || 0 != memcmp(topic, prefix.data(), prefix.length()))
+            {
+                return nullptr;
+            }
+            return handlers.find(topic + prefix.length(), length - prefix.length());
+        }
+
+        size_t size() const
+        {
+            return handlers.size();
+        }
+
+        /// @brief Records a topic the microcontroller publishes, called for every publish.
+        /// @return true if the topic is new and one of the filters of the last updateFilters() covers it: the broker
+        /// would send it back, the filters have to be renewed.
+        bool addPublished(const char* topic)
+        {
+            if (!isRoutable(topic))
+            {
+                return false;
+            }
+            const char* suffix = topic + prefix.length();
+            size_t      length = strlen(suffix);
+            if (nullptr != published.find(suffix, length))
+            {
+                return false;
+            }
+            published.insert(suffix, length, true);
+            for (const Filter& filter : filters)
+            {
+                if (filter.covers(suffix, length))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        size_t getPublishedCount() const
+        {
+            return published.size();
+        }
+
+        /// @brief Computes the topic filters to subscribe, e.g. "<prefix>/ws2818/#" and "<prefix>/alive_ack", and keeps
+        /// them for addPublished().
+        std::vector<std::string> updateFilters()
+        {
+            filters.clear();
+            for (size_t index = 0; index < handlers.size(); index++)
+            {
+                const std::string& suffix = handlers.getSuffix(index);
+                Filter             filter = {suffix, false};
+                // The shortest sub-tree without a published topic: "/ws2818", "/ws2818/0", ...
+                for (size_t end = suffix.find('/', 1); std::string::npos != end; end = suffix.find('/', end + 1))
+                {
+                    if (!isPublishedBelow(suffix.data(), end))
+                    {
+                        filter = {suffix.substr(0, end), true};
+                        break;
+                    }
+                }
+                bool known = false;
+                for (const Filter& other : filters)
+                {
+                    known = known || (other.wildcard == filter.wildcard && other.suffix == filter.suffix);
+                }
+                if (!known)
+                {
+                    filters.push_back(filter);
+                }
+            }
+            std::vector<std::string> topics;
+            for (const Filter& filter : filters)
+            {
+                topics.push_back(prefix + filter.suffix + (filter.wildcard ? "/#" : ""));
+            }
+            return topics;
+        }
+
+      protected:
+        struct Filter
+        {
+            std::string suffix;
+            bool        wildcard; // suffix/#, else the topic itself.
+
+            bool covers(const char* topic, size_t length) const
+            {
+                if (!wildcard)
+                {
+                    return suffix.length() == length && 0 == memcmp(suffix.data(), topic, length);
+                }
+                // "a/#" covers "a" and everything below "a/".
+                return length >= suffix.length() && 0 == memcmp(suffix.data(), topic, suffix.length()) &&
+                       (length == suffix.length() || '/' == topic[suffix.length()]);
+            }
+        };
+
+        /// @return true if a published topic is in the sub-tree suffix/# (including suffix itself).
+        bool isPublishedBelow(const char* suffix, size_t length) const
+        {
+            Filter filter = {std::string(suffix, length), true};
+            for (size_t index = 0; index < published.size(); index++)
+            {
+                const std::string& topic = published.getSuffix(index);
+                if (filter.covers(topic.data(), topic.length()))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::string          prefix;
+        SuffixTable<Handler> handlers;
+        SuffixTable<bool>    published; // suffixes of the published topics
+        std::vector<Filter>  filters;   // of the last updateFilters()
+    };
+} // namespace IotZoo
+
+#endif // __TOPIC_ROUTER_HPP__
@@ -0,0 +1,80 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Interned MQTT topics. A device builds its topics once and publishes by topic id afterwards, so the hot publish path
+// neither reads the settings from flash nor concatenates Strings on the heap.
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __TOPIC_TABLE_HPP__
+#define __TOPIC_TABLE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace IotZoo
+{
+    using TopicId = int16_t;
+
+    static constexpr TopicId InvalidTopicId = -1;
+
+    class TopicTable
+    {
+      public:
+        /// @brief Adds the topic. The same topic always gets the same id, so adding it again on every connection
+        /// does not grow the table.
+        /// @return InvalidTopicId if the topic is empty or the table is full.
+        TopicId add(const char* topic);
+
+        /// @brief Adds prefix + suffix without a temporary String, e.g. add(baseTopic, "/error").
+        TopicId add(const char* prefix, const char* suffix);
+
+        /// @return InvalidTopicId if the topic is unknown.
+        TopicId find(const char* topic) const;
+
+        /// @brief The returned pointer is valid until the next add().
+        /// @return "" if the topic id is unknown.
+        const char* get(TopicId topicId) const;
+
+        size_t getLength(TopicId topicId) const;
+
+        bool isValid(TopicId topicId) const
+        {
+            return topicId >= 0 && static_cast<size_t>(topicId) < entries.size();
+        }
+
+        size_t size() const
+        {
+            return entries.size();
+        }
+
+        /// @brief Bytes used by the topics and the index.
+        size_t getMemoryUsage() const
+        {
+            return buffer.capacity() + entries.capacity() * sizeof(Entry);
+        }
+
+        void clear();
+
+      protected:
+        struct Entry
+        {
+            uint32_t hash;   // FNV-1a of the topic, compared first.
+            uint32_t offset; // of the first character in buffer.
+            uint16_t length; // without the terminating '\0'.
+        };
+
+        TopicId find(const char* prefix, size_t prefixLength, const char* suffix, size_t suffixLength, uint32_t hash) const;
+
+        std::vector<char>  buffer; // all topics, each terminated by '\0'.
+        std::vector<Entry> entries;
+    };
+} // namespace IotZoo
+
+#endif // __TOPIC_TABLE_HPP__
@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Windowed aggregation of a sampled sensor value. The samples are folded into running statistics (Welford's
+// algorithm: count, mean, variance, min, max) in O(1) memory, and a summary is published per window instead of every
+// sample: {"mean":3.42,"min":3.1,"max":3.9,"stddev":0.21,"count":600}
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __WINDOW_AGGREGATOR_HPP__
+#define __WINDOW_AGGREGATOR_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    class RunningStatistics
+    {
+      public:
+        void add(float value);
+
+        void reset();
+
+        uint32_t getCount() const
+        {
+            return count;
+        }
+
+        float getMean() const
+        {
+            return mean;
+        }
+
+        /// @brief Sample variance, 0 for less than 2 samples.
+        float getVariance() const
+        {
+            return count > 1 ? m2 / static_cast<float>(count - 1) : 0.0f;
+        }
+
+        float getStandardDeviation() const;
+
+        float getMin() const
+        {
+            return min;
+        }
+
+        float getMax() const
+        {
+            return max;
+        }
+
+      protected:
+        uint32_t count = 0;
+        float    mean  = 0;
+        float    m2    = 0; // sum of the squared differences from the mean
+        float    min   = 0;
+        float    max   = 0;
+    };
+
+    struct AggregateSummary
+    {
+        uint32_t count   = 0;
+        uint32_t invalid = 0; // samples without a valid value, e.g. a sensor which does not answer.
+        float    mean    = 0;
+        float    min     = 0;
+        float    max     = 0;
+        float    stddev  = 0;
+
+        /// @brief {"mean":3.42,"min":3.1,"max":3.9,"stddev":0.21,"count":600}, with ,"invalid":3 if there were invalid samples.
+        /// @return The length without the terminating zero, 0 if the buffer is too small.
+        size_t toJson(char* buffer, size_t size, unsigned int decimalPlaces) const;
+    };
+
+    class WindowAggregator
+    {
+      public:
+        explicit WindowAggregator(uint32_t windowMillis = 60000) : windowMillis(windowMillis)
+        {
+        }
+
+        /// @brief Adds the sample. The first sample starts a window, a sample at or after its end starts the next one.
+        /// @return true if a window was completed by this sample: summary is set, the sample belongs to the next window.
+        bool add(float value, uint32_t nowMillis, AggregateSummary& summary);
+
+        /// @brief Counts a sample without a valid value. Also completes a window, so invalid samples are reported once per
+        /// window. The summary of a window without valid samples has a count of 0.
+        /// @return true if a window was completed by this sample, as add().
+        bool addInvalid(uint32_t nowMillis, AggregateSummary& summary);
+
+        void setWindowMillis(uint32_t windowMillis)
+        {
+            this->windowMillis = windowMillis;
+        }
+
+        uint32_t getWindowMillis() const
+        {
+            return windowMillis;
+        }
+
+        /// @brief The statistics of the current window.
+        const RunningStatistics& getStatistics() const
+        {
+            return statistics;
+        }
+
+      protected:
+        /// @brief Completes the window if it is over and starts the next one at nowMillis if none is open.
+        bool advance(uint32_t nowMillis, AggregateSummary& summary);
+
+        RunningStatistics statistics;
+        uint32_t          windowMillis;
+        uint32_t          windowStartMillis = 0;
+        uint32_t          invalid           = 0; // in the current window
+    };
+
+    /// @brief Average power of an impulse output (e.g. the LED of an electricity meter) per window. The mean is the
+    /// energy of the window: impulses * wattHoursPerImpulse / window time. The mean of the per impulse powers would
+    /// weight high loads more, their impulses come faster. min, max and stddev are those of the per impulse powers.
+    class ImpulsePowerMeter
+    {
+      public:
+        /// @param wattHoursPerImpulse e.g. 0.1 for 10000 impulses per kWh.
+        ImpulsePowerMeter(uint32_t windowMillis, float wattHoursPerImpulse) : windowMillis(windowMillis), wattHoursPerImpulse(wattHoursPerImpulse)
+        {
+        }
+
+        /// @return The power since the previous impulse in watt, 0 for the first impulse.
+        float addImpulse(uint32_t nowMillis);
+
+        /// @brief Call periodically, also without impulses: a window without impulses has a mean of 0 W.
+        /// @return true if the window is over: summary is set, the next window starts.
+        bool poll(uint32_t nowMillis, AggregateSummary& summary);
+
+        uint32_t getWindowMillis() const
+        {
+            return windowMillis;
+        }
+
+      protected:
+        void start(uint32_t nowMillis);
+
+        RunningStatistics statistics; // of the per impulse powers
+        uint32_t          windowMillis;
+        float             wattHoursPerImpulse;
+        uint32_t          impulses          = 0; // in the current window
+        uint32_t          windowStartMillis = 0;
+        uint32_t          lastImpulseMillis = 0;
+        bool              started           = false;
+        bool              hasImpulse        = false;
+    };
+} // namespace IotZoo
+
+#endif // __WINDOW_AGGREGATOR_HPP__
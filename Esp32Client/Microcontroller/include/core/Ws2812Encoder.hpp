@@ -0,0 +1,64 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+// Encodes WS2812 / WS2818 pixel bytes into RMT items: one item (high time, low time) per bit, MSB first.
+// The item has the layout of rmt_item32_t: duration0 (15 bit), level0 (1 bit), duration1 (15 bit), level1 (1 bit).
+// --------------------------------------------------------------------------------------------------------------------
+#ifndef __WS2812_ENCODER_HPP__
+#define __WS2812_ENCODER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IotZoo
+{
+    /// @brief Pulse lengths in RMT ticks.
+    struct Ws2812Timing
+    {
+        uint16_t zeroHigh;
+        uint16_t zeroLow;
+        uint16_t oneHigh;
+        uint16_t oneLow;
+
+        /// @brief Data sheet timings: 0 = 400 ns high / 850 ns low, 1 = 800 ns high / 450 ns low (800 kHz).
+        static constexpr Ws2812Timing fromTickNanos(uint32_t tickNanos)
+        {
+            return {static_cast<uint16_t>((400 + tickNanos / 2) / tickNanos), static_cast<uint16_t>((850 + tickNanos / 2) / tickNanos),
+                    static_cast<uint16_t>((800 + tickNanos / 2) / tickNanos), static_cast<uint16_t>((450 + tickNanos / 2) / tickNanos)};
+        }
+    };
+
+    class Ws2812Encoder
+    {
+      public:
+        static constexpr uint32_t BitNanos    = 1250;
+        static constexpr uint32_t ResetMicros = 300; // newer WS2812B need > 280 µs low to latch.
+
+        /// @brief High for highTicks, then low for lowTicks.
+        static constexpr uint32_t makeItem(uint16_t highTicks, uint16_t lowTicks)
+        {
+            return (highTicks & 0x7FFFu) | (1u << 15) | (static_cast<uint32_t>(lowTicks & 0x7FFFu) << 16);
+        }
+
+        /// @brief Encodes as many whole bytes as fit into wantedItems, like an RMT translator (sample_to_rmt_t).
+        /// @param translatedSize Count of encoded bytes.
+        /// @param itemCount Count of written items.
+        static void encode(const Ws2812Timing& timing, const uint8_t* source, size_t sourceSize, uint32_t* items, size_t wantedItems,
+                           size_t& translatedSize, size_t& itemCount);
+
+        /// @brief Time to transmit the bytes, including the reset pulse.
+        static uint32_t getFrameMicros(size_t byteCount)
+        {
+            return static_cast<uint32_t>((byteCount * 8 * BitNanos + 999) / 1000) + ResetMicros;
+        }
+    };
+} // namespace IotZoo
+
+#endif // __WS2812_ENCODER_HPP__
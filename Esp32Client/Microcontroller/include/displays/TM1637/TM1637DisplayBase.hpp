@@ -14,6 +14,7 @@
 #define __TM1637_DISPLAY_BASE_HPP__
 
 #include "DeviceBase.hpp"
+#include "core/Log.hpp"
 
 #include <ArduinoJson.h>
 
@@ -139,7 +140,7 @@ namespace IotZoo
 
         void setServerDownText(const String& serverDownText)
         {
-            Serial.println("TM1637DisplayBase::setServerDownText: " + serverDownText);
+            LOG_DEBUG(LogModuleDisplays, "TM1637DisplayBase::setServerDownText: " + serverDownText);
             this->serverDownText = serverDownText;
         }
 
@@ -11,6 +11,8 @@
 #ifndef __TM1637_HELPER_HPP__
 #define __TM1637_HELPER_HPP__
 
+#include "core/Log.hpp"
+
 #include <Arduino.h>
 
 namespace IotZoo
@@ -47,7 +49,7 @@ namespace IotZoo
         data = data.substring(0, 6);
       }
 
-      Serial.println("Set dot for " + data + ", length: " + String(data.length()) + ", indexDot: " + String(indexDot));
+      LOG_DEBUG(LogModuleDisplays, "Set dot for " + data + ", length: " + String(data.length()) + ", indexDot: " + String(indexDot));
 
       if (data.length() == 6)
       {
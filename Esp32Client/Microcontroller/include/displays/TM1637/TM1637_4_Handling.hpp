@@ -28,7 +28,7 @@ namespace IotZoo
     public:
         TM1637_4_Handling();
 
-        void onMqttConnectionEstablished(MqttClient *mqttClient, const String &baseTopic);
+        void onMqttConnectionEstablished(MqttClient *mqttClient, const String &baseTopic) override;
     };
 }
 #endif // __TM_1637_4_HANDLING_HPP
@@ -31,6 +31,8 @@ namespace IotZoo
         /// @param mqttClient 
         /// @param baseTopic 
         void onMqttConnectionEstablished(Settings* const settings, MqttClient *mqttClient, const String &baseTopic);
+
+        void onMqttConnectionEstablished(MqttClient *mqttClient, const String &baseTopic) override;
         
         /// @brief A temperature value should be displayed.
         /// @param topic 
@@ -24,7 +24,7 @@ namespace IotZoo
     public:
         TM1637_Handling(Tm1637DisplayType tm1637DisplayType);
 
-        void setup();
+        void setup() override;
 
         virtual void onIotZooClientUnavailable() override;
 
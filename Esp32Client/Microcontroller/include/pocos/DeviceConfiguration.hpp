@@ -0,0 +1,34 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Connect «Things» with microcontrollers in a simple way.
+// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef __DEVICE_CONFIGURATION_HPP__
+#define __DEVICE_CONFIGURATION_HPP__
+
+#include <ArduinoJson.h>
+
+namespace IotZoo
+{
+   /// @brief Configuration of one connected device, as saved by the IotZooClient (device_config).
+   struct DeviceConfiguration
+   {
+      int DeviceIndex = -1;
+      JsonArray Pins;
+      JsonArray PropertyValues;
+
+      /// @brief GPIO of the pin at index in the pin list of the device.
+      int getPin(size_t index) const
+      {
+         return Pins[index]["MicrocontrollerGpoPin"];
+      }
+   };
+
+} // namespace IotZoo
+#endif // __DEVICE_CONFIGURATION_HPP__
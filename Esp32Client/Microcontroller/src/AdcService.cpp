@@ -0,0 +1,132 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#if defined(USE_UV)
+#include "AdcService.hpp"
+#include "core/Log.hpp"
+
+namespace IotZoo
+{
+    AdcService::~AdcService()
+    {
+        if (isStarted())
+        {
+            vTaskDelete(taskHandle);
+            taskHandle = nullptr;
+            adc_digi_stop();
+            adc_digi_deinitialize();
+        }
+    }
+
+    int AdcService::addPin(uint8_t pin, uint8_t oversamplingBits, uint16_t decimation)
+    {
+        int8_t channel = digitalPinToAnalogChannel(pin);
+        if (channel < 0 || channel >= ADC1_CHANNEL_MAX)
+        {
+            LOG_WARNING(LogModuleSensors, "AdcService: pin " + String(pin) + " is not on ADC1.");
+            return InvalidChannel;
+        }
+        if (isStarted())
+        {
+            LOG_ERROR(LogModuleSensors, "AdcService: pin " + String(pin) + " added after begin().");
+            return InvalidChannel;
+        }
+        if (!demultiplexer.hasChannel(channel) && !demultiplexer.addChannel(channel, oversamplingBits, decimation))
+        {
+            LOG_ERROR(LogModuleSensors, "AdcService: unable to add pin " + String(pin));
+            return InvalidChannel;
+        }
+        return channel;
+    }
+
+    bool AdcService::begin()
+    {
+        if (isStarted() || 0 == demultiplexer.getChannelCount())
+        {
+            return isStarted();
+        }
+
+        adc_digi_init_config_t initConfig = {};
+        initConfig.max_store_buf_size     = ADC_SERVICE_BUFFER_SIZE;
+        initConfig.conv_num_each_intr     = ADC_SERVICE_FRAME_SIZE;
+        adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX] = {};
+        uint32_t                  patternCount                  = 0;
+        for (uint8_t channel = 0; channel < ADC1_CHANNEL_MAX; channel++)
+        {
+            if (!demultiplexer.hasChannel(channel))
+            {
+                continue;
+            }
+            initConfig.adc1_chan_mask |= 1 << channel;
+            pattern[patternCount].atten     = ADC_ATTEN_DB_11; // 0 ... 3.3 V
+            pattern[patternCount].channel   = channel;
+            pattern[patternCount].unit      = 0; // ADC1
+            pattern[patternCount].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+            patternCount++;
+        }
+
+        adc_digi_configuration_t config = {};
+        config.conv_limit_en            = 1; // required by the ESP32
+        config.conv_limit_num           = 250;
+        config.pattern_num              = patternCount;
+        config.adc_pattern              = pattern;
+        config.sample_freq_hz           = ADC_SERVICE_SAMPLE_FREQUENCY;
+        config.conv_mode                = ADC_CONV_SINGLE_UNIT_1;
+        config.format                   = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+        if (ESP_OK != adc_digi_initialize(&initConfig))
+        {
+            LOG_ERROR(LogModuleSensors, "AdcService: unable to initialize the continuous ADC.");
+            return false;
+        }
+        if (ESP_OK != adc_digi_controller_configure(&config) || ESP_OK != adc_digi_start())
+        {
+            LOG_ERROR(LogModuleSensors, "AdcService: unable to start the continuous ADC.");
+            adc_digi_deinitialize();
+            return false;
+        }
+        if (pdPASS != xTaskCreatePinnedToCore(readerTask, "adcReader", 3072, this, ADC_SERVICE_TASK_PRIORITY, &taskHandle, ADC_SERVICE_TASK_CORE))
+        {
+            LOG_ERROR(LogModuleSensors, "AdcService: unable to create the reader task.");
+            taskHandle = nullptr;
+            adc_digi_stop();
+            adc_digi_deinitialize();
+            return false;
+        }
+        LOG_INFO(LogModuleSensors, "AdcService: " + String(patternCount) + " pin(s), " + String(ADC_SERVICE_SAMPLE_FREQUENCY) + " conversions/s.");
+        return true;
+    }
+
+    void AdcService::readerTask(void* parameter)
+    {
+        static_cast<AdcService*>(parameter)->demultiplex();
+    }
+
+    void AdcService::demultiplex()
+    {
+        while (true)
+        {
+            uint32_t  length = 0;
+            esp_err_t result = adc_digi_read_bytes(buffer, sizeof(buffer), &length, ADC_MAX_DELAY);
+            if (ESP_ERR_INVALID_STATE == result)
+            {
+                overflows++; // the frame is valid, older ones were dropped.
+            }
+            else if (ESP_OK != result)
+            {
+                continue;
+            }
+            demultiplexer.write(buffer, length);
+        }
+    }
+} // namespace IotZoo
+
+#endif // defined(USE_UV)
@@ -16,12 +16,52 @@
 #include "AlarmZonesDeviceExtension.hpp"
 #include "DeviceBase.hpp"
 #include "PixelMatrix.hpp"
+#include "core/Log.hpp"
+#include "core/PixelJsonParser.hpp"
 
 namespace IotZoo
 {
+    namespace
+    {
+        // The levels in the order of their priority: the first keyword found in the subject wins.
+        constexpr const char* DefaultLevels = R"([
+            {"keyword":"motion","color":"#FFAF00"},
+            {"keyword":"animal","color":"#00FF00"},
+            {"keyword":"vehicle","color":"#0000FF"},
+            {"keyword":"person","color":"#FF0000"},
+            {"keyword":"rang","color":"#800080"}])";
+
+        constexpr const char* DefaultZones8x8 = R"({"zones":{
+            "dachboden":[27,3,34,3],
+            "schuppen":[51,3,58,3],
+            "vorne":[0,3,13,3,16,3,29,3],
+            "hinten":[21,1,26,1,37,1,42,1],
+            "terrasse":[2,3,11,3,18,3],
+            "parkplatz":[32,4,44,4,48,4,60,4],
+            "garten":[42,2,52,2,58,2],
+            "westen":[52,3,41,3,36,3,25,3],
+            "osten":[21,3,24,3,37,3,40,3,52,4,56,4],
+            "feld":[7,1,8,1,23,1,24,1,39,1,40,1,55,1,56,1],
+            "klingel":[4,3]}})";
+
+        constexpr const char* DefaultZones16x16 = R"({"zones":{
+            "dachboden":[102,4,118,4,134,4,150,4,166,4,182,4],
+            "schuppen":[93,3,96,3,125,3,128,3,157,3],
+            "garten":[128,3,157,3,160,3],
+            "vorne":[6,10,16,9,40,8],
+            "hinten":[146,12,162,12,178,12],
+            "terrasse":[77,3,80,3,109,3,112,3,141,3],
+            "parkplatz":[0,4,28,4,32,4,60,4,64,4],
+            "westen":[161,8,183,8,193,8,215,8,225,8],
+            "osten":[168,6,178,6,200,6,210,6,232,6,242,6],
+            "feld":[240,16],
+            "klingel":[6,5,21,5]}})";
+    } // namespace
+
     AlarmZonesDeviceExtension::AlarmZonesDeviceExtension(DeviceBase* const deviceBase) : DeviceExtension(deviceBase)
     {
         Serial.println("Constructor AlarmZonesDeviceExtension");
+        loadZoneMap();
     }
 
     void AlarmZonesDeviceExtension::onMqttConnectionEstablished()
@@ -29,6 +69,10 @@ namespace IotZoo
         String topic = deviceBase->getBaseTopic() + "/" + deviceBase->getDeviceName() + "/" + String(deviceBase->getDeviceIndex()) + "/alarm";
         deviceBase->getMqttClient()->subscribe(topic, [&](const String& json) { onAlarmReceived(json); });
         Serial.println("PixelMatrix subscribed to topic " + topic);
+
+        topic = deviceBase->getBaseTopic() + "/" + deviceBase->getDeviceName() + "/" + String(deviceBase->getDeviceIndex()) + "/alarmZones";
+        deviceBase->getMqttClient()->subscribe(topic, [&](const String& json) { onZoneMapReceived(json); });
+        Serial.println("PixelMatrix subscribed to topic " + topic);
     }
 
     /// @brief Let the user know what the device can do.
@@ -37,232 +81,123 @@ namespace IotZoo
     {
         topics->emplace_back(deviceBase->getBaseTopic() + "/" + deviceBase->getDeviceName() + "/" + String(deviceBase->getDeviceIndex()) + "/alarm",
                              "{ \"zone\":\"cam1\", \"level\": 1}", MessageDirection::IotZooClientOutbound);
+        topics->emplace_back(deviceBase->getBaseTopic() + "/" + deviceBase->getDeviceName() + "/" + String(deviceBase->getDeviceIndex()) +
+                                 "/alarmZones",
+                             R"({"brightness":4,"millisUntilTurnOff":60000,"levels":[{"keyword":"person","color":"#FF0000"}],"zones":{"garten":[42,2,52,2]}})",
+                             MessageDirection::IotZooClientOutbound);
     }
 
-    uint AlarmZonesDeviceExtension::getAlarmLevel(const String& subject)
+    String AlarmZonesDeviceExtension::getSettingsKey() const
     {
-        uint level = 0;
-        if (subject.indexOf("motion") > -1) // yellow
-        {
-            level = 1;
-        }
-        else if (subject.indexOf("animal") > -1) // green
+        const PixelMatrix* pixelMatrix = (const PixelMatrix*)deviceBase;
+        return "alarmZones" + String(pixelMatrix->GetNumberOfLedsPerColumn()) + "x" + String(pixelMatrix->GetNumberOfLedsPerRow());
+    }
+
+    void AlarmZonesDeviceExtension::loadZoneMap()
+    {
+        Settings* settings = deviceBase->getSettings();
+        String    json     = nullptr != settings ? settings->loadConfiguration(getSettingsKey()) : String();
+        if (json.length() && parseZoneMap(json))
         {
-            level = 2;
+            return;
         }
-        else if (subject.indexOf("vehicle") > -1) // blue
+
+        const PixelMatrix* pixelMatrix = (const PixelMatrix*)deviceBase;
+        if (pixelMatrix->GetNumberOfLedsPerColumn() == 8 && pixelMatrix->GetNumberOfLedsPerRow() == 8)
         {
-            level = 3;
+            parseZoneMap(DefaultZones8x8);
         }
-        else if (subject.indexOf("person") > -1) // red
+        else if (pixelMatrix->GetNumberOfLedsPerColumn() == 16 && pixelMatrix->GetNumberOfLedsPerRow() == 16)
         {
-            level = 4;
+            parseZoneMap(DefaultZones16x16);
         }
-        else if (subject.indexOf("rang") > -1) // purple
+        else
         {
-            level = 5;
+            parseZoneMap("{}"); // levels only, send the zones to the alarmZones topic.
         }
-        Serial.println("level: " + String(level));
-        return level;
     }
 
-    void AlarmZonesDeviceExtension::onAlarmReceived(const String& subject)
+    bool AlarmZonesDeviceExtension::parseZoneMap(const String& json)
     {
-        Serial.println("onAlarmReceived subject: " + subject);
-        String subjectLocal = subject;
-        subjectLocal.toLowerCase();
-
-        uint level      = getAlarmLevel(subjectLocal);
-        uint brightness = 4;
-        if (level == 0)
+        DynamicJsonDocument jsonDocument(4096);
+        DeserializationError error = deserializeJson(jsonDocument, json);
+        if (error)
         {
-            return;
+            LOG_WARNING(LogModuleWs2818, "AlarmZones: deserializeJson() failed: " + String(error.c_str()));
+            return false;
         }
-        PixelMatrix* pixelMatrix = (PixelMatrix*)deviceBase;
 
-        u32_t color              = 0;
-        u32_t millisUntilTurnOff = 60000;
-
-        if (level == 1)
+        DynamicJsonDocument defaultLevels(1024);
+        JsonArrayConst      levels = jsonDocument["levels"];
+        if (levels.isNull())
         {
-            color = pixelMatrix->getPixels()->Color(255, 175, 0); // motion -> yellow/orange
-           // return;                                               // ignore motion
+            deserializeJson(defaultLevels, DefaultLevels);
+            levels = defaultLevels.as<JsonArrayConst>();
         }
-        else if (level == 2)
+
+        zoneMap.clear();
+        brightness         = jsonDocument["brightness"] | brightness;
+        millisUntilTurnOff = jsonDocument["millisUntilTurnOff"] | millisUntilTurnOff;
+        for (JsonObjectConst level : levels)
         {
-            color = pixelMatrix->getPixels()->Color(0, 255, 0); // animal -> green
+            const char* keyword = level["keyword"] | "";
+            const char* color   = level["color"] | "";
+            uint32_t    rgb     = 0;
+            if (!PixelJsonParser::parseColor(color, strlen(color), rgb) || !zoneMap.addLevel(keyword, rgb))
+            {
+                LOG_WARNING(LogModuleWs2818, "AlarmZones: invalid level " + String(keyword));
+            }
         }
-        else if (level == 3)
+        for (JsonPairConst zone : jsonDocument["zones"].as<JsonObjectConst>())
         {
-            color = pixelMatrix->getPixels()->Color(0, 0, 255); // vehicle -> blue
+            if (!zoneMap.addZone(zone.key().c_str()))
+            {
+                LOG_WARNING(LogModuleWs2818, "AlarmZones: too many zones, ignoring " + String(zone.key().c_str()));
+                continue;
+            }
+            JsonArrayConst runs = zone.value();
+            for (size_t i = 0; i + 1 < runs.size(); i += 2)
+            {
+                zoneMap.addRun(runs[i], runs[i + 1]);
+            }
         }
-        else if (level == 4)
+        zoneMap.build();
+        LOG_INFO(LogModuleWs2818, "AlarmZones: " + String(zoneMap.getLevelCount()) + " levels, " + String(zoneMap.getZoneCount()) + " zones");
+        return true;
+    }
+
+    void AlarmZonesDeviceExtension::onZoneMapReceived(const String& json)
+    {
+        if (!parseZoneMap(json))
         {
-            color = pixelMatrix->getPixels()->Color(255, 0, 0); // person -> red
+            deviceBase->getMqttClient()->publish(deviceBase->getBaseTopic() + "/error", "alarmZones: invalid JSON");
+            return;
         }
-        else if (level == 5)
+        Settings* settings = deviceBase->getSettings();
+        if (nullptr != settings)
         {
-            color = pixelMatrix->getPixels()->Color(128, 0, 128); // alarm rang -> purple
+            settings->saveConfigurationData(getSettingsKey(), json);
         }
+    }
 
-        if (pixelMatrix->GetNumberOfLedsPerColumn() == 8 && pixelMatrix->GetNumberOfLedsPerRow() == 8)
+    void AlarmZonesDeviceExtension::onAlarmReceived(const String& subject)
+    {
+        LOG_DEBUG(LogModuleWs2818, "onAlarmReceived subject: " + subject);
+
+        // Case insensitive, no lower case copy of the subject.
+        Alarm alarm;
+        if (!zoneMap.lookup(subject.c_str(), subject.length(), alarm))
         {
-            if (subjectLocal.indexOf("dachboden") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 27, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 34, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("schuppen") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 51, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 58, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("vorne") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 0, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 13, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 16, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 29, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("hinten") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 21, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 26, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 37, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 42, 1, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("terrasse") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 2, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 11, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 18, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("parkplatz") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 32, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 44, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 48, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 60, 4, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("garten") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 42, 2, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 52, 2, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 58, 2, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("westen") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 52, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 41, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 36, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 25, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("osten") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 21, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 24, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 37, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 40, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 52, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 56, 4, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("feld") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 7, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 8, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 23, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 24, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 39, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 40, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 55, 1, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 56, 1, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("klingel") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 4, 3, brightness, millisUntilTurnOff);
-            }
+            return;
         }
-        else if (pixelMatrix->GetNumberOfLedsPerColumn() == 16 && pixelMatrix->GetNumberOfLedsPerRow() == 16)
+        LOG_DEBUG(LogModuleWs2818, "level: " + String(alarm.level + 1) + ", zone: " + String(alarm.zone));
+
+        PixelMatrix* pixelMatrix = (PixelMatrix*)deviceBase;
+        for (size_t i = 0; i < alarm.runCount; i++)
         {
-            if (subjectLocal.indexOf("dachboden") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 102, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 118, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 134, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 150, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 166, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 182, 4, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("schuppen") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 93, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 96, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 125, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 128, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 157, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("garten") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 128, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 157, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 160, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("vorne") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 6, 10, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 16, 9, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 40, 8, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("hinten") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 146, 12, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 162, 12, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 178, 12, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("terrasse") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 77, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 80, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 109, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 112, 3, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 141, 3, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("parkplatz") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 0, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 28, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 32, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 60, 4, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 64, 4, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("westen") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 161, 8, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 183, 8, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 193, 8, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 215, 8, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 225, 8, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("osten") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 168, 6, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 178, 6, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 200, 6, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 210, 6, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 232, 6, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 242, 6, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("feld") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 240, 16, brightness, millisUntilTurnOff);
-            }
-            else if (subjectLocal.indexOf("klingel") > -1)
-            {
-                pixelMatrix->setPixelColor(color, 6, 5, brightness, millisUntilTurnOff);
-                pixelMatrix->setPixelColor(color, 21, 5, brightness, millisUntilTurnOff);
-            }
+            pixelMatrix->setPixelColor(alarm.color, alarm.runs[i].startIndex, alarm.runs[i].length, brightness, millisUntilTurnOff);
         }
-        pixelMatrix->getPixels()->show();
+        pixelMatrix->showIfDirty();
     }
 } // namespace IotZoo
 
@@ -11,6 +11,7 @@
 
 #ifdef USE_AUDIO_STREAMER
 #include "AudioStreamer.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -26,83 +27,113 @@ namespace IotZoo
         memset((void*)i2sBuffer, 0, sizeof(i2sBuffer));
         memset(pcm16Buffer, 0, sizeof(pcm16Buffer));
 
-        i2s_driver_install(I2S_NUM_0, &i2sConfig, 0, nullptr);
+        i2s_driver_install(AUDIO_I2S_PORT, &i2sConfig, 0, nullptr);
         Serial.println("i2s_driver_install ok");
-        i2s_set_pin(I2S_NUM_0, &pinConfig);
+        i2s_set_pin(AUDIO_I2S_PORT, &pinConfig);
         Serial.println("i2s_set_pin ok");
-        i2s_zero_dma_buffer(I2S_NUM_0);
+        i2s_zero_dma_buffer(AUDIO_I2S_PORT);
+
+        // i2s_read() blocks until a DMA buffer is full. Do that in an own task, so it does not stall the other devices.
+        if (pdPASS != xTaskCreatePinnedToCore(captureTask, "audioCapture", 4096, this, AUDIO_CAPTURE_TASK_PRIORITY, &captureTaskHandle,
+                                              AUDIO_CAPTURE_TASK_CORE))
+        {
+            Serial.println("Unable to create the audio capture task!");
+            captureTaskHandle = nullptr;
+        }
+        // a chunk is 500 ms, the ring buffer holds 512 ms.
+        loopIntervalMillis = 50;
+
+        String topicAudioStream  = baseTopic + "/audio_stream/" + getDeviceIdex();
+        topicIdPcm               = mqttClient->addTopic(topicAudioStream, "/pcm");
+        topicIdSoundLevelRms     = mqttClient->addTopic(topicAudioStream, "/sound_level_rms");
+        topicIdSoundLevelDecibel = mqttClient->addTopic(topicAudioStream, "/sound_level_decibel");
         Serial.println("Constructor AudioStreamer ok");
     }
 
-    double AudioStreamer::rmsToDecibel(double rms, double fullScale)
+    AudioStreamer::~AudioStreamer()
     {
-        if (rms <= 0.0)
+        if (nullptr != captureTaskHandle)
         {
-            return -std::numeric_limits<double>::infinity();
+            vTaskDelete(captureTaskHandle);
+            captureTaskHandle = nullptr;
         }
+        i2s_driver_uninstall(AUDIO_I2S_PORT);
+    }
 
-        return 20.0 * std::log10(rms / fullScale);
+    void AudioStreamer::captureTask(void* parameter)
+    {
+        static_cast<AudioStreamer*>(parameter)->capture();
     }
 
-    void AudioStreamer::loop()
+    void AudioStreamer::capture()
     {
-        size_t bytesRead = 0;
-        i2s_read(I2S_NUM_0, i2sBuffer, sizeof(i2sBuffer), &bytesRead, portMAX_DELAY);
-+
-        // Serial.println("Bytes read from I2S: " + String(bytesRead));
+        while (true)
+        {
+            size_t bytesRead = 0;
+            if (ESP_OK != i2s_read(AUDIO_I2S_PORT, i2sBuffer, sizeof(i2sBuffer), &bytesRead, portMAX_DELAY))
+            {
+                continue;
+            }
 
-        int sampleCount = bytesRead / sizeof(int32_t);
+            size_t sampleCount = bytesRead / sizeof(int32_t);
 
-        for (int i = 0; i < sampleCount; i++)
-        {
-            int16_t pcm    = (int16_t)(i2sBuffer[i] >> 8); // 24->16 bit
-            pcm16Buffer[i] = pcm;
+            for (size_t i = 0; i < sampleCount; i++)
+            {
+                pcm16Buffer[i] = (int16_t)(i2sBuffer[i] >> 8); // 24->16 bit
+            }
+
+            // If the loop is too slow, the newest samples are dropped and counted.
+            ringBuffer.push(pcm16Buffer, sampleCount);
         }
+    }
 
+    void AudioStreamer::loop()
+    {
         // Collect Chunks.
-        for (int i = 0; i < sampleCount; i++)
+        size_t samplesRead = 0;
+        while ((samplesRead = ringBuffer.pop(chunkBuffer + bufferIndex, CHUNK_SIZE - bufferIndex)) > 0)
         {
-            chunkBuffer[bufferIndex++] = pcm16Buffer[i];
+            rmsAccumulator.add(chunkBuffer + bufferIndex, samplesRead);
+            bufferIndex += samplesRead;
             if (bufferIndex >= CHUNK_SIZE)
             {
-                // Check RMS.
-                double sumSq = 0;
-                for (int j = 0; j < CHUNK_SIZE; j++)
-                {
-                    sumSq += chunkBuffer[j] * chunkBuffer[j];
-                }
-                double rms    = sqrt(sumSq / CHUNK_SIZE);
-                String strRms = String(rms, 0);
-                Serial.println("RMS: " + strRms);
-                if (rms >= minRms)
-                {
-                    /* wird schlechter
-                        // optional normalize
-                        double gain = TARGET_RMS / rms;
-                        for (int j = 0; j < CHUNK_SIZE; j++)
-                        {
-                            int32_t v      = (int32_t)(chunkBuffer[j] * gain);
-                            chunkBuffer[j] = (int16_t)max(min(v, 32767), -32768);
-                        }
-                            */
-                    if (features & AudioStreamerFeatures::Streaming)
-                    {
-                        mqttClient->publish(baseTopic + "/audio_stream/" + getDeviceIdex() + "/pcm", (uint8_t*)chunkBuffer,
-                                            CHUNK_SIZE * sizeof(int16_t), false);
-                    }
-                    if (features & AudioStreamerFeatures::SoundLevelRms)
-                    {
-                        mqttClient->publish(baseTopic + "/audio_stream/" + getDeviceIdex() + "/sound_level_rms", strRms);
-                    }
-                    if (features & AudioStreamerFeatures::SoundLevelDecibel)
-                    {
-                        double decibel = rmsToDecibel(rms);
-                        mqttClient->publish(baseTopic + "/audio_stream/" + getDeviceIdex() + "/sound_level_decibel", String(decibel, 0));
-                    }
-                }
+                publishChunk();
+                rmsAccumulator.reset();
                 bufferIndex = 0; // collect next chunk.
             }
         }
+
+        uint32_t overruns = ringBuffer.getOverruns();
+        if (overruns != reportedOverruns)
+        {
+            LOG_WARNING(LogModuleAudio, "AudioStreamer: ring buffer overrun, dropped samples: " + String(overruns - reportedOverruns));
+            reportedOverruns = overruns;
+        }
+    }
+
+    void AudioStreamer::publishChunk()
+    {
+        // Check RMS.
+        double rms = rmsAccumulator.getRms();
+        LOG_VERBOSE(LogModuleAudio, "RMS: " + String(rms, 0));
+        if (rms < minRms)
+        {
+            return;
+        }
+
+        if (features & AudioStreamerFeatures::Streaming)
+        {
+            mqttClient->publish(topicIdPcm, (uint8_t*)chunkBuffer, CHUNK_SIZE * sizeof(int16_t), false);
+        }
+        if (features & AudioStreamerFeatures::SoundLevelRms)
+        {
+            mqttClient->publish(topicIdSoundLevelRms, String(rms, 0));
+        }
+        if (features & AudioStreamerFeatures::SoundLevelDecibel)
+        {
+            double decibel = rmsToDecibel(rms);
+            mqttClient->publish(topicIdSoundLevelDecibel, String(decibel, 0));
+        }
     }
 
     void AudioStreamer::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
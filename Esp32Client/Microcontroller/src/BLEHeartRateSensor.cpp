@@ -20,7 +20,8 @@ namespace IotZoo
         : DeviceBase(deviceIndex, settings, mqttClient, baseTopic)
     {
         Serial.println("Constructor HeartRateSensor. advertisingTimeOut: " + String(advertisingTimeOut) + " s");
-        charUUID = (NimBLEUUID((uint16_t)0x2A37));
+        charUUID           = (NimBLEUUID((uint16_t)0x2A37));
+        loopIntervalMillis = 100;
     }
 
     HeartRateSensor::~HeartRateSensor()
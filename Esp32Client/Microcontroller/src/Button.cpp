@@ -12,6 +12,7 @@
 #ifdef USE_BUTTON
 #include "Button.hpp"
 #include "ButtonHelper.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -62,7 +63,7 @@ namespace IotZoo
         mqttClient->subscribe(topicButtonSetCounter,
                               [&](const String& json)
                               {
-                                  Serial.println("set counter");
+                                  LOG_DEBUG(LogModuleSensors, "set counter");
                                   counter = counterOld = atoi(json.c_str());
                               });
     }
@@ -77,7 +78,7 @@ namespace IotZoo
         if (hasStateChanged())
         {
             counterOld = counter;
-            Serial.println("Button at Pin + " + String(getPin()) + " has been pushed " + String(counter) + " times.");
+            LOG_DEBUG(LogModuleSensors, "Button at Pin + " + String(getPin()) + " has been pushed " + String(counter) + " times.");
             mqttClient->publish(topicButtonPushedCounter, String(counter));
         }
     }
@@ -17,6 +17,11 @@
 
 namespace IotZoo
 {
+    ButtonHandling::ButtonHandling() : DeviceHandlingBase()
+    {
+        loopIntervalMillis = 10;
+    }
+
     /// @brief Let the user know what the device can do.
     /// @param topics
     void ButtonHandling::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
@@ -31,7 +36,7 @@ namespace IotZoo
     /// for a subscription.
     /// @param mqttClient
     /// @param baseTopic
-    void ButtonHandling::onMqttConnectionEstablished()
+    void ButtonHandling::onMqttConnectionEstablished(MqttClient* mqttClient, const String& baseTopic)
     {
         for (auto& button : ButtonHelper::buttons)
         {
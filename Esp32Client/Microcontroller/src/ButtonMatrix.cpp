@@ -11,6 +11,7 @@
 #include "Defines.hpp"
 #ifdef USE_KEYPAD
 #include "ButtonMatrix.hpp"
+#include "core/Log.hpp"
 
 #include <Arduino.h>
 
@@ -21,6 +22,19 @@ namespace IotZoo
     {
         keyMap       = makeKeymap(hexaKeys);
         customKeypad = new Keypad(keyMap, rowPins, colPins, ROWS, COLS);
+
+        for (int row = 0; row < ROWS; row++)
+        {
+            for (int col = 0; col < COLS; col++)
+            {
+                String   topicKey = getBaseTopic() + "/button_matrix/" + String(deviceIndex) + "/button/" + String(hexaKeys[row][col]);
+                TopicId* topicIds = topicIdsKey[row * COLS + col];
+                topicIds[KeyTopicState]    = mqttClient->addTopic(topicKey);
+                topicIds[KeyTopicPressed]  = mqttClient->addTopic(topicKey, "/pressed");
+                topicIds[KeyTopicHold]     = mqttClient->addTopic(topicKey, "/hold");
+                topicIds[KeyTopicReleased] = mqttClient->addTopic(topicKey, "/released");
+            }
+        }
     }
 
     ButtonMatrix::~ButtonMatrix()
@@ -56,12 +70,40 @@ namespace IotZoo
         }
     }
 
+    int ButtonMatrix::getKeyIndex(char keyChar) const
+    {
+        for (int row = 0; row < ROWS; row++)
+        {
+            for (int col = 0; col < COLS; col++)
+            {
+                if (hexaKeys[row][col] == keyChar)
+                {
+                    return row * COLS + col;
+                }
+            }
+        }
+        return -1;
+    }
+
+    void ButtonMatrix::publishKeyState(char keyChar, const char* state, KeyTopic keyTopic)
+    {
+#ifdef USE_MQTT
+        int keyIndex = getKeyIndex(keyChar);
+        if (keyIndex < 0)
+        {
+            return;
+        }
+        mqttClient->publish(topicIdsKey[keyIndex][KeyTopicState], state);
+        mqttClient->publish(topicIdsKey[keyIndex][keyTopic], String(millis()));
+#endif
+    }
+
     void ButtonMatrix::loop()
     {
         String msg;
         if (getCustomKeypad()->getKeys())
         {
-            Serial.println("get keys...");
+            LOG_VERBOSE(LogModuleSensors, "get keys...");
             for (int i = 0; i < LIST_MAX; i++) // Scan the whole key list.
             {
                 if (getCustomKeypad()->key[i].stateChanged) // Only find keys that have changed state.
@@ -71,38 +113,20 @@ namespace IotZoo
                         // Report active key state : IDLE, PRESSED, HOLD, or RELEASED
                     case PRESSED:
                     {
-                        msg     = " PRESSED.";
-                        Key key = getCustomKeypad()->key[i];
-#ifdef USE_MQTT
-                        String topicButton = getBaseTopic() + "/button_matrix/" + String(getDeviceIndex()) + "/button/" + String(key.kchar);
-                        mqttClient->publish(topicButton, "PRESSED");
-                        topicButton = getBaseTopic() + "/button_matrix/" + String(getDeviceIndex()) + "/button/" + String(key.kchar) + "/pressed";
-                        mqttClient->publish(topicButton, String(millis()));
-#endif
+                        msg = " PRESSED.";
+                        publishKeyState(getCustomKeypad()->key[i].kchar, "PRESSED", KeyTopicPressed);
                     }
                     break;
                     case HOLD:
                     {
-                        msg     = " HOLD.";
-                        Key key = getCustomKeypad()->key[i];
-#ifdef USE_MQTT
-                        String topicButton = getBaseTopic() + "/button_matrix/" + String(getDeviceIndex()) + "/button/" + String(key.kchar);
-                        mqttClient->publish(topicButton, "HOLD");
-                        topicButton = getBaseTopic() + "/button_matrix/" + String(getDeviceIndex()) + "/button/" + String(key.kchar) + "/hold";
-                        mqttClient->publish(topicButton, String(millis()));
-#endif
+                        msg = " HOLD.";
+                        publishKeyState(getCustomKeypad()->key[i].kchar, "HOLD", KeyTopicHold);
                     }
                     break;
                     case RELEASED:
                     {
-                        msg     = " RELEASED.";
-                        Key key = getCustomKeypad()->key[i];
-#ifdef USE_MQTT
-                        String topicButton = getBaseTopic() + "/button_matrix/" + String(getDeviceIndex()) + "/button/" + String(key.kchar);
-                        mqttClient->publish(topicButton, "RELEASED");
-                        topicButton = getBaseTopic() + "/button_matrix/" + String(getDeviceIndex()) + "/button/" + String(key.kchar) + "/released";
-                        mqttClient->publish(topicButton, String(millis()));
-#endif
+                        msg = " RELEASED.";
+                        publishKeyState(getCustomKeypad()->key[i].kchar, "RELEASED", KeyTopicReleased);
                     }
                     break;
                     case IDLE:
@@ -110,9 +134,9 @@ namespace IotZoo
                         msg = " IDLE.";
                     }
                     }
-                    Serial.print("Key ");
-                    Serial.print(getCustomKeypad()->key[i].kchar);
-                    Serial.println(msg);
+                    LOG_PRINT(LogModuleSensors, LogLevelDebug, "Key ");
+                    LOG_PRINT(LogModuleSensors, LogLevelDebug, getCustomKeypad()->key[i].kchar);
+                    LOG_DEBUG(LogModuleSensors, msg);
                 }
             }
         }
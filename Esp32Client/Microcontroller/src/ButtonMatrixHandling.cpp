@@ -14,6 +14,11 @@
 
 namespace IotZoo
 {
+    ButtonMatrixHandling::ButtonMatrixHandling() : DeviceHandlingBase()
+    {
+        loopIntervalMillis = 5; // scan the keypad often, otherwise short key presses get lost.
+    }
+
     /// @brief Let the user know what the device can do.
     /// @param topics
     void ButtonMatrixHandling::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
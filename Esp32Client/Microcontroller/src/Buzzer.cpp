@@ -12,6 +12,7 @@
 #ifdef USE_BUZZER
 #include "ArduinoJson.h"
 #include "Buzzer.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -40,7 +41,7 @@ namespace IotZoo
 
     void Buzzer::beep(u_int16_t frequencyHz, u_int16_t durationMs)
     {
-        Serial.print("Beep frequencyHz: " + String(frequencyHz) + ", durationMs: " + String(durationMs));
+        LOG_PRINT(LogModuleActuators, LogLevelDebug, "Beep frequencyHz: " + String(frequencyHz) + ", durationMs: " + String(durationMs));
         buzzer->sound(frequencyHz, durationMs);
     }
 
@@ -69,7 +70,7 @@ namespace IotZoo
         mqttClient->subscribe(topicBeep,
                               [&](const String& json)
                               {
-                                  Serial.println(topicBeep + ": " + json);
+                                  LOG_DEBUG(LogModuleActuators, topicBeep + ": " + json);
                                   StaticJsonDocument<2048> jsonDocument;
 
                                   DeserializationError error = deserializeJson(jsonDocument, json);
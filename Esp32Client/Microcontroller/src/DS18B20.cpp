@@ -11,9 +11,45 @@
 #include "Defines.hpp"
 #ifdef USE_DS18B20
 #include "DS18B20.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
+    size_t DallasTemperatureBus::search(RomAddress* addresses, size_t capacity)
+    {
+        size_t count = 0;
+        for (uint8_t index = 0; index < dallasTemperature->getDeviceCount() && count < capacity; index++)
+        {
+            if (dallasTemperature->getAddress(addresses[count].bytes, index))
+            {
+                count++;
+            }
+            else
+            {
+                Serial.println("Found ghost device at " + String(index) + " but could not detect address. Check power and cabling");
+            }
+        }
+        return count;
+    }
+
+    bool DallasTemperatureBus::setResolution(uint8_t resolution)
+    {
+        dallasTemperature->setResolution(resolution);
+        return true;
+    }
+
+    bool DallasTemperatureBus::startConversion()
+    {
+        dallasTemperature->setWaitForConversion(false);
+        return dallasTemperature->requestTemperatures().result;
+    }
+
+    bool DallasTemperatureBus::readCelsius(const RomAddress& address, float& celsius)
+    {
+        celsius = dallasTemperature->getTempC(address.bytes);
+        return DEVICE_DISCONNECTED_C != celsius;
+    }
+
     DS18B20::DS18B20(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, uint8_t pinData,
                      u_int8_t resolution, int transmissionIntervalMs)
         : DeviceBase(deviceIndex, settings, mqttClient, baseTopic)
@@ -27,43 +63,41 @@ namespace IotZoo
         // Pass our oneWire reference to Dallas Temperature sensor
         dallasTemperatureSensors = new DallasTemperature(oneWire);
 
-        dallasTemperatureSensors->setResolution(resolution);
-        setInterval(transmissionIntervalMs);
-
         Serial.println("Start the DS18B20 sensor!");
         // Start the DS18B20 sensor
         dallasTemperatureSensors->begin();
-        numberOfDevices = dallasTemperatureSensors->getDeviceCount();
-        Serial.print("Found ");
-        Serial.print(numberOfDevices, DEC);
-        Serial.println(" temperature sensors.");
 
-        // Loop through each device, print out address
-        for (int i = 0; i < numberOfDevices; i++)
-        {
-            // We'll use this variable to store a found device address
-            DeviceAddress tempDeviceAddress;
+        bus    = new DallasTemperatureBus(dallasTemperatureSensors);
+        poller = new DS18B20Poller(*bus, resolution, transmissionIntervalMs);
+        setInterval(transmissionIntervalMs);
+        size_t numberOfDevices = poller->begin();
+        Serial.println("Found " + String(numberOfDevices) + " temperature sensors.");
 
-            // Search the wire for address
-            if (dallasTemperatureSensors->getAddress(tempDeviceAddress, i))
-            {
-                Serial.print("Found DS18B20 temperature sensor ");
-                Serial.print(i, DEC);
-                Serial.print(" with address: ");
-                printDeviceAddress(tempDeviceAddress);
-            }
-            else
-            {
-                Serial.print("Found ghost device at ");
-                Serial.print(i, DEC);
-                Serial.print(" but could not detect address. Check power and cabling");
-            }
+        channelsCelsius.resize(numberOfDevices);
+        for (size_t i = 0; i < numberOfDevices; i++)
+        {
+            char hex[17];
+            poller->getAddress(i).toHex(hex);
+            PublishChannel& channel                    = channelsCelsius[i];
+            String          topic                      = getTopicCelsius(poller->getAddress(i));
+            channel.name                               = hex; // e.g. "28FF641E8516034B.DeadbandAbsolute"
+            channel.topicId                            = mqttClient->addTopic(topic);
+            channel.policy.parameters.deadbandAbsolute = 0.2f;
+            channel.policy.parameters.maxAgeMillis     = 900000;
+            addPublishChannel(channel);
+            Serial.println("DS18B20 temperature sensor " + String(i) + ": " + topic);
         }
+        // The state machine checks the conversion time, 94 ms at 9 bit.
+        loopIntervalMillis = 100;
     }
 
     DS18B20::~DS18B20()
     {
         Serial.println("Destructor DS18B20");
+        delete poller;
+        poller = nullptr;
+        delete bus;
+        bus = nullptr;
         delete dallasTemperatureSensors;
         dallasTemperatureSensors = nullptr;
         delete oneWire;
@@ -75,80 +109,37 @@ namespace IotZoo
     void DS18B20::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
     {
         Serial.println("Register temperature sensors.");
-        // std::list<float> temperatures = ds18B20SensorManager->requestTemperatures();
-        int index = 0;
-        // for (auto &temperature : temperatures)
-        for (int index = 0; index < 10; index++)
+        for (size_t index = 0; index < poller->getSensorCount(); index++)
         {
-            topics->emplace_back(getBaseTopic() + "/ds18b20_manager/0/sensor/" + String(index) + "/celsius",
-                                 "The Temperature in °C of Sensor " + String(index), MessageDirection::IotZooClientInbound);
+            topics->emplace_back(getTopicCelsius(poller->getAddress(index)), "The Temperature in °C of Sensor " + String(index),
+                                 MessageDirection::IotZooClientInbound);
         }
     }
 
-    void DS18B20::printDeviceAddress(DeviceAddress deviceAddress)
+    String DS18B20::getTopicCelsius(const RomAddress& address) const
     {
-        for (uint8_t i = 0; i < 8; i++)
-        {
-            if (deviceAddress[i] < 16)
-            {
-                Serial.print("0");
-            }
-            Serial.print(deviceAddress[i], HEX);
-        }
-        Serial.println();
-    }
-
-    std::vector<float> DS18B20::requestTemperatures()
-    {
-        std::vector<float>           temperatures;
-        DallasTemperature::request_t request = dallasTemperatureSensors->requestTemperatures();
-
-        if (request.result)
-        {
-            delay(250); // Do not remove this delay!
-            for (int i = 0; i < numberOfDevices; i++)
-            {
-                float temperatureCelsius = dallasTemperatureSensors->getTempCByIndex(i);
-                temperatures.push_back(temperatureCelsius);
-            }
-        }
-        else
-        {
-            Serial.println("DS18B20 is not working.");
-        }
-        return temperatures;
+        char hex[17];
+        address.toHex(hex);
+        return getBaseTopic() + "/ds18b20_manager/0/sensor/" + String(hex) + "/celsius";
     }
 
     void DS18B20::loop()
     {
-
-        if (millis() - getLastPublishedTemperatureMillis() < getInterval())
-        {
-            return;
-        }
-
-        setLastPublishedTemperatureMillis(millis());
-
-        std::vector<float> temperatures = requestTemperatures();
-        Serial.println("Count of Temperature sensors: " + String(temperatures.size()));
-        int indexTemperatureSensor = 0;
-
-        for (const auto& temperatureCelsius : temperatures)
-        {
-            String topic = getBaseTopic() + "/ds18b20_manager/0/sensor/" + String(indexTemperatureSensor) + "/celsius";
-
-            Serial.print(topic + "/" + String(temperatureCelsius));
-            Serial.println(" ºC");
-            if (temperatureCelsius != DEVICE_DISCONNECTED_C)
-            {
-                mqttClient->publish(topic, String(temperatureCelsius, 1));
-            }
-            else
-            {
-                mqttClient->publish(topic, "device is not ready");
-            }
-            indexTemperatureSensor++;
-        }
+        poller->loop(millis(),
+                     [this](const TemperatureReading& reading)
+                     {
+                         PublishChannel& channel = channelsCelsius[reading.sensor];
+                         LOG_DEBUG(LogModuleSensors, String(mqttClient->getTopic(channel.topicId)) + "/" + String(reading.celsius) + " ºC");
+                         if (reading.valid)
+                         {
+                             publishIfDue(channel, reading.celsius, 1);
+                         }
+                         else
+                         {
+                             mqttClient->publish(channel.topicId, "device is not ready");
+                             channel.policy.reset();
+                         }
+                     });
     }
 } // namespace IotZoo
 
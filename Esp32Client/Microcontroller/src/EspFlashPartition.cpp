@@ -0,0 +1,51 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#ifdef USE_STORE_AND_FORWARD
+#include "EspFlashPartition.hpp"
+#include "core/Log.hpp"
+
+#include <Arduino.h>
+
+namespace IotZoo
+{
+    bool EspFlashPartition::begin(esp_partition_subtype_t subtype, const char* label, size_t maxSize)
+    {
+        partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, subtype, label);
+        if (nullptr == partition)
+        {
+            LOG_ERROR(LogModuleSettings, "EspFlashPartition: no data partition " + String(nullptr == label ? "" : label));
+            return false;
+        }
+        size = partition->size < maxSize ? partition->size : maxSize;
+        size -= size % SPI_FLASH_SEC_SIZE;
+        LOG_INFO(LogModuleSettings, "EspFlashPartition: " + String(partition->label) + ", " + String(size / 1024) + " KB");
+        return true;
+    }
+
+    bool EspFlashPartition::read(size_t offset, void* data, size_t length)
+    {
+        return nullptr != partition && offset + length <= size && ESP_OK == esp_partition_read(partition, offset, data, length);
+    }
+
+    bool EspFlashPartition::write(size_t offset, const void* data, size_t length)
+    {
+        return nullptr != partition && offset + length <= size && ESP_OK == esp_partition_write(partition, offset, data, length);
+    }
+
+    bool EspFlashPartition::eraseSector(size_t offset)
+    {
+        return nullptr != partition && offset + SPI_FLASH_SEC_SIZE <= size &&
+               ESP_OK == esp_partition_erase_range(partition, offset, SPI_FLASH_SEC_SIZE);
+    }
+} // namespace IotZoo
+
+#endif // USE_STORE_AND_FORWARD
@@ -11,73 +11,247 @@
 #include "Defines.hpp"
 #ifdef USE_GPS
 #include "Gps.hpp"
+#include "core/Log.hpp"
+
+#include <ArduinoJson.h>
 
 namespace IotZoo
 {
     Gps::Gps(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, uint8_t pinRx, uint8_t pinTx,
-             uint32_t baud)
+             uint32_t baud, const PositionFilterParameters& filterParameters, size_t trackBatchSize)
         : DeviceBase(deviceIndex, settings, mqttClient, baseTopic)
     {
-        Serial.println("Constructor Gps. pinRx: " + String(pinRx) + ", pinTx: " + String(pinTx) + ", baud: " + String(baud));
-        this->pinRx    = pinRx;
-        this->pinTx    = pinTx;
-        softwareSerial = new SoftwareSerial(pinRx, pinTx);
-        softwareSerial->begin(baud);
+        Serial.println("Constructor Gps. pinRx: " + String(pinRx) + ", pinTx: " + String(pinTx) + ", baud: " + String(baud) +
+                       ", minDistanceMeters: " + String(filterParameters.minDistanceMeters) + ", maxIntervalMillis: " +
+                       String(filterParameters.maxIntervalMillis) + ", trackBatchSize: " + String(trackBatchSize));
+        this->pinRx = pinRx;
+        this->pinTx = pinTx;
+        // The decoder task is woken up by the <LF> at the end of every sentence.
+        uart = new UartReader(pinRx, pinTx, baud);
+        uart->begin(onUartData, this, "gpsDecoder", '\n');
+        // The sentences wait in the ring buffer, up to 16 sentences are queued.
+        loopIntervalMillis = 200;
+
+        positionFilter.parameters = filterParameters;
+        trackBatch.setCapacity(trackBatchSize < MaxTrackBatchSize ? trackBatchSize : MaxTrackBatchSize);
+        trackBuffer.resize(32 + trackBatch.capacity() * 36); // 3 numbers per point, the first ones absolute.
+
+        topicIdPosition = mqttClient->addTopic(getBaseTopic() + "/gps/position" + String(deviceIndex));
+        topicIdGeofence = mqttClient->addTopic(getBaseTopic() + "/gps/geofence" + String(deviceIndex));
+        topicIdTrack    = mqttClient->addTopic(getBaseTopic() + "/gps/track" + String(deviceIndex));
+        topicGeofences  = getBaseTopic() + "/gps/geofences" + String(deviceIndex);
+
+        if (nullptr != settings)
+        {
+            String json = settings->loadConfiguration(getGeofencesSettingsKey());
+            if (json.length())
+            {
+                parseGeofences(json);
+            }
+        }
     }
 
     Gps::~Gps()
     {
-        Serial.println("Constructor Gps");
-        delete softwareSerial;
+        Serial.println("Destructor Gps");
+        delete uart;
+        uart = nullptr;
     }
 
     /// @brief Let the user know what the device can do.
     /// @param topics
     void Gps::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
     {
-        String examplePayload = "{\"lat\": 52.63, \"lon\": 9.61, \"alt\": 32.1, \"dateTimeUtc\": \"2025-10-05 17:30:36\"}";
+        String examplePayload = "{\"Lat\": 52.630012, \"Lon\": 9.610047, \"Alt\": 32.1, \"DateTimeUtc\": \"2025-10-05 17:30:36\", \"Reason\": \"distance\"} "
+                                "Reason: first, distance, heading, heartbeat.";
 
         topics->emplace_back(getBaseTopic() + "/gps/position" + String(deviceIndex), examplePayload, MessageDirection::IotZooClientInbound);
+        topics->emplace_back(getBaseTopic() + "/gps/geofence" + String(deviceIndex), "{\"event\":\"enter\",\"fence\":\"home\"} Events: enter, exit.",
+                             MessageDirection::IotZooClientInbound);
+        if (trackBatch.capacity() > 0)
+        {
+            topics->emplace_back(getBaseTopic() + "/gps/track" + String(deviceIndex),
+                                 "{\"t\":[63036,5,7],\"lat\":[5263000,12,18],\"lon\":[961000,-5,6]} t: seconds since midnight UTC, lat and lon: "
+                                 "1e-5 degrees. The first values are absolute, the others the difference to the previous value.",
+                                 MessageDirection::IotZooClientInbound);
+        }
+        topics->emplace_back(topicGeofences,
+                             R"({"hysteresisMeters":15,"fences":[{"name":"home","lat":52.63,"lon":9.61,"radius":100},{"name":"field","points":[[52.631,9.612],[52.631,9.615],[52.633,9.615]]}]})",
+                             MessageDirection::IotZooClientOutbound);
     }
 
-    void Gps::loop()
+    void Gps::onMqttConnectionEstablished()
     {
-        smartDelay(1000);
-
-        if (millis() > 5000 && gps.charsProcessed() < 10)
+        if (mqttCallbacksAreRegistered)
         {
-            Serial.println(F("No GPS data received: check wiring"));
+            Serial.println("Reconnection -> nothing to do.");
+            return;
         }
+        mqttClient->subscribe(topicGeofences,
+                              [this](const String& json)
+                              {
+                                  if (!parseGeofences(json))
+                                  {
+                                      publishError("gps geofences: invalid JSON or fence");
+                                      return;
+                                  }
+                                  if (nullptr != settings)
+                                  {
+                                      settings->saveConfigurationData(getGeofencesSettingsKey(), json);
+                                  }
+                              });
+        mqttCallbacksAreRegistered = true;
+    }
 
-        if (gps.location.isValid())
-        {
-            String payload = "{ \"Lat\": " + String(gps.location.lat(), 3U) + ", \"Lon\": " + String(gps.location.lng(), 3U) +
-                             ", \"Alt\": " + String(gps.altitude.meters(), 1U);
+    String Gps::getGeofencesSettingsKey() const
+    {
+        return "gpsGeofences" + String(deviceIndex);
+    }
 
-            if (gps.date.isValid() && gps.time.isValid())
+    bool Gps::parseGeofences(const String& json)
+    {
+        DynamicJsonDocument  jsonDocument(4096);
+        DeserializationError error = deserializeJson(jsonDocument, json);
+        if (error)
+        {
+            return false;
+        }
+        Geofences parsed;
+        parsed.hysteresisMeters = jsonDocument["hysteresisMeters"] | parsed.hysteresisMeters;
+        for (JsonObjectConst fence : jsonDocument["fences"].as<JsonArrayConst>())
+        {
+            const char*    name   = fence["name"] | "fence";
+            JsonArrayConst points = fence["points"];
+            bool           added  = false;
+            if (points.isNull())
+            {
+                added = parsed.addCircle(name, {fence["lat"] | 0.0, fence["lon"] | 0.0}, fence["radius"] | 0.0f);
+            }
+            else
+            {
+                GeoPoint vertices[Geofences::MaxVertices];
+                size_t   count = 0;
+                for (JsonArrayConst point : points)
+                {
+                    if (count < Geofences::MaxVertices)
+                    {
+                        vertices[count] = {point[0].as<double>(), point[1].as<double>()};
+                    }
+                    count++;
+                }
+                added = parsed.addPolygon(name, vertices, count);
+            }
+            if (!added)
             {
-                char sz[64] = {};
-                sprintf(sz, "%02d-%02d-%02d %02d:%02d:%02d", gps.date.year(), gps.date.month(), gps.date.day(), gps.time.hour(), gps.time.minute(),
-                        gps.time.second());
-                payload += ", \"DateTimeUtc\": \"" + String(sz) + "\"";
+                return false;
             }
-            payload += "}";
-            mqttClient->publish(getBaseTopic() + "/gps/position" + String(deviceIndex), payload);
         }
+        geofences = parsed; // the fences start outside, a fix inside raises an enter event.
+        LOG_INFO(LogModuleSensors, "Gps: " + String(geofences.getFenceCount()) + " geofences");
+        return true;
     }
 
-    // This custom version of delay() ensures that the gps object
-    // is being "fed".
-    void Gps::smartDelay(unsigned long ms)
+    void Gps::loop()
     {
-        unsigned long start = millis();
-        do
+        NmeaSentence sentence;
+        while (sentences.pop(&sentence, 1) > 0)
         {
-            while (softwareSerial->available())
+            for (size_t index = 0; index < sentence.length; index++)
             {
-                gps.encode(softwareSerial->read());
+                gps.encode(sentence.text[index]);
             }
-        } while (millis() - start < ms);
+            gps.encode('\r');
+            gps.encode('\n');
+        }
+
+        uint32_t overruns = sentences.getOverruns() + (nullptr != uart ? uart->getOverflows() : 0);
+        if (overruns != reportedOverruns)
+        {
+            LOG_WARNING(LogModuleSensors, "Gps: dropped sentences or UART overflows: " + String(overruns - reportedOverruns));
+            reportedOverruns = overruns;
+        }
+
+        if (gps.location.isUpdated())
+        {
+            onFix();
+        }
+        else if (millis() > 5000 && gps.charsProcessed() < 10 && millis() - millisLastWarning >= 10000)
+        {
+            millisLastWarning = millis();
+            LOG_WARNING(LogModuleSensors, F("No GPS data received: check wiring"));
+        }
+    }
+
+    void Gps::onFix()
+    {
+        GeoPoint position = {gps.location.lat(), gps.location.lng()}; // resets isUpdated()
+        if (!gps.location.isValid())
+        {
+            return;
+        }
+
+        geofences.update(position,
+                         [this](const GeofenceEvent& event)
+                         {
+                             // The fence name comes from the configuration, serializeJson escapes it.
+                             StaticJsonDocument<128> jsonDocument;
+                             jsonDocument["event"] = Geofences::getEventName(event.type);
+                             jsonDocument["fence"] = geofences.getName(event.fence);
+                             String payload;
+                             serializeJson(jsonDocument, payload);
+                             mqttClient->publish(topicIdGeofence, payload);
+                         });
+
+        PublishReason reason = positionFilter.update(position, gps.course.deg(), gps.speed.mps(), millis());
+        if (PublishReason::None == reason)
+        {
+            return;
+        }
+        if (0 == trackBatch.capacity())
+        {
+            publishPosition(reason);
+            return;
+        }
+        uint32_t secondsOfDay = gps.time.isValid() ? gps.time.hour() * 3600UL + gps.time.minute() * 60UL + gps.time.second() : 0;
+        if (trackBatch.add(position, secondsOfDay))
+        {
+            publishTrackBatch();
+        }
+    }
+
+    void Gps::publishPosition(PublishReason reason)
+    {
+        StaticJsonDocument<256> jsonDocument;
+        jsonDocument["Lat"] = serialized(String(gps.location.lat(), 6));
+        jsonDocument["Lon"] = serialized(String(gps.location.lng(), 6));
+        jsonDocument["Alt"] = serialized(String(gps.altitude.meters(), 1));
+        if (gps.date.isValid() && gps.time.isValid())
+        {
+            char sz[64] = {};
+            sprintf(sz, "%02d-%02d-%02d %02d:%02d:%02d", gps.date.year(), gps.date.month(), gps.date.day(), gps.time.hour(), gps.time.minute(),
+                    gps.time.second());
+            jsonDocument["DateTimeUtc"] = sz;
+        }
+        jsonDocument["Reason"] = PositionFilter::getReasonName(reason);
+
+        String payload;
+        serializeJson(jsonDocument, payload);
+        mqttClient->publish(topicIdPosition, payload);
+    }
+
+    void Gps::publishTrackBatch()
+    {
+        if (trackBatch.serialize(trackBuffer.data(), trackBuffer.size()) > 0)
+        {
+            mqttClient->publish(topicIdTrack, String(trackBuffer.data()));
+            trackBatch.clear();
+        }
+    }
+
+    void Gps::onUartData(void* context, const uint8_t* data, size_t length)
+    {
+        Gps* gps = static_cast<Gps*>(context);
+        gps->framer.write(data, length, [gps](const NmeaSentence& sentence) { gps->sentences.push(&sentence, 1); });
     }
 
 } // namespace IotZoo
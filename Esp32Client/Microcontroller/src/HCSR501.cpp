@@ -12,6 +12,7 @@
 #ifdef USE_HC_SR501
 #include "HCSR501.hpp"
 #include "HRSR501Helper.hpp"
+#include "core/Log.hpp"
 
 #include <Arduino.h>
 
@@ -23,6 +24,7 @@ namespace IotZoo
     {
         Serial.println("Constructor HCSC501 pinMotionDetector: " + String(pinMotionDetector));
         this->pinMotionDetector = pinMotionDetector;
+        topicIdTriggered        = mqttClient->addTopic(getBaseTopic() + "/motion_detector/" + String(deviceIndex) + "/triggered");
         pinMode(pinMotionDetector, INPUT_PULLDOWN);
         setup(HRSR501Helper::readInterrupt);
     }
@@ -37,7 +39,7 @@ namespace IotZoo
         bool isTriggered = isTriggered = motionDetectorCounterRising > oldMotionDetectorCounterRising;
         if (isTriggered)
         {
-            Serial.println("Motion detector " + String(index) + " triggered! " + String(lastMillisMotionDetectorRising));
+            LOG_DEBUG(LogModuleSensors, "Motion detector " + String(index) + " triggered! " + String(lastMillisMotionDetectorRising));
             oldMotionDetectorCounterRising = motionDetectorCounterRising;
         }
         return isTriggered;
@@ -79,11 +81,9 @@ namespace IotZoo
 
     void HCSC501::loop()
     {
-        String topicMotionDetectorTriggered = getBaseTopic() + "/motion_detector/" + String(getDeviceIndex()) + "/triggered";
-
         if (isTriggered())
         {
-            mqttClient->publish(topicMotionDetectorTriggered, String(getCounterRising()));
+            mqttClient->publish(topicIdTriggered, String(getCounterRising()));
         }
     }
 } // namespace IotZoo
@@ -18,6 +18,7 @@ namespace IotZoo
     HRSR501Handling::HRSR501Handling()
     {
         Serial.println("Constructor HRSR501Handling");
+        loopIntervalMillis = 50;
     }
 
     HRSR501Handling::~HRSR501Handling()
@@ -14,6 +14,7 @@
 #include "HW040/HW040.hpp"
 #include "HW040/HW040Helper.hpp"
 #include "MqttClient.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -91,7 +92,7 @@ namespace IotZoo
     void RotaryEncoder::setLastTimeButtonDown(unsigned long lastTimeButtonDown)
     {
         this->lastTimeButtonDown = lastTimeButtonDown;
-        Serial.println("lastTimeButtonDown is set to " + String(lastTimeButtonDown) + " for RotaryEncoder.");
+        LOG_DEBUG(LogModuleSensors, "lastTimeButtonDown is set to " + String(lastTimeButtonDown) + " for RotaryEncoder.");
     }
 
     unsigned long RotaryEncoder::getLastTimeButtonDown() const
@@ -115,7 +116,7 @@ namespace IotZoo
         {
             if (nullptr == mqttClient)
             {
-                Serial.println("mqttClient is nullptr!");
+                LOG_ERROR(LogModuleSensors, "mqttClient is nullptr!");
                 return;
             }
 
@@ -127,7 +128,7 @@ namespace IotZoo
                 if (!getWasButtonDown())
                 {
                     String millisTmp = String(millis());
-                    Serial.println("Button of encoder " + String(deviceIndex) + " is pressed at " + millisTmp + ".");
+                    LOG_DEBUG(LogModuleSensors, "Button of encoder " + String(deviceIndex) + " is pressed at " + millisTmp + ".");
                     String topicButtonPressed = baseTopic + "/rotary_encoder/" + String(deviceIndex) + "/button_pressed";
                     mqttClient->publish(topicButtonPressed, millisTmp);
                 }
@@ -138,17 +139,17 @@ namespace IotZoo
             // don't do anything unless value changed.
             if (encoderChanged())
             {
-                Serial.print("Value encoder " + String(deviceIndex) + ": ");
+                LOG_PRINT(LogModuleSensors, LogLevelDebug, "Value encoder " + String(deviceIndex) + ": ");
                 long rotaryEncoderValue = readEncoder();
 
-                Serial.println(rotaryEncoderValue);
+                LOG_DEBUG(LogModuleSensors, rotaryEncoderValue);
 
                 mqttClient->publish(topicEncoderValue, String(rotaryEncoderValue));
             }
         }
         catch (const std::exception& e)
         {
-            Serial.println(e.what());
+            LOG_ERROR(LogModuleSensors, e.what());
         }
     }
 } // namespace IotZoo
@@ -19,6 +19,7 @@ namespace IotZoo
     HW040Handling::HW040Handling() : DeviceHandlingBase()
     {
         Serial.println("Constructor HW040Handling");
+        loopIntervalMillis = 5; // rotary encoder
     }
 
     void HW040Handling::setup()
@@ -14,6 +14,8 @@
 #ifdef USE_HW507
 
 #include "HW507.hpp"
+#include "core/Log.hpp"
+
 #include <math.h>
 
 namespace IotZoo
@@ -22,7 +24,9 @@ namespace IotZoo
                  uint8_t pinData, uint16_t intervalMs)
         : DeviceBase(deviceIndex, settings, mqttClient, baseTopic)
     {
-        this->intervalMs = intervalMs;
+        this->intervalMs   = intervalMs;
+        loopIntervalMillis = min<ulong>(intervalMs, getMinSampleIntervalMillis(deviceType));
+        aggregator.setWindowMillis(intervalMs);
         if (0 == pinData)
         {
             pinData = 23;
@@ -30,13 +34,21 @@ namespace IotZoo
         Serial.println("Constructor HW507, deviceType: " + String(deviceType) + ", dataPin: " + String(pinData) +
                      ", intervalMs: " + String(intervalMs));
         pinMode(pinData, INPUT_PULLUP);
-        dht = new DHT(pinData, deviceType);
+        dht             = new DHT(pinData, deviceType);
+        channelHumidity.name                               = "humidity";
+        channelHumidity.topicId                            = mqttClient->addTopic(getBaseTopic() + "/dht/" + getHumiditySensorType() + "/humidity");
+        channelHumidity.policy.parameters.deadbandAbsolute = 1; // the accuracy is ±5 %
+        channelHumidity.policy.parameters.maxAgeMillis     = 600000;
+        addPublishChannel(channelHumidity);
+        topicIdStatistics = mqttClient->addTopic(getBaseTopic() + "/dht/" + getHumiditySensorType() + "/humidity/stats");
     }
 
     void HW507::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
     {
         String topic = getBaseTopic() + "/dht/" + this->getHumiditySensorType() + "/humidity";
         topics->emplace_back(topic, String(44), MessageDirection::IotZooClientInbound);
+        topics->emplace_back(topic + "/stats", "{\"mean\":44.2,\"min\":43.0,\"max\":45.0,\"stddev\":0.8,\"count\":5}",
+                             MessageDirection::IotZooClientInbound);
     }
 
     void HW507::onMqttConnectionEstablished()
@@ -47,23 +59,40 @@ namespace IotZoo
 
     void HW507::loop()
     {
-        String topic = getBaseTopic() + "/dht/" + this->getHumiditySensorType() + "/humidity";
-
-        if (millis() - lastMillis > intervalMs)
+        // The samples of intervalMs are aggregated: the summary is published per window, the mean only if it changed
+        // beyond the deadband. Invalid samples are counted and reported once per window.
+        float            humidity = dht->readHumidity();
+        uint32_t         now      = millis();
+        AggregateSummary summary;
+        bool             windowCompleted;
+        if (isnan(humidity))
         {
-            float humidity = dht->readHumidity();
-            if (isnan(humidity))
-            {
-                publishError("humidity: no valid value!");
-            }
-            else
-            {
-                Serial.println("humidity: " + String(humidity));
-
-                mqttClient->publish(topic, String(humidity, 1));
-            }
-            lastMillis = millis();
+            channelHumidity.policy.reset();
+            windowCompleted = aggregator.addInvalid(now, summary);
+        }
+        else
+        {
+            windowCompleted = aggregator.add(humidity, now, summary);
+        }
+        if (!windowCompleted)
+        {
+            return;
+        }
+        if (summary.invalid > 0)
+        {
+            publishError("humidity: " + String(summary.invalid) + " of " + String(summary.invalid + summary.count) + " samples not valid!");
+        }
+        if (0 == summary.count)
+        {
+            return;
+        }
+        char json[128];
+        if (summary.toJson(json, sizeof(json), 1) > 0)
+        {
+            LOG_DEBUG(LogModuleSensors, "humidity: " + String(json));
+            mqttClient->publish(topicIdStatistics, json);
         }
+        publishIfDue(channelHumidity, summary.mean, 1);
     }
 } // namespace IotZoo
 
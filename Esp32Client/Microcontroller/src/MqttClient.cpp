@@ -12,9 +12,39 @@
 
 #ifdef USE_MQTT
 #include "MqttClient.hpp"
+#include "core/Log.hpp"
+
+#include <ArduinoJson.h>
+#include <algorithm>
 
 namespace IotZoo
 {
+    // EspMQTTClient converts every payload into a String, which ends at the first zero byte, and keeps its PubSubClient
+    // private. An explicit instantiation may name private members: this hands out the PubSubClient and the message
+    // callback of EspMQTTClient, so binary payloads are taken from PubSubClient before the conversion.
+    template <typename Tag, typename Tag::type Member> struct PrivateMember
+    {
+        friend typename Tag::type get(Tag)
+        {
+            return Member;
+        }
+    };
+
+    struct EspMqttPubSubClient
+    {
+        using type = PubSubClient EspMQTTClient::*;
+        friend type get(EspMqttPubSubClient);
+    };
+
+    struct EspMqttMessageReceived
+    {
+        using type = void (EspMQTTClient::*)(char* topic, uint8_t* payload, unsigned int length);
+        friend type get(EspMqttMessageReceived);
+    };
+
+    template struct PrivateMember<EspMqttPubSubClient, &EspMQTTClient::_mqttClient>;
+    template struct PrivateMember<EspMqttMessageReceived, &EspMQTTClient::mqttMessageReceivedCallback>;
+
     /*
     const char* makeClientId(const char* mac)
     {
@@ -38,7 +68,7 @@ namespace IotZoo
     MqttClient::MqttClient(const char* mqttClientName, const char* wifiSsid, const char* wifiPassword, const char* mqttServerIp,
                            const char* mqttUsername, const char* mqttPassword, const short mqttServerPort, int bufferSize)
     {
-        Serial.println("Constructor MqttClient mqttServerIp: " + String(mqttServerIp) + ":" + String(mqttServerPort));
+        LOG_INFO(LogModuleMqtt, "Constructor MqttClient mqttServerIp: " + String(mqttServerIp) + ":" + String(mqttServerPort));
         mqttClient = new EspMQTTClient(wifiSsid,       // SSID
                                        wifiPassword,   // PWD SSID
                                        mqttServerIp,   // MQTT Broker server ip
@@ -49,7 +79,7 @@ namespace IotZoo
                                        mqttServerPort);
 
         mqttClient->setMaxPacketSize(bufferSize); // default is only 128 bytes! When exeeding the message will not be published!
-        mqttClient->enableDebuggingMessages(true);
+        mqttClient->enableDebuggingMessages(IOTZOO_LOG_ENABLED(LogModuleMqtt, LogLevelDebug));
         // The reconnection should be established after 100 ms.
         mqttClient->setMqttReconnectionAttemptDelay(100);
 
@@ -58,12 +88,16 @@ namespace IotZoo
         mqttClient->enableOTA("IotZoo", // password
                               8266);    // port
 
+        // Replaces the callback EspMQTTClient set in its constructor, messages of other topics are passed on to it.
+        (mqttClient->*get(EspMqttPubSubClient())).setCallback([this](char* topic, uint8_t* payload, unsigned int length)
+                                                              { onMessageReceived(topic, payload, length); });
+
         // mqttClient->enableHTTPWebUpdater("IotZoo");
     }
 
     MqttClient::~MqttClient()
     {
-        Serial.println("Destructor MqttClient");
+        LOG_INFO(LogModuleMqtt, "Destructor MqttClient");
     }
 
     void MqttClient::enableLastWillMessage(const String& topic, const String& message,
@@ -74,10 +108,25 @@ namespace IotZoo
 
     bool MqttClient::publish(const String& topic, const String& payload, bool retain)
     {
-        Serial.println("─┐");
-        Serial.print(">>> Publishing topic:\r\n" + topic + "\r\n\r\npayload ↣ " + payload + "\r\nretain: " + String(retain) +
-                     "\r\nMqttBrokerIp: " + this->mqttClient->getMqttServerIp());
-        return printSuccess(mqttClient->publish(topic, payload, retain));
+        return enqueue(topic.c_str(), reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length(), retain);
+    }
+
+    bool MqttClient::publish(TopicId topicId, const String& payload, bool retain)
+    {
+        if (!topics.isValid(topicId))
+        {
+            return false;
+        }
+        return enqueue(topics.get(topicId), reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length(), retain);
+    }
+
+    bool MqttClient::publish(TopicId topicId, const uint8_t* payload, unsigned int payloadLength, boolean retained)
+    {
+        if (!topics.isValid(topicId))
+        {
+            return false;
+        }
+        return printSuccess(mqttClient->publish(topics.get(topicId), payload, payloadLength, retained));
     }
 
     /// @brief
@@ -87,21 +136,194 @@ namespace IotZoo
     /// @return
     bool MqttClient::subscribe(const String& topic, MessageReceivedCallback messageReceivedCallback, uint8_t qos)
     {
-        Serial.print("Subscribing topic: " + topic + ", qos: " + String(qos));
-        return printSuccess(mqttClient->subscribe(topic, messageReceivedCallback, qos));
+        LOG_PRINT(LogModuleMqtt, LogLevelInfo, "Subscribing topic: " + topic + ", qos: " + String(qos));
+        MessageReceivedCallback callback = messageReceivedCallback;
+#ifdef USE_PROFILER
+        if (nullptr != profiler)
+        {
+            int           probeId      = profiler->addProbe(topic.c_str());
+            LoopProfiler* loopProfiler = profiler;
+            callback                   = [loopProfiler, probeId, messageReceivedCallback](const String& message)
+            {
+                uint32_t startCycles = ESP.getCycleCount();
+                messageReceivedCallback(message);
+                loopProfiler->record(probeId, ESP.getCycleCount() - startCycles);
+            };
+        }
+#endif
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        if (route(topic, [callback](const String&, const String& message) { callback(message); }, qos))
+        {
+            return true;
+        }
+#endif
+        return printSuccess(mqttClient->subscribe(topic, callback, qos));
     }
 
     bool MqttClient::subscribe(const String& topic, MessageReceivedCallbackWithTopic messageReceivedCallback, uint8_t qos)
     {
-        Serial.print("Subscribing (topic with topic): " + topic + ", qos: " + String(qos));
-        return printSuccess(mqttClient->subscribe(topic, messageReceivedCallback, qos));
+        LOG_PRINT(LogModuleMqtt, LogLevelInfo, "Subscribing (topic with topic): " + topic + ", qos: " + String(qos));
+        MessageReceivedCallbackWithTopic callback = messageReceivedCallback;
+#ifdef USE_PROFILER
+        if (nullptr != profiler)
+        {
+            int           probeId      = profiler->addProbe(topic.c_str());
+            LoopProfiler* loopProfiler = profiler;
+            callback                   = [loopProfiler, probeId, messageReceivedCallback](const String& topicStr, const String& message)
+            {
+                uint32_t startCycles = ESP.getCycleCount();
+                messageReceivedCallback(topicStr, message);
+                loopProfiler->record(probeId, ESP.getCycleCount() - startCycles);
+            };
+        }
+#endif
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        if (route(topic, callback, qos))
+        {
+            return true;
+        }
+#endif
+        return printSuccess(mqttClient->subscribe(topic, callback, qos));
+    }
+
+    bool MqttClient::subscribeBinary(const String& topic, BinaryMessageReceivedCallback messageReceivedCallback, uint8_t qos)
+    {
+        LOG_PRINT(LogModuleMqtt, LogLevelInfo, "Subscribing (binary) topic: " + topic + ", qos: " + String(qos));
+        BinaryMessageReceivedCallback callback = messageReceivedCallback;
+#ifdef USE_PROFILER
+        if (nullptr != profiler)
+        {
+            int           probeId      = profiler->addProbe(topic.c_str());
+            LoopProfiler* loopProfiler = profiler;
+            callback                   = [loopProfiler, probeId, messageReceivedCallback](const uint8_t* payload, size_t length)
+            {
+                uint32_t startCycles = ESP.getCycleCount();
+                messageReceivedCallback(payload, length);
+                loopProfiler->record(probeId, ESP.getCycleCount() - startCycles);
+            };
+        }
+#endif
+        binarySubscriptions.add(topic.c_str(), callback);
+        // The subscription at the broker, renewed by EspMQTTClient. The messages never reach the String callback.
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        if (route(topic, [](const String&, const String&) {}, qos))
+        {
+            return true;
+        }
+#endif
+        return printSuccess(mqttClient->subscribe(topic, [](const String&) {}, qos));
     }
 
     bool MqttClient::unsubscribe(const String& topic)
     {
+        binarySubscriptions.remove(topic.c_str());
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        if (router.remove(topic.c_str()))
+        {
+            routerChanged = true;
+            return true;
+        }
+#endif
         return mqttClient->unsubscribe(topic);
     }
 
+#ifdef USE_WILDCARD_SUBSCRIPTION
+    void MqttClient::setWildcardPrefix(const String& prefix)
+    {
+        for (const String& filter : routedSubscriptions)
+        {
+            mqttClient->unsubscribe(filter);
+        }
+        routedSubscriptions.clear();
+        router.setPrefix(prefix.c_str());
+        for (size_t index = 0; index < topics.size(); index++)
+        {
+            router.addPublished(topics.get(static_cast<TopicId>(index)));
+        }
+    }
+
+    bool MqttClient::route(const String& topic, const MessageReceivedCallbackWithTopic& messageReceivedCallback, uint8_t qos)
+    {
+        // The filters are subscribed with qos 0.
+        if (0 != qos || !router.add(topic.c_str(), messageReceivedCallback))
+        {
+            return false;
+        }
+        routerChanged = true; // subscribed in loop(), once for all handlers added in onConnectionEstablished.
+        return true;
+    }
+
+    void MqttClient::subscribeRouted()
+    {
+        if (!isConnected())
+        {
+            return;
+        }
+        routerChanged = false;
+        // Sub-trees without a published topic, so the broker does not send the own messages back, e.g. the audio stream.
+        std::vector<std::string> filters = router.updateFilters();
+        for (size_t index = 0; index < routedSubscriptions.size();)
+        {
+            if (filters.end() == std::find(filters.begin(), filters.end(), routedSubscriptions[index].c_str()))
+            {
+                LOG_INFO(LogModuleMqtt, "Unsubscribing routed filter: " + routedSubscriptions[index]);
+                mqttClient->unsubscribe(routedSubscriptions[index]);
+                routedSubscriptions.erase(routedSubscriptions.begin() + index);
+            }
+            else
+            {
+                index++;
+            }
+        }
+        for (const std::string& filter : filters)
+        {
+            String filterTopic = filter.c_str();
+            if (routedSubscriptions.end() != std::find(routedSubscriptions.begin(), routedSubscriptions.end(), filterTopic))
+            {
+                continue;
+            }
+            LOG_INFO(LogModuleMqtt, "Subscribing routed filter: " + filterTopic);
+            bool ok = printSuccess(mqttClient->subscribe(
+                filterTopic,
+                [this](const String& topic, const String& message)
+                {
+                    // Handlers subscribe in onConnectionEstablished, not while a message is dispatched. A topic without
+                    // a handler, e.g. published before the filters were renewed, is dropped.
+                    MessageReceivedCallbackWithTopic* handler = router.find(topic.c_str(), topic.length());
+                    if (nullptr != handler)
+                    {
+                        (*handler)(topic, message);
+                    }
+                },
+                0));
+            if (ok)
+            {
+                routedSubscriptions.push_back(filterTopic);
+            }
+        }
+    }
+
+    void MqttClient::notePublished(const char* topic)
+    {
+        if (router.addPublished(topic))
+        {
+            routerChanged = true;
+        }
+    }
+#else
+    void MqttClient::notePublished(const char*)
+    {
+    }
+#endif
+
+    void MqttClient::onMessageReceived(char* topic, uint8_t* payload, unsigned int length)
+    {
+        if (!binarySubscriptions.dispatch(topic, payload, length))
+        {
+            (mqttClient->*get(EspMqttMessageReceived()))(topic, payload, length);
+        }
+    }
+
     unsigned int MqttClient::getConnectionEstablishedCount() const
     {
         return mqttClient->getConnectionEstablishedCount(); // Return the number of time onConnectionEstablished has been
@@ -115,28 +337,145 @@ namespace IotZoo
 
     void MqttClient::removeRetainedMessageFromBroker(const String& topic)
     {
-        Serial.println("*** Removing topic " + topic);
+        LOG_INFO(LogModuleMqtt, "*** Removing topic " + topic);
+        notePublished(topic.c_str());
         mqttClient->publish(topic, "", true);
     }
 
+    PublishClass MqttClient::getPublishClass(const char* topic) const
+    {
+        for (const auto& pattern : telemetryTopicPatterns)
+        {
+            if (nullptr != strstr(topic, pattern.c_str()))
+            {
+                return PublishClass::Telemetry;
+            }
+        }
+        return PublishClass::Event;
+    }
+
+    bool MqttClient::enqueue(const char* topic, const uint8_t* payload, unsigned int payloadLength, bool retain)
+    {
+#ifdef USE_STORE_AND_FORWARD
+        if (nullptr != storeAndForward && !isConnected())
+        {
+            if (storeAndForward->store(topic, payload, payloadLength, retain, millis()))
+            {
+                return true;
+            }
+        }
+#endif
+        PublishClass publishClass = getPublishClass(topic);
+        switch (publishQueue.push(topic, payload, payloadLength, retain, publishClass))
+        {
+            case PublishQueue::Result::Queued:
+            case PublishQueue::Result::Coalesced:
+                return true;
+            case PublishQueue::Result::TooLarge:
+                // e.g. the alive message or the device configuration.
+                return publishNow(topic, payload, payloadLength, retain);
+            case PublishQueue::Result::Dropped:
+            default:
+                if (PublishClass::Event == publishClass)
+                {
+                    // Backpressure: the queue is full of events, events must not get lost.
+                    return publishNow(topic, payload, payloadLength, retain);
+                }
+                return false;
+        }
+    }
+
+    bool MqttClient::publishNow(const char* topic, const uint8_t* payload, unsigned int payloadLength, bool retain)
+    {
+        if constexpr (IOTZOO_LOG_ENABLED(LogModuleMqtt, LogLevelDebug))
+        {
+            Serial.println("─┐");
+            Serial.print(">>> Publishing topic:\r\n");
+            Serial.print(topic);
+            Serial.print("\r\n\r\npayload ↣ ");
+            Serial.write(payload, payloadLength);
+            Serial.print("\r\nretain: " + String(retain));
+        }
+        notePublished(topic);
+        return printSuccess(mqttClient->publish(topic, payload, payloadLength, retain));
+    }
+
     /// Main loop
     void MqttClient::loop()
     {
         mqttClient->loop();
+        bool connected = isConnected();
+#ifdef USE_WILDCARD_SUBSCRIPTION
+        if (!connected)
+        {
+            routedSubscriptions.clear(); // the broker drops the subscriptions of a clean session.
+            routerChanged = true;
+        }
+        else if (routerChanged)
+        {
+            subscribeRouted(); // the devices subscribe only after the first connect.
+        }
+#endif
+        if (publishQueue.size() > 0 && connected)
+        {
+            publishQueue.drain([this](const char* topic, const uint8_t* payload, size_t payloadLength, bool retain)
+                               { return publishNow(topic, payload, payloadLength, retain); },
+                               []() { return static_cast<uint32_t>(micros()); }, publishBudgetMicros);
+        }
+#ifdef USE_STORE_AND_FORWARD
+        // The stored messages are replayed when the live messages are sent, to <topic>/stored: the live topic always
+        // has the latest value, the stored topic lags behind it until the replay is done.
+        if (nullptr != storeAndForward && (!connected || 0 == publishQueue.size()))
+        {
+            storeAndForward->loop(connected, millis(), [this](const StoredMessage& message) { return publishStored(message); });
+        }
+#endif
     }
 
+#ifdef USE_STORE_AND_FORWARD
+    bool MqttClient::publishStored(const StoredMessage& message)
+    {
+        // Published to <topic>/stored, never retained, so the subscribers and the retained value of the live topic do
+        // not get an old value: {"storedMillis":5000,"ageMillis":42000,"payload":"21.5"}. The payload is the original
+        // one as a JSON string. A message stored before a restart has "restored":true instead of "ageMillis", millis()
+        // started again at 0.
+        StaticJsonDocument<128> wrapper;
+        char                    text[StoredMessage::MaxPayloadLength + 1];
+        memcpy(text, message.payload, message.length);
+        text[message.length] = '\0';
+
+        wrapper["storedMillis"] = message.timestamp;
+        if (message.restored)
+        {
+            wrapper["restored"] = true;
+        }
+        else
+        {
+            wrapper["ageMillis"] = static_cast<uint32_t>(millis() - message.timestamp);
+        }
+        wrapper["payload"] = static_cast<const char*>(text);
+        String json;
+        serializeJson(wrapper, json);
+        String topic = String(message.topic) + "/stored";
+        return publishNow(topic.c_str(), reinterpret_cast<const uint8_t*>(json.c_str()), json.length(), false);
+    }
+#endif
+
     bool MqttClient::printSuccess(bool ok)
     {
-        Serial.println("");
         if (ok)
         {
-            Serial.println(" -> OK " + String(millis()));
+            if constexpr (IOTZOO_LOG_ENABLED(LogModuleMqtt, LogLevelDebug))
+            {
+                Serial.println("");
+                Serial.println(" -> OK " + String(millis()));
+                Serial.println("─┘");
+            }
         }
         else
         {
-            Serial.println(" -> NOK " + String(millis()));
+            LOG_WARNING(LogModuleMqtt, "\r\n -> NOK " + String(millis()) + "\r\n─┘");
         }
-        Serial.println("─┘");
         return ok;
     }
 } // namespace IotZoo
@@ -52,6 +52,15 @@ namespace IotZoo
         }
     }
 
+    PixelBuffer PixelMatrix::getPixelBuffer() const
+    {
+        PixelBuffer buffer = WS2818::getPixelBuffer();
+        buffer.columns     = numberOfLedsPerRow;
+        buffer.rows        = numberOfLedsPerColumn;
+        buffer.serpentine  = true;
+        return buffer;
+    }
+
     void PixelMatrix::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
     {
         WS2818::addMqttTopicsToRegister(topics);
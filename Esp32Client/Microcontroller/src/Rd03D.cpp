@@ -12,23 +12,25 @@
 #include "Defines.hpp"
 #ifdef USE_RD_03D
 
-#include "RD03D.hpp"
+#include "Rd03D.hpp"
+#include "core/Log.hpp"
 
 #include <ArduinoJson.h>
 
 namespace IotZoo
 {
     Rd03D::Rd03D(int deviceIndex, Settings* const settings, MqttClient* const mqttClient, const String& baseTopic, uint8_t pinRx, uint8_t pinTx,
-                 u_int16_t timeoutMillis, u_int16_t maxDistanceMillimeters, bool multiTargetMode)
-        : DeviceBase(deviceIndex, settings, mqttClient, baseTopic)
+                 u_int16_t timeoutMillis, u_int16_t maxDistanceMillimeters, bool multiTargetMode, u_int16_t publishIntervalMillis)
+        : DeviceBase(deviceIndex, settings, mqttClient, baseTopic), publishIntervalMillis(publishIntervalMillis)
     {
         Serial.print("Constructor Rd03D, pinRx: " + String(pinRx) + ", pinTx: " + String(pinTx));
         Serial.println("timeoutMillis: " + String(timeoutMillis) + ", maxDistanceMillimeters: " + String(maxDistanceMillimeters) +
-                       ", multiTargetMode: " + String(multiTargetMode));
+                       ", multiTargetMode: " + String(multiTargetMode) + ", publishIntervalMillis: " + String(publishIntervalMillis));
         this->pinRx           = pinRx;
         this->pinTx           = pinTx;
         this->multiTargetMode = multiTargetMode;
         this->timeoutMillis   = timeoutMillis;
+        loopIntervalMillis    = 100;
         if (this->timeoutMillis < 1000)
         {
             this->timeoutMillis = 1000;
@@ -38,45 +40,45 @@ namespace IotZoo
         {
             this->maxDistanceMillimeters = 7000;
         }
-        topicDistanceTarget1       = baseTopic + "/rd03d/0/target/0/distance_mm";
-        topicMovementChangeTarget1 = baseTopic + "/rd03d/0/target/0";
-        if (multiTargetMode)
+        for (size_t index = 0; index < getTargetCount(); index++)
         {
-            topicDistanceTarget2       = baseTopic + "/rd03d/0/target/1/distance_mm";
-            topicMovementChangeTarget2 = baseTopic + "/rd03d/0/target/1";
-            topicDistanceTarget3       = baseTopic + "/rd03d/0/target/2/distance_mm";
-            topicMovementChangeTarget3 = baseTopic + "/rd03d/0/target/2";
+            topicDistanceTarget[index]       = baseTopic + "/rd03d/0/target/" + String(index) + "/distance_mm";
+            topicMovementChangeTarget[index] = baseTopic + "/rd03d/0/target/" + String(index);
         }
         topicMovementDetected             = baseTopic + "/rd03d/0/movement_detected";
         topicCountOfDetectedPeopleInRange = baseTopic + "/rd03d/0/count_of_people_in_range";
+        topicTracks                       = baseTopic + "/rd03d/0/tracks";
+        topicZones                        = baseTopic + "/rd03d/0/zones";
+        if (nullptr != settings)
+        {
+            String json = settings->loadConfiguration(SettingsKeyZones);
+            if (json.length())
+            {
+                parseZones(json);
+            }
+        }
         setup();
     }
 
     Rd03D::~Rd03D()
     {
         Serial.println("Destructor Rd03D, pinRx: " + String(pinRx) + ", pinTx: " + String(pinTx));
-        this->pinRx = pinRx;
+        delete uart;
+        uart = nullptr;
     }
 
     /// @brief Let the user know what the device can do.
     /// @param topics
     void Rd03D::addMqttTopicsToRegister(std::vector<Topic>* const topics) const
     {
-        topics->emplace_back(topicDistanceTarget1, "Sends the distance to human 1 in mm.", MessageDirection::IotZooClientInbound);
-        if (multiTargetMode)
+        for (size_t index = 0; index < getTargetCount(); index++)
         {
-            topics->emplace_back(topicDistanceTarget2, "Sends the distance to human 2 in mm.", MessageDirection::IotZooClientInbound);
-
-            topics->emplace_back(topicDistanceTarget3, "Sends the distance to human 3 in mm.", MessageDirection::IotZooClientInbound);
+            topics->emplace_back(topicDistanceTarget[index], "Sends the distance to human " + String(index + 1) + " in mm.",
+                                 MessageDirection::IotZooClientInbound);
         }
-        topics->emplace_back(topicMovementChangeTarget1, "Sends movement change data in json format for target 1.",
-                             MessageDirection::IotZooClientInbound);
-        if (multiTargetMode)
+        for (size_t index = 0; index < getTargetCount(); index++)
         {
-            topics->emplace_back(topicMovementChangeTarget2, "Sends movement change data in json format for target 2.",
-                                 MessageDirection::IotZooClientInbound);
-
-            topics->emplace_back(topicMovementChangeTarget3, "Sends movement change data in json format for target 3.",
+            topics->emplace_back(topicMovementChangeTarget[index], "Sends movement change data in json format for target " + String(index + 1) + ".",
                                  MessageDirection::IotZooClientInbound);
         }
 
@@ -84,112 +86,217 @@ namespace IotZoo
                              MessageDirection::IotZooClientInbound);
 
         topics->emplace_back(topicCountOfDetectedPeopleInRange, "Number of people in range [0-3].", MessageDirection::IotZooClientInbound);
+
+        topics->emplace_back(topicTracks,
+                             "Tracked people, smoothed, with ids that stay the same while a person is in range. Published when a track appears, "
+                             "disappears or moves: [{\"id\":3,\"x\":-261,\"y\":537,\"vx\":0,\"vy\":420,\"distanceMillimeters\":597,\"angle\":116}]",
+                             MessageDirection::IotZooClientInbound);
+
+        topics->emplace_back(topicZones, R"({"zones":[{"name":"couch","dwellMillis":10000,"points":[[-2000,1000],[0,1000],[0,2000],[-2000,2000]]}]})",
+                             MessageDirection::IotZooClientOutbound);
+        for (size_t zone = 0; zone < zones.getZoneCount(); zone++)
+        {
+            String topicZone = baseTopic + "/rd03d/0/zone/" + zones.getName(zone);
+            topics->emplace_back(topicZone, "{\"event\":\"enter\",\"id\":3,\"dwellMillis\":0} Events: enter, dwell, exit.",
+                                 MessageDirection::IotZooClientInbound);
+            topics->emplace_back(topicZone + "/occupancy", "Number of people in the zone.", MessageDirection::IotZooClientInbound);
+        }
     }
 
-    void Rd03D::loop()
+    void Rd03D::onMqttConnectionEstablished()
     {
-        bool peopleDetected = false;
-        // Evaluation of the data.
-        while (Serial1.available())
+        if (mqttCallbacksAreRegistered)
         {
-            serialBufferCountTmp = Serial1.read(); // reads the first byte of the incomming data.
-
-            serialBuffer[serialBufferCount++] = serialBufferCountTmp;
-
-            // Prevent buffer overflow
-            if (serialBufferCount >= sizeof(serialBuffer))
-            {
-                serialBufferCount = sizeof(serialBuffer) - 1;
-            }
+            Serial.println("Reconnection -> nothing to do.");
+            return;
+        }
+        mqttClient->subscribe(topicZones,
+                              [this](const String& json)
+                              {
+                                  if (!parseZones(json))
+                                  {
+                                      publishError("rd03d zones: invalid JSON, polygon or zone name");
+                                      return;
+                                  }
+                                  if (nullptr != settings)
+                                  {
+                                      settings->saveConfigurationData(SettingsKeyZones, json);
+                                  }
+                              });
+        mqttCallbacksAreRegistered = true;
+    }
 
-            // Check for end of frame (0xCC, 0x55) and extract data for target1, target2, target3.
-            if (processData())
+    bool Rd03D::parseZones(const String& json)
+    {
+        DynamicJsonDocument  jsonDocument(4096);
+        DeserializationError error = deserializeJson(jsonDocument, json);
+        if (error)
+        {
+            return false;
+        }
+        OccupancyZones parsed;
+        for (JsonObjectConst zone : jsonDocument["zones"].as<JsonArrayConst>())
+        {
+            ZonePoint      points[OccupancyZones::MaxVertices];
+            size_t         count     = 0;
+            JsonArrayConst jsonPoints = zone["points"];
+            for (JsonArrayConst point : jsonPoints)
             {
-                int countOfDetectedPeople = 0;
-
-                if (target1.distanceMillimeters < maxDistanceMillimeters && target1.distanceMillimeters > 0)
-                {
-                    Serial.println("Target 1 Distance: " + String(target1.distanceMillimeters));
-                    target1IsMoving    = true;
-                    millisTarget1Moved = millis();
-
-                    countOfDetectedPeople++;
-
-                    mqttClient->publish(topicDistanceTarget1, String(target1.distanceMillimeters));
-                    mqttClient->publish(topicMovementChangeTarget1, serializeTarget(target1));
-                }
-                else
+                if (count < OccupancyZones::MaxVertices)
                 {
-                    // Serial.println("Target 1 out of range of (" + String(maxDistanceMillimeters) + ") mm: " +
-                    // String(target1.distanceMillimeters) + " mm.");
-                    //  target1IsMoving = false; sometimes we got wrong data from the sensor, so out of range must not mean
-                    //  that the target is not there or moving.
+                    points[count] = {point[0].as<int16_t>(), point[1].as<int16_t>()};
                 }
+                count++;
+            }
+            // The name is a level of the zone topic.
+            if (!parsed.addZone(zone["name"] | "zone", points, count, zone["dwellMillis"] | 0))
+            {
+                return false;
+            }
+        }
+        // The occupants of the old zones leave them, the subscribers would wait for the exit otherwise.
+        zones.exitAll(millis(), [this](const ZoneEvent& event) { onZoneEvent(event); });
+        zones = parsed;
+        LOG_INFO(LogModuleSensors, "Rd03D: " + String(zones.getZoneCount()) + " zones");
+        return true;
+    }
 
-                if (target2.distanceMillimeters < maxDistanceMillimeters && target2.distanceMillimeters > 0)
-                {
-                    Serial.println("Target 2 Distance: " + String(target2.distanceMillimeters));
-                    countOfDetectedPeople++;
+    void Rd03D::onZoneEvent(const ZoneEvent& event)
+    {
+        String topicZone = baseTopic + "/rd03d/0/zone/" + zones.getName(event.zone);
+        mqttClient->publish(topicZone, "{\"event\":\"" + String(OccupancyZones::getEventName(event.type)) + "\",\"id\":" + String(event.trackId) +
+                                           ",\"dwellMillis\":" + String(event.dwellMillis) + "}");
+        if (ZoneEventType::Dwell != event.type)
+        {
+            mqttClient->publish(topicZone + "/occupancy", String(event.occupancy));
+        }
+    }
 
-                    mqttClient->publish(topicDistanceTarget2, String(target2.distanceMillimeters));
-                    mqttClient->publish(topicMovementChangeTarget2, serializeTarget(target2));
+    void Rd03D::loop()
+    {
+        // The frames were decoded by the decoder task of the UART.
+        Rd03DFrame frame;
+        while (frames.pop(&frame, 1) > 0)
+        {
+            onFrame(frame);
+        }
 
-                    millisTarget2Moved = millis();
-                }
-                else
-                {
-                    // Serial.println("Target 2 out of range of (" + String(maxDistanceMillimeters) + ") mm: " +
-                    // String(target2.distanceMillimeters) + " mm.");
-                }
+        uint32_t overruns = frames.getOverruns() + (nullptr != uart ? uart->getOverflows() : 0);
+        if (overruns != reportedOverruns)
+        {
+            LOG_WARNING(LogModuleSensors, "Rd03D: dropped frames or UART overflows: " + String(overruns - reportedOverruns));
+            reportedOverruns = overruns;
+        }
 
-                if (target3.distanceMillimeters < maxDistanceMillimeters && target3.distanceMillimeters > 0)
-                {
-                    Serial.println("Target 3 Distance: " + String(target3.distanceMillimeters));
-                    countOfDetectedPeople++;
+        if (millis() - millisLastPublish >= publishIntervalMillis)
+        {
+            millisLastPublish = millis();
+            publishTracks();
+        }
 
-                    mqttClient->publish(topicDistanceTarget3, String(target3.distanceMillimeters));
-                    mqttClient->publish(topicMovementChangeTarget3, serializeTarget(target2));
+        for (size_t index = 0; index < TargetCount; index++)
+        {
+            if (millis() - millisTargetMoved[index] > timeoutMillis)
+            {
+                // No movement for a long time
+                targetIsMoving[index] = false;
+            }
+        }
 
-                    millisTarget3Moved = millis();
-                }
-                else
-                {
-                    // Serial.println("Target 3 out of range of (" + String(maxDistanceMillimeters) + ") mm: " +
-                    // String(target3.distanceMillimeters) + " mm.");
-                }
+        publishMovementStatus();
+    }
 
-                this->countOfPeopleInRange = countOfDetectedPeople;
+    void Rd03D::onFrame(const Rd03DFrame& frame)
+    {
+        TargetTracker::Measurement measurements[TargetCount];
+        size_t                     count = 0;
+        for (size_t index = 0; index < getTargetCount(); index++)
+        {
+            const Target& target = frame.targets[index];
+            // Out of range does not mean that the target is not there or moving: sometimes we got wrong data from the sensor.
+            // The tracker keeps the track for a few frames.
+            if (target.distanceMillimeters < maxDistanceMillimeters && target.distanceMillimeters > 0)
+            {
+                measurements[count++] = {static_cast<float>(target.x), static_cast<float>(target.y)};
             }
         }
+        tracker.update(measurements, count, millis());
 
-        if (millis() - millisTarget1Moved > timeoutMillis)
+        if (zones.getZoneCount() > 0)
         {
-            // No movement for a long time
-            target1IsMoving = false;
+            // Every frame, but only the changes go to MQTT.
+            const Track*  tracks[TargetTracker::MaxTracks];
+            TrackPosition positions[TargetTracker::MaxTracks];
+            size_t        trackCount = tracker.getConfirmedTracks(tracks, TargetTracker::MaxTracks);
+            for (size_t index = 0; index < trackCount; index++)
+            {
+                positions[index] = {tracks[index]->id, static_cast<int16_t>(tracks[index]->x.position), static_cast<int16_t>(tracks[index]->y.position)};
+            }
+            zones.update(positions, trackCount, millis(), [this](const ZoneEvent& event) { onZoneEvent(event); });
         }
+    }
 
-        if (millis() - millisTarget2Moved > timeoutMillis)
+    void Rd03D::publishTracks()
+    {
+        const Track* tracks[TargetCount];
+        size_t       count   = tracker.getConfirmedTracks(tracks, getTargetCount());
+        bool         changed = count != countOfPeopleInRange;
+
+        for (size_t index = 0; index < getTargetCount(); index++)
         {
-            // No movement for a long time
-            target2IsMoving = false;
+            PublishedTrack& published = publishedTracks[index];
+            if (index >= count)
+            {
+                changed |= 0 != published.id;
+                published = PublishedTrack();
+                continue;
+            }
+            const Track& track = *tracks[index];
+            float        dx    = track.x.position - published.x;
+            float        dy    = track.y.position - published.y;
+            if (track.id == published.id && dx * dx + dy * dy < MinChangeMillimeters * MinChangeMillimeters)
+            {
+                continue; // e.g. a person sitting on the couch.
+            }
+            changed      = true;
+            published.id = track.id;
+            published.x  = track.x.position;
+            published.y  = track.y.position;
+
+            targetIsMoving[index]    = true;
+            millisTargetMoved[index] = millis();
+
+            StaticJsonDocument<256> jsonDocument;
+            serializeTrack(track, jsonDocument.to<JsonObject>());
+            String json;
+            serializeJson(jsonDocument, json);
+            mqttClient->publish(topicDistanceTarget[index], String(jsonDocument["distanceMillimeters"].as<int>()));
+            mqttClient->publish(topicMovementChangeTarget[index], json);
         }
+        this->countOfPeopleInRange = count;
 
-        if (millis() - millisTarget3Moved > timeoutMillis)
+        if (changed)
         {
-            // No movement for a long time
-            target3IsMoving = false;
+            StaticJsonDocument<768> jsonDocument;
+            JsonArray               jsonTracks = jsonDocument.to<JsonArray>();
+            for (size_t index = 0; index < count; index++)
+            {
+                serializeTrack(*tracks[index], jsonTracks.createNestedObject());
+            }
+            String json;
+            serializeJson(jsonDocument, json);
+            mqttClient->publish(topicTracks, json);
         }
-
-        publishMovementStatus();
     }
 
     void Rd03D::publishMovementStatus()
     {
-        bool isMovingStatus = target1IsMoving || target2IsMoving || target3IsMoving;
+        bool isMovingStatus = targetIsMoving[0] || targetIsMoving[1] || targetIsMoving[2];
         if (currentIsMovingStatus != isMovingStatus)
         {
-            Serial.println("Moving status changed -> target1IsMoving: " + String(target1IsMoving) + ", target2IsMoving: " + String(target2IsMoving) +
-                           ", target3IsMoving: " + String(target3IsMoving) + ", Count of People in Range: " + String(countOfPeopleInRange));
+            LOG_DEBUG(LogModuleSensors, "Moving status changed -> target1IsMoving: " + String(targetIsMoving[0]) +
+                                            ", target2IsMoving: " + String(targetIsMoving[1]) + ", target3IsMoving: " + String(targetIsMoving[2]) +
+                                            ", Count of People in Range: " + String(countOfPeopleInRange));
 
             mqttClient->publish(topicMovementDetected, String(isMovingStatus));
             mqttClient->publish(topicCountOfDetectedPeopleInRange, String(countOfPeopleInRange));
@@ -199,87 +306,47 @@ namespace IotZoo
 
     void Rd03D::setup()
     {
-        Serial1.setRxBufferSize(1024);
-        Serial1.begin(256000, // Baudrate
-                      SERIAL_8N1, pinRx, pinTx);
+        uart = new UartReader(pinRx, pinTx, 256000);
+        // The frames end with 55 CC, two different characters, which the pattern detection cannot find. The driver posts
+        // an event after the idle gap between two frames instead.
+        if (!uart->begin(onUartData, this, "rd03dDecoder"))
+        {
+            return;
+        }
         // Send target detection command
         if (multiTargetMode)
         {
-            Serial1.write(Multi_Target_Detection_CMD, sizeof(Multi_Target_Detection_CMD));
+            uart->write(Multi_Target_Detection_CMD, sizeof(Multi_Target_Detection_CMD));
             Serial.println("Multi-target detection mode activated.");
         }
         else
         {
-            Serial1.write(Single_Target_Detection_CMD, sizeof(Single_Target_Detection_CMD));
+            uart->write(Single_Target_Detection_CMD, sizeof(Single_Target_Detection_CMD));
             Serial.println("Single-target detection mode activated.");
         }
-        serialBufferCount = 0;
-        Serial1.flush();
-    }
-
-    String Rd03D::serializeTarget(const Target& target)
-    {
-        StaticJsonDocument<256> doc;
-        doc["x"] = target.x;
-        doc["y"] = target.y;
-        // doc["speedCentimetersPerSecond"] = std::rint(target.speedCentimetersPerSecond);
-        doc["distanceMillimeters"] = target.distanceMillimeters;
-        doc["angle"]               = std::rint(target.angle);
-        String json;
-        size_t size = serializeJson(doc, json);
-        // Serial.println("Serialized target " + json + " size: " + String(size) + " bytes.");
-        return json;
     }
 
-    Target Rd03D::getTarget(uint8_t targetIndex)
+    void Rd03D::onUartData(void* context, const uint8_t* data, size_t length)
     {
-        Target target;
-
-        int bufferIndex = 4 + targetIndex * 8;
-
-        target.x                             = (serialBuffer[bufferIndex++] | (serialBuffer[bufferIndex++] << 8)) - 0x200;
-        target.y                             = (serialBuffer[bufferIndex++] | (serialBuffer[bufferIndex++] << 8)) - 0x8000;
-        target.speedCentimetersPerSecond     = (serialBuffer[bufferIndex++] | (serialBuffer[bufferIndex++] << 8)) - 0x10;
-        target.distanceResolutionMillimeters = (serialBuffer[bufferIndex++] | (serialBuffer[bufferIndex++] << 8));
-        target.distanceMillimeters           = sqrt(pow(target.x, 2) + pow(target.y, 2));
-        target.angle                         = atan2(target.y, target.x) * 180.0 / PI;
-        return target;
-    }
-
-    /// @brief Processes the received data.
-    /// @return true, if at least one target was found; otherwise false.
-    bool Rd03D::processData()
-    {
-        int minBufferCount = 25;
-        if (!multiTargetMode)
+        Rd03D* rd03D = static_cast<Rd03D*>(context);
+        while (length > 0)
         {
-            minBufferCount = 10;
+            size_t written = rd03D->parser.write(data, length);
+            rd03D->parser.parse([rd03D](const Rd03DFrame& frame) { rd03D->frames.push(&frame, 1); });
+            data += written;
+            length -= written;
         }
+    }
 
-        if (serialBufferCount > minBufferCount && serialBuffer[serialBufferCount - 1] == 0xCC && serialBuffer[serialBufferCount - 2] == 0x55)
-        {
-            /* RX_BUF: 0xAA 0xFF 0x03 0x00                   Header
-             *  0x05 0x01 0x19 0x82 0x00 0x00 0x68 0x01      target1
-             *  0xE3 0x81 0x33 0x88 0x20 0x80 0x68 0x01      target2
-             *  0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00      target3
-             *  0x55 0xCC
-             */
-
-            // Extract data for Targets
-            target1 = getTarget(0);
-            target2 = getTarget(1);
-            target3 = getTarget(2);
-            // Serial.print("Target 1 - Distance: " + String(target1.distanceMillimeters));
-            // Serial.print(", Target 2 - Distance: " + String(target2.distanceMillimeters));
-            // Serial.println(", Target 3 - Distance: " + String(target3.distanceMillimeters));
-
-            // Reset buffer and counter
-            memset(serialBuffer, 0x00, sizeof(serialBuffer));
-            serialBufferCount = 0;
-
-            return target1.distanceMillimeters > 0 || target2.distanceMillimeters > 0 || target2.distanceMillimeters > 0;
-        }
-        return false;
+    void Rd03D::serializeTrack(const Track& track, JsonObject json) const
+    {
+        json["id"]                  = track.id;
+        json["x"]                   = std::lrint(track.x.position);
+        json["y"]                   = std::lrint(track.y.position);
+        json["vx"]                  = std::lrint(track.x.velocity);
+        json["vy"]                  = std::lrint(track.y.velocity);
+        json["distanceMillimeters"] = std::lrint(std::sqrt(track.x.position * track.x.position + track.y.position * track.y.position));
+        json["angle"]               = std::lrint(std::atan2(track.y.position, track.x.position) * 180.0f / PI);
     }
 } // namespace IotZoo
 
@@ -41,7 +41,15 @@ namespace IotZoo
         : DeviceBase(deviceIndex, settings, mqttClient, baseTopic)
     {
         Serial.println("Constructor KY025, intervalMs: " + String(intervalMs) + ", pinData: " + String(pinData));
-        this->intervalMs = intervalMs;
+        this->intervalMs   = intervalMs;
+        loopIntervalMillis = 200;
+        topicIdCounter     = mqttClient->addTopic(getBaseTopic() + "/reed_contact/" + String(deviceIndex) + "/counter");
+
+        channelPpm.name                                = "ppm";
+        channelPpm.topicId                             = mqttClient->addTopic(getBaseTopic() + "/reed_contact/" + String(deviceIndex) + "/ppm");
+        channelPpm.policy.parameters.minIntervalMillis = 200;
+        channelPpm.policy.parameters.deadbandAbsolute  = 1; // published without decimal places.
+        addPublishChannel(channelPpm);
         pinMode(pinData, INPUT_PULLUP);
         attachInterrupt(pinData, isrKY025, FALLING);
     }
@@ -56,28 +64,18 @@ namespace IotZoo
 
     void KY025::loop()
     {
-        if (millis() - lastLoopMillis < 200)
-        {
-            Serial.println("KY025 skip loop");
-            return;
-        }
-
+        // The counter is an event, the ppm a value: published when it changed.
+        float ppm = rpm;
         if (oldReedContactCounter != reedContactCounter)
         {
             oldReedContactCounter = reedContactCounter;
-
-            mqttClient->publish(getBaseTopic() + "/reed_contact/" + String(getDeviceIndex()) + "/ppm", String(rpm, 0));
-            mqttClient->publish(getBaseTopic() + "/reed_contact/" + String(getDeviceIndex()) + "/counter", String(reedContactCounter));
-            lastLoopMillis = millis();
+            mqttClient->publish(topicIdCounter, String(reedContactCounter));
         }
-        else
+        else if (millis() - lastRotationMillis > 3000)
         {
-            if (millis() - lastLoopMillis > 3000)
-            {
-                mqttClient->publish(getBaseTopic() + "/reed_contact/" + String(getDeviceIndex()) + "/ppm", "0");
-                lastLoopMillis = millis();
-            }
+            ppm = 0; // stopped
         }
+        publishIfDue(channelPpm, ppm, 0);
     }
 
 } // namespace IotZoo
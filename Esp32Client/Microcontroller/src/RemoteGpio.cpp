@@ -13,6 +13,7 @@
 #ifndef __REMOTE_GPIO_HPP__
 #include "./pocos/Topic.hpp"
 #include "RemoteGpio.hpp"
+#include "core/Log.hpp"
 #endif
 
 namespace IotZoo
@@ -66,7 +67,7 @@ namespace IotZoo
 
     void RemoteGpio::handlePayload(const String& rawData)
     {
-        Serial.println("Remote GPIO RawData: " + rawData);
+        LOG_DEBUG(LogModuleActuators, "Remote GPIO RawData: " + rawData);
         String payload(rawData);
         payload.trim();
         payload.toUpperCase();
@@ -74,12 +75,12 @@ namespace IotZoo
         if (payload == "0" || payload == "LOW" || payload == "OFF")
         {
             digitalWrite(pinGpio, LOW);
-            Serial.println("digitalWrite Pin " + String(pinGpio) + " LOW");
+            LOG_DEBUG(LogModuleActuators, "digitalWrite Pin " + String(pinGpio) + " LOW");
         }
         else if (payload == "1" || payload == "HIGH" || payload == "ON")
         {
             digitalWrite(pinGpio, HIGH);
-            Serial.println("digitalWrite Pin " + String(pinGpio) + " HIGH");
+            LOG_DEBUG(LogModuleActuators, "digitalWrite Pin " + String(pinGpio) + " HIGH");
         }
         else if (payload.startsWith("TOGGLE"))
         {
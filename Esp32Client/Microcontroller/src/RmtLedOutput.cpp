@@ -0,0 +1,113 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Connect WS2812, WS2818 Leds with microcontrollers in a simple way.
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#ifdef USE_WS2818_RMT
+#include "RmtLedOutput.hpp"
+#include "core/Log.hpp"
+#include "core/Ws2812Encoder.hpp"
+
+namespace IotZoo
+{
+    // 80 MHz APB clock / 2 = 25 ns per tick.
+    static constexpr uint8_t      RmtClockDivider = 2;
+    static constexpr Ws2812Timing RmtTiming       = Ws2812Timing::fromTickNanos(25);
+
+    uint8_t RmtLedOutput::usedChannels = 0;
+
+    RmtLedOutput::RmtLedOutput(uint8_t pin, size_t byteCount) : pin(pin), byteCount(byteCount)
+    {
+        frameMicros = Ws2812Encoder::getFrameMicros(byteCount);
+    }
+
+    RmtLedOutput::~RmtLedOutput()
+    {
+        if (isStarted())
+        {
+            rmt_wait_tx_done(channel, pdMS_TO_TICKS(frameMicros / 1000 + 1)); // the driver reads the transmit buffer.
+            rmt_driver_uninstall(channel);
+            usedChannels &= ~(1 << channel);
+            channel = RMT_CHANNEL_MAX;
+        }
+        free(transmitBuffer);
+        transmitBuffer = nullptr;
+    }
+
+    bool RmtLedOutput::begin()
+    {
+        for (int candidate = 0; candidate < RMT_CHANNEL_MAX; candidate++)
+        {
+            if (0 == (usedChannels & (1 << candidate)))
+            {
+                channel = static_cast<rmt_channel_t>(candidate);
+                break;
+            }
+        }
+        if (!isStarted())
+        {
+            LOG_ERROR(LogModuleWs2818, "RmtLedOutput: no free RMT channel for pin " + String(pin));
+            return false;
+        }
+
+        transmitBuffer = static_cast<uint8_t*>(malloc(byteCount));
+        if (nullptr == transmitBuffer)
+        {
+            LOG_ERROR(LogModuleWs2818, "RmtLedOutput: out of memory");
+            channel = RMT_CHANNEL_MAX;
+            return false;
+        }
+
+        rmt_config_t config = RMT_DEFAULT_CONFIG_TX(static_cast<gpio_num_t>(pin), channel);
+        config.clk_div      = RmtClockDivider;
+        if (ESP_OK != rmt_config(&config) || ESP_OK != rmt_driver_install(channel, 0, 0) || ESP_OK != rmt_translator_init(channel, translate))
+        {
+            LOG_ERROR(LogModuleWs2818, "RmtLedOutput: unable to install the RMT driver for pin " + String(pin));
+            free(transmitBuffer);
+            transmitBuffer = nullptr;
+            channel        = RMT_CHANNEL_MAX;
+            return false;
+        }
+        usedChannels |= (1 << channel);
+        startMicros = micros() - frameMicros;
+        LOG_INFO(LogModuleWs2818, "RmtLedOutput: pin " + String(pin) + " uses RMT channel " + String(channel));
+        return true;
+    }
+
+    bool RmtLedOutput::isBusy() const
+    {
+        // The reset pulse is not part of the RMT items: wait for the whole frame time, not only for rmt_wait_tx_done.
+        return (micros() - startMicros) < frameMicros || ESP_OK != rmt_wait_tx_done(channel, 0);
+    }
+
+    bool RmtLedOutput::show(const uint8_t* pixels)
+    {
+        if (!isStarted() || isBusy())
+        {
+            return false;
+        }
+        memcpy(transmitBuffer, pixels, byteCount);
+        startMicros = micros();
+        return ESP_OK == rmt_write_sample(channel, transmitBuffer, byteCount, false);
+    }
+
+    void IRAM_ATTR RmtLedOutput::translate(const void* source, rmt_item32_t* items, size_t sourceSize, size_t wantedItems, size_t* translatedSize,
+                                           size_t* itemCount)
+    {
+        if (nullptr == source || nullptr == items)
+        {
+            *translatedSize = 0;
+            *itemCount      = 0;
+            return;
+        }
+        Ws2812Encoder::encode(RmtTiming, static_cast<const uint8_t*>(source), sourceSize, reinterpret_cast<uint32_t*>(items), wantedItems,
+                              *translatedSize, *itemCount);
+    }
+} // namespace IotZoo
+#endif // USE_WS2818_RMT
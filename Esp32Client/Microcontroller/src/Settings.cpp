@@ -16,6 +16,7 @@
 #ifndef __DEFINES_HPP__
 #include "Defines.hpp"
 #endif
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -23,16 +24,26 @@ namespace IotZoo
     {
         Serial.println("Constructor Settings");
 
-        if (!preferences.begin(NamespaceNameConfig)) // create namespace config if it does not exist yet.
+        if (!storage.begin(false)) // create namespace config if it does not exist yet.
         {
             Serial.println("Settings failure!");
         }
-        preferences.end();
+        storage.end();
+
+        // read all known keys within one begin()/end(), afterwards the reads are served from RAM.
+        cache.load({{"interval_alive", SettingsCache::ValueType::Long},
+                    {"alive_led", SettingsCache::ValueType::UShort},
+                    {"interval_temperature_sensors", SettingsCache::ValueType::Long},
+                    {"MqttBrokerIp", SettingsCache::ValueType::String},
+                    {"NamespaceName", SettingsCache::ValueType::String},
+                    {"ProjectName", SettingsCache::ValueType::String},
+                    {"devices", SettingsCache::ValueType::String}});
     }
 
     Settings::~Settings()
     {
         Serial.println("Destructor Settings");
+        flush();
     }
 
     void Settings::saveDeviceConfigurations(const String& json)
@@ -42,36 +53,20 @@ namespace IotZoo
 
     void Settings::saveConfigurationData(const String& key, const String& data)
     {
-        Serial.println("save configuration. key: " + key + ", NamespaceNameConfig: " + NamespaceNameConfig + ", data: " + data);
+        LOG_DEBUG(LogModuleSettings, "save configuration. key: " + key + ", NamespaceNameConfig: " + NamespaceNameConfig + ", data: " + data);
         if (key.length() == 0)
         {
             return;
         }
-        preferences.begin(NamespaceNameConfig, false);
-        int bytesWritten = preferences.putString(key.c_str(), data);
-        Serial.print("Bytes written: " + String(bytesWritten));
-        if (bytesWritten == data.length())
-        {
-            Serial.println(" (ok)");
-        }
-        preferences.end();
-        Serial.println("Check: " + loadConfiguration(key));
+        cache.putString(key.c_str(), toStdString(data), millis());
     }
 
     String Settings::loadConfiguration(const String& key)
     {
-        Serial.println("load configuration. key: " + key + ", NamespaceNameConfig: " + NamespaceNameConfig);
-
-        if (!preferences.begin(NamespaceNameConfig, true))
-        {
-            Serial.println("namespace not found in config");
-            return "";
-        }
+        LOG_DEBUG(LogModuleSettings, "load configuration. key: " + key + ", NamespaceNameConfig: " + NamespaceNameConfig);
 
-        String data = preferences.getString(key.c_str(), "");
-        Serial.println("Loaded data: " + data);
-
-        preferences.end();
+        String data = cache.getString(key.c_str(), "").c_str();
+        LOG_DEBUG(LogModuleSettings, "Loaded data: " + data);
         return data;
     }
 
@@ -83,91 +78,52 @@ namespace IotZoo
     // gets the interval for sending alive message via mqtt.
     long Settings::getAliveIntervalMillis()
     {
-        preferences.begin(NamespaceNameConfig, true);
-        long interval = preferences.getLong("interval_alive", 15000);
-        preferences.end();
-        return interval;
+        return cache.getLong("interval_alive", 15000);
     }
 
     void Settings::setAliveIntervalMillis(long interval)
     {
-        preferences.begin(NamespaceNameConfig, false);
-        preferences.putLong("interval_alive", interval);
-        preferences.end();
+        cache.putLong("interval_alive", interval, millis());
     }
 
     // 0 = off, 1 = on, 2 = turned on during the day 
     short Settings::getAliveAckLedMode()
     {
-        preferences.begin(NamespaceNameConfig, true);       
-        short isActive = preferences.getUShort("alive_led", 2); // default = turned on during the day (off at night)
-        preferences.end();
-        return isActive;
+        return cache.getUShort("alive_led", 2); // default = turned on during the day (off at night)
     }
 
     bool Settings::setAliveLedMode(short aliveLedMode)
     {
-        preferences.begin(NamespaceNameConfig, false);
-        bool ok = preferences.getUShort("alive_led", aliveLedMode) == aliveLedMode;
-        preferences.end();
-        return ok;
+        cache.putUShort("alive_led", aliveLedMode, millis());
+        return true;
     }
 
     bool Settings::storeData(const String& key, const String& data)
     {
-        try
-        {
-            Serial.println("storeData to '" + key + "' data: '" + data + "'");
-            int size = 0;
-            if (preferences.begin(NamespaceNameConfig, false))
-            {
-                size = preferences.putString(key.c_str(), data);
-                preferences.end();
-            }
-            return size == data.length();
-        }
-        catch (const std::exception& e)
-        {
-            Serial.println(e.what()); // Exception handling does only work with build_flags -DPIO_FRAMEWORK_ARDUINO_ENABLE_EXCEPTIONS
-            return false;
-        }
+        LOG_DEBUG(LogModuleSettings, "storeData to '" + key + "' data: '" + data + "'");
+        cache.putString(key.c_str(), toStdString(data), millis());
+        return true;
     }
 
     String Settings::getDataString(const String& key, const String& fallbackValue, bool printLog /*= true*/)
     {
         if (printLog)
         {
-            Serial.println("getData '" + key + "', fallback is '" + fallbackValue + "'");
+            LOG_DEBUG(LogModuleSettings, "getData '" + key + "', fallback is '" + fallbackValue + "'");
         }
 
-        String data;
-        try
+        String data = cache.getString(key.c_str(), "").c_str();
+        if (data.length() == 0 || data == "null")
         {
-            if (preferences.begin(NamespaceNameConfig, true))
-            {
-                data = preferences.getString(key.c_str(),
-                                             fallbackValue); // fallback
-            }
-            preferences.end();
-            if (data == "null")
+            if (printLog)
             {
-                Serial.println("Using fallback '" + fallbackValue + "'!");
-                return fallbackValue;
+                LOG_INFO(LogModuleSettings, "Using fallback '" + fallbackValue + "'!");
             }
-        }
-        catch (const std::exception& e)
-        {
-            Serial.println(e.what()); // Exception handling does only work with build_flags -DPIO_FRAMEWORK_ARDUINO_ENABLE_EXCEPTIONS
-            return fallbackValue;
-        }
-        if (data.length() == 0)
-        {
-            Serial.println("Using fallback '" + fallbackValue + "'!");
             return fallbackValue;
         }
         if (printLog)
         {
-            Serial.println(key + ": " + data);
+            LOG_DEBUG(LogModuleSettings, key + ": " + data);
         }
         return data;
     }
@@ -208,16 +164,35 @@ namespace IotZoo
 
     long Settings::getIntervalTemperatureSensorsMillis()
     {
-        preferences.begin(NamespaceNameConfig, true);
-        long interval = preferences.getLong("interval_temperature_sensors", 30000);
-        preferences.end();
-        return interval;
+        return cache.getLong("interval_temperature_sensors", 30000);
     }
 
     void Settings::setIntervalTemperatureSensorsMillis(long interval)
     {
-        preferences.begin(NamespaceNameConfig, false);
-        preferences.putLong("interval_temperature_sensors", interval);
-        preferences.end();
+        cache.putLong("interval_temperature_sensors", interval, millis());
+    }
+
+    size_t Settings::flush()
+    {
+        size_t written = cache.flush();
+        if (written > 0)
+        {
+            LOG_INFO(LogModuleSettings, "Settings: " + String(written) + " key(s) written to the flash.");
+        }
+        if (cache.getDirtyCount() > 0)
+        {
+            LOG_ERROR(LogModuleSettings, "Settings: writing to the flash failed! Errors: " + String(cache.getWriteErrors()));
+        }
+        return written;
+    }
+
+    size_t Settings::flushIfDue()
+    {
+        size_t written = cache.flushIfDue(millis());
+        if (written > 0)
+        {
+            LOG_INFO(LogModuleSettings, "Settings: " + String(written) + " key(s) written to the flash.");
+        }
+        return written;
     }
 } // namespace IotZoo
\ No newline at end of file
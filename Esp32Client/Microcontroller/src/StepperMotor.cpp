@@ -13,6 +13,7 @@
 
 #ifndef __STEPPER_MOTOR_HPP__
 #include "StepperMotor.hpp"
+#include "core/Log.hpp"
 #endif
 
 namespace IotZoo
@@ -24,7 +25,8 @@ namespace IotZoo
         Serial.println("Constructor StepperMotor");
         stepperControl = new StepperControl(StepperControl::DefaultStepCount, pin1, pin2, pin3, pin4);
         stepperControl->SetStepType(StepperControl::FullStep);
-        topicActionDone = getBaseTopic() + "/stepper/" + String(deviceIndex) + "/action_done";
+        topicActionDone    = getBaseTopic() + "/stepper/" + String(deviceIndex) + "/action_done";
+        loopIntervalMillis = 100;
     }
 
     StepperMotor::~StepperMotor()
@@ -48,7 +50,7 @@ namespace IotZoo
     // Example: "actions":[{"degrees": -300, "rpm": 10 }]
     void StepperMotor::onReceivedActionsForStepper(const String& json)
     {
-        Serial.println("*** onReceivedActionsForStepper: " + json);
+        LOG_DEBUG(LogModuleActuators, "*** onReceivedActionsForStepper: " + json);
         if (!json.startsWith("["))
         {
             publishError("wrong data");
@@ -111,7 +113,7 @@ namespace IotZoo
             batches = 1;
         }
 
-        Serial.println("Batches: " + String(batches));
+        LOG_DEBUG(LogModuleActuators, "Batches: " + String(batches));
 
         double degrees = stepperAction->getDegrees() / batches;
 
@@ -123,12 +125,12 @@ namespace IotZoo
 
         if (isForwardDirection)
         {
-            Serial.println("Forward");
+            LOG_DEBUG(LogModuleActuators, "Forward");
             action.Direction = StepperControl::Forward;
         }
         else
         {
-            Serial.println("Backward");
+            LOG_DEBUG(LogModuleActuators, "Backward");
             action.Direction = StepperControl::Backward;
         }
         degrees = std::abs(degrees);
@@ -140,9 +142,10 @@ namespace IotZoo
         action.EndDelay       = 0;
         action.DidEndCallback = &actionEnded;
 
-        Serial.println("processing action: degrees: " + String(degrees) + ", rpm: " + String(action.Rpm) + ", steps: " + String(action.Steps) +
-                       ", Direction: " + String(action.Direction) + ", Start delay ms: " + String(action.StartDelay) +
-                       ", CompletedBatches: " + String(completedBatches) + ", totalBatches: " + String(batches));
+        LOG_DEBUG(LogModuleActuators, "processing action: degrees: " + String(degrees) + ", rpm: " + String(action.Rpm) +
+                                          ", steps: " + String(action.Steps) + ", Direction: " + String(action.Direction) +
+                                          ", Start delay ms: " + String(action.StartDelay) + ", CompletedBatches: " + String(completedBatches) +
+                                          ", totalBatches: " + String(batches));
         stepperControl->AddStepperAction(action);
         stepperControl->StartAction();
 
@@ -150,7 +153,7 @@ namespace IotZoo
         completedBatches++;
         if (completedBatches >= batches)
         {
-            Serial.println("Batch done!");
+            LOG_DEBUG(LogModuleActuators, "Batch done!");
             stepperActions.erase(stepperActions.begin());
             mqttClient->publish(topicActionDone, String(stepperAction->getActionId()));
         }
@@ -11,6 +11,7 @@
 #include "Defines.hpp"
 #ifdef USE_SWITCH
 #include "Switch.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -20,6 +21,9 @@ namespace IotZoo
         this->pin = pin;
         Serial.println("Constructor Switch. Pin: " + String(pin));
         pinMode(pin, INPUT_PULLUP);
+        loopIntervalMillis = 10;
+        topicIdOn          = mqttClient->addTopic(getBaseTopic() + "/switch/" + String(deviceIndex) + "/on");
+        topicIdOff         = mqttClient->addTopic(getBaseTopic() + "/switch/" + String(deviceIndex) + "/off");
     }
 
     Switch::~Switch()
@@ -54,7 +58,7 @@ namespace IotZoo
         buttonStateHasChanged = oldIsButtonPressed != isButtonPressed;
         if (buttonStateHasChanged)
         {
-            Serial.println("State has changed. ButtonState at Pin " + String(pin) + " is now " + String(isButtonPressed));
+            LOG_DEBUG(LogModuleSensors, "State has changed. ButtonState at Pin " + String(pin) + " is now " + String(isButtonPressed));
         }
         return buttonStateHasChanged;
     }
@@ -63,18 +67,15 @@ namespace IotZoo
     {
         if (hasStateChanged())
         {
-            String topicButton = getBaseTopic() + "/switch/" + String(getDeviceIndex());
             if (isPressed())
             {
-                Serial.println("Switch at Pin + " + String(getPin()) + " changed state to on. Payload: millis on ESP32.");
-                topicButton += "/on";
-                mqttClient->publish(topicButton, String(millis()));
+                LOG_DEBUG(LogModuleSensors, "Switch at Pin + " + String(getPin()) + " changed state to on. Payload: millis on ESP32.");
+                mqttClient->publish(topicIdOn, String(millis()));
             }
             else
             {
-                Serial.println("Switch at Pin + " + String(getPin()) + " changed state to off. Payload: millis on ESP32.");
-                topicButton += "/off";
-                mqttClient->publish(topicButton, String(millis()));
+                LOG_DEBUG(LogModuleSensors, "Switch at Pin + " + String(getPin()) + " changed state to off. Payload: millis on ESP32.");
+                mqttClient->publish(topicIdOff, String(millis()));
             }
         }
     }
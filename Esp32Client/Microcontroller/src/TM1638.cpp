@@ -12,6 +12,7 @@
 #ifdef USE_LED_AND_KEY
 
 #include "TM1638.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -22,6 +23,7 @@ namespace IotZoo
         Serial.println("Constructor TM1638");
         tm1638plus = new TM1638plus(strobe, clock, data, highfreq);
         tm1638plus->displayBegin();
+        loopIntervalMillis = 20;
     }
 
     TM1638::~TM1638()
@@ -78,7 +80,7 @@ namespace IotZoo
         mqttClient->subscribe(topicLedAndKeyText,
                               [=](const String& text)
                               {
-                                  Serial.println("topicLedAndKeyText: " + text);
+                                  LOG_DEBUG(LogModuleDisplays, "topicLedAndKeyText: " + text);
                                   tm1638plus->reset();
                                   tm1638plus->displayText(text.c_str());
                               });
@@ -87,7 +89,7 @@ namespace IotZoo
         mqttClient->subscribe(topicLedAndKeyNumber,
                               [=](const String& payload)
                               {
-                                  Serial.println("topicLedAndKeyNumber: " + payload);
+                                  LOG_DEBUG(LogModuleDisplays, "topicLedAndKeyNumber: " + payload);
                                   tm1638plus->reset();
                                   tm1638plus->displayIntNum(atoi(payload.c_str()), false, AlignTextType_e::TMAlignTextRight);
                               });
@@ -12,6 +12,7 @@
 #ifdef USE_TRAFFIC_LIGHT_LEDS
 
 #include "TrafficLight.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -39,8 +40,8 @@ namespace IotZoo
 
     void TrafficLight::handleTrafficLightPayload(const String& payload)
     {
-        Serial.println("handleTrafficLightPayload: " + payload + " received. GPIO Red: " + String(pinRedLed) +
-                       ", GPIO Yellow: " + String(pinYellowLed) + ", GPIO Green: " + String(pinGreenLed));
+        LOG_DEBUG(LogModuleActuators, "handleTrafficLightPayload: " + payload + " received. GPIO Red: " + String(pinRedLed) +
+                                          ", GPIO Yellow: " + String(pinYellowLed) + ", GPIO Green: " + String(pinGreenLed));
         String payloadLowerCase = payload;
         payloadLowerCase.toLowerCase();
         if (payloadLowerCase == "g" || payloadLowerCase == "0" || payloadLowerCase == "green")
@@ -48,21 +49,21 @@ namespace IotZoo
             digitalWrite(pinRedLed, LOW);
             digitalWrite(pinYellowLed, LOW);
             digitalWrite(pinGreenLed, HIGH);
-            Serial.println("GREEN");
+            LOG_DEBUG(LogModuleActuators, "GREEN");
         }
         else if (payloadLowerCase == "y" || payloadLowerCase == "1" || payloadLowerCase == "yellow")
         {
             digitalWrite(pinRedLed, LOW);
             digitalWrite(pinYellowLed, HIGH);
             digitalWrite(pinGreenLed, LOW);
-            Serial.println("YELLOW");
+            LOG_DEBUG(LogModuleActuators, "YELLOW");
         }
         else if (payloadLowerCase == "r" || payloadLowerCase == "2" || payloadLowerCase == "red")
         {
             digitalWrite(pinRedLed, HIGH);   // RED LED
             digitalWrite(pinYellowLed, LOW); // YELLOW LED
             digitalWrite(pinGreenLed, LOW);  // GREEN LED
-            Serial.println("RED");
+            LOG_DEBUG(LogModuleActuators, "RED");
         }
     }
 
@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "Defines.hpp"
+#if defined(USE_GPS) || defined(USE_RD_03D)
+#include "UartReader.hpp"
+#include "core/Log.hpp"
+
+namespace IotZoo
+{
+    uint8_t UartReader::usedPorts = 1 << UART_NUM_0; // Serial
+
+    UartReader::UartReader(uint8_t pinRx, uint8_t pinTx, uint32_t baud) : pinRx(pinRx), pinTx(pinTx), baud(baud)
+    {
+    }
+
+    UartReader::~UartReader()
+    {
+        if (nullptr != taskHandle)
+        {
+            vTaskDelete(taskHandle);
+            taskHandle = nullptr;
+        }
+        if (isStarted())
+        {
+            uart_driver_delete(port);
+            usedPorts &= ~(1 << port);
+            port = UART_NUM_MAX;
+        }
+    }
+
+    bool UartReader::begin(DataCallback onData, void* context, const char* taskName, int pattern)
+    {
+        this->onData  = onData;
+        this->context = context;
+        this->pattern = pattern;
+
+        for (int candidate = 0; candidate < UART_NUM_MAX; candidate++)
+        {
+            if (0 == (usedPorts & (1 << candidate)))
+            {
+                port = static_cast<uart_port_t>(candidate);
+                break;
+            }
+        }
+        if (!isStarted())
+        {
+            LOG_ERROR(LogModuleSensors, "UartReader: no free UART for " + String(taskName));
+            return false;
+        }
+
+        uart_config_t config = {};
+        config.baud_rate     = static_cast<int>(baud);
+        config.data_bits     = UART_DATA_8_BITS;
+        config.parity        = UART_PARITY_DISABLE;
+        config.stop_bits     = UART_STOP_BITS_1;
+        config.flow_ctrl     = UART_HW_FLOWCTRL_DISABLE;
+        config.source_clk    = UART_SCLK_APB;
+
+        if (ESP_OK != uart_driver_install(port, UART_READER_RX_BUFFER_SIZE, 0, UART_READER_EVENT_QUEUE_SIZE, &eventQueue, 0) ||
+            ESP_OK != uart_param_config(port, &config) || ESP_OK != uart_set_pin(port, pinTx, pinRx, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE))
+        {
+            LOG_ERROR(LogModuleSensors, "UartReader: unable to install the UART driver for " + String(taskName));
+            uart_driver_delete(port);
+            port = UART_NUM_MAX;
+            return false;
+        }
+        usedPorts |= 1 << port;
+
+        // Without a pattern the driver posts an event when the FIFO is full or after an idle gap.
+        uart_set_rx_timeout(port, UART_READER_RX_TIMEOUT_SYMBOLS);
+        if (NoPattern != pattern)
+        {
+            uart_enable_pattern_det_baud_intr(port, static_cast<char>(pattern), 1, 9, 0, 0);
+            uart_pattern_queue_reset(port, UART_READER_EVENT_QUEUE_SIZE);
+        }
+
+        if (pdPASS != xTaskCreatePinnedToCore(decoderTask, taskName, 3072, this, UART_READER_TASK_PRIORITY, &taskHandle, UART_READER_TASK_CORE))
+        {
+            LOG_ERROR(LogModuleSensors, "UartReader: unable to create the task " + String(taskName));
+            taskHandle = nullptr;
+            return false;
+        }
+        LOG_INFO(LogModuleSensors, "UartReader: " + String(taskName) + " on UART " + String(port) + ", pinRx: " + String(pinRx) +
+                                       ", pinTx: " + String(pinTx) + ", baud: " + String(baud));
+        return true;
+    }
+
+    int UartReader::write(const uint8_t* data, size_t length)
+    {
+        if (!isStarted())
+        {
+            return 0;
+        }
+        return uart_write_bytes(port, reinterpret_cast<const char*>(data), length);
+    }
+
+    void UartReader::decoderTask(void* parameter)
+    {
+        static_cast<UartReader*>(parameter)->decode();
+    }
+
+    void UartReader::decode()
+    {
+        uart_event_t event;
+        while (true)
+        {
+            if (pdTRUE != xQueueReceive(eventQueue, &event, portMAX_DELAY))
+            {
+                continue;
+            }
+            switch (event.type)
+            {
+                case UART_DATA:
+                    readAll();
+                    break;
+                case UART_PATTERN_DET:
+                    readAll();
+                    // The positions are not needed, the decoder finds the end of the frame itself.
+                    while (uart_pattern_pop_pos(port) >= 0)
+                    {
+                    }
+                    break;
+                case UART_FIFO_OVF:
+                case UART_BUFFER_FULL:
+                    // The decoder resyncs on the next frame.
+                    overflows = overflows + 1;
+                    uart_flush_input(port);
+                    xQueueReset(eventQueue);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void UartReader::readAll()
+    {
+        size_t length = 0;
+        while (ESP_OK == uart_get_buffered_data_len(port, &length) && length > 0)
+        {
+            int count = uart_read_bytes(port, buffer, length < sizeof(buffer) ? length : sizeof(buffer), 0);
+            if (count <= 0)
+            {
+                break;
+            }
+            onData(context, buffer, static_cast<size_t>(count));
+        }
+    }
+} // namespace IotZoo
+
+#endif // defined(USE_GPS) || defined(USE_RD_03D)
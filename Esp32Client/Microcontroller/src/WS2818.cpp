@@ -13,6 +13,8 @@
 #include "Defines.hpp"
 #ifdef USE_WS2818
 #include "WS2818.hpp"
+#include "core/Log.hpp"
+#include "core/PixelJsonParser.hpp"
 
 namespace IotZoo
 {
@@ -23,13 +25,18 @@ namespace IotZoo
         deviceName         = "neo";
         dioPin             = pin;
         this->numberOfLeds = numberOfLeds;
-        pixels             = new Adafruit_NeoPixel(numberOfLeds, dioPin, (NEO_GRB + NEO_KHZ800));
+        pixels             = new Adafruit_NeoPixel(numberOfLeds, dioPin, pixelType);
+        loopIntervalMillis = 1000 / LedEffect::MaxFramesPerSecond; // the frame rate of the effects.
         setup();
     }
 
     WS2818::~WS2818()
     {
         Serial.println("Destructor WS2818");
+#ifdef USE_WS2818_RMT
+        delete rmtOutput;
+        rmtOutput = nullptr;
+#endif
         delete pixels;
         pixels = nullptr;
     }
@@ -38,38 +45,56 @@ namespace IotZoo
     {
         Serial.println("WS2818 setup. DIN Pin is " + String(dioPin));
 
-        pixelProperties.resize(this->numberOfLeds);
-        for (int index = 0; index < this->numberOfLeds; index++)
-        {
-            pixelProperties[index].PixelId            = index;
-            pixelProperties[index].MillisUntilTurnOff = 0;
-        }
+        turnOffTimers.resize(this->numberOfLeds);
 
         pixels->begin();
         pixels->clear();
+#ifdef USE_WS2818_RMT
+        delete rmtOutput;
+        rmtOutput = new RmtLedOutput(dioPin, numberOfLeds * getPixelBuffer().bytesPerPixel);
+        if (!rmtOutput->begin())
+        {
+            delete rmtOutput;
+            rmtOutput = nullptr;
+        }
+#endif
+        dirty = true; // turn off what the LEDs show since the power on.
         Serial.println("WS2818 setup done.");
     }
 
     void WS2818::loop()
     {
-        // Reset pixel color
-        for (auto& pixelProperty : pixelProperties)
+        // Turn off the expired pixels. Only the expired pixels are touched.
+        uint32_t now = millis();
+        int32_t  index;
+        while ((index = turnOffTimers.popExpired(now)) != ExpiryHeap::NoId)
         {
-            // Serial.println("index:" + String(pixelProperty.PixelId) + ", MillisUntilTurnOff: " +
-            //                String(pixelProperties[pixelProperty.PixelId].MillisUntilTurnOff) + ", CurrentMillis: " + String(millis()));
+            pixels->setPixelColor(index, 0);
+            dirty = true;
+        }
+        if (effect.loop(getPixelBuffer(), now))
+        {
+            dirty = true;
+        }
+        showIfDirty();
+    }
 
-            if (pixelProperty.MillisUntilTurnOff == 0)
-            {
-                continue;
-            }
-            if (millis() > pixelProperty.MillisUntilTurnOff)
-            {
-                // turn the pixel off.
-                pixels->setPixelColor(pixelProperty.PixelId, 0);
-                pixelProperties[pixelProperty.PixelId].MillisUntilTurnOff = 0;
-            }
+    void WS2818::showIfDirty()
+    {
+        if (!dirty)
+        {
+            return;
+        }
+#ifdef USE_WS2818_RMT
+        if (nullptr != rmtOutput)
+        {
+            // The brightness is already applied to the buffer of the Adafruit_NeoPixel.
+            dirty = !rmtOutput->show(pixels->getPixels());
+            return;
         }
+#endif
         pixels->show();
+        dirty = false;
     }
 
     // @brief Example: iotzoo/esp32/08:D1:F9:E0:31:78/neo/0/setPixelColor
@@ -102,124 +127,115 @@ namespace IotZoo
     {
         try
         {
-            Serial.println("setPixelColor rawData: " + String(json)); // {"brightness":10,"color":"#FFFF00","pixels":[{"color":"#10E084","index":0,"length":10,"brightness":10,"millisUntilTurnOff":2000},{"color":"#FFFFFF","index":30,"length":8,"millisUntilTurnOff":1000},{"index":50,"length":8,"millisUntilTurnOff":3000}]}
-            String colorHexGlobal;
+            LOG_VERBOSE(LogModuleWs2818, "setPixelColor rawData: " + json); // {"brightness":10,"color":"#FFFF00","pixels":[{"color":"#10E084","index":0,"length":10,"brightness":10,"millisUntilTurnOff":2000},{"color":"#FFFFFF","index":30,"length":8,"millisUntilTurnOff":1000},{"index":50,"length":8,"millisUntilTurnOff":3000}]}
+
+            effect.stop();
+            // Streaming: every range is applied while it is read, so the message size is not limited by a JSON document.
+            PixelJsonParser::Error error = PixelJsonParser::parse(json.c_str(), json.length(),
+                                                                  [this](const PixelRange& range)
+                                                                  {
+                                                                      LOG_VERBOSE(LogModuleWs2818, "setPixelColor color: " + String(range.color) +
+                                                                                                       ", startIndex: " + String(range.startIndex) +
+                                                                                                       ", length: " + String(range.length));
+                                                                      if (range.startIndex >= numberOfLeds)
+                                                                      {
+                                                                          return;
+                                                                      }
+                                                                      // Clipped to the strip, "index":65535 must not run the loop up to the limit of the type.
+                                                                      uint16_t length = std::min<uint32_t>(range.length, numberOfLeds - range.startIndex);
+                                                                      setPixelColor(range.color, range.startIndex, length, range.brightness,
+                                                                                    range.millisUntilTurnOff);
+                                                                  });
+            if (PixelJsonParser::Error::None != error)
+            {
+                publishError("setPixelColor: " + String(PixelJsonParser::getErrorText(error)));
+            }
+            showIfDirty();
+        }
+        catch (const std::exception& e)
+        {
+            publishError(e.what());
+        }
+    }
 
-            u_int16_t startIndex;
-            u_int16_t length                   = 1;
-            u_int8_t  brightness               = 2; // 0 means off
-            u32_t     millisUntilTurnOffGlobal = 0;
+    PixelBuffer WS2818::getPixelBuffer() const
+    {
+        PixelBuffer buffer;
+        buffer.data    = pixels->getPixels();
+        buffer.columns = numberOfLeds;
+        buffer.rows    = 1;
+        // Byte order as encoded by Adafruit_NeoPixel, e.g. NEO_GRB.
+        uint8_t whiteOffset  = (pixelType >> 6) & 0b11;
+        buffer.redOffset     = (pixelType >> 4) & 0b11;
+        buffer.greenOffset   = (pixelType >> 2) & 0b11;
+        buffer.blueOffset    = pixelType & 0b11;
+        buffer.bytesPerPixel = (whiteOffset == buffer.redOffset) ? 3 : 4;
+        // getBrightness() is brightness - 1: 255 means unscaled.
+        buffer.brightnessScale = static_cast<uint16_t>(pixels->getBrightness()) + 1;
+        return buffer;
+    }
 
-            StaticJsonDocument<4096> jsonDocument;
-            if (!deserializeStaticJsonAndPublishError(jsonDocument, json))
+    void WS2818::setFrame(const uint8_t* frame, size_t length)
+    {
+        PixelFrameHeader  header;
+        PixelFrame::Error error = PixelFrame::readHeader(frame, length, header);
+        if (PixelFrame::Error::None == error && header.brightness != 0 && pixels->getBrightness() != header.brightness)
+        {
+            pixels->setBrightness(header.brightness); // affects all pixels!!!
+        }
+
+        PixelBuffer buffer = getPixelBuffer();
+        if (PixelFrame::Error::None == error)
+        {
+            error = PixelFrame::apply(frame, length, buffer, header);
+        }
+        if (PixelFrame::Error::None != error)
+        {
+            publishError("setFrame: " + String(PixelFrame::getErrorText(error)) + " (" + String(length) + " bytes)");
+            return;
+        }
+
+        effect.stop();
+        // The frame pixels stay on.
+        for (uint16_t y = header.y; y < header.y + header.height; y++)
+        {
+            for (uint16_t x = header.x; x < header.x + header.width; x++)
             {
-                return;
+                turnOffTimers.cancel(PixelFrame::getLedIndex(buffer, x, y));
             }
+        }
 
-            JsonArray elements = jsonDocument["pixels"];
-            if (nullptr == elements)
+        dirty = true;
+        if (0 == (header.flags & PixelFrame::FlagDoNotShow))
+        {
+            showIfDirty(); // otherwise with the last part of the frame, at the latest in loop().
+        }
+    }
+
+    void WS2818::setPixelsByPreset(const String& presetName)
+    {
+        try
+        {
+            LOG_DEBUG(LogModuleWs2818, "setPixelsByPreset(presetName: " + presetName + ")");
+            if (nullptr == settings)
             {
-                publishError("\"pixels\":[] missing");
+                LOG_ERROR(LogModuleWs2818, "settings is null!");
                 return;
             }
+            String json = settings->loadConfiguration(presetName);
 
-            bool useGlobalRgb = jsonDocument["r"] != nullptr && jsonDocument["g"] != nullptr && jsonDocument["b"] != nullptr;
-
-            auto brightnessProperty = jsonDocument["brightness"];
-            if (nullptr != brightnessProperty)
+            if (json.indexOf("\"effect\"") >= 0)
             {
-                brightness = brightnessProperty.as<u_int8_t>();
-                if (brightness > 0 and brightness < 2)
-                {
-                    brightness = 2;
-                }
+                setEffect(json);
             }
-            if (useGlobalRgb && jsonDocument["color"] == nullptr)
+            else if (json.length())
             {
-                u8_t r         = jsonDocument["r"].as<u8_t>();
-                u8_t g         = jsonDocument["g"].as<u8_t>();
-                u8_t b         = jsonDocument["b"].as<u8_t>();
-                colorHexGlobal = pixels->Color(r, g, b);
-                Serial.print("using global rgb");
+                setPixelColor(json);
             }
             else
             {
-                colorHexGlobal = jsonDocument["color"].as<String>();
-            }
-            if (colorHexGlobal.startsWith("#"))
-            {
-                colorHexGlobal = colorHexGlobal.substring(1);
-            }
-
-            auto millisUntilTurnOffPropertyGlobal = jsonDocument["millisUntilTurnOff"];
-            if (millisUntilTurnOffPropertyGlobal != nullptr)
-            {
-                millisUntilTurnOffGlobal = millisUntilTurnOffPropertyGlobal.as<uint64_t>();
-            }
-            for (JsonVariant pixel : elements)
-            {
-                Serial.print("New pixel ");
-                String colorHex;
-                auto   colorProperty = pixel["color"];
-
-                bool useRgb = pixel["r"] != nullptr && pixel["g"] != nullptr && pixel["b"] != nullptr;
-
-                if (!useRgb)
-                {
-                    if (nullptr != colorProperty)
-                    {
-                        colorHex = pixel["color"].as<String>();
-                        if (colorHex.startsWith("#"))
-                        {
-                            colorHex = colorHex.substring(1);
-                        }
-                    }
-                    else
-                    {
-                        colorHex = colorHexGlobal;
-                    }
-                }
-                else
-                {
-                    u8_t r   = pixel["r"].as<u8_t>();
-                    u8_t g   = pixel["g"].as<u8_t>();
-                    u8_t b   = pixel["b"].as<u8_t>();
-                    colorHex = pixels->Color(r, g, b);
-                    Serial.print(", r: " + String(r));
-                    Serial.print(", g: " + String(g));
-                    Serial.print(", b: " + String(b));
-                }
-
-                startIndex = pixel["index"].as<u_int16_t>();
-
-                length = pixel["length"].as<u_int16_t>();
-                if (length < 1)
-                {
-                    length = 1;
-                }
-
-                auto     millisUntilTurnOffProperty = pixel["millisUntilTurnOff"];
-                uint64_t millisUntilTurnOff         = 0;
-                if (millisUntilTurnOffProperty != nullptr)
-                {
-                    millisUntilTurnOff = millisUntilTurnOffProperty.as<uint64_t>();
-                }
-                else
-                {
-                    millisUntilTurnOff = millisUntilTurnOffPropertyGlobal;
-                }
-
-                u_int32_t color = stoi(colorHex.c_str(), 0, 16);
-
-                Serial.println("setPixelColor colorHex: " + String(colorHex) + ", color: " + String(color) + ", startIndex: " + String(startIndex) +
-                               ", brightness: " + brightness + ", length: " + String(length) + ", MillisUntilTurnOff: " + String(millisUntilTurnOff));
-
-                for (u_int16_t index = startIndex; index < startIndex + length; index++)
-                {
-                    setPixelColor(color, index, brightness, millisUntilTurnOff);
-                }
+                publishError("no data for preset " + presetName + " found!");
             }
-            pixels->show();
         }
         catch (const std::exception& e)
         {
@@ -227,26 +243,66 @@ namespace IotZoo
         }
     }
 
-    void WS2818::setPixelsByPreset(const String& presetName)
+    void WS2818::setEffect(const String& json)
     {
         try
         {
-            Serial.println("setPixelsByPreset(presetName: " + presetName + ")");
-            if (nullptr == settings)
+            LOG_DEBUG(LogModuleWs2818, "setEffect: " + json);
+            StaticJsonDocument<512> jsonDocument;
+            if (!deserializeStaticJsonAndPublishError(jsonDocument, json))
             {
-                Serial.println("settings is null!");
                 return;
             }
-            String json = settings->loadConfiguration(presetName);
 
-            if (json.length())
+            LedEffectParameters parameters;
+            parameters.type = LedEffect::parseType(jsonDocument["effect"] | "none");
+            if (LedEffectType::None == parameters.type)
             {
-                setPixelColor(json);
+                effect.stop(); // e.g. "none"
+                return;
             }
-            else
+
+            const char* colorNames[] = {"color", "color2"};
+            uint32_t*   colors[]     = {&parameters.color, &parameters.color2};
+            for (int i = 0; i < 2; i++)
             {
-                publishError("no data for preset " + presetName + " found!");
+                const char* color = jsonDocument[colorNames[i]];
+                if (nullptr != color && !PixelJsonParser::parseColor(color, strlen(color), *colors[i]))
+                {
+                    publishError("setEffect: invalid " + String(colorNames[i]) + " " + String(color));
+                    return;
+                }
             }
+            parameters.periodMillis    = jsonDocument["periodMillis"] | parameters.periodMillis;
+            // Read wide and clamped: stored into the narrow fields, "fps":300 would become 44.
+            parameters.startIndex      = std::min<uint32_t>(jsonDocument["index"] | uint32_t(parameters.startIndex), UINT16_MAX);
+            parameters.count           = std::min<uint32_t>(jsonDocument["count"] | uint32_t(parameters.count), UINT16_MAX);
+            parameters.length          = std::min<uint32_t>(jsonDocument["length"] | uint32_t(parameters.length), UINT16_MAX);
+            parameters.framesPerSecond = LedEffect::clampFramesPerSecond(jsonDocument["fps"] | uint32_t(parameters.framesPerSecond));
+            const char* sprite         = jsonDocument["sprite"];
+            if (nullptr != sprite && !LedEffect::parseSprite(sprite, parameters))
+            {
+                publishError("setEffect: invalid sprite (hex, max. " + String(LedEffectParameters::MaxSpriteColumns) + " columns)");
+                return;
+            }
+
+            uint8_t brightness = jsonDocument["brightness"] | 0;
+            if (brightness != 0 && pixels->getBrightness() != brightness)
+            {
+                pixels->setBrightness(brightness); // affects all pixels!!!
+            }
+
+            // The effect owns its pixels, pending turn off timers would cut holes into it.
+            uint32_t endIndex = (LedEffectType::Scroll == parameters.type || 0 == parameters.count)
+                                    ? numberOfLeds
+                                    : std::min<uint32_t>(numberOfLeds, parameters.startIndex + parameters.count);
+            for (uint32_t index = (LedEffectType::Scroll == parameters.type) ? 0 : parameters.startIndex; index < endIndex; index++)
+            {
+                turnOffTimers.cancel(index);
+            }
+
+            effect.start(parameters, millis());
+            LOG_INFO(LogModuleWs2818, "effect " + String(LedEffect::getTypeName(parameters.type)) + " started");
         }
         catch (const std::exception& e)
         {
@@ -287,6 +343,14 @@ namespace IotZoo
 
         topics->emplace_back(getBaseTopic() + "/" + deviceName + "/0/setPixelColor", jsonExampleColorHex, MessageDirection::IotZooClientOutbound);
         topics->emplace_back(getBaseTopic() + "/" + deviceName + "/0/setPixelsByPreset", "Smiley", MessageDirection::IotZooClientOutbound);
+        topics->emplace_back(getBaseTopic() + "/" + deviceName + "/0/setFrame",
+                             "binary: 12 byte header (format 0 = RGB888, 1 = RGB565, 2 = palette, flags, brightness, 0, x, y, width, height as "
+                             "uint16 little endian), then the pixels row by row",
+                             MessageDirection::IotZooClientOutbound);
+        topics->emplace_back(getBaseTopic() + "/" + deviceName + "/0/setEffect",
+                             R"({"effect":"chase","color":"#FF0000","color2":"#000010","periodMillis":2000,"index":0,"count":30,"length":5,"fps":30} )"
+                             "effects: fade, chase, rainbow, breathe, blink, scroll (pixel matrix, \"sprite\":\"3C4281A5A581423C\"), none",
+                             MessageDirection::IotZooClientOutbound);
     }
 
     /// @brief The MQTT connection is established. Now subscribe to the topics. An existing MQTT connection is a prerequisite
@@ -309,6 +373,14 @@ namespace IotZoo
         topic = getBaseTopic() + "/" + deviceName + "/" + String(deviceIndex) + "/setPixelsByPreset";
         mqttClient->subscribe(topic, [&](const String& presetName) { setPixelsByPreset(presetName); });
         Serial.println("LED strip subscribed to topic " + topic);
+
+        topic = getBaseTopic() + "/" + deviceName + "/" + String(deviceIndex) + "/setFrame";
+        mqttClient->subscribeBinary(topic, [&](const uint8_t* frame, size_t length) { setFrame(frame, length); });
+        Serial.println("LED strip subscribed to topic " + topic);
+
+        topic = getBaseTopic() + "/" + deviceName + "/" + String(deviceIndex) + "/setEffect";
+        mqttClient->subscribe(topic, [&](const String& json) { setEffect(json); });
+        Serial.println("LED strip subscribed to topic " + topic);
     }
 
     void WS2818::setPixelColorRgb(uint8_t r, uint8_t g, uint8_t b, uint16_t index, uint8_t brightness /* = 20*/, uint64_t millisUntilTurnOff /* = 0*/)
@@ -319,7 +391,9 @@ namespace IotZoo
     void WS2818::setPixelColorRgb(uint8_t r, uint8_t g, uint8_t b, uint16_t startIndex, uint16_t length, uint8_t brightness,
                                   uint64_t millisUntilTurnOff)
     {
-        for (uint16_t index = startIndex; index < startIndex + length; index++)
+        // uint32_t: startIndex + length may exceed the range of uint16_t.
+        uint32_t endIndex = std::min<uint32_t>(numberOfLeds, static_cast<uint32_t>(startIndex) + length);
+        for (uint32_t index = startIndex; index < endIndex; index++)
         {
             setPixelColor(pixels->Color(r, g, b), index, brightness, millisUntilTurnOff);
         }
@@ -327,11 +401,11 @@ namespace IotZoo
 
     void WS2818::setPixelColor(uint32_t color, uint16_t index, uint8_t brightness /* = 20*/, uint64_t millisUntilTurnOff /* = 0*/)
     {
-        Serial.println("setPixelColor(color:" + String(color) + ", index: " + String(index) + ", brightness: " + String(brightness) +
-                       ", millisUntilTurnOff: " + String(millisUntilTurnOff) + ")");
-        if (index > this->numberOfLeds)
+        LOG_VERBOSE(LogModuleWs2818, "setPixelColor(color:" + String(color) + ", index: " + String(index) + ", brightness: " + String(brightness) +
+                                         ", millisUntilTurnOff: " + String(millisUntilTurnOff) + ")");
+        if (index >= this->numberOfLeds)
         {
-            Serial.println("index out of range");
+            LOG_WARNING(LogModuleWs2818, "index out of range");
             return;
         }
         if (brightness != 0 && pixels->getBrightness() != brightness)
@@ -340,20 +414,25 @@ namespace IotZoo
         }
 
         pixels->setPixelColor(index, color);
+        dirty = true;
 
         if (millisUntilTurnOff > 0)
         {
-            pixelProperties[index].MillisUntilTurnOff = millisUntilTurnOff + millis();
+            // Wrap safe deadline, at most 24 days ahead.
+            uint32_t timeout = millisUntilTurnOff > INT32_MAX ? INT32_MAX : static_cast<uint32_t>(millisUntilTurnOff);
+            turnOffTimers.schedule(index, millis() + timeout);
         }
         else
         {
-            pixelProperties[index].MillisUntilTurnOff = 0;
+            turnOffTimers.cancel(index);
         }
     }
 
     void WS2818::setPixelColor(uint32_t color, uint16_t startIndex, uint16_t length, uint8_t brightness, uint64_t millisUntilTurnOff)
     {
-        for (uint16_t index = startIndex; index < startIndex + length; index++)
+        // uint32_t: startIndex + length may exceed the range of uint16_t.
+        uint32_t endIndex = std::min<uint32_t>(numberOfLeds, static_cast<uint32_t>(startIndex) + length);
+        for (uint32_t index = startIndex; index < endIndex; index++)
         {
             setPixelColor(color, index, brightness, millisUntilTurnOff);
         }
@@ -0,0 +1,98 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/AdcDemultiplexer.hpp"
+
+namespace IotZoo
+{
+    bool AdcDemultiplexer::addChannel(uint8_t channel, uint8_t oversamplingBits, uint16_t decimation)
+    {
+        if (channel >= ChannelSlots || hasChannel(channel) || channelCount >= MaxChannels || oversamplingBits > MaxOversamplingBits ||
+            0 == decimation || decimation > MaxDecimation)
+        {
+            return false;
+        }
+        Channel& entry         = channels[channelCount];
+        entry.adcChannel       = channel;
+        entry.oversamplingBits = oversamplingBits;
+        entry.decimation       = decimation;
+        entry.samplesPerOutput = static_cast<uint32_t>(decimation) << (2 * oversamplingBits);
+        slots[channel]         = static_cast<int8_t>(channelCount++);
+        return true;
+    }
+
+    void AdcDemultiplexer::write(const uint8_t* data, size_t length)
+    {
+        for (size_t i = 0; i + 1 < length; i += 2)
+        {
+            uint16_t record = static_cast<uint16_t>(data[i] | (data[i + 1] << 8));
+            writeSample(static_cast<uint8_t>(record >> RawBits), record & 0x0FFF);
+        }
+    }
+
+    void AdcDemultiplexer::writeSample(uint8_t channel, uint16_t raw)
+    {
+        if (!hasChannel(channel))
+        {
+            unknownRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Channel& entry = channels[slots[channel]];
+        entry.sum += raw;
+        if (++entry.sampleCount < entry.samplesPerOutput)
+        {
+            return;
+        }
+        uint16_t value = static_cast<uint16_t>((entry.sum >> entry.oversamplingBits) / entry.decimation);
+        entry.queue.push(&value, 1);
+        entry.sum         = 0;
+        entry.sampleCount = 0;
+    }
+
+    size_t AdcDemultiplexer::read(uint8_t channel, uint16_t* values, size_t count)
+    {
+        if (!hasChannel(channel))
+        {
+            return 0;
+        }
+        return channels[slots[channel]].queue.pop(values, count);
+    }
+
+    bool AdcDemultiplexer::readLatest(uint8_t channel, uint16_t& value)
+    {
+        uint16_t values[8];
+        bool     found = false;
+        size_t   count;
+        while ((count = read(channel, values, 8)) > 0)
+        {
+            value = values[count - 1];
+            found = true;
+        }
+        return found;
+    }
+
+    uint32_t AdcDemultiplexer::getFullScale(uint8_t channel) const
+    {
+        if (!hasChannel(channel))
+        {
+            return 0;
+        }
+        return 0x0FFFu << channels[slots[channel]].oversamplingBits;
+    }
+
+    uint32_t AdcDemultiplexer::getOverruns(uint8_t channel) const
+    {
+        if (!hasChannel(channel))
+        {
+            return 0;
+        }
+        return channels[slots[channel]].queue.getOverruns();
+    }
+} // namespace IotZoo
@@ -0,0 +1,106 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/AlarmZoneMap.hpp"
+
+namespace IotZoo
+{
+    namespace
+    {
+        /// @brief Index of the lowest set bit, -1 if none.
+        int lowestBit(uint64_t bits)
+        {
+            if (0 == bits)
+            {
+                return -1;
+            }
+            return __builtin_ctzll(bits);
+        }
+    } // namespace
+
+    void AlarmZoneMap::clear()
+    {
+        levelKeywords.clear();
+        levelColors.clear();
+        zoneNames.clear();
+        runs.clear();
+        zoneFirstRun.clear();
+        matcher.clear();
+    }
+
+    bool AlarmZoneMap::addLevel(const char* keyword, uint32_t color)
+    {
+        if (nullptr == keyword || 0 == *keyword || levelKeywords.size() >= MaxLevels)
+        {
+            return false;
+        }
+        levelKeywords.emplace_back(keyword);
+        levelColors.push_back(color);
+        return true;
+    }
+
+    bool AlarmZoneMap::addZone(const char* name)
+    {
+        if (nullptr == name || 0 == *name || zoneNames.size() >= MaxZones)
+        {
+            return false;
+        }
+        zoneNames.emplace_back(name);
+        zoneFirstRun.push_back(static_cast<uint16_t>(runs.size()));
+        return true;
+    }
+
+    bool AlarmZoneMap::addRun(uint16_t startIndex, uint16_t length)
+    {
+        if (zoneNames.empty() || 0 == length)
+        {
+            return false;
+        }
+        runs.push_back({startIndex, length});
+        return true;
+    }
+
+    void AlarmZoneMap::build()
+    {
+        matcher.clear();
+        for (const auto& keyword : levelKeywords)
+        {
+            matcher.add(keyword.c_str());
+        }
+        for (const auto& name : zoneNames)
+        {
+            matcher.add(name.c_str());
+        }
+        matcher.build();
+    }
+
+    bool AlarmZoneMap::lookup(const char* subject, size_t length, Alarm& alarm) const
+    {
+        uint64_t found     = matcher.match(subject, length);
+        uint64_t levelMask = (1ull << levelKeywords.size()) - 1;
+
+        alarm       = Alarm();
+        alarm.level = lowestBit(found & levelMask);
+        if (alarm.level < 0)
+        {
+            return false;
+        }
+        alarm.color = levelColors[alarm.level];
+        alarm.zone  = lowestBit(found >> levelKeywords.size());
+        if (alarm.zone >= 0)
+        {
+            size_t firstRun = zoneFirstRun[alarm.zone];
+            size_t endRun   = static_cast<size_t>(alarm.zone) + 1 < zoneFirstRun.size() ? zoneFirstRun[alarm.zone + 1] : runs.size();
+            alarm.runs      = runs.data() + firstRun;
+            alarm.runCount  = endRun - firstRun;
+        }
+        return true;
+    }
+} // namespace IotZoo
@@ -0,0 +1,56 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/AudioLevel.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace IotZoo
+{
+    void RmsAccumulator::add(const int16_t* samples, size_t count)
+    {
+        // integer arithmetic, the ESP32 has no double precision FPU.
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            int32_t sample = samples[i];
+            sum += static_cast<uint32_t>(sample * sample);
+        }
+        sumOfSquares += sum;
+        sampleCount += count;
+    }
+
+    double RmsAccumulator::getRms() const
+    {
+        if (sampleCount == 0)
+        {
+            return 0.0;
+        }
+        return std::sqrt(static_cast<double>(sumOfSquares) / sampleCount);
+    }
+
+    double calculateRms(const int16_t* samples, size_t count)
+    {
+        RmsAccumulator accumulator;
+        accumulator.add(samples, count);
+        return accumulator.getRms();
+    }
+
+    double rmsToDecibel(double rms, double fullScale)
+    {
+        if (rms <= 0.0)
+        {
+            return -std::numeric_limits<double>::infinity();
+        }
+
+        return 20.0 * std::log10(rms / fullScale);
+    }
+} // namespace IotZoo
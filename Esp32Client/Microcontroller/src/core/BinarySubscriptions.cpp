@@ -0,0 +1,66 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/BinarySubscriptions.hpp"
+#include "core/Fnv1a.hpp"
+
+namespace IotZoo
+{
+    bool BinarySubscriptions::add(const char* topic, const Handler& handler)
+    {
+        if ('\0' == topic[0])
+        {
+            return false;
+        }
+        int32_t index = find(topic);
+        if (index >= 0)
+        {
+            entries[index].handler = handler;
+            return true;
+        }
+        entries.push_back({fnv1a(topic), topic, handler});
+        return true;
+    }
+
+    bool BinarySubscriptions::remove(const char* topic)
+    {
+        int32_t index = find(topic);
+        if (index < 0)
+        {
+            return false;
+        }
+        entries.erase(entries.begin() + index);
+        return true;
+    }
+
+    bool BinarySubscriptions::dispatch(const char* topic, const uint8_t* payload, size_t length) const
+    {
+        int32_t index = find(topic);
+        if (index < 0)
+        {
+            return false;
+        }
+        entries[index].handler(payload, length);
+        return true;
+    }
+
+    int32_t BinarySubscriptions::find(const char* topic) const
+    {
+        uint32_t hash = fnv1a(topic);
+        for (size_t index = 0; index < entries.size(); index++)
+        {
+            if (entries[index].hash == hash && entries[index].topic == topic)
+            {
+                return static_cast<int32_t>(index);
+            }
+        }
+        return -1;
+    }
+} // namespace IotZoo
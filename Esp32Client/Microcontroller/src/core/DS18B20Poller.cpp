@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/DS18B20Poller.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace IotZoo
+{
+    void RomAddress::toHex(char* buffer) const
+    {
+        static const char Digits[] = "0123456789ABCDEF";
+        for (size_t i = 0; i < sizeof(bytes); i++)
+        {
+            buffer[2 * i]     = Digits[bytes[i] >> 4];
+            buffer[2 * i + 1] = Digits[bytes[i] & 0x0F];
+        }
+        buffer[2 * sizeof(bytes)] = '\0';
+    }
+
+    bool RomAddress::operator<(const RomAddress& other) const
+    {
+        return memcmp(bytes, other.bytes, sizeof(bytes)) < 0;
+    }
+
+    bool RomAddress::operator==(const RomAddress& other) const
+    {
+        return 0 == memcmp(bytes, other.bytes, sizeof(bytes));
+    }
+
+    DS18B20Poller::DS18B20Poller(OneWireTemperatureBus& bus, uint8_t resolution, uint32_t intervalMillis)
+        : bus(bus), resolution(resolution < 9 ? 9 : (resolution > 12 ? 12 : resolution)), intervalMillis(intervalMillis)
+    {
+    }
+
+    size_t DS18B20Poller::begin()
+    {
+        addresses.resize(MaxSensors);
+        size_t count = bus.search(addresses.data(), MaxSensors);
+        addresses.resize(count < MaxSensors ? count : MaxSensors);
+        std::sort(addresses.begin(), addresses.end());
+        bus.setResolution(resolution);
+        state   = ConversionState::Idle;
+        started = false;
+        return addresses.size();
+    }
+
+    bool DS18B20Poller::loop(uint32_t nowMillis, ReadingCallback onReading, void* context)
+    {
+        switch (state)
+        {
+            case ConversionState::Idle:
+                if (started && nowMillis - conversionStartMillis < intervalMillis)
+                {
+                    return false;
+                }
+                started               = true;
+                conversionStartMillis = nowMillis;
+                if (addresses.empty() || !bus.startConversion())
+                {
+                    busErrors += addresses.empty() ? 0 : 1;
+                    return false;
+                }
+                state = ConversionState::Converting;
+                return false;
+
+            case ConversionState::Converting:
+                if (nowMillis - conversionStartMillis < getConversionMillis(resolution))
+                {
+                    return false;
+                }
+                for (size_t sensor = 0; sensor < addresses.size(); sensor++)
+                {
+                    float celsius = 0;
+                    bool  valid   = bus.readCelsius(addresses[sensor], celsius);
+                    onReading(context, {sensor, addresses[sensor], celsius, valid});
+                }
+                state = ConversionState::Idle;
+                return true;
+        }
+        return false;
+    }
+
+    uint32_t DS18B20Poller::getConversionMillis(uint8_t resolution)
+    {
+        // t_CONV of the datasheet: 93.75 ms at 9 bit, doubled per bit.
+        switch (resolution)
+        {
+            case 9:
+                return 94;
+            case 10:
+                return 188;
+            case 11:
+                return 375;
+            default:
+                return 750;
+        }
+    }
+} // namespace IotZoo
@@ -0,0 +1,148 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/ExpiryHeap.hpp"
+
+namespace IotZoo
+{
+    ExpiryHeap::ExpiryHeap(size_t capacity)
+    {
+        resize(capacity);
+    }
+
+    void ExpiryHeap::resize(size_t capacity)
+    {
+        if (capacity > NotScheduled)
+        {
+            capacity = NotScheduled;
+        }
+        heap.clear();
+        heap.reserve(capacity); // no allocation while scheduling.
+        deadlines.assign(capacity, 0);
+        positions.assign(capacity, NotScheduled);
+    }
+
+    void ExpiryHeap::schedule(uint16_t id, uint32_t deadlineMillis)
+    {
+        if (id >= positions.size())
+        {
+            return;
+        }
+        if (positions[id] == NotScheduled)
+        {
+            deadlines[id] = deadlineMillis;
+            heap.push_back(id);
+            positions[id] = static_cast<uint16_t>(heap.size() - 1);
+            siftUp(positions[id]);
+            return;
+        }
+        bool earlier  = isBefore(deadlineMillis, deadlines[id]);
+        deadlines[id] = deadlineMillis;
+        if (earlier)
+        {
+            siftUp(positions[id]);
+        }
+        else
+        {
+            siftDown(positions[id]);
+        }
+    }
+
+    void ExpiryHeap::cancel(uint16_t id)
+    {
+        if (isScheduled(id))
+        {
+            remove(positions[id]);
+        }
+    }
+
+    int32_t ExpiryHeap::popExpired(uint32_t nowMillis)
+    {
+        if (heap.empty() || isBefore(nowMillis, deadlines[heap[0]]))
+        {
+            return NoId;
+        }
+        uint16_t id = heap[0];
+        remove(0);
+        return id;
+    }
+
+    uint32_t ExpiryHeap::millisUntilNext(uint32_t nowMillis) const
+    {
+        if (heap.empty())
+        {
+            return UINT32_MAX;
+        }
+        uint32_t deadline = deadlines[heap[0]];
+        return isBefore(nowMillis, deadline) ? deadline - nowMillis : 0;
+    }
+
+    void ExpiryHeap::remove(uint16_t position)
+    {
+        uint16_t id   = heap[position];
+        uint16_t last = heap.back();
+        heap.pop_back();
+        positions[id] = NotScheduled;
+        if (position == heap.size())
+        {
+            return;
+        }
+        place(position, last);
+        siftUp(position);
+        siftDown(positions[last]);
+    }
+
+    void ExpiryHeap::siftUp(uint16_t position)
+    {
+        uint16_t id = heap[position];
+        while (position > 0)
+        {
+            uint16_t parent = (position - 1) / 2;
+            if (!isBefore(deadlines[id], deadlines[heap[parent]]))
+            {
+                break;
+            }
+            place(position, heap[parent]);
+            position = parent;
+        }
+        place(position, id);
+    }
+
+    void ExpiryHeap::siftDown(uint16_t position)
+    {
+        uint16_t id   = heap[position];
+        size_t   size = heap.size();
+        while (true)
+        {
+            size_t child = 2 * static_cast<size_t>(position) + 1;
+            if (child >= size)
+            {
+                break;
+            }
+            if (child + 1 < size && isBefore(deadlines[heap[child + 1]], deadlines[heap[child]]))
+            {
+                child++;
+            }
+            if (!isBefore(deadlines[heap[child]], deadlines[id]))
+            {
+                break;
+            }
+            place(position, heap[child]);
+            position = static_cast<uint16_t>(child);
+        }
+        place(position, id);
+    }
+
+    void ExpiryHeap::place(uint16_t position, uint16_t id)
+    {
+        heap[position] = id;
+        positions[id]  = position;
+    }
+} // namespace IotZoo
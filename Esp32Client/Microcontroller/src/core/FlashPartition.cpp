@@ -0,0 +1,93 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/FlashPartition.hpp"
+
+#include <cstring>
+
+namespace IotZoo
+{
+    FilePartition::FilePartition(const char* path, size_t size, size_t sectorSize)
+        : size(size - size % sectorSize), sectorSize(sectorSize), eraseCounts(size / sectorSize, 0)
+    {
+        file = fopen(path, "r+b");
+        if (nullptr != file)
+        {
+            fseek(file, 0, SEEK_END);
+            if (static_cast<size_t>(ftell(file)) == this->size)
+            {
+                return;
+            }
+            fclose(file);
+        }
+        file = fopen(path, "w+b");
+        if (nullptr == file)
+        {
+            return;
+        }
+        std::vector<uint8_t> erased(sectorSize, 0xFF);
+        for (size_t offset = 0; offset < this->size; offset += sectorSize)
+        {
+            fwrite(erased.data(), 1, sectorSize, file);
+        }
+        fflush(file);
+    }
+
+    FilePartition::~FilePartition()
+    {
+        if (nullptr != file)
+        {
+            fclose(file);
+        }
+    }
+
+    bool FilePartition::read(size_t offset, void* data, size_t length)
+    {
+        if (nullptr == file || offset + length > size)
+        {
+            return false;
+        }
+        return 0 == fseek(file, static_cast<long>(offset), SEEK_SET) && fread(data, 1, length, file) == length;
+    }
+
+    bool FilePartition::write(size_t offset, const void* data, size_t length)
+    {
+        std::vector<uint8_t> content(length);
+        if (!read(offset, content.data(), length))
+        {
+            return false;
+        }
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < length; i++)
+        {
+            content[i] &= bytes[i];
+        }
+        if (0 != fseek(file, static_cast<long>(offset), SEEK_SET) || fwrite(content.data(), 1, length, file) != length)
+        {
+            return false;
+        }
+        return 0 == fflush(file);
+    }
+
+    bool FilePartition::eraseSector(size_t offset)
+    {
+        if (nullptr == file || offset % sectorSize != 0 || offset >= size)
+        {
+            return false;
+        }
+        std::vector<uint8_t> erased(sectorSize, 0xFF);
+        if (0 != fseek(file, static_cast<long>(offset), SEEK_SET) || fwrite(erased.data(), 1, sectorSize, file) != sectorSize)
+        {
+            return false;
+        }
+        eraseCounts[offset / sectorSize]++;
+        return 0 == fflush(file);
+    }
+} // namespace IotZoo
@@ -0,0 +1,277 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/GpsTracking.hpp"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+namespace IotZoo
+{
+    namespace
+    {
+        constexpr float DegreesToRadians = 3.14159265f / 180.0f;
+
+        float cosLatitudeOf(double latitude)
+        {
+            return std::cos(static_cast<float>(latitude) * DegreesToRadians);
+        }
+
+        float distanceToSegment(float px, float py, float ax, float ay, float bx, float by)
+        {
+            float dx     = bx - ax;
+            float dy     = by - ay;
+            float length = dx * dx + dy * dy;
+            float t      = length > 0 ? ((px - ax) * dx + (py - ay) * dy) / length : 0;
+            t            = t < 0 ? 0 : (t > 1 ? 1 : t);
+            float ex     = ax + t * dx - px;
+            float ey     = ay + t * dy - py;
+            return std::sqrt(ex * ex + ey * ey);
+        }
+
+        bool appendText(char* buffer, size_t size, size_t& length, const char* text)
+        {
+            int count = snprintf(buffer + length, size - length, "%s", text);
+            if (count < 0 || static_cast<size_t>(count) >= size - length)
+            {
+                return false;
+            }
+            length += static_cast<size_t>(count);
+            return true;
+        }
+
+        bool appendNumber(char* buffer, size_t size, size_t& length, int64_t value, bool separator)
+        {
+            int count = snprintf(buffer + length, size - length, separator ? ",%" PRId64 : "%" PRId64, value);
+            if (count < 0 || static_cast<size_t>(count) >= size - length)
+            {
+                return false;
+            }
+            length += static_cast<size_t>(count);
+            return true;
+        }
+
+        int64_t fieldOf(const TrackPoint& point, int field)
+        {
+            return 0 == field ? static_cast<int64_t>(point.timeSeconds) : (1 == field ? point.latitudeE5 : point.longitudeE5);
+        }
+    } // namespace
+
+    void GeoMath::toLocalMeters(const GeoPoint& origin, float cosLatitude, const GeoPoint& point, float& x, float& y)
+    {
+        x = static_cast<float>(point.longitude - origin.longitude) * DegreesToRadians * EarthRadiusMeters * cosLatitude;
+        y = static_cast<float>(point.latitude - origin.latitude) * DegreesToRadians * EarthRadiusMeters;
+    }
+
+    float GeoMath::distanceMeters(const GeoPoint& a, const GeoPoint& b)
+    {
+        float x, y;
+        toLocalMeters(a, cosLatitudeOf((a.latitude + b.latitude) / 2), b, x, y);
+        return std::sqrt(x * x + y * y);
+    }
+
+    float GeoMath::headingDifference(float a, float b)
+    {
+        float difference = std::fabs(std::fmod(a - b, 360.0f));
+        return difference > 180.0f ? 360.0f - difference : difference;
+    }
+
+    PublishReason PositionFilter::update(const GeoPoint& position, float courseDegrees, float speedMetersPerSecond, uint32_t nowMillis)
+    {
+        PublishReason reason  = PublishReason::None;
+        uint32_t      elapsed = nowMillis - publishedMillis;
+        if (!hasPublished)
+        {
+            reason = PublishReason::First;
+        }
+        else if (elapsed < parameters.minIntervalMillis)
+        {
+            return PublishReason::None;
+        }
+        else if (GeoMath::distanceMeters(publishedPosition, position) >= parameters.minDistanceMeters)
+        {
+            reason = PublishReason::Distance;
+        }
+        else if (speedMetersPerSecond >= parameters.minSpeedMetersPerSecond &&
+                 GeoMath::headingDifference(courseDegrees, publishedCourse) >= parameters.minHeadingDegrees)
+        {
+            reason = PublishReason::Heading;
+        }
+        else if (elapsed >= parameters.maxIntervalMillis)
+        {
+            reason = PublishReason::Heartbeat;
+        }
+
+        if (PublishReason::None != reason)
+        {
+            hasPublished      = true;
+            publishedPosition = position;
+            publishedCourse   = courseDegrees;
+            publishedMillis   = nowMillis;
+        }
+        return reason;
+    }
+
+    const char* PositionFilter::getReasonName(PublishReason reason)
+    {
+        switch (reason)
+        {
+            case PublishReason::First:
+                return "first";
+            case PublishReason::Distance:
+                return "distance";
+            case PublishReason::Heading:
+                return "heading";
+            case PublishReason::Heartbeat:
+                return "heartbeat";
+            default:
+                return "none";
+        }
+    }
+
+    void Geofences::clear()
+    {
+        fences.clear();
+    }
+
+    bool Geofences::addCircle(const char* name, const GeoPoint& center, float radiusMeters)
+    {
+        if (fences.size() >= MaxFences || radiusMeters <= 0)
+        {
+            return false;
+        }
+        Fence fence        = {};
+        fence.name         = name;
+        fence.origin       = center;
+        fence.cosLatitude  = cosLatitudeOf(center.latitude);
+        fence.radiusMeters = radiusMeters;
+        fences.push_back(fence);
+        return true;
+    }
+
+    bool Geofences::addPolygon(const char* name, const GeoPoint* vertices, size_t count)
+    {
+        if (fences.size() >= MaxFences || count < 3 || count > MaxVertices)
+        {
+            return false;
+        }
+        Fence fence       = {};
+        fence.name        = name;
+        fence.origin      = vertices[0];
+        fence.cosLatitude = cosLatitudeOf(vertices[0].latitude);
+        fence.vertexCount = static_cast<uint8_t>(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            GeoMath::toLocalMeters(fence.origin, fence.cosLatitude, vertices[i], fence.x[i], fence.y[i]);
+        }
+        fences.push_back(fence);
+        return true;
+    }
+
+    float Geofences::getSignedDistance(size_t index, const GeoPoint& position) const
+    {
+        const Fence& fence = fences[index];
+        float        px, py;
+        GeoMath::toLocalMeters(fence.origin, fence.cosLatitude, position, px, py);
+        if (0 == fence.vertexCount)
+        {
+            return std::sqrt(px * px + py * py) - fence.radiusMeters;
+        }
+
+        bool  inside   = false;
+        float distance = INFINITY;
+        for (size_t i = 0, j = fence.vertexCount - 1; i < fence.vertexCount; j = i++)
+        {
+            if ((fence.y[i] > py) != (fence.y[j] > py) &&
+                px < (fence.x[j] - fence.x[i]) * (py - fence.y[i]) / (fence.y[j] - fence.y[i]) + fence.x[i])
+            {
+                inside = !inside;
+            }
+            float edgeDistance = distanceToSegment(px, py, fence.x[i], fence.y[i], fence.x[j], fence.y[j]);
+            distance           = edgeDistance < distance ? edgeDistance : distance;
+        }
+        return inside ? -distance : distance;
+    }
+
+    void Geofences::update(const GeoPoint& position, EventCallback onEvent, void* context)
+    {
+        for (size_t index = 0; index < fences.size(); index++)
+        {
+            Fence& fence    = fences[index];
+            float  distance = getSignedDistance(index, position);
+            if (!fence.inside && distance <= 0)
+            {
+                fence.inside = true;
+                onEvent(context, {GeofenceEventType::Enter, static_cast<uint8_t>(index)});
+            }
+            else if (fence.inside && distance > hysteresisMeters)
+            {
+                fence.inside = false;
+                onEvent(context, {GeofenceEventType::Exit, static_cast<uint8_t>(index)});
+            }
+        }
+    }
+
+    const char* Geofences::getEventName(GeofenceEventType type)
+    {
+        return GeofenceEventType::Enter == type ? "enter" : "exit";
+    }
+
+    TrackBatch::TrackBatch(size_t capacity)
+    {
+        setCapacity(capacity);
+    }
+
+    void TrackBatch::setCapacity(size_t capacity)
+    {
+        maxPoints = capacity;
+        points.clear();
+        points.reserve(capacity); // no allocation while collecting.
+    }
+
+    bool TrackBatch::add(const GeoPoint& position, uint32_t timeSeconds)
+    {
+        if (0 == maxPoints)
+        {
+            return false;
+        }
+        if (points.size() >= maxPoints)
+        {
+            points.erase(points.begin()); // the batch was not sent, keep the newest points.
+        }
+        points.push_back(
+            {timeSeconds, static_cast<int32_t>(std::lround(position.latitude * 1e5)), static_cast<int32_t>(std::lround(position.longitude * 1e5))});
+        return points.size() >= maxPoints;
+    }
+
+    size_t TrackBatch::serialize(char* buffer, size_t size) const
+    {
+        static const char* const Keys[] = {"{\"t\":[", "],\"lat\":[", "],\"lon\":["};
+
+        size_t length = 0;
+        for (int field = 0; field < 3; field++)
+        {
+            if (!appendText(buffer, size, length, Keys[field]))
+            {
+                return 0;
+            }
+            for (size_t index = 0; index < points.size(); index++)
+            {
+                int64_t value = fieldOf(points[index], field) - (index > 0 ? fieldOf(points[index - 1], field) : 0);
+                if (!appendNumber(buffer, size, length, value, index > 0))
+                {
+                    return 0;
+                }
+            }
+        }
+        return appendText(buffer, size, length, "]}") ? length : 0;
+    }
+} // namespace IotZoo
@@ -0,0 +1,140 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/KeywordMatcher.hpp"
+
+#include <cstring>
+
+namespace IotZoo
+{
+    namespace
+    {
+        constexpr uint16_t NoState = 0xFFFF;
+
+        uint8_t toLower(uint8_t character)
+        {
+            return (character >= 'A' && character <= 'Z') ? character - 'A' + 'a' : character;
+        }
+    } // namespace
+
+    void KeywordMatcher::clear()
+    {
+        keywords.clear();
+        transitions.clear();
+        outputs.clear();
+        memset(symbols, 0, sizeof(symbols));
+        symbolCount = 1;
+    }
+
+    int KeywordMatcher::add(const char* keyword)
+    {
+        if (nullptr == keyword || 0 == *keyword || keywords.size() >= MaxKeywords)
+        {
+            return -1;
+        }
+        keywords.emplace_back(keyword);
+        return static_cast<int>(keywords.size() - 1);
+    }
+
+    void KeywordMatcher::build()
+    {
+        memset(symbols, 0, sizeof(symbols));
+        symbolCount = 1;
+        size_t maxStates = 1;
+        for (const auto& keyword : keywords)
+        {
+            for (char character : keyword)
+            {
+                uint8_t lower = toLower(static_cast<uint8_t>(character));
+                if (0 == symbols[lower])
+                {
+                    symbols[lower] = static_cast<uint8_t>(symbolCount++);
+                    if (lower >= 'a' && lower <= 'z')
+                    {
+                        symbols[lower - 'a' + 'A'] = symbols[lower];
+                    }
+                }
+            }
+            maxStates += keyword.length();
+        }
+
+        // Trie of the keywords. State 0 is the root.
+        transitions.assign(maxStates * symbolCount, NoState);
+        outputs.assign(1, 0);
+        for (size_t id = 0; id < keywords.size(); id++)
+        {
+            uint16_t state = 0;
+            for (char character : keywords[id])
+            {
+                uint16_t& next = transitions[state * symbolCount + symbols[static_cast<uint8_t>(character)]];
+                if (NoState == next)
+                {
+                    next = static_cast<uint16_t>(outputs.size());
+                    outputs.push_back(0);
+                }
+                state = next;
+            }
+            outputs[state] |= 1ull << id;
+        }
+        transitions.resize(outputs.size() * symbolCount);
+
+        // Breadth first: the missing transitions follow the failure links, so the automaton never goes back in the text.
+        std::vector<uint16_t> failure(outputs.size(), 0);
+        std::vector<uint16_t> queue;
+        queue.reserve(outputs.size());
+        for (uint16_t symbol = 0; symbol < symbolCount; symbol++)
+        {
+            uint16_t& next = transitions[symbol];
+            if (NoState == next)
+            {
+                next = 0;
+            }
+            else
+            {
+                queue.push_back(next);
+            }
+        }
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            uint16_t state = queue[head];
+            for (uint16_t symbol = 0; symbol < symbolCount; symbol++)
+            {
+                uint16_t& next        = transitions[state * symbolCount + symbol];
+                uint16_t  failureNext = transitions[failure[state] * symbolCount + symbol];
+                if (NoState == next)
+                {
+                    next = failureNext;
+                }
+                else
+                {
+                    failure[next] = failureNext;
+                    outputs[next] |= outputs[failureNext]; // the keywords that are a suffix of this one, e.g. "ring" in "bell ring"
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+
+    uint64_t KeywordMatcher::match(const char* text, size_t length) const
+    {
+        if (transitions.empty())
+        {
+            return 0;
+        }
+        uint64_t found = 0;
+        uint16_t state = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            state = transitions[state * symbolCount + symbols[static_cast<uint8_t>(text[i])]];
+            found |= outputs[state];
+        }
+        return found;
+    }
+} // namespace IotZoo
@@ -0,0 +1,243 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/LedEffect.hpp"
+
+#include <cstring>
+
+namespace IotZoo
+{
+    namespace
+    {
+        struct EffectName
+        {
+            LedEffectType type;
+            const char*   name;
+        };
+
+        constexpr EffectName EffectNames[] = {
+            {LedEffectType::Fade, "fade"},       {LedEffectType::Chase, "chase"}, {LedEffectType::Rainbow, "rainbow"},
+            {LedEffectType::Breathe, "breathe"}, {LedEffectType::Blink, "blink"}, {LedEffectType::Scroll, "scroll"},
+        };
+
+        int hexValue(char character)
+        {
+            if (character >= '0' && character <= '9')
+            {
+                return character - '0';
+            }
+            if (character >= 'a' && character <= 'f')
+            {
+                return character - 'a' + 10;
+            }
+            if (character >= 'A' && character <= 'F')
+            {
+                return character - 'A' + 10;
+            }
+            return -1;
+        }
+    } // namespace
+
+    void LedEffect::start(const LedEffectParameters& parameters, uint32_t nowMillis)
+    {
+        this->parameters = parameters;
+        if (0 == this->parameters.periodMillis)
+        {
+            this->parameters.periodMillis = 1;
+        }
+        this->parameters.framesPerSecond = clampFramesPerSecond(this->parameters.framesPerSecond);
+        startMillis     = nowMillis;
+        nextFrameMillis = nowMillis;
+    }
+
+    bool LedEffect::loop(const PixelBuffer& buffer, uint32_t nowMillis)
+    {
+        if (!isRunning() || static_cast<int32_t>(nowMillis - nextFrameMillis) < 0)
+        {
+            return false;
+        }
+        render(buffer, nowMillis);
+
+        uint32_t frameIntervalMillis = 1000 / parameters.framesPerSecond;
+        nextFrameMillis += frameIntervalMillis;
+        if (static_cast<int32_t>(nowMillis - nextFrameMillis) >= 0)
+        {
+            nextFrameMillis = nowMillis + frameIntervalMillis; // too late: skip the missed frames.
+        }
+
+        if (LedEffectType::Fade == parameters.type && nowMillis - startMillis >= parameters.periodMillis)
+        {
+            stop(); // the last frame shows color2.
+        }
+        return true;
+    }
+
+    void LedEffect::render(const PixelBuffer& buffer, uint32_t nowMillis) const
+    {
+        uint32_t elapsed = nowMillis - startMillis;
+        uint32_t period  = parameters.periodMillis;
+        uint32_t phase   = elapsed % period; // 0 .. period - 1
+
+        if (LedEffectType::Scroll == parameters.type)
+        {
+            uint32_t distance = buffer.columns + parameters.spriteColumns;
+            int32_t  spriteX  = static_cast<int32_t>(buffer.columns) - static_cast<int32_t>(static_cast<uint64_t>(phase) * distance / period);
+            for (uint16_t y = 0; y < buffer.rows; y++)
+            {
+                for (uint16_t x = 0; x < buffer.columns; x++)
+                {
+                    int32_t spriteColumn = static_cast<int32_t>(x) - spriteX;
+                    bool    lit          = spriteColumn >= 0 && spriteColumn < parameters.spriteColumns && y < 8 &&
+                                (parameters.sprite[spriteColumn] >> y) & 1;
+                    PixelFrame::setPixel(buffer, PixelFrame::getLedIndex(buffer, x, y), lit ? parameters.color : parameters.color2);
+                }
+            }
+            return;
+        }
+
+        uint32_t ledCount = static_cast<uint32_t>(buffer.columns) * buffer.rows;
+        if (parameters.startIndex >= ledCount)
+        {
+            return;
+        }
+        uint32_t count = ledCount - parameters.startIndex;
+        if (parameters.count > 0 && parameters.count < count)
+        {
+            count = parameters.count;
+        }
+
+        uint32_t color = parameters.color; // the same color for all pixels, except chase and rainbow.
+        switch (parameters.type)
+        {
+            case LedEffectType::Fade:
+                color = blend(parameters.color, parameters.color2,
+                              elapsed >= period ? 256 : static_cast<uint16_t>(static_cast<uint64_t>(elapsed) * 256 / period));
+                break;
+            case LedEffectType::Breathe:
+            {
+                // Triangle 0 .. 256 .. 0, squared: the eye sees the brightness logarithmically.
+                uint32_t level = static_cast<uint32_t>(static_cast<uint64_t>(phase) * 512 / period);
+                level          = level > 256 ? 512 - level : level;
+                color          = blend(0, parameters.color, static_cast<uint16_t>(level * level / 256));
+                break;
+            }
+            case LedEffectType::Blink:
+                color = phase < period / 2 ? parameters.color : parameters.color2;
+                break;
+            default:
+                break;
+        }
+
+        uint32_t chaseHead = static_cast<uint32_t>(static_cast<uint64_t>(phase) * count / period);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t pixelColor = color;
+            if (LedEffectType::Chase == parameters.type)
+            {
+                // lit if i is one of the length pixels behind the head, around the end.
+                uint32_t behindHead = (chaseHead + count - i) % count;
+                pixelColor          = behindHead < parameters.length ? parameters.color : parameters.color2;
+            }
+            else if (LedEffectType::Rainbow == parameters.type)
+            {
+                pixelColor = hueToColor(static_cast<uint16_t>((i * 65536 / count) + static_cast<uint64_t>(phase) * 65536 / period));
+            }
+            PixelFrame::setPixel(buffer, parameters.startIndex + i, pixelColor);
+        }
+    }
+
+    LedEffectType LedEffect::parseType(const char* name)
+    {
+        for (const auto& effectName : EffectNames)
+        {
+            if (0 == strcmp(name, effectName.name))
+            {
+                return effectName.type;
+            }
+        }
+        return LedEffectType::None;
+    }
+
+    const char* LedEffect::getTypeName(LedEffectType type)
+    {
+        for (const auto& effectName : EffectNames)
+        {
+            if (type == effectName.type)
+            {
+                return effectName.name;
+            }
+        }
+        return "none";
+    }
+
+    bool LedEffect::parseSprite(const char* text, LedEffectParameters& parameters)
+    {
+        size_t length = strlen(text);
+        if ((length & 1) || length / 2 > LedEffectParameters::MaxSpriteColumns)
+        {
+            return false;
+        }
+        for (size_t column = 0; column < length / 2; column++)
+        {
+            int high = hexValue(text[2 * column]);
+            int low  = hexValue(text[2 * column + 1]);
+            if (high < 0 || low < 0)
+            {
+                return false;
+            }
+            parameters.sprite[column] = static_cast<uint8_t>((high << 4) | low);
+        }
+        parameters.spriteColumns = static_cast<uint8_t>(length / 2);
+        return true;
+    }
+
+    uint32_t LedEffect::hueToColor(uint16_t hue)
+    {
+        // Six sectors of 0x2AAB, within a sector one channel ramps up or down.
+        uint32_t sector = hue / 0x2AAB;
+        uint32_t ramp   = (hue % 0x2AAB) * 255 / 0x2AAA;
+        uint32_t r, g, b;
+        switch (sector)
+        {
+            case 0:
+                r = 255, g = ramp, b = 0;
+                break;
+            case 1:
+                r = 255 - ramp, g = 255, b = 0;
+                break;
+            case 2:
+                r = 0, g = 255, b = ramp;
+                break;
+            case 3:
+                r = 0, g = 255 - ramp, b = 255;
+                break;
+            case 4:
+                r = ramp, g = 0, b = 255;
+                break;
+            default:
+                r = 255, g = 0, b = 255 - ramp;
+                break;
+        }
+        return (r << 16) | (g << 8) | b;
+    }
+
+    uint32_t LedEffect::blend(uint32_t a, uint32_t b, uint16_t weight)
+    {
+        uint32_t result = 0;
+        for (int shift = 0; shift <= 16; shift += 8)
+        {
+            uint32_t channelA = (a >> shift) & 0xFF;
+            uint32_t channelB = (b >> shift) & 0xFF;
+            uint32_t channel  = (channelA * (256 - weight) + channelB * weight) >> 8;
+            result |= channel << shift;
+        }
+        return result;
+    }
+} // namespace IotZoo
@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/LoopProfiler.hpp"
+
+#include <cmath>
+
+namespace IotZoo
+{
+    size_t CycleHistogram::getBucketIndex(uint32_t cycles)
+    {
+        if (cycles < SubBuckets)
+        {
+            return cycles; // exact
+        }
+        uint32_t mostSignificantBit = 31 - __builtin_clz(cycles); // >= 2
+        uint32_t subBucket          = (cycles >> (mostSignificantBit - 2)) & (SubBuckets - 1);
+        return (mostSignificantBit - 1) * SubBuckets + subBucket;
+    }
+
+    uint32_t CycleHistogram::getBucketUpperBound(size_t bucketIndex)
+    {
+        if (bucketIndex < SubBuckets)
+        {
+            return bucketIndex;
+        }
+        uint32_t mostSignificantBit = bucketIndex / SubBuckets + 1;
+        uint32_t subBucket          = bucketIndex % SubBuckets;
+        uint32_t width              = 1u << (mostSignificantBit - 2);
+        uint32_t lowerBound         = (SubBuckets + subBucket) * width;
+        return lowerBound + (width - 1);
+    }
+
+    void CycleHistogram::add(uint32_t cycles)
+    {
+        size_t bucketIndex = getBucketIndex(cycles);
+        if (counts[bucketIndex] == UINT16_MAX)
+        {
+            halve();
+        }
+        counts[bucketIndex]++;
+        totalCount++;
+    }
+
+    uint32_t CycleHistogram::getPercentile(float percentile) const
+    {
+        if (totalCount == 0)
+        {
+            return 0;
+        }
+        // rank of the value, rounded up: the p99 of 100 values is the 99th value.
+        uint32_t rank = static_cast<uint32_t>(std::ceil(totalCount * static_cast<double>(percentile) / 100.0));
+        if (rank == 0)
+        {
+            rank = 1;
+        }
+
+        uint32_t cumulatedCount = 0;
+        for (size_t bucketIndex = 0; bucketIndex < Buckets; bucketIndex++)
+        {
+            cumulatedCount += counts[bucketIndex];
+            if (cumulatedCount >= rank)
+            {
+                return getBucketUpperBound(bucketIndex);
+            }
+        }
+        return getBucketUpperBound(Buckets - 1);
+    }
+
+    void CycleHistogram::clear()
+    {
+        for (uint16_t& count : counts)
+        {
+            count = 0;
+        }
+        totalCount = 0;
+    }
+
+    void CycleHistogram::halve()
+    {
+        totalCount = 0;
+        for (uint16_t& count : counts)
+        {
+            count /= 2;
+            totalCount += count;
+        }
+    }
+
+    int LoopProfiler::addProbe(const std::string& name)
+    {
+        for (size_t probeId = 0; probeId < probes.size(); probeId++)
+        {
+            if (probes[probeId].name == name)
+            {
+                return static_cast<int>(probeId);
+            }
+        }
+        Probe probe;
+        probe.name = name;
+        probes.push_back(probe);
+        return static_cast<int>(probes.size() - 1);
+    }
+
+    void LoopProfiler::record(int probeId, uint32_t cycles)
+    {
+        if (!isValid(probeId))
+        {
+            return;
+        }
+        Probe& probe = probes[probeId];
+        probe.count++;
+        probe.totalCycles += cycles;
+        if (cycles < probe.minCycles)
+        {
+            probe.minCycles = cycles;
+        }
+        if (cycles > probe.maxCycles)
+        {
+            probe.maxCycles = cycles;
+        }
+        probe.histogram.add(cycles);
+    }
+
+    LoopProfiler::Statistics LoopProfiler::getStatistics(int probeId) const
+    {
+        Statistics statistics;
+        if (!isValid(probeId) || probes[probeId].count == 0)
+        {
+            return statistics;
+        }
+        const Probe& probe   = probes[probeId];
+        statistics.count     = probe.count;
+        statistics.minCycles = probe.minCycles;
+        statistics.maxCycles = probe.maxCycles;
+        statistics.avgCycles = static_cast<uint32_t>(probe.totalCycles / probe.count);
+        statistics.p99Cycles = probe.histogram.getPercentile(99);
+        if (statistics.p99Cycles > probe.maxCycles)
+        {
+            statistics.p99Cycles = probe.maxCycles; // the bucket bound must not exceed the measured maximum.
+        }
+        return statistics;
+    }
+
+    const char* LoopProfiler::getProbeName(int probeId) const
+    {
+        return isValid(probeId) ? probes[probeId].name.c_str() : "";
+    }
+
+    void LoopProfiler::reset()
+    {
+        for (Probe& probe : probes)
+        {
+            probe.count       = 0;
+            probe.minCycles   = UINT32_MAX;
+            probe.maxCycles   = 0;
+            probe.totalCycles = 0;
+            probe.histogram.clear();
+        }
+    }
+} // namespace IotZoo
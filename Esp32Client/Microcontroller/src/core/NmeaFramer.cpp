@@ -0,0 +1,105 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/NmeaFramer.hpp"
+
+namespace IotZoo
+{
+    namespace
+    {
+        int hexDigit(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            return -1;
+        }
+    } // namespace
+
+    size_t NmeaFramer::write(const uint8_t* data, size_t length, SentenceCallback onSentence, void* context)
+    {
+        size_t sentences = 0;
+        for (size_t index = 0; index < length; index++)
+        {
+            char c = static_cast<char>(data[index]);
+            if ('$' == c || '!' == c)
+            {
+                // A start character within a sentence: the rest of the previous sentence was lost.
+                if (inSentence)
+                {
+                    skippedBytes += sentence.length;
+                }
+                inSentence      = true;
+                sentence.length = 0;
+            }
+            else if (!inSentence)
+            {
+                skippedBytes++;
+                continue;
+            }
+            else if ('\r' == c)
+            {
+                continue;
+            }
+            else if ('\n' == c)
+            {
+                inSentence                     = false;
+                sentence.text[sentence.length] = '\0';
+                if (!hasValidChecksum(sentence.text, sentence.length))
+                {
+                    checksumErrors++;
+                    continue;
+                }
+                sentenceCount++;
+                sentences++;
+                onSentence(context, sentence);
+                continue;
+            }
+
+            if (sentence.length >= NmeaSentence::MaxLength)
+            {
+                inSentence = false;
+                overlongSentences++;
+                continue;
+            }
+            sentence.text[sentence.length++] = c;
+        }
+        return sentences;
+    }
+
+    bool NmeaFramer::hasValidChecksum(const char* text, size_t length)
+    {
+        if (length < 4 || '*' != text[length - 3])
+        {
+            return false;
+        }
+        int high = hexDigit(text[length - 2]);
+        int low  = hexDigit(text[length - 1]);
+        if (high < 0 || low < 0)
+        {
+            return false;
+        }
+        uint8_t checksum = 0;
+        for (size_t index = 1; index < length - 3; index++)
+        {
+            checksum ^= static_cast<uint8_t>(text[index]);
+        }
+        return checksum == ((high << 4) | low);
+    }
+} // namespace IotZoo
@@ -0,0 +1,174 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/OccupancyZones.hpp"
+
+namespace IotZoo
+{
+    void OccupancyZones::clear()
+    {
+        zones.clear();
+    }
+
+    bool OccupancyZones::addZone(const char* name, const ZonePoint* vertices, size_t count, uint32_t dwellMillis)
+    {
+        if (zones.size() >= MaxZones || count < 3 || count > MaxVertices || !isValidName(name))
+        {
+            return false;
+        }
+        Zone zone;
+        zone.name          = name;
+        zone.edgeCount     = 0;
+        zone.dwellMillis   = dwellMillis;
+        zone.occupantCount = 0;
+        zone.minX = zone.maxX = vertices[0].x;
+        zone.minY = zone.maxY = vertices[0].y;
+        for (size_t i = 0; i < count; i++)
+        {
+            const ZonePoint& a = vertices[i];
+            const ZonePoint& b = vertices[(i + 1) % count];
+            zone.minX          = a.x < zone.minX ? a.x : zone.minX;
+            zone.maxX          = a.x > zone.maxX ? a.x : zone.maxX;
+            zone.minY          = a.y < zone.minY ? a.y : zone.minY;
+            zone.maxY          = a.y > zone.maxY ? a.y : zone.maxY;
+            if (a.y == b.y)
+            {
+                continue; // a horizontal edge is never crossed by the horizontal ray.
+            }
+            Edge& edge        = zone.edges[zone.edgeCount++];
+            edge.x0           = a.x;
+            edge.y0           = a.y;
+            edge.y1           = b.y;
+            edge.inverseSlope = (static_cast<int64_t>(b.x - a.x) << 16) / (b.y - a.y);
+        }
+        zones.push_back(zone);
+        return true;
+    }
+
+    bool OccupancyZones::contains(size_t zoneIndex, int16_t x, int16_t y) const
+    {
+        const Zone& zone = zones[zoneIndex];
+        if (x < zone.minX || x > zone.maxX || y < zone.minY || y > zone.maxY)
+        {
+            return false;
+        }
+        // Crossing number: count the edges a ray from the point to the right crosses.
+        bool inside = false;
+        for (uint8_t i = 0; i < zone.edgeCount; i++)
+        {
+            const Edge& edge = zone.edges[i];
+            if ((edge.y0 > y) != (edge.y1 > y))
+            {
+                int64_t crossingX = edge.x0 + ((static_cast<int64_t>(y - edge.y0) * edge.inverseSlope) >> 16);
+                if (x < crossingX)
+                {
+                    inside = !inside;
+                }
+            }
+        }
+        return inside;
+    }
+
+    void OccupancyZones::update(const TrackPosition* tracks, size_t count, uint32_t nowMillis, EventCallback onEvent, void* context)
+    {
+        for (size_t zoneIndex = 0; zoneIndex < zones.size(); zoneIndex++)
+        {
+            Zone& zone = zones[zoneIndex];
+
+            // Exit: the occupants that are gone or outside now.
+            for (uint8_t o = 0; o < zone.occupantCount;)
+            {
+                Occupant& occupant = zone.occupants[o];
+                bool      inside   = false;
+                for (size_t t = 0; t < count; t++)
+                {
+                    if (tracks[t].id == occupant.trackId)
+                    {
+                        inside = contains(zoneIndex, tracks[t].x, tracks[t].y);
+                        break;
+                    }
+                }
+                if (inside)
+                {
+                    if (!occupant.dwellReported && zone.dwellMillis > 0 && nowMillis - occupant.enterMillis >= zone.dwellMillis)
+                    {
+                        occupant.dwellReported = true;
+                        onEvent(context, {ZoneEventType::Dwell, static_cast<uint8_t>(zoneIndex), occupant.trackId, zone.occupantCount,
+                                          nowMillis - occupant.enterMillis});
+                    }
+                    o++;
+                    continue;
+                }
+                Occupant left = occupant;
+                occupant      = zone.occupants[--zone.occupantCount];
+                onEvent(context,
+                        {ZoneEventType::Exit, static_cast<uint8_t>(zoneIndex), left.trackId, zone.occupantCount, nowMillis - left.enterMillis});
+            }
+
+            // Enter: the targets inside that are no occupants yet.
+            for (size_t t = 0; t < count; t++)
+            {
+                bool known = false;
+                for (uint8_t o = 0; o < zone.occupantCount && !known; o++)
+                {
+                    known = zone.occupants[o].trackId == tracks[t].id;
+                }
+                if (known || zone.occupantCount >= MaxTargetsPerZone || !contains(zoneIndex, tracks[t].x, tracks[t].y))
+                {
+                    continue;
+                }
+                zone.occupants[zone.occupantCount++] = {tracks[t].id, false, nowMillis};
+                onEvent(context, {ZoneEventType::Enter, static_cast<uint8_t>(zoneIndex), tracks[t].id, zone.occupantCount, 0});
+            }
+        }
+    }
+
+    void OccupancyZones::exitAll(uint32_t nowMillis, EventCallback onEvent, void* context)
+    {
+        for (size_t zoneIndex = 0; zoneIndex < zones.size(); zoneIndex++)
+        {
+            Zone& zone = zones[zoneIndex];
+            while (zone.occupantCount > 0)
+            {
+                const Occupant& left = zone.occupants[--zone.occupantCount];
+                onEvent(context,
+                        {ZoneEventType::Exit, static_cast<uint8_t>(zoneIndex), left.trackId, zone.occupantCount, nowMillis - left.enterMillis});
+            }
+        }
+    }
+
+    bool OccupancyZones::isValidName(const char* name)
+    {
+        size_t length = 0;
+        for (; name[length] != '\0'; length++)
+        {
+            uint8_t c = static_cast<uint8_t>(name[length]);
+            if (length >= MaxNameLength || c < 0x20 || c == 0x7F || c == '/' || c == '+' || c == '#')
+            {
+                return false;
+            }
+        }
+        return length > 0;
+    }
+
+    const char* OccupancyZones::getEventName(ZoneEventType type)
+    {
+        switch (type)
+        {
+            case ZoneEventType::Enter:
+                return "enter";
+            case ZoneEventType::Dwell:
+                return "dwell";
+            case ZoneEventType::Exit:
+                return "exit";
+        }
+        return "unknown";
+    }
+} // namespace IotZoo
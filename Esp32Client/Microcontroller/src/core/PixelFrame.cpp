@@ -0,0 +1,169 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PixelFrame.hpp"
+
+namespace IotZoo
+{
+    namespace
+    {
+        uint16_t readUInt16(const uint8_t* data)
+        {
+            return static_cast<uint16_t>(data[0] | (data[1] << 8));
+        }
+
+        inline void writePixel(const PixelBuffer& buffer, uint8_t* pixel, uint8_t r, uint8_t g, uint8_t b)
+        {
+            if (buffer.brightnessScale < 256)
+            {
+                r = (r * buffer.brightnessScale) >> 8;
+                g = (g * buffer.brightnessScale) >> 8;
+                b = (b * buffer.brightnessScale) >> 8;
+            }
+            pixel[buffer.redOffset]   = r;
+            pixel[buffer.greenOffset] = g;
+            pixel[buffer.blueOffset]  = b;
+        }
+    } // namespace
+
+    PixelFrame::Error PixelFrame::readHeader(const uint8_t* frame, size_t length, PixelFrameHeader& header)
+    {
+        if (length < HeaderSize)
+        {
+            return Error::TooShort;
+        }
+        if (frame[0] > static_cast<uint8_t>(PixelFrameFormat::Palette))
+        {
+            return Error::UnknownFormat;
+        }
+        header.format     = static_cast<PixelFrameFormat>(frame[0]);
+        header.flags      = frame[1];
+        header.brightness = frame[2];
+        header.x          = readUInt16(frame + 4);
+        header.y          = readUInt16(frame + 6);
+        header.width      = readUInt16(frame + 8);
+        header.height     = readUInt16(frame + 10);
+        return Error::None;
+    }
+
+    PixelFrame::Error PixelFrame::apply(const uint8_t* frame, size_t length, const PixelBuffer& buffer, PixelFrameHeader& header)
+    {
+        Error error = readHeader(frame, length, header);
+        if (Error::None != error)
+        {
+            return error;
+        }
+        if (static_cast<uint32_t>(header.x) + header.width > buffer.columns || static_cast<uint32_t>(header.y) + header.height > buffer.rows)
+        {
+            return Error::OutOfRange;
+        }
+
+        const uint8_t* palette       = nullptr;
+        size_t         paletteSize   = 0;
+        size_t         offset        = HeaderSize;
+        size_t         bytesPerPixel = 3;
+        if (PixelFrameFormat::Rgb565 == header.format)
+        {
+            bytesPerPixel = 2;
+        }
+        else if (PixelFrameFormat::Palette == header.format)
+        {
+            if (length < HeaderSize + 2)
+            {
+                return Error::TooShort;
+            }
+            paletteSize = readUInt16(frame + HeaderSize);
+            if (paletteSize < 1 || paletteSize > 256)
+            {
+                return Error::InvalidPalette;
+            }
+            palette       = frame + HeaderSize + 2;
+            offset        = HeaderSize + 2 + paletteSize * 3;
+            bytesPerPixel = 1;
+        }
+
+        size_t pixelCount = static_cast<size_t>(header.width) * header.height;
+        if (length != offset + pixelCount * bytesPerPixel)
+        {
+            return Error::LengthMismatch;
+        }
+
+        const uint8_t* source = frame + offset;
+        if (nullptr != palette && paletteSize < 256)
+        {
+            for (size_t i = 0; i < pixelCount; i++)
+            {
+                if (source[i] >= paletteSize)
+                {
+                    return Error::InvalidPalette;
+                }
+            }
+        }
+
+        for (uint16_t row = 0; row < header.height; row++)
+        {
+            uint16_t y = header.y + row;
+            for (uint16_t column = 0; column < header.width; column++)
+            {
+                uint8_t* pixel = buffer.data + getLedIndex(buffer, header.x + column, y) * buffer.bytesPerPixel;
+                switch (header.format)
+                {
+                    case PixelFrameFormat::Rgb888:
+                        writePixel(buffer, pixel, source[0], source[1], source[2]);
+                        break;
+                    case PixelFrameFormat::Rgb565:
+                    {
+                        uint16_t value = readUInt16(source);
+                        uint8_t  r     = (value >> 11) & 0x1F;
+                        uint8_t  g     = (value >> 5) & 0x3F;
+                        uint8_t  b     = value & 0x1F;
+                        writePixel(buffer, pixel, (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+                        break;
+                    }
+                    case PixelFrameFormat::Palette:
+                    {
+                        const uint8_t* color = palette + source[0] * 3;
+                        writePixel(buffer, pixel, color[0], color[1], color[2]);
+                        break;
+                    }
+                }
+                source += bytesPerPixel;
+            }
+        }
+        return Error::None;
+    }
+
+    void PixelFrame::setPixel(const PixelBuffer& buffer, uint32_t ledIndex, uint32_t color)
+    {
+        writePixel(buffer, buffer.data + ledIndex * buffer.bytesPerPixel, static_cast<uint8_t>(color >> 16), static_cast<uint8_t>(color >> 8),
+                   static_cast<uint8_t>(color));
+    }
+
+    const char* PixelFrame::getErrorText(Error error)
+    {
+        switch (error)
+        {
+            case Error::None:
+                return "";
+            case Error::TooShort:
+                return "frame too short";
+            case Error::UnknownFormat:
+                return "unknown frame format";
+            case Error::OutOfRange:
+                return "rectangle out of range";
+            case Error::LengthMismatch:
+                return "frame length does not match the header";
+            case Error::InvalidPalette:
+                return "invalid palette";
+            default:
+                return "unknown error";
+        }
+    }
+} // namespace IotZoo
@@ -0,0 +1,489 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PixelJsonParser.hpp"
+
+#include <cstring>
+
+namespace IotZoo
+{
+    namespace
+    {
+        /// @brief Forward only reader of JSON tokens. Strings are not unescaped, they are only compared with keys.
+        class JsonReader
+        {
+          public:
+            JsonReader(const char* json, size_t length) : position(json), end(json + length)
+            {
+            }
+
+            /// @return the next non white space character, '\0' at the end.
+            char peek()
+            {
+                while (position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+                {
+                    position++;
+                }
+                return position < end ? *position : '\0';
+            }
+
+            bool consume(char expected)
+            {
+                if (peek() != expected)
+                {
+                    return false;
+                }
+                position++;
+                return true;
+            }
+
+            bool readString(const char*& text, size_t& length)
+            {
+                if (!consume('"'))
+                {
+                    return false;
+                }
+                text = position;
+                while (position < end && *position != '"')
+                {
+                    if (*position == '\\')
+                    {
+                        position++;
+                    }
+                    position++;
+                }
+                if (position >= end)
+                {
+                    return false;
+                }
+                length = position - text;
+                position++;
+                return true;
+            }
+
+            /// @brief A number or a number in a string, e.g. 255 or "255". Decimals are cut off, negative values are 0.
+            bool readUnsigned(uint64_t& value)
+            {
+                const char* text   = nullptr;
+                size_t      length = 0;
+                if (peek() == '"')
+                {
+                    if (!readString(text, length))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    text = position;
+                    while (position < end && isScalarCharacter(*position))
+                    {
+                        position++;
+                    }
+                    length = position - text;
+                }
+                return parseUnsigned(text, length, value);
+            }
+
+            /// @brief Skips a string, number, literal, object or array. Nested values are counted, not recursed.
+            bool skipValue()
+            {
+                char first = peek();
+                if (first == '"')
+                {
+                    const char* text;
+                    size_t      length;
+                    return readString(text, length);
+                }
+                if (first != '{' && first != '[')
+                {
+                    const char* start = position;
+                    while (position < end && isScalarCharacter(*position))
+                    {
+                        position++;
+                    }
+                    return position > start;
+                }
+
+                size_t depth = 0;
+                while (position < end)
+                {
+                    char character = *position;
+                    if (character == '"')
+                    {
+                        const char* text;
+                        size_t      length;
+                        if (!readString(text, length))
+                        {
+                            return false;
+                        }
+                        continue;
+                    }
+                    position++;
+                    if (character == '{' || character == '[')
+                    {
+                        depth++;
+                    }
+                    else if (character == '}' || character == ']')
+                    {
+                        if (--depth == 0)
+                        {
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            const char* getPosition() const
+            {
+                return position;
+            }
+
+            void setPosition(const char* newPosition)
+            {
+                position = newPosition;
+            }
+
+          protected:
+            static bool isScalarCharacter(char character)
+            {
+                return character != ',' && character != '}' && character != ']' && character != ' ' && character != '\t' &&
+                       character != '\r' && character != '\n';
+            }
+
+            static bool parseUnsigned(const char* text, size_t length, uint64_t& value)
+            {
+                value = 0;
+                if (length > 0 && *text == '-')
+                {
+                    return length > 1; // negative -> 0
+                }
+                size_t digits = 0;
+                while (digits < length && text[digits] >= '0' && text[digits] <= '9')
+                {
+                    value = value * 10 + (text[digits] - '0');
+                    digits++;
+                }
+                return digits > 0;
+            }
+
+            const char* position;
+            const char* end;
+        };
+
+        bool keyEquals(const char* key, size_t length, const char* expected)
+        {
+            return strlen(expected) == length && 0 == memcmp(key, expected, length);
+        }
+
+        /// @brief "#10E084" or "10E084".
+        bool parseHexColor(const char* text, size_t length, uint32_t& color)
+        {
+            if (length > 0 && *text == '#')
+            {
+                text++;
+                length--;
+            }
+            if (length == 0 || length > 8)
+            {
+                return false;
+            }
+            color = 0;
+            for (size_t i = 0; i < length; i++)
+            {
+                char     character = text[i];
+                uint32_t nibble;
+                if (character >= '0' && character <= '9')
+                {
+                    nibble = character - '0';
+                }
+                else if (character >= 'a' && character <= 'f')
+                {
+                    nibble = character - 'a' + 10;
+                }
+                else if (character >= 'A' && character <= 'F')
+                {
+                    nibble = character - 'A' + 10;
+                }
+                else
+                {
+                    return false;
+                }
+                color = (color << 4) | nibble;
+            }
+            return true;
+        }
+
+        uint8_t clampByte(uint64_t value)
+        {
+            return value > 255 ? 255 : static_cast<uint8_t>(value);
+        }
+
+        /// @brief The color properties of the message or of a pixel.
+        struct ColorProperties
+        {
+            bool     hasColor = false;
+            uint32_t color    = 0;
+            uint8_t  rgbMask  = 0; // bit 0: r, bit 1: g, bit 2: b
+            uint8_t  rgb[3]   = {0, 0, 0};
+
+            bool hasRgb() const
+            {
+                return rgbMask == 0x07;
+            }
+
+            uint32_t getRgb() const
+            {
+                return (static_cast<uint32_t>(rgb[0]) << 16) | (static_cast<uint32_t>(rgb[1]) << 8) | rgb[2];
+            }
+
+            /// @return Error::None if the key is no color property.
+            PixelJsonParser::Error read(JsonReader& reader, const char* key, size_t keyLength, bool& handled)
+            {
+                handled = true;
+                if (keyEquals(key, keyLength, "color"))
+                {
+                    const char* text;
+                    size_t      length;
+                    if (!reader.readString(text, length))
+                    {
+                        return PixelJsonParser::Error::Syntax;
+                    }
+                    if (!parseHexColor(text, length, color))
+                    {
+                        return PixelJsonParser::Error::InvalidColor;
+                    }
+                    hasColor = true;
+                    return PixelJsonParser::Error::None;
+                }
+                int component = keyEquals(key, keyLength, "r") ? 0 : keyEquals(key, keyLength, "g") ? 1 : keyEquals(key, keyLength, "b") ? 2 : -1;
+                if (component < 0)
+                {
+                    handled = false;
+                    return PixelJsonParser::Error::None;
+                }
+                uint64_t value;
+                if (!reader.readUnsigned(value))
+                {
+                    return PixelJsonParser::Error::Syntax;
+                }
+                rgb[component] = clampByte(value);
+                rgbMask |= 1 << component;
+                return PixelJsonParser::Error::None;
+            }
+        };
+
+        /// @brief Iterates the members of an object: calls onMember(key, keyLength) with the reader in front of the value.
+        template <typename OnMember> PixelJsonParser::Error readObject(JsonReader& reader, OnMember onMember)
+        {
+            if (!reader.consume('{'))
+            {
+                return PixelJsonParser::Error::Syntax;
+            }
+            if (reader.consume('}'))
+            {
+                return PixelJsonParser::Error::None;
+            }
+            while (true)
+            {
+                const char* key;
+                size_t      keyLength;
+                if (!reader.readString(key, keyLength) || !reader.consume(':'))
+                {
+                    return PixelJsonParser::Error::Syntax;
+                }
+                PixelJsonParser::Error error = onMember(key, keyLength);
+                if (PixelJsonParser::Error::None != error)
+                {
+                    return error;
+                }
+                if (reader.consume(','))
+                {
+                    continue;
+                }
+                return reader.consume('}') ? PixelJsonParser::Error::None : PixelJsonParser::Error::Syntax;
+            }
+        }
+    } // namespace
+
+    PixelJsonParser::Error PixelJsonParser::parse(const char* json, size_t length, RangeCallback onRange, void* context)
+    {
+        JsonReader      reader(json, length);
+        ColorProperties globalColor;
+        PixelRange      defaults;
+        const char*     pixelsPosition = nullptr;
+
+        // 1st pass: the message properties, "pixels" is only located.
+        Error error = readObject(reader,
+                                 [&](const char* key, size_t keyLength) -> Error
+                                 {
+                                     bool  handled;
+                                     Error colorError = globalColor.read(reader, key, keyLength, handled);
+                                     if (handled)
+                                     {
+                                         return colorError;
+                                     }
+                                     if (keyEquals(key, keyLength, "pixels"))
+                                     {
+                                         pixelsPosition = reader.getPosition();
+                                         return reader.skipValue() ? Error::None : Error::Syntax;
+                                     }
+                                     uint64_t value;
+                                     if (keyEquals(key, keyLength, "brightness"))
+                                     {
+                                         if (!reader.readUnsigned(value))
+                                         {
+                                             return Error::Syntax;
+                                         }
+                                         defaults.brightness = clampByte(value);
+                                         if (defaults.brightness == 1)
+                                         {
+                                             defaults.brightness = 2;
+                                         }
+                                         return Error::None;
+                                     }
+                                     if (keyEquals(key, keyLength, "millisUntilTurnOff"))
+                                     {
+                                         if (!reader.readUnsigned(value))
+                                         {
+                                             return Error::Syntax;
+                                         }
+                                         defaults.millisUntilTurnOff = value;
+                                         return Error::None;
+                                     }
+                                     return reader.skipValue() ? Error::None : Error::Syntax;
+                                 });
+        if (Error::None != error)
+        {
+            return error;
+        }
+        if (nullptr == pixelsPosition)
+        {
+            return Error::PixelsMissing;
+        }
+
+        bool hasDefaultColor = globalColor.hasColor || globalColor.hasRgb();
+        // As before: the message color wins over the message r/g/b, the pixel r/g/b win over the pixel color.
+        defaults.color = globalColor.hasColor ? globalColor.color : globalColor.getRgb();
+
+        // 2nd pass: the pixels, every range is reported as soon as it is read.
+        reader.setPosition(pixelsPosition);
+        if (!reader.consume('['))
+        {
+            return Error::PixelsMissing;
+        }
+        if (reader.consume(']'))
+        {
+            return Error::None;
+        }
+        while (true)
+        {
+            PixelRange      range = defaults;
+            ColorProperties pixelColor;
+            error = readObject(reader,
+                               [&](const char* key, size_t keyLength) -> Error
+                               {
+                                   bool  handled;
+                                   Error colorError = pixelColor.read(reader, key, keyLength, handled);
+                                   if (handled)
+                                   {
+                                       return colorError;
+                                   }
+                                   uint64_t value;
+                                   if (keyEquals(key, keyLength, "index"))
+                                   {
+                                       if (!reader.readUnsigned(value))
+                                       {
+                                           return Error::Syntax;
+                                       }
+                                       range.startIndex = value > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(value);
+                                       return Error::None;
+                                   }
+                                   if (keyEquals(key, keyLength, "length"))
+                                   {
+                                       if (!reader.readUnsigned(value))
+                                       {
+                                           return Error::Syntax;
+                                       }
+                                       range.length = value < 1 ? 1 : value > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(value);
+                                       return Error::None;
+                                   }
+                                   if (keyEquals(key, keyLength, "brightness"))
+                                   {
+                                       if (!reader.readUnsigned(value))
+                                       {
+                                           return Error::Syntax;
+                                       }
+                                       range.brightness = clampByte(value) == 1 ? 2 : clampByte(value);
+                                       return Error::None;
+                                   }
+                                   if (keyEquals(key, keyLength, "millisUntilTurnOff"))
+                                   {
+                                       if (!reader.readUnsigned(value))
+                                       {
+                                           return Error::Syntax;
+                                       }
+                                       range.millisUntilTurnOff = value;
+                                       return Error::None;
+                                   }
+                                   return reader.skipValue() ? Error::None : Error::Syntax;
+                               });
+            if (Error::None != error)
+            {
+                return error;
+            }
+
+            if (pixelColor.hasRgb())
+            {
+                range.color = pixelColor.getRgb();
+            }
+            else if (pixelColor.hasColor)
+            {
+                range.color = pixelColor.color;
+            }
+            else if (!hasDefaultColor)
+            {
+                return Error::ColorMissing;
+            }
+            onRange(context, range);
+
+            if (reader.consume(','))
+            {
+                continue;
+            }
+            return reader.consume(']') ? Error::None : Error::Syntax;
+        }
+    }
+
+    bool PixelJsonParser::parseColor(const char* text, size_t length, uint32_t& color)
+    {
+        return parseHexColor(text, length, color);
+    }
+
+    const char* PixelJsonParser::getErrorText(Error error)
+    {
+        switch (error)
+        {
+            case Error::None:
+                return "";
+            case Error::Syntax:
+                return "invalid JSON";
+            case Error::PixelsMissing:
+                return "\"pixels\":[] missing";
+            case Error::ColorMissing:
+                return "color missing";
+            case Error::InvalidColor:
+                return "invalid color, expected e.g. \"#FFFF00\"";
+            default:
+                return "unknown error";
+        }
+    }
+} // namespace IotZoo
@@ -0,0 +1,93 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PublishPolicy.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace IotZoo
+{
+    bool PublishPolicy::update(float value, uint32_t nowMillis)
+    {
+        bool publish = false;
+        if (!hasPublished)
+        {
+            publish = true;
+        }
+        else if (nowMillis - publishedMillis < parameters.minIntervalMillis)
+        {
+            publish = false;
+        }
+        else if (parameters.maxAgeMillis > 0 && nowMillis - publishedMillis >= parameters.maxAgeMillis)
+        {
+            publish = true;
+        }
+        else
+        {
+            float change = std::fabs(value - publishedValue);
+            if (parameters.deadbandAbsolute <= 0 && parameters.deadbandPercent <= 0)
+            {
+                publish = change > 0 || std::isnan(value) != std::isnan(publishedValue);
+            }
+            else
+            {
+                publish = (parameters.deadbandAbsolute > 0 && change >= parameters.deadbandAbsolute) ||
+                          (parameters.deadbandPercent > 0 && change >= std::fabs(publishedValue) * parameters.deadbandPercent / 100.0f);
+            }
+        }
+
+        if (!publish)
+        {
+            suppressedCount++;
+            return false;
+        }
+        hasPublished    = true;
+        publishedValue  = value;
+        publishedMillis = nowMillis;
+        return true;
+    }
+
+    bool PublishPolicy::setParameter(const char* channel, const char* name, float value)
+    {
+        const char* separator = strchr(name, '.');
+        if (nullptr != separator)
+        {
+            size_t length = static_cast<size_t>(separator - name);
+            if (strlen(channel) != length || 0 != strncmp(channel, name, length))
+            {
+                return false;
+            }
+            name = separator + 1;
+        }
+
+        if (0 == strcmp(name, "DeadbandAbsolute"))
+        {
+            parameters.deadbandAbsolute = value;
+        }
+        else if (0 == strcmp(name, "DeadbandPercent"))
+        {
+            parameters.deadbandPercent = value;
+        }
+        else if (0 == strcmp(name, "MinPublishIntervalMillis"))
+        {
+            parameters.minIntervalMillis = value > 0 ? static_cast<uint32_t>(value) : 0;
+        }
+        else if (0 == strcmp(name, "MaxPublishIntervalMillis"))
+        {
+            parameters.maxAgeMillis = value > 0 ? static_cast<uint32_t>(value) : 0;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+} // namespace IotZoo
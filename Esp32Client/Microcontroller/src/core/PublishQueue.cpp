@@ -0,0 +1,163 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PublishQueue.hpp"
+#include "core/Fnv1a.hpp"
+
+#include <cstring>
+
+namespace IotZoo
+{
+    PublishQueue::PublishQueue(size_t capacity) : slots(capacity)
+    {
+    }
+
+    PublishQueue::Result PublishQueue::push(const char* topic, const uint8_t* payload, size_t length, bool retain,
+                                            PublishClass publishClass)
+    {
+        size_t topicLength = strlen(topic);
+        if (topicLength > MaxTopicLength || length > MaxPayloadLength)
+        {
+            return Result::TooLarge;
+        }
+
+        uint32_t topicHash = fnv1a(topic);
+        Result   result    = Result::Queued;
+        Slot*    slot      = nullptr;
+
+        if (PublishClass::Telemetry == publishClass)
+        {
+            slot = findTelemetry(topic, topicHash);
+            if (nullptr != slot)
+            {
+                // The queued value is outdated. Keep the position in the queue, replace the value.
+                coalesced++;
+                result = Result::Coalesced;
+            }
+        }
+
+        if (nullptr == slot)
+        {
+            slot = findFree();
+        }
+
+        if (nullptr == slot)
+        {
+            // Full. Make room by dropping the oldest telemetry value, events are never dropped for telemetry.
+            Slot* oldestTelemetry = findOldest(true);
+            if (nullptr == oldestTelemetry)
+            {
+                if (PublishClass::Telemetry == publishClass)
+                {
+                    droppedTelemetry++;
+                }
+                else
+                {
+                    droppedEvents++;
+                }
+                return Result::Dropped;
+            }
+            droppedTelemetry++;
+            release(*oldestTelemetry);
+            slot = oldestTelemetry;
+        }
+
+        if (!slot->used)
+        {
+            slot->used     = true;
+            slot->sequence = nextSequence++;
+            count++;
+            if (count > highWaterMark)
+            {
+                highWaterMark = count;
+            }
+        }
+        slot->retain        = retain;
+        slot->publishClass  = publishClass;
+        slot->topicHash     = topicHash;
+        slot->payloadLength = static_cast<uint16_t>(length);
+        memcpy(slot->topic, topic, topicLength + 1);
+        if (length > 0)
+        {
+            memcpy(slot->payload, payload, length);
+        }
+        return result;
+    }
+
+    size_t PublishQueue::drain(const Sender& send, const Clock& micros, uint32_t budgetMicros)
+    {
+        size_t   sent        = 0;
+        uint32_t startMicros = micros();
+        while (count > 0)
+        {
+            if (sent > 0 && micros() - startMicros >= budgetMicros)
+            {
+                break;
+            }
+            Slot* slot = findOldest(false);
+            if (!send(slot->topic, slot->payload, slot->payloadLength, slot->retain))
+            {
+                break; // e.g. not connected, try again in the next loop.
+            }
+            release(*slot);
+            sent++;
+        }
+        return sent;
+    }
+
+    PublishQueue::Slot* PublishQueue::findTelemetry(const char* topic, uint32_t topicHash)
+    {
+        for (auto& slot : slots)
+        {
+            if (slot.used && PublishClass::Telemetry == slot.publishClass && slot.topicHash == topicHash &&
+                0 == strcmp(slot.topic, topic))
+            {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    PublishQueue::Slot* PublishQueue::findFree()
+    {
+        for (auto& slot : slots)
+        {
+            if (!slot.used)
+            {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    PublishQueue::Slot* PublishQueue::findOldest(bool telemetryOnly)
+    {
+        Slot* oldest = nullptr;
+        for (auto& slot : slots)
+        {
+            if (!slot.used || (telemetryOnly && PublishClass::Telemetry != slot.publishClass))
+            {
+                continue;
+            }
+            // Unsigned difference, still correct after the sequence wrapped.
+            if (nullptr == oldest || static_cast<int32_t>(slot.sequence - oldest->sequence) < 0)
+            {
+                oldest = &slot;
+            }
+        }
+        return oldest;
+    }
+
+    void PublishQueue::release(Slot& slot)
+    {
+        slot.used = false;
+        count--;
+    }
+} // namespace IotZoo
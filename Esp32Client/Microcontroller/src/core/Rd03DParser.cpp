@@ -0,0 +1,111 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/Rd03DParser.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace IotZoo
+{
+    namespace
+    {
+        constexpr uint8_t Header[Rd03DParser::HeaderSize]   = {0xAA, 0xFF, 0x03, 0x00};
+        constexpr uint8_t Trailer[Rd03DParser::TrailerSize] = {0x55, 0xCC};
+    } // namespace
+
+    uint8_t* Rd03DParser::getWriteBuffer(size_t& length)
+    {
+        size_t free       = BufferSize - available();
+        size_t index      = head & (BufferSize - 1);
+        size_t contiguous = BufferSize - index;
+        length            = free < contiguous ? free : contiguous;
+        return buffer + index;
+    }
+
+    void Rd03DParser::commitWrite(size_t length)
+    {
+        head += length;
+    }
+
+    size_t Rd03DParser::write(const uint8_t* data, size_t length)
+    {
+        size_t written = 0;
+        while (written < length)
+        {
+            size_t   free;
+            uint8_t* target = getWriteBuffer(free);
+            if (0 == free)
+            {
+                break;
+            }
+            size_t count = (length - written) < free ? (length - written) : free;
+            memcpy(target, data + written, count);
+            commitWrite(count);
+            written += count;
+        }
+        return written;
+    }
+
+    size_t Rd03DParser::parse(FrameCallback onFrame, void* context)
+    {
+        size_t frames = 0;
+        while (available() >= HeaderSize)
+        {
+            // Sync: the header.
+            if (at(0) != Header[0] || at(1) != Header[1] || at(2) != Header[2] || at(3) != Header[3])
+            {
+                tail++;
+                skippedBytes++;
+                continue;
+            }
+            // Payload: wait for the complete frame.
+            if (available() < FrameSize)
+            {
+                break;
+            }
+            // Trailer: otherwise the header was noise or the frame is truncated. Resync after the header byte.
+            if (at(FrameSize - 2) != Trailer[0] || at(FrameSize - 1) != Trailer[1])
+            {
+                tail++;
+                badFrames++;
+                continue;
+            }
+
+            Rd03DFrame frame;
+            decodeFrame(frame);
+            tail += FrameSize;
+            frameCount++;
+            frames++;
+            onFrame(context, frame);
+        }
+        return frames;
+    }
+
+    void Rd03DParser::decodeFrame(Rd03DFrame& frame) const
+    {
+        for (size_t i = 0; i < Rd03DFrame::TargetCount; i++)
+        {
+            size_t  offset                       = HeaderSize + i * 8;
+            Target& target                       = frame.targets[i];
+            target.x                             = decodeSigned(readUInt16(offset));
+            target.y                             = decodeSigned(readUInt16(offset + 2));
+            target.speedCentimetersPerSecond     = decodeSigned(readUInt16(offset + 4));
+            target.distanceResolutionMillimeters = readUInt16(offset + 6);
+            if (0 == target.x && 0 == target.y)
+            {
+                continue; // no target: distance 0.
+            }
+            float distance             = std::sqrt(static_cast<float>(target.x) * target.x + static_cast<float>(target.y) * target.y);
+            target.distanceMillimeters = static_cast<int16_t>(distance < INT16_MAX ? distance : INT16_MAX);
+            target.angle               = std::atan2(static_cast<float>(target.y), static_cast<float>(target.x)) * 180.0f / static_cast<float>(M_PI);
+        }
+    }
+} // namespace IotZoo
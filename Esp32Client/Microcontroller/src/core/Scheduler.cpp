@@ -0,0 +1,99 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/Scheduler.hpp"
+
+namespace IotZoo
+{
+    int Scheduler::addTask(const char* name, uint32_t intervalMillis, TaskCallback callback, uint32_t nowMillis)
+    {
+        if (!callback)
+        {
+            return InvalidTaskId;
+        }
+        Task task;
+        task.name           = name;
+        task.intervalMillis = intervalMillis;
+        task.nextWakeMillis = nowMillis;
+        task.callback       = callback;
+        tasks.push_back(task);
+        return static_cast<int>(tasks.size() - 1);
+    }
+
+    void Scheduler::setInterval(int taskId, uint32_t intervalMillis)
+    {
+        if (!isValid(taskId))
+        {
+            return;
+        }
+        Task& task = tasks[taskId];
+        // keep the last wake time, only the period changes.
+        uint32_t lastWakeMillis = task.nextWakeMillis - task.intervalMillis;
+        task.intervalMillis     = intervalMillis;
+        task.nextWakeMillis     = lastWakeMillis + intervalMillis;
+    }
+
+    uint32_t Scheduler::getInterval(int taskId) const
+    {
+        return isValid(taskId) ? tasks[taskId].intervalMillis : 0;
+    }
+
+    const char* Scheduler::getTaskName(int taskId) const
+    {
+        return isValid(taskId) ? tasks[taskId].name : "";
+    }
+
+    void Scheduler::wakeUp(int taskId, uint32_t nowMillis)
+    {
+        if (isValid(taskId))
+        {
+            tasks[taskId].nextWakeMillis = nowMillis;
+        }
+    }
+
+    size_t Scheduler::runDueTasks(uint32_t nowMillis)
+    {
+        size_t executed = 0;
+        for (Task& task : tasks)
+        {
+            if (!isDue(nowMillis, task.nextWakeMillis))
+            {
+                continue;
+            }
+            task.nextWakeMillis += task.intervalMillis;
+            if (isDue(nowMillis, task.nextWakeMillis) && task.intervalMillis > 0)
+            {
+                // overrun: skip the missed periods instead of running the task several times in a row.
+                task.nextWakeMillis = nowMillis + task.intervalMillis;
+            }
+            task.callback();
+            executed++;
+        }
+        return executed;
+    }
+
+    uint32_t Scheduler::millisUntilNextDeadline(uint32_t nowMillis) const
+    {
+        uint32_t minMillis = UINT32_MAX;
+        for (const Task& task : tasks)
+        {
+            if (isDue(nowMillis, task.nextWakeMillis))
+            {
+                return 0;
+            }
+            uint32_t untilDeadline = task.nextWakeMillis - nowMillis;
+            if (untilDeadline < minMillis)
+            {
+                minMillis = untilDeadline;
+            }
+        }
+        return minMillis;
+    }
+} // namespace IotZoo
@@ -0,0 +1,227 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/SettingsCache.hpp"
+#include "core/Fnv1a.hpp"
+
+namespace IotZoo
+{
+    SettingsCache::SettingsCache(SettingsStorage* storage, uint32_t writeBackDelayMillis)
+        : storage(storage), writeBackDelayMillis(writeBackDelayMillis)
+    {
+    }
+
+    void SettingsCache::load(const std::vector<std::pair<const char*, ValueType>>& keys)
+    {
+        bool isOpen = storage->begin(true);
+        for (const auto& key : keys)
+        {
+            uint32_t hash = fnv1a(key.first);
+            if (nullptr != find(key.first, hash))
+            {
+                continue;
+            }
+            Entry entry;
+            entry.key  = key.first;
+            entry.hash = hash;
+            entry.type = key.second;
+            if (isOpen)
+            {
+                read(entry);
+            }
+            entries.push_back(entry);
+        }
+        if (isOpen)
+        {
+            storage->end();
+        }
+    }
+
+    std::string SettingsCache::getString(const char* key, const std::string& fallbackValue)
+    {
+        const Entry& entry = getEntry(key, ValueType::String);
+        return entry.exists ? entry.stringValue : fallbackValue;
+    }
+
+    int32_t SettingsCache::getLong(const char* key, int32_t fallbackValue)
+    {
+        const Entry& entry = getEntry(key, ValueType::Long);
+        return entry.exists ? entry.numberValue : fallbackValue;
+    }
+
+    uint16_t SettingsCache::getUShort(const char* key, uint16_t fallbackValue)
+    {
+        const Entry& entry = getEntry(key, ValueType::UShort);
+        return entry.exists ? static_cast<uint16_t>(entry.numberValue) : fallbackValue;
+    }
+
+    void SettingsCache::putString(const char* key, const std::string& value, uint32_t nowMillis)
+    {
+        Entry& entry = getEntry(key, ValueType::String);
+        if (entry.exists && entry.stringValue == value)
+        {
+            return; // unchanged, spare the flash.
+        }
+        markDirty(entry, nowMillis).stringValue = value;
+    }
+
+    void SettingsCache::putLong(const char* key, int32_t value, uint32_t nowMillis)
+    {
+        Entry& entry = getEntry(key, ValueType::Long);
+        if (entry.exists && entry.numberValue == value)
+        {
+            return;
+        }
+        markDirty(entry, nowMillis).numberValue = value;
+    }
+
+    void SettingsCache::putUShort(const char* key, uint16_t value, uint32_t nowMillis)
+    {
+        Entry& entry = getEntry(key, ValueType::UShort);
+        if (entry.exists && entry.numberValue == value)
+        {
+            return;
+        }
+        markDirty(entry, nowMillis).numberValue = value;
+    }
+
+    size_t SettingsCache::flush()
+    {
+        if (getDirtyCount() == 0)
+        {
+            return 0;
+        }
+        if (!storage->begin(false))
+        {
+            writeErrors++;
+            return 0;
+        }
+        size_t written = 0;
+        for (Entry& entry : entries)
+        {
+            if (!entry.dirty)
+            {
+                continue;
+            }
+            if (write(entry))
+            {
+                entry.dirty = false;
+                written++;
+            }
+            else
+            {
+                writeErrors++; // stays dirty, the next flush tries again.
+            }
+        }
+        storage->end();
+        return written;
+    }
+
+    size_t SettingsCache::flushIfDue(uint32_t nowMillis)
+    {
+        if (static_cast<int32_t>(nowMillis - lastChangeMillis) < static_cast<int32_t>(writeBackDelayMillis))
+        {
+            return 0;
+        }
+        return flush();
+    }
+
+    size_t SettingsCache::getDirtyCount() const
+    {
+        size_t dirtyCount = 0;
+        for (const Entry& entry : entries)
+        {
+            if (entry.dirty)
+            {
+                dirtyCount++;
+            }
+        }
+        return dirtyCount;
+    }
+
+    SettingsCache::Entry& SettingsCache::getEntry(const char* key, ValueType type)
+    {
+        uint32_t hash  = fnv1a(key);
+        Entry*   entry = find(key, hash);
+        if (nullptr != entry)
+        {
+            return *entry;
+        }
+
+        // first access of a key which has not been loaded: read through.
+        Entry newEntry;
+        newEntry.key  = key;
+        newEntry.hash = hash;
+        newEntry.type = type;
+        if (storage->begin(true))
+        {
+            read(newEntry);
+            storage->end();
+        }
+        entries.push_back(newEntry);
+        return entries.back();
+    }
+
+    SettingsCache::Entry* SettingsCache::find(const char* key, uint32_t hash)
+    {
+        for (Entry& entry : entries)
+        {
+            if (entry.hash == hash && entry.key == key)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void SettingsCache::read(Entry& entry)
+    {
+        entry.exists = storage->isKey(entry.key.c_str());
+        if (!entry.exists)
+        {
+            return;
+        }
+        switch (entry.type)
+        {
+        case ValueType::String:
+            entry.stringValue = storage->getString(entry.key.c_str());
+            break;
+        case ValueType::Long:
+            entry.numberValue = storage->getLong(entry.key.c_str());
+            break;
+        case ValueType::UShort:
+            entry.numberValue = storage->getUShort(entry.key.c_str());
+            break;
+        }
+    }
+
+    bool SettingsCache::write(const Entry& entry)
+    {
+        switch (entry.type)
+        {
+        case ValueType::String:
+            // an empty string writes 0 bytes, but is no error.
+            return storage->putString(entry.key.c_str(), entry.stringValue) == entry.stringValue.length();
+        case ValueType::Long:
+            return storage->putLong(entry.key.c_str(), entry.numberValue) == sizeof(int32_t);
+        case ValueType::UShort:
+            return storage->putUShort(entry.key.c_str(), static_cast<uint16_t>(entry.numberValue)) == sizeof(uint16_t);
+        }
+        return false;
+    }
+
+    SettingsCache::Entry& SettingsCache::markDirty(Entry& entry, uint32_t nowMillis)
+    {
+        entry.exists     = true;
+        entry.dirty      = true;
+        lastChangeMillis = nowMillis;
+        return entry;
+    }
+} // namespace IotZoo
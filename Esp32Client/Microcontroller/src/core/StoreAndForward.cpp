@@ -0,0 +1,142 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/StoreAndForward.hpp"
+
+#include <cstring>
+
+namespace IotZoo
+{
+    StoreAndForward::StoreAndForward(TelemetryLog* log, const StoreAndForwardParameters& parameters)
+        : log(log), parameters(parameters), ram(parameters.ramCapacity > 0 ? parameters.ramCapacity : 1)
+    {
+        replayTokens = parameters.replayBurst;
+    }
+
+    bool StoreAndForward::store(const char* topic, const uint8_t* payload, size_t length, bool retain, uint32_t nowMillis)
+    {
+        size_t topicLength = strlen(topic);
+        if (0 == topicLength || topicLength > StoredMessage::MaxTopicLength || length > StoredMessage::MaxPayloadLength)
+        {
+            return false;
+        }
+        if (!outage)
+        {
+            outage            = true;
+            outageStartMillis = nowMillis;
+        }
+
+        bool           writeThrough = nullptr != log && nowMillis - outageStartMillis >= parameters.ramHoldMillis;
+        StoredMessage  flashMessage;
+        StoredMessage* message = &flashMessage;
+        if (writeThrough)
+        {
+            while (ramCount > 0)
+            {
+                spillOldest(); // the older messages first.
+            }
+        }
+        else
+        {
+            if (ramCount == ram.size())
+            {
+                spillOldest();
+            }
+            message = &getRamMessage(ramCount);
+        }
+        message->setTopic(topic);
+        message->timestamp = nowMillis;
+        message->restored  = false;
+        message->retain    = retain;
+        message->length    = static_cast<uint16_t>(length);
+        memcpy(message->payload, payload, length);
+
+        if (!writeThrough)
+        {
+            ramCount++;
+            return true;
+        }
+        if (!log->append(flashMessage))
+        {
+            dropped++;
+            return false;
+        }
+        spilled++;
+        return true;
+    }
+
+    void StoreAndForward::spillOldest()
+    {
+        if (nullptr != log && log->append(getRamMessage(0)))
+        {
+            spilled++;
+        }
+        else
+        {
+            dropped++;
+        }
+        ramHead = (ramHead + 1) % ram.size();
+        ramCount--;
+    }
+
+    size_t StoreAndForward::loop(bool connected, uint32_t nowMillis, Sender send, void* context)
+    {
+        if (!connected)
+        {
+            if (!outage)
+            {
+                outage            = true;
+                outageStartMillis = nowMillis;
+            }
+            if (nullptr != log && nowMillis - outageStartMillis >= parameters.ramHoldMillis)
+            {
+                while (ramCount > 0)
+                {
+                    spillOldest(); // the outage is not a short one: survive a reset.
+                }
+            }
+            return 0;
+        }
+        outage = false;
+
+        replayTokens += (nowMillis - millisLastReplay) * parameters.replayMessagesPerSecond / 1000.0f;
+        millisLastReplay = nowMillis;
+        if (replayTokens > parameters.replayBurst)
+        {
+            replayTokens = parameters.replayBurst;
+        }
+
+        size_t        count = 0;
+        StoredMessage flashMessage;
+        while (replayTokens >= 1)
+        {
+            // The messages in the flash are older than the ones in the RAM.
+            bool                 fromFlash = nullptr != log && log->peek(flashMessage);
+            const StoredMessage* message   = fromFlash ? &flashMessage : (ramCount > 0 ? &getRamMessage(0) : nullptr);
+            if (nullptr == message || !send(context, *message))
+            {
+                break;
+            }
+            if (fromFlash)
+            {
+                log->markSent();
+            }
+            else
+            {
+                ramHead = (ramHead + 1) % ram.size();
+                ramCount--;
+            }
+            replayTokens -= 1;
+            replayed++;
+            count++;
+        }
+        return count;
+    }
+} // namespace IotZoo
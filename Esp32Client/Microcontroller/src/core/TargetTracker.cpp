@@ -0,0 +1,260 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/TargetTracker.hpp"
+
+namespace IotZoo
+{
+    namespace
+    {
+        constexpr float InitialVelocityVariance = 1000.0f * 1000.0f; // (mm/s)², a person walks up to ~1.5 m/s.
+        constexpr int   Unassigned              = -1;
+    } // namespace
+
+    void AxisFilter::reset(float measuredPosition, float measurementVariance)
+    {
+        position = measuredPosition;
+        velocity = 0;
+        p00      = measurementVariance;
+        p01      = 0;
+        p11      = InitialVelocityVariance;
+    }
+
+    void AxisFilter::predict(float seconds, float accelerationVariance)
+    {
+        float seconds2 = seconds * seconds;
+        position += velocity * seconds;
+        // P = F P F' + Q, white acceleration noise.
+        p00 += 2 * seconds * p01 + seconds2 * p11 + accelerationVariance * seconds2 * seconds2 / 4;
+        p01 += seconds * p11 + accelerationVariance * seconds2 * seconds / 2;
+        p11 += accelerationVariance * seconds2;
+    }
+
+    void AxisFilter::update(float measuredPosition, float measurementVariance)
+    {
+        float innovation = measuredPosition - position;
+        float s          = p00 + measurementVariance;
+        float k0         = p00 / s;
+        float k1         = p01 / s;
+        position += k0 * innovation;
+        velocity += k1 * innovation;
+        p11 -= k1 * p01;
+        p01 *= (1 - k0);
+        p00 *= (1 - k0);
+    }
+
+    TargetTracker::TargetTracker(const TrackerParameters& parameters) : parameters(parameters)
+    {
+    }
+
+    void TargetTracker::clear()
+    {
+        for (auto& track : tracks)
+        {
+            track = Track();
+        }
+    }
+
+    void TargetTracker::update(const Measurement* measurements, size_t count, uint32_t nowMillis)
+    {
+        if (count > MaxMeasurements)
+        {
+            count = MaxMeasurements;
+        }
+        float accelerationVariance = parameters.accelerationNoise * parameters.accelerationNoise;
+        float measurementVariance  = parameters.measurementNoiseMillimeters * parameters.measurementNoiseMillimeters;
+
+        for (auto& track : tracks)
+        {
+            if (track.active)
+            {
+                float seconds = static_cast<float>(nowMillis - track.millis) / 1000.0f;
+                track.x.predict(seconds, accelerationVariance);
+                track.y.predict(seconds, accelerationVariance);
+                track.millis = nowMillis;
+            }
+        }
+
+        int assignment[MaxMeasurements];
+        associate(measurements, count, assignment);
+
+        bool updated[MaxTracks] = {};
+        for (size_t m = 0; m < count; m++)
+        {
+            if (Unassigned != assignment[m])
+            {
+                Track& track = tracks[assignment[m]];
+                track.x.update(measurements[m].x, measurementVariance);
+                track.y.update(measurements[m].y, measurementVariance);
+                updated[assignment[m]] = true;
+            }
+        }
+
+        for (size_t t = 0; t < MaxTracks; t++)
+        {
+            Track& track = tracks[t];
+            if (!track.active)
+            {
+                continue;
+            }
+            if (updated[t])
+            {
+                track.misses = 0;
+                if (track.hits < 255)
+                {
+                    track.hits++;
+                }
+                if (track.hits >= parameters.hitsToConfirm)
+                {
+                    track.confirmed = true;
+                }
+            }
+            else
+            {
+                track.hits = 0;
+                track.misses++;
+                // A tentative track dies with its first miss: noise does not live long.
+                if (!track.confirmed || track.misses >= parameters.missesToDelete)
+                {
+                    track.active = false;
+                }
+            }
+        }
+
+        // Birth: the unassigned measurements start tentative tracks.
+        for (size_t m = 0; m < count; m++)
+        {
+            if (Unassigned != assignment[m])
+            {
+                continue;
+            }
+            for (auto& track : tracks)
+            {
+                if (!track.active)
+                {
+                    track        = Track();
+                    track.id     = nextId++;
+                    track.active = true;
+                    track.hits   = 1;
+                    track.millis = nowMillis;
+                    track.x.reset(measurements[m].x, measurementVariance);
+                    track.y.reset(measurements[m].y, measurementVariance);
+                    track.confirmed = track.hits >= parameters.hitsToConfirm;
+                    if (0 == nextId)
+                    {
+                        nextId = 1;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    void TargetTracker::associate(const Measurement* measurements, size_t count, int* assignment) const
+    {
+        float gate2 = parameters.gateMillimeters * parameters.gateMillimeters;
+
+        // cost[m][t]: squared distance, or < 0 outside of the gate.
+        float cost[MaxMeasurements][MaxTracks];
+        for (size_t m = 0; m < count; m++)
+        {
+            for (size_t t = 0; t < MaxTracks; t++)
+            {
+                float dx   = measurements[m].x - tracks[t].x.position;
+                float dy   = measurements[m].y - tracks[t].y.position;
+                float d2   = dx * dx + dy * dy;
+                cost[m][t] = (tracks[t].active && d2 <= gate2) ? d2 : -1;
+            }
+            assignment[m] = Unassigned;
+        }
+
+        // Every measurement takes a track or none (index MaxTracks). An unassigned measurement costs the gate, so
+        // any assignment within the gate is preferred.
+        constexpr int Choices      = MaxTracks + 1;
+        int           combinations = 1;
+        for (size_t m = 0; m < count; m++)
+        {
+            combinations *= Choices;
+        }
+        float bestCost = 0;
+        int   best     = -1;
+        for (int combination = 0; combination < combinations; combination++)
+        {
+            bool     valid = true;
+            float    total = 0;
+            unsigned used  = 0;
+            int      code  = combination;
+            for (size_t m = 0; m < count && valid; m++)
+            {
+                int t = code % Choices;
+                code /= Choices;
+                if (MaxTracks == static_cast<size_t>(t))
+                {
+                    total += gate2;
+                }
+                else if (cost[m][t] < 0 || (used & (1u << t)))
+                {
+                    valid = false;
+                }
+                else
+                {
+                    used |= 1u << t;
+                    total += cost[m][t];
+                }
+            }
+            if (valid && (best < 0 || total < bestCost))
+            {
+                best     = combination;
+                bestCost = total;
+            }
+        }
+
+        for (size_t m = 0; m < count; m++)
+        {
+            int t = best % Choices;
+            best /= Choices;
+            assignment[m] = (MaxTracks == static_cast<size_t>(t)) ? Unassigned : t;
+        }
+    }
+
+    size_t TargetTracker::getConfirmedTracks(const Track** result, size_t capacity) const
+    {
+        size_t count = 0;
+        for (const auto& track : tracks)
+        {
+            if (!track.active || !track.confirmed || count >= capacity)
+            {
+                continue;
+            }
+            // insertion sort by id
+            size_t position = count++;
+            while (position > 0 && result[position - 1]->id > track.id)
+            {
+                result[position] = result[position - 1];
+                position--;
+            }
+            result[position] = &track;
+        }
+        return count;
+    }
+
+    size_t TargetTracker::getConfirmedTrackCount() const
+    {
+        size_t count = 0;
+        for (const auto& track : tracks)
+        {
+            if (track.active && track.confirmed)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+} // namespace IotZoo
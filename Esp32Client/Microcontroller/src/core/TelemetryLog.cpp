@@ -0,0 +1,324 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/TelemetryLog.hpp"
+#include "core/Fnv1a.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace IotZoo
+{
+    bool StoredMessage::setTopic(const char* topic)
+    {
+        size_t length = strlen(topic);
+        if (0 == length || length > MaxTopicLength)
+        {
+            return false;
+        }
+        memcpy(this->topic, topic, length + 1);
+        topicLength = static_cast<uint8_t>(length);
+        return true;
+    }
+
+    uint32_t TelemetryLog::getChecksum(const RecordHeader& header, const char* topic, const uint8_t* payload)
+    {
+        uint32_t hash = fnv1a(reinterpret_cast<const uint8_t*>(&header.length), sizeof(header.length));
+        hash          = fnv1a(&header.flags, sizeof(header.flags), hash);
+        hash          = fnv1a(&header.topicLength, sizeof(header.topicLength), hash);
+        hash          = fnv1a(reinterpret_cast<const uint8_t*>(&header.timestamp), sizeof(header.timestamp), hash);
+        hash          = fnv1a(reinterpret_cast<const uint8_t*>(topic), header.topicLength, hash);
+        return fnv1a(payload, header.length, hash);
+    }
+
+    bool TelemetryLog::readSectorHeader(size_t sector, SectorHeader& header)
+    {
+        return partition.read(sector * partition.getSectorSize(), &header, sizeof(header)) && Magic == header.magic;
+    }
+
+    bool TelemetryLog::begin()
+    {
+        const size_t sectorCount = getSectorCount();
+        const size_t sectorSize  = partition.getSectorSize();
+        if (sectorCount < 2)
+        {
+            return false;
+        }
+
+        // The sector written last has the highest sequence, the oldest one the lowest.
+        bool     found          = false;
+        size_t   headSector     = 0;
+        size_t   oldestSector   = 0;
+        uint32_t oldestSequence = UINT32_MAX;
+        for (size_t sector = 0; sector < sectorCount; sector++)
+        {
+            SectorHeader header;
+            if (!readSectorHeader(sector, header))
+            {
+                continue;
+            }
+            if (!found || header.sequence > writeSequence)
+            {
+                headSector    = sector;
+                writeSequence = header.sequence;
+            }
+            if (header.sequence < oldestSequence)
+            {
+                oldestSector   = sector;
+                oldestSequence = header.sequence;
+            }
+            found = true;
+        }
+
+        pendingCount  = 0;
+        restoredCount = 0;
+        peekedOffset  = SIZE_MAX;
+        if (!found)
+        {
+            SectorHeader header = {Magic, 1};
+            if (!partition.eraseSector(0) || !partition.write(0, &header, sizeof(header)))
+            {
+                return false;
+            }
+            writeSequence = 1;
+            writeOffset   = sizeof(SectorHeader);
+            readOffset    = writeOffset;
+            return true;
+        }
+
+        // The write position: behind the last record of the head sector. A torn header fills the sector.
+        size_t offset    = headSector * sectorSize + sizeof(SectorHeader);
+        size_t sectorEnd = (headSector + 1) * sectorSize;
+        while (offset + sizeof(RecordHeader) <= sectorEnd)
+        {
+            RecordHeader header;
+            if (!partition.read(offset, &header, sizeof(header)))
+            {
+                return false;
+            }
+            if (FreeLength == header.length)
+            {
+                bool erased = true;
+                for (size_t index = 0; index < sizeof(header); index++)
+                {
+                    erased = erased && 0xFF == reinterpret_cast<const uint8_t*>(&header)[index];
+                }
+                offset = erased ? offset : sectorEnd;
+                break;
+            }
+            if (!isRecord(header) || offset + getRecordSize(header) > sectorEnd)
+            {
+                offset = sectorEnd;
+                break;
+            }
+            offset += getRecordSize(header);
+        }
+        writeOffset = offset;
+
+        // The replay position: the first committed record, starting with the oldest sector.
+        readOffset = oldestSector * sectorSize + sizeof(SectorHeader);
+        offset     = readOffset;
+        bool first = true;
+        RecordHeader header;
+        while (seek(offset, header))
+        {
+            if (StateCommitted == header.state)
+            {
+                if (first)
+                {
+                    readOffset = offset;
+                    first      = false;
+                }
+                pendingCount++;
+            }
+            offset += getRecordSize(header);
+        }
+        if (first)
+        {
+            readOffset = writeOffset;
+        }
+        restoredCount = pendingCount;
+        return true;
+    }
+
+    bool TelemetryLog::seek(size_t& offset, RecordHeader& header)
+    {
+        const size_t sectorCount = getSectorCount();
+        const size_t sectorSize  = partition.getSectorSize();
+        for (size_t visited = 0; visited <= sectorCount;)
+        {
+            if (offset == writeOffset)
+            {
+                return false;
+            }
+            size_t sectorEnd = getSectorEnd(offset);
+            if (offset + sizeof(RecordHeader) <= sectorEnd && partition.read(offset, &header, sizeof(header)) && isRecord(header) &&
+                offset + getRecordSize(header) <= sectorEnd)
+            {
+                return true;
+            }
+            size_t sector      = getSector(offset);
+            size_t writeSector = getSector(writeOffset);
+            if (sector == writeSector)
+            {
+                offset = writeOffset;
+                return false;
+            }
+            // The end of the records of the sector: continue with the next sector in use.
+            SectorHeader sectorHeader;
+            do
+            {
+                sector = (sector + 1) % sectorCount;
+                visited++;
+            } while (sector != writeSector && !readSectorHeader(sector, sectorHeader) && visited <= sectorCount);
+            offset = sector * sectorSize + sizeof(SectorHeader);
+        }
+        offset = writeOffset;
+        return false;
+    }
+
+    bool TelemetryLog::readRecord(size_t offset, const RecordHeader& header, StoredMessage& message)
+    {
+        if (!partition.read(offset + sizeof(RecordHeader), message.topic, header.topicLength) ||
+            !partition.read(offset + sizeof(RecordHeader) + header.topicLength, message.payload, header.length) ||
+            header.checksum != getChecksum(header, message.topic, message.payload))
+        {
+            return false;
+        }
+        message.topic[header.topicLength] = '\0';
+        message.topicLength               = header.topicLength;
+        message.timestamp                 = header.timestamp;
+        message.restored                  = restoredCount > 0;
+        message.retain                    = 0 != (header.flags & FlagRetain);
+        message.length                    = header.length;
+        return true;
+    }
+
+    bool TelemetryLog::append(const StoredMessage& message)
+    {
+        if (message.length > StoredMessage::MaxPayloadLength || 0 == message.topicLength)
+        {
+            return false;
+        }
+
+        RecordHeader header;
+        header.length      = message.length;
+        header.state       = 0xFF; // committed after the topic and the payload are written.
+        header.flags       = message.retain ? FlagRetain : 0;
+        header.topicLength = message.topicLength;
+        memset(header.reserved, 0xFF, sizeof(header.reserved));
+        header.timestamp = message.timestamp;
+        header.checksum  = getChecksum(header, message.topic, message.payload);
+
+        size_t size = getRecordSize(header);
+        if (writeOffset + size > getSectorEnd(writeOffset) && !advanceWriteSector())
+        {
+            return false;
+        }
+
+        uint8_t record[sizeof(RecordHeader) + StoredMessage::MaxTopicLength + StoredMessage::MaxPayloadLength + 3];
+        memset(record, 0xFF, size);
+        memcpy(record, &header, sizeof(header));
+        memcpy(record + sizeof(header), message.topic, message.topicLength);
+        memcpy(record + sizeof(header) + message.topicLength, message.payload, message.length);
+
+        size_t  offset = writeOffset;
+        uint8_t state  = StateCommitted;
+        writeOffset += size; // a failed write must not be written again.
+        if (!partition.write(offset, record, size) || !partition.write(offset + offsetof(RecordHeader, state), &state, sizeof(state)))
+        {
+            return false;
+        }
+        pendingCount++;
+        return true;
+    }
+
+    bool TelemetryLog::advanceWriteSector()
+    {
+        const size_t sectorSize = partition.getSectorSize();
+        size_t       sector     = (getSector(writeOffset) + 1) % getSectorCount();
+
+        if (readOffset != writeOffset && getSector(readOffset) == sector)
+        {
+            // The oldest messages not sent yet are in the sector: evict them, the replay continues behind them.
+            size_t       offset = readOffset;
+            RecordHeader header;
+            while (seek(offset, header) && getSector(offset) == sector)
+            {
+                if (StateCommitted == header.state)
+                {
+                    evicted++;
+                    pendingCount -= pendingCount > 0 ? 1 : 0;
+                    restoredCount -= restoredCount > 0 ? 1 : 0;
+                }
+                offset += getRecordSize(header);
+            }
+            readOffset = offset;
+        }
+        if (SIZE_MAX != peekedOffset && getSector(peekedOffset) == sector)
+        {
+            peekedOffset = SIZE_MAX;
+        }
+
+        SectorHeader header = {Magic, writeSequence + 1};
+        if (!partition.eraseSector(sector * sectorSize) || !partition.write(sector * sectorSize, &header, sizeof(header)))
+        {
+            return false;
+        }
+        if (readOffset == writeOffset)
+        {
+            readOffset = sector * sectorSize + sizeof(SectorHeader);
+        }
+        writeSequence = header.sequence;
+        writeOffset   = sector * sectorSize + sizeof(SectorHeader);
+        return true;
+    }
+
+    bool TelemetryLog::peek(StoredMessage& message)
+    {
+        RecordHeader header;
+        while (seek(readOffset, header))
+        {
+            if (StateCommitted == header.state)
+            {
+                if (readRecord(readOffset, header, message))
+                {
+                    peekedOffset = readOffset;
+                    peekedSize   = getRecordSize(header);
+                    return true;
+                }
+                corrupted++;
+                pendingCount -= pendingCount > 0 ? 1 : 0;
+                restoredCount -= restoredCount > 0 ? 1 : 0;
+            }
+            else if (StateSent != header.state)
+            {
+                corrupted++; // torn by a reset before it was committed.
+            }
+            readOffset += getRecordSize(header);
+        }
+        peekedOffset = SIZE_MAX;
+        return false;
+    }
+
+    void TelemetryLog::markSent()
+    {
+        if (SIZE_MAX == peekedOffset || peekedOffset != readOffset)
+        {
+            return;
+        }
+        uint8_t state = StateSent;
+        partition.write(peekedOffset + offsetof(RecordHeader, state), &state, sizeof(state));
+        readOffset += peekedSize;
+        peekedOffset = SIZE_MAX;
+        pendingCount -= pendingCount > 0 ? 1 : 0;
+        restoredCount -= restoredCount > 0 ? 1 : 0;
+    }
+} // namespace IotZoo
@@ -0,0 +1,90 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/TopicTable.hpp"
+#include "core/Fnv1a.hpp"
+
+#include <cstring>
+
+namespace IotZoo
+{
+    TopicId TopicTable::add(const char* topic)
+    {
+        return add(topic, "");
+    }
+
+    TopicId TopicTable::add(const char* prefix, const char* suffix)
+    {
+        size_t   prefixLength = strlen(prefix);
+        size_t   suffixLength = strlen(suffix);
+        size_t   length       = prefixLength + suffixLength;
+        uint32_t hash         = fnv1a(suffix, fnv1a(prefix));
+
+        TopicId topicId = find(prefix, prefixLength, suffix, suffixLength, hash);
+        if (InvalidTopicId != topicId)
+        {
+            return topicId;
+        }
+        if (length == 0 || length > UINT16_MAX || entries.size() >= static_cast<size_t>(INT16_MAX))
+        {
+            return InvalidTopicId;
+        }
+
+        Entry entry;
+        entry.hash   = hash;
+        entry.offset = static_cast<uint32_t>(buffer.size());
+        entry.length = static_cast<uint16_t>(length);
+        buffer.insert(buffer.end(), prefix, prefix + prefixLength);
+        buffer.insert(buffer.end(), suffix, suffix + suffixLength);
+        buffer.push_back('\0');
+        entries.push_back(entry);
+        return static_cast<TopicId>(entries.size() - 1);
+    }
+
+    TopicId TopicTable::find(const char* topic) const
+    {
+        return find(topic, strlen(topic), "", 0, fnv1a(topic));
+    }
+
+    TopicId TopicTable::find(const char* prefix, size_t prefixLength, const char* suffix, size_t suffixLength,
+                             uint32_t hash) const
+    {
+        for (size_t index = 0; index < entries.size(); index++)
+        {
+            const Entry& entry = entries[index];
+            if (entry.hash != hash || entry.length != prefixLength + suffixLength)
+            {
+                continue;
+            }
+            const char* topic = &buffer[entry.offset];
+            if (memcmp(topic, prefix, prefixLength) == 0 && memcmp(topic + prefixLength, suffix, suffixLength) == 0)
+            {
+                return static_cast<TopicId>(index);
+            }
+        }
+        return InvalidTopicId;
+    }
+
+    const char* TopicTable::get(TopicId topicId) const
+    {
+        return isValid(topicId) ? &buffer[entries[topicId].offset] : "";
+    }
+
+    size_t TopicTable::getLength(TopicId topicId) const
+    {
+        return isValid(topicId) ? entries[topicId].length : 0;
+    }
+
+    void TopicTable::clear()
+    {
+        buffer.clear();
+        entries.clear();
+    }
+} // namespace IotZoo
@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/WindowAggregator.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace IotZoo
+{
+    void RunningStatistics::add(float value)
+    {
+        count++;
+        if (1 == count)
+        {
+            mean = min = max = value;
+            m2               = 0;
+            return;
+        }
+        float delta = value - mean;
+        mean += delta / static_cast<float>(count);
+        m2 += delta * (value - mean);
+        min = value < min ? value : min;
+        max = value > max ? value : max;
+    }
+
+    void RunningStatistics::reset()
+    {
+        count = 0;
+        mean  = 0;
+        m2    = 0;
+        min   = 0;
+        max   = 0;
+    }
+
+    float RunningStatistics::getStandardDeviation() const
+    {
+        return std::sqrt(getVariance());
+    }
+
+    size_t AggregateSummary::toJson(char* buffer, size_t size, unsigned int decimalPlaces) const
+    {
+        char invalidMember[24] = "";
+        if (invalid > 0)
+        {
+            snprintf(invalidMember, sizeof(invalidMember), ",\"invalid\":%u", static_cast<unsigned int>(invalid));
+        }
+        int precision = static_cast<int>(decimalPlaces);
+        int length    = snprintf(buffer, size, "{\"mean\":%.*f,\"min\":%.*f,\"max\":%.*f,\"stddev\":%.*f,\"count\":%u%s}", precision, mean, precision,
+                                 min, precision, max, precision, stddev, static_cast<unsigned int>(count), invalidMember);
+        if (length < 0 || static_cast<size_t>(length) >= size)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(length);
+    }
+
+    bool WindowAggregator::advance(uint32_t nowMillis, AggregateSummary& summary)
+    {
+        bool open      = statistics.getCount() > 0 || invalid > 0;
+        bool completed = false;
+        if (open && nowMillis - windowStartMillis >= windowMillis)
+        {
+            summary.count   = statistics.getCount();
+            summary.invalid = invalid;
+            summary.mean    = statistics.getMean();
+            summary.min     = statistics.getMin();
+            summary.max     = statistics.getMax();
+            summary.stddev  = statistics.getStandardDeviation();
+            statistics.reset();
+            invalid   = 0;
+            open      = false;
+            completed = true;
+        }
+        if (!open)
+        {
+            windowStartMillis = nowMillis;
+        }
+        return completed;
+    }
+
+    bool WindowAggregator::add(float value, uint32_t nowMillis, AggregateSummary& summary)
+    {
+        bool completed = advance(nowMillis, summary);
+        statistics.add(value);
+        return completed;
+    }
+
+    bool WindowAggregator::addInvalid(uint32_t nowMillis, AggregateSummary& summary)
+    {
+        bool completed = advance(nowMillis, summary);
+        invalid++;
+        return completed;
+    }
+
+    void ImpulsePowerMeter::start(uint32_t nowMillis)
+    {
+        if (!started)
+        {
+            started           = true;
+            windowStartMillis = nowMillis;
+        }
+    }
+
+    float ImpulsePowerMeter::addImpulse(uint32_t nowMillis)
+    {
+        start(nowMillis);
+        impulses++;
+        float watt = 0;
+        if (hasImpulse && nowMillis != lastImpulseMillis)
+        {
+            watt = wattHoursPerImpulse * 3600000.0f / static_cast<float>(nowMillis - lastImpulseMillis);
+            statistics.add(watt);
+        }
+        hasImpulse        = true;
+        lastImpulseMillis = nowMillis;
+        return watt;
+    }
+
+    bool ImpulsePowerMeter::poll(uint32_t nowMillis, AggregateSummary& summary)
+    {
+        start(nowMillis);
+        uint32_t elapsedMillis = nowMillis - windowStartMillis;
+        if (elapsedMillis < windowMillis)
+        {
+            return false;
+        }
+        summary.count   = impulses;
+        summary.invalid = 0;
+        summary.mean    = static_cast<float>(impulses) * wattHoursPerImpulse * 3600000.0f / static_cast<float>(elapsedMillis);
+        summary.min     = statistics.getCount() > 0 ? statistics.getMin() : summary.mean;
+        summary.max     = statistics.getCount() > 0 ? statistics.getMax() : summary.mean;
+        summary.stddev  = statistics.getStandardDeviation();
+        statistics.reset();
+        impulses          = 0;
+        windowStartMillis = nowMillis;
+        return true;
+    }
+} // namespace IotZoo
@@ -0,0 +1,38 @@
+// --------------------------------------------------------------------------------------------------------------------
+//      ____    ______   _____
+//     /  _/___/_  __/  /__  / ____  ____
+//     / // __ \/ /       / / / __ \/ __ \  P L A Y G R O U N D
+//   _/ // /_/ / /       / /_/ /_/ / /_/ /
+//  /___/\____/_/       /____|____/\____/   (c) 2025 - 2026 Holger Freudenreich under the MIT licence.
+//
+// --------------------------------------------------------------------------------------------------------------------
+// Firmware for ESP8266 and ESP32 Microcontrollers
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/Ws2812Encoder.hpp"
+
+namespace IotZoo
+{
+    void Ws2812Encoder::encode(const Ws2812Timing& timing, const uint8_t* source, size_t sourceSize, uint32_t* items, size_t wantedItems,
+                               size_t& translatedSize, size_t& itemCount)
+    {
+        const uint32_t zero = makeItem(timing.zeroHigh, timing.zeroLow);
+        const uint32_t one  = makeItem(timing.oneHigh, timing.oneLow);
+
+        size_t byteCount = wantedItems / 8;
+        if (byteCount > sourceSize)
+        {
+            byteCount = sourceSize;
+        }
+        for (size_t i = 0; i < byteCount; i++)
+        {
+            uint8_t value = source[i];
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                *items++ = (value & 0x80) ? one : zero;
+                value <<= 1;
+            }
+        }
+        translatedSize = byteCount;
+        itemCount      = byteCount * 8;
+    }
+} // namespace IotZoo
@@ -12,6 +12,7 @@
 #ifdef USE_HT1621
 
 #include "displays/HT1621.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -58,12 +59,12 @@ namespace IotZoo
                               {
                                   try
                                   {
-                                      Serial.println("HT1621 received temperature data: " + data);
+                                      LOG_DEBUG(LogModuleDisplays, "HT1621 received temperature data: " + data);
                                       lcd.printCelsius(atof(data.c_str()));
                                   }
                                   catch (...)
                                   {
-                                      Serial.println("Data is not a number: " + data);
+                                      LOG_WARNING(LogModuleDisplays, "Data is not a number: " + data);
                                   }
                               });
 
@@ -72,12 +73,12 @@ namespace IotZoo
                               {
                                   try
                                   {
-                                      Serial.println("HT1621 received number: " + data);
+                                      LOG_DEBUG(LogModuleDisplays, "HT1621 received number: " + data);
                                       lcd.print(atof(data.c_str()));
                                   }
                                   catch (...)
                                   {
-                                      Serial.println("Data is not a number: " + data);
+                                      LOG_WARNING(LogModuleDisplays, "Data is not a number: " + data);
                                   }
                               });
         mqttClient->subscribe(baseTopic + "/ht1621/0/batteryLevel",
@@ -85,12 +86,12 @@ namespace IotZoo
                               {
                                   try
                                   {
-                                      Serial.println("HT1621 received battery level: " + data);
+                                      LOG_DEBUG(LogModuleDisplays, "HT1621 received battery level: " + data);
                                       lcd.setBatteryLevel(atoi(data.c_str()));
                                   }
                                   catch (...)
                                   {
-                                      Serial.println("Data is not a number: " + data);
+                                      LOG_WARNING(LogModuleDisplays, "Data is not a number: " + data);
                                   }
                               });
     }
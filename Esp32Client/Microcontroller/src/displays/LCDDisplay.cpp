@@ -12,6 +12,7 @@
 #include "Defines.hpp"
 #ifdef USE_LCD_160X
 #include "./displays/LCDDisplay.hpp"
+#include "core/Log.hpp"
 
 #include <ArduinoJson.h>
 
@@ -136,7 +137,7 @@ namespace IotZoo
     // {"text": "IoT Zoo", "clear": true, "x":1, "y": 0}
     void LcdDisplay::setLcd160xData(const String& json)
     {
-        Serial.println("setLcd160xData: " + json);
+        LOG_DEBUG(LogModuleDisplays, "setLcd160xData: " + json);
 
         String text;
         bool   doClear = true;
@@ -151,8 +152,8 @@ namespace IotZoo
             DeserializationError error = deserializeJson(jsonDocument, json);
             if (error)
             {
-                Serial.print(F("deserializeJson() failed: "));
-                Serial.println(error.f_str());
+                LOG_PRINT(LogModuleDisplays, LogLevelWarning, F("deserializeJson() failed: "));
+                LOG_WARNING(LogModuleDisplays, error.f_str());
                 return;
             }
 
@@ -186,7 +187,7 @@ namespace IotZoo
         text.replace("µ", "\xE4");
         text.replace("Ω", "\xF4");
 
-        Serial.println(text);
+        LOG_DEBUG(LogModuleDisplays, text);
         if (doClear)
         {
             clear();
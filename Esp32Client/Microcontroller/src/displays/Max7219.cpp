@@ -12,6 +12,7 @@
 #ifdef USE_MAX7219
 
 #include "displays/Max7219.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -60,7 +61,7 @@ namespace IotZoo
         mqttClient->subscribe(getBaseTopic() + "/max7219/" + String(deviceIndex) + "/setPoint",
                               [&](const String& json)
                               {
-                                  Serial.println("setPoint json: " + json);
+                                  LOG_DEBUG(LogModuleDisplays, "setPoint json: " + json);
 
                                   StaticJsonDocument<256> jsonDocument;
                                   if (!deserializeStaticJsonAndPublishError(jsonDocument, json))
@@ -76,7 +77,7 @@ namespace IotZoo
         mqttClient->subscribe(getBaseTopic() + "/max7219/" + String(deviceIndex) + "/setColumn",
                               [&](const String& json)
                               {
-                                  Serial.println("setColumn json: " + json);
+                                  LOG_DEBUG(LogModuleDisplays, "setColumn json: " + json);
 
                                   StaticJsonDocument<256> jsonDocument;
                                   if (!deserializeStaticJsonAndPublishError(jsonDocument, json))
@@ -90,7 +91,7 @@ namespace IotZoo
         mqttClient->subscribe(getBaseTopic() + "/max7219/" + String(deviceIndex) + "/setRow",
                               [&](const String& json)
                               {
-                                  Serial.println("setRow json: " + json);
+                                  LOG_DEBUG(LogModuleDisplays, "setRow json: " + json);
 
                                   StaticJsonDocument<256> jsonDocument;
                                   if (!deserializeStaticJsonAndPublishError(jsonDocument, json))
@@ -104,14 +105,14 @@ namespace IotZoo
         mqttClient->subscribe(getBaseTopic() + "/max7219/" + String(deviceIndex) + "/clear",
                               [&](const String& json)
                               {
-                                  Serial.println("clear json: " + json);
+                                  LOG_DEBUG(LogModuleDisplays, "clear json: " + json);
                                   max7219->clear();
                               });
 
         mqttClient->subscribe(getBaseTopic() + "/max7219/" + String(deviceIndex) + "/allOn",
                               [&](const String& json)
                               {
-                                  Serial.println("all on. columnCount: " + String(max7219->getColumnCount()));
+                                  LOG_DEBUG(LogModuleDisplays, "all on. columnCount: " + String(max7219->getColumnCount()));
                                   for (int i = 0; i < max7219->getColumnCount(); i++)
                                   {
                                       max7219->setColumn(i, 255);
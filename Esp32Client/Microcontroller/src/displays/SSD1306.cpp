@@ -11,6 +11,7 @@
 #include "Defines.hpp"
 #ifdef USE_OLED_SSD1306
 #include "./displays/SSD1306.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -81,10 +82,10 @@ namespace IotZoo
     {
         if (lineNumber > 6)
         {
-            Serial.println("Invalid line number " + String(lineNumber));
+            LOG_WARNING(LogModuleDisplays, "Invalid line number " + String(lineNumber));
             return;
         }
-        Serial.println(text + " on line number " + String(lineNumber));
+        LOG_DEBUG(LogModuleDisplays, text + " on line number " + String(lineNumber));
         oled->setCursor(0, lineNumber);
         oled->clearToEOL();
         oled->print(text);
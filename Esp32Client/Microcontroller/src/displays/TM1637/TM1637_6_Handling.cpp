@@ -12,6 +12,7 @@
 #ifdef USE_TM1637_6
 #include "./displays/TM1637/TM1637Helper.hpp"
 #include "./displays/TM1637/TM1637_6_Handling.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -61,6 +62,11 @@ namespace IotZoo
         callbacksAreRegistered = true;
     }
 
+    void TM1637_6_Handling::onMqttConnectionEstablished(MqttClient* mqttClient, const String& baseTopic)
+    {
+        onMqttConnectionEstablished(settings, mqttClient, baseTopic);
+    }
+
     /// @brief Data Reveived to display on a TM1637 4 digit display.
     /// @param rawData: data in json format or unformatted.
     void TM1637_6_Handling::callMqttbackOnReceivedDataTm1637Temperature(const String& topic, const String& message)
@@ -90,12 +96,12 @@ namespace IotZoo
             }
 
             int indexEnd = topic.lastIndexOf("/");
-            Serial.println("indexEnd: " + String(indexEnd));
+            LOG_VERBOSE(LogModuleDisplays, "indexEnd: " + String(indexEnd));
             if (indexEnd >= 0)
             {
                 int deviceIndex = topic.c_str()[indexEnd - 1] - '0'; // at least 10 (0 - 9).
-                Serial.println(deviceIndex);
-                Serial.println(topic.c_str()[indexEnd - 1]);
+                LOG_VERBOSE(LogModuleDisplays, deviceIndex);
+                LOG_VERBOSE(LogModuleDisplays, topic.c_str()[indexEnd - 1]);
 
                 auto display = displays1637.begin();
                 if (deviceIndex > 0)
@@ -12,6 +12,7 @@
 #if defined(USE_TM1637_4) || defined(USE_TM1637_6)
 #include "./displays/TM1637/TM1637Helper.hpp"
 #include "./displays/TM1637/TM1637_Handling.hpp"
+#include "core/Log.hpp"
 
 namespace IotZoo
 {
@@ -54,7 +55,7 @@ namespace IotZoo
     /// @param rawData: data in json format or unformatted.
     void TM1637_Handling::onReceivedDataTm1637_Number(const String& rawData, int deviceIndex)
     {
-        Serial.println("onReceivedDataTm1637_Number " + rawData);
+        LOG_DEBUG(LogModuleDisplays, "onReceivedDataTm1637_Number " + rawData);
 
         TM1637* display = getDisplayByDeviceIndex(deviceIndex);
 
@@ -97,48 +98,49 @@ namespace IotZoo
             }
             catch (const std::exception& e)
             {
-                Serial.println("Unable to convert to a number!");
+                LOG_WARNING(LogModuleDisplays, "Unable to convert to a number!");
             }
 
-            Serial.println("device index: " + String(deviceIndex) + "; number: " + String(number) + "; LeadingZeros: " + String(showLeadingZeros) +
-                           "; displayLength: " + String(displayLength) + "; position: " + String(position) + "; dots: " + String(dots));
+            LOG_DEBUG(LogModuleDisplays, "device index: " + String(deviceIndex) + "; number: " + String(number) +
+                                             "; LeadingZeros: " + String(showLeadingZeros) + "; displayLength: " + String(displayLength) +
+                                             "; position: " + String(position) + "; dots: " + String(dots));
             display->showNumberDec(number, dots, showLeadingZeros, displayLength, position);
         }
     }
 
     void TM1637_Handling::callbackMqttOnReceivedDataTm1637_Number(const String& topic, const String& message)
     {
-        Serial.println("callbackMqttOnReceivedDataTm1637_Number topic: " + topic + " message: " + message);
+        LOG_DEBUG(LogModuleDisplays, "callbackMqttOnReceivedDataTm1637_Number topic: " + topic + " message: " + message);
 
         int indexEnd = topic.lastIndexOf("/");
-        Serial.println("indexEnd: " + String(indexEnd));
+        LOG_VERBOSE(LogModuleDisplays, "indexEnd: " + String(indexEnd));
         if (indexEnd >= 0)
         {
             int deviceIndex = topic.c_str()[indexEnd - 1] - '0'; // at least 10 (0 - 9).
-            Serial.println(deviceIndex);
-            Serial.println(topic.c_str()[indexEnd - 1]);
+            LOG_VERBOSE(LogModuleDisplays, deviceIndex);
+            LOG_VERBOSE(LogModuleDisplays, topic.c_str()[indexEnd - 1]);
             onReceivedDataTm1637_Number(message, deviceIndex);
         }
     }
 
     void TM1637_Handling::callMqttbackOnReceivedDataTm1637Text(const String& topic, const String& message)
     {
-        Serial.println("callMqttbackOnReceivedDataTm1637Text topic: " + topic + " message: " + message);
+        LOG_DEBUG(LogModuleDisplays, "callMqttbackOnReceivedDataTm1637Text topic: " + topic + " message: " + message);
 
         int indexEnd = topic.lastIndexOf("/");
-        Serial.println("indexEnd: " + String(indexEnd));
+        LOG_VERBOSE(LogModuleDisplays, "indexEnd: " + String(indexEnd));
         if (indexEnd >= 0)
         {
             int deviceIndex = topic.c_str()[indexEnd - 1] - '0'; // at least 10 (0 - 9).
-            Serial.println(deviceIndex);
-            Serial.println(topic.c_str()[indexEnd - 1]);
+            LOG_VERBOSE(LogModuleDisplays, deviceIndex);
+            LOG_VERBOSE(LogModuleDisplays, topic.c_str()[indexEnd - 1]);
 
             TM1637* display = getDisplayByDeviceIndex(deviceIndex);
 
             if (nullptr != display)
             {
                 display->setBrightness(0x0A, true); // 0x0f = max brightness. Do not delete this, the display may be turned off.
-                Serial.println(message);
+                LOG_DEBUG(LogModuleDisplays, message);
                 display->showString(message.c_str(), display->getDefaultDisplayLength());
             }
         }
@@ -153,7 +155,7 @@ namespace IotZoo
                 return &display;
             }
         }
-        Serial.println("TM1637 display with index " + String(index) + " not found!");
+        LOG_WARNING(LogModuleDisplays, "TM1637 display with index " + String(index) + " not found!");
         return nullptr;
     }
 
@@ -162,15 +164,15 @@ namespace IotZoo
     /// @param message
     void TM1637_Handling::callbackMqttOnReceivedDataTm1637Level(const String& topic, const String& message)
     {
-        Serial.println("callbackMqttOnReceivedDataTm1637Level topic: " + topic + " message: " + message);
+        LOG_DEBUG(LogModuleDisplays, "callbackMqttOnReceivedDataTm1637Level topic: " + topic + " message: " + message);
 
         int indexEnd = topic.lastIndexOf("/");
-        Serial.println("indexEnd: " + String(indexEnd));
+        LOG_VERBOSE(LogModuleDisplays, "indexEnd: " + String(indexEnd));
         if (indexEnd >= 0)
         {
             int deviceIndex = topic.c_str()[indexEnd - 1] - '0'; // at least 10 (0 - 9).
-            Serial.println(deviceIndex);
-            Serial.println(topic.c_str()[indexEnd - 1]);
+            LOG_VERBOSE(LogModuleDisplays, deviceIndex);
+            LOG_VERBOSE(LogModuleDisplays, topic.c_str()[indexEnd - 1]);
 
             TM1637* display = getDisplayByDeviceIndex(deviceIndex);
             if (nullptr != display)
@@ -183,7 +185,7 @@ namespace IotZoo
                 }
                 catch (const std::exception& e)
                 {
-                    Serial.println("Unable to convert to a number!");
+                    LOG_WARNING(LogModuleDisplays, "Unable to convert to a number!");
                 }
 
                 display->showLevel(level, false);
@@ -13,6 +13,19 @@
 // --------------------------------------------------------------------------------------------------------------------
 #include "ConnectionSettings.hpp"
 #include "Defines.hpp"
+#include "DeviceBase.hpp"
+#include "DeviceHandlingBase.hpp"
+#include "core/DeviceRegistry.hpp"
+#include "core/Log.hpp"
+#include "core/Scheduler.hpp"
+#ifdef USE_PROFILER
+#include "core/LoopProfiler.hpp"
+#endif
+#ifdef USE_STORE_AND_FORWARD
+#include "EspFlashPartition.hpp"
+#include "core/StoreAndForward.hpp"
+#endif
+#include "pocos/DeviceConfiguration.hpp"
 #include "pocos/Microcontroller.hpp"
 #include "pocos/Topic.hpp"
 
@@ -40,17 +53,14 @@ WebServer webServer(80);
 
 #ifdef USE_STEPPER_MOTOR
 #include "StepperMotor.hpp"
-IotZoo::StepperMotor* stepperMotor = nullptr;
 #endif
 
 #ifdef USE_LED_AND_KEY
 #include "TM1638.hpp"
-IotZoo::TM1638* tm1638 = nullptr;
 #endif
 
 #ifdef USE_WS2818
 #include "WS2818.hpp"
-IotZoo::WS2818* ws2812 = nullptr;
 #ifdef USE_WS2818_PIXEL_MATRIX
 #include "PixelMatrix.hpp"
 #endif
@@ -69,12 +79,10 @@ IotZoo::HRSR501Handling motionDetectorsHrsc501Handling;
 
 #ifdef USE_RD_03D
 #include "Rd03D.hpp"
-IotZoo::Rd03D* rd03d = nullptr;
 #endif
 
 #ifdef USE_BUZZER
 #include "Buzzer.hpp"
-IotZoo::Buzzer* buzzer = nullptr;
 #endif
 
 #ifdef ARDUINO_ESP32_DEV
@@ -85,19 +93,21 @@ Settings* settings = nullptr;
 
 #ifdef USE_TRAFFIC_LIGHT_LEDS
 #include "TrafficLight.hpp"
-std::vector<TrafficLight> trafficLightLeds{};
 #endif
 
 #ifdef USE_REMOTE_GPIOS
 #include "RemoteGpio.hpp"
-std::vector<RemoteGpio> remoteGpios{};
+std::vector<RemoteGpio*> remoteGpios{}; // by index for the REST server.
 #endif
 
 #ifdef USE_HB0014
+#include "core/WindowAggregator.hpp"
 const int     digitalPinInfraredLed   = 34;
 int           digitalValueInfrared    = 0; // digital readings
 int           digitalValueOldInfrared = 0;
 unsigned long lastMillisInfrared      = millis();
+// 10000 impulses per kWh. The average power and the min/max of the per impulse powers are published per minute.
+IotZoo::ImpulsePowerMeter powerMeter(60000, 0.1f);
 #endif
 
 #ifdef USE_OLED_SSD1306
@@ -107,12 +117,10 @@ OledSsd1306Display* oled1306 = nullptr;
 
 #ifdef USE_LCD_160X
 #include "./displays/LCDDisplay.hpp"
-LcdDisplay* lcdDisplay = nullptr;
 #endif
 
 #ifdef USE_HT1621
 #include "./displays/HT1621.hpp"
-IotZoo::HT1621* ht1621 = nullptr;
 #endif
 
 #ifdef USE_KEYPAD
@@ -136,22 +144,18 @@ ButtonHandling buttonHandling;
 
 #ifdef USE_KY025
 #include "ReedContactKY025.hpp"
-KY025* ky025 = nullptr;
 #endif
 
 #ifdef USE_AUDIO_STREAMER
 #include "AudioStreamer.hpp"
-AudioStreamer* audioStreamer = nullptr;
 #endif
 
 #ifdef USE_GPS
 #include "Gps.hpp"
-Gps* gps = nullptr;
 #endif
 
 #ifdef USE_SWITCH
 #include "Switch.hpp"
-std::vector<Switch> switches{};
 #endif
 
 enum class DayMode
@@ -175,6 +179,30 @@ unsigned long lastServerAliveMillis = millis();
 long          loopCounter           = 0;
 long          loopDurationMs        = 0;
 
+// The loop sleeps until the earliest deadline, but at most this time, so the MQTT client stays responsive.
+static const uint32_t MaxIdleMillis = 10;
+
+IotZoo::Scheduler scheduler;
+int               taskIdAlive = IotZoo::Scheduler::InvalidTaskId;
+void              scheduleTasks();
+
+#ifdef USE_PROFILER
+IotZoo::LoopProfiler profiler; // one probe per scheduled task and per MQTT subscription.
+#endif
+
+#ifdef USE_STORE_AND_FORWARD
+// Messages published while the broker is not reachable: 16 in RAM, then up to 256 KB in the spiffs partition.
+IotZoo::EspFlashPartition telemetryPartition;
+IotZoo::TelemetryLog      telemetryLog(telemetryPartition);
+IotZoo::StoreAndForward*  storeAndForward         = nullptr;
+uint32_t                  millisLastOutageWarning = 0;
+#endif
+
+// The configured devices. Filled once by makeInstanceConfiguredDevices().
+IotZoo::DeviceRegistry<IotZoo::DeviceBase>              deviceRegistry;
+IotZoo::DeviceRegistry<IotZoo::DeviceHandlingBase>      handlingRegistry;
+IotZoo::DeviceFactoryTable<IotZoo::DeviceConfiguration> deviceFactories;
+
 static const uint8_t LED_BUILTIN = 2;
 
 DayMode dayMode = DayMode::Unknown;
@@ -193,6 +221,10 @@ bool topicsRegistered = false;
 void restart()
 {
     Serial.println("*** RESTART NOW!!! ***");
+    if (nullptr != settings)
+    {
+        settings->flush(); // the settings are written back lazily, do not lose the last changes.
+    }
     ESP.restart();
 }
 
@@ -220,12 +252,10 @@ String identifyBoard()
 
 #ifdef USE_DS18B20
 #include "DS18B20.hpp"
-IotZoo::DS18B20* ds18B20SensorManager = nullptr;
 #endif
 
 #ifdef USE_HW507
 #include "HW507.hpp"
-IotZoo::HW507* hw507HumiditySensor = nullptr;
 #endif
 
 #ifdef USE_MQTT
@@ -235,7 +265,7 @@ MqttClient* mqttClient = nullptr;
 
 #ifdef USE_TM1637_4
 #include "./displays/TM1637/TM1637_4_Handling.hpp"
-IotZoo::TM1637_4_Handling* tm1637_4Handling;
+IotZoo::TM1637_4_Handling tm1637_4Handling;
 #endif // USE_TM1637_4
 
 #ifdef USE_TM1637_6
@@ -245,18 +275,33 @@ IotZoo::TM1637_6_Handling tm1637_6Handling;
 
 #ifdef USE_MAX7219
 #include "./displays/Max7219.hpp"
-Max7219* max7219;
 #endif // USE_MAX7219
 
 #ifdef USE_UV
+#include "AdcService.hpp"
 #include "GUVAS12SD.hpp"
-UvSensorGUVAS12SD* uvSensorGUVAS12SD = nullptr;
+IotZoo::AdcService adcService; // continuous sampling of the analog pins of all devices.
 #endif // USE_UV
 
 #if defined(USE_MQTT)
 const String NamespaceNameFallback = "iotzoo";
 
-String getNamespaceAndProjectNameForTopic()
+// The namespace and the project name are stored in the flash. Read them once, a change requires a restart anyway.
+bool   topicCacheValid = false;
+String namespaceAndProjectNameForTopic;
+String baseTopic;
+
+// Interned topics of the microcontroller, see addTopics().
+TopicId topicIdError = InvalidTopicId;
+TopicId topicIdAlive = InvalidTopicId;
+
+/// @brief The namespace or the project name has been changed.
+void invalidateTopicCache()
+{
+    topicCacheValid = false;
+}
+
+void buildTopicCache()
 {
     String namespaceName = settings->getNamespaceName(NamespaceNameFallback);
     if (namespaceName.length() > 0)
@@ -268,20 +313,48 @@ String getNamespaceAndProjectNameForTopic()
     {
         projectName += "/";
     }
-    return namespaceName + projectName;
+    namespaceAndProjectNameForTopic = namespaceName + projectName;
+    baseTopic                       = namespaceAndProjectNameForTopic + identifyBoard() + "/" + macAddress;
+    topicCacheValid                 = true;
+}
+
+String getNamespaceAndProjectNameForTopic()
+{
+    if (!topicCacheValid)
+    {
+        buildTopicCache();
+    }
+    return namespaceAndProjectNameForTopic;
 }
 
 /// @brief Get the base MQTT Topic.
 /// @return
 String getBaseTopic()
 {
-    return getNamespaceAndProjectNameForTopic() + identifyBoard() + "/" + macAddress;
+    if (!topicCacheValid)
+    {
+        buildTopicCache();
+    }
+    return baseTopic;
+}
+
+/// @brief Interns the topics the microcontroller publishes to periodically.
+void addTopics()
+{
+    topicIdError = mqttClient->addTopic(getBaseTopic(), "/error");
+    topicIdAlive = mqttClient->addTopic(getBaseTopic(), "/alive");
+
+    // Sensor values: only the latest value counts, the queue may coalesce or drop them.
+    mqttClient->addTelemetryTopicPattern("/celsius");
+    mqttClient->addTelemetryTopicPattern("/humidity");
+    mqttClient->addTelemetryTopicPattern("/sound_level_");
+    mqttClient->addTelemetryTopicPattern("/ppm");
+    mqttClient->addTelemetryTopicPattern("/gps/position");
 }
 
 void publishError(const String& errMsg)
 {
-    String topic = getBaseTopic() + "/error";
-    mqttClient->publish(topic, errMsg);
+    mqttClient->publish(topicIdError, errMsg);
 }
 
 bool deserializeStaticJsonAndPublishError(JsonDocument& jsonDocument, const String& json)
@@ -334,6 +407,7 @@ bool onReceivedMicrocontrollerConfiguration(const String& json)
         bool   ok0           = settings->setNamespaceName(namespaceName);
         bool   ok1           = settings->setProjectName(projectName);
         bool   ok2           = settings->setMqttBrokerIp(ipMqttBroker);
+        invalidateTopicCache();
         if (ok0 && ok1 && ok2)
         {
             Serial.println("Successful saved settings");
@@ -412,8 +486,65 @@ void AddAliveNestedJsonObject(JsonDocument* jsonDocument)
     jsonObjectAlive["ReconnectionCount"]  = mqttClient->getConnectionEstablishedCount() - 1;
     jsonObjectAlive["AliveIntervalMs"]    = settings->getAliveIntervalMillis();
     jsonObjectAlive["AliveAckLedEnabled"] = settings->getAliveAckLedMode();
+    jsonObjectAlive["FreeHeap"]           = ESP.getFreeHeap();
+    jsonObjectAlive["MinFreeHeap"]        = ESP.getMinFreeHeap(); // lowest value since the start.
+    jsonObjectAlive["LogLevel"]           = IOTZOO_LOG_LEVEL;     // to compare loopDurationMs and heap of the build profiles.
+
+    const PublishQueue& publishQueue           = mqttClient->getPublishQueue();
+    JsonObject          jsonObjectPublishQueue = jsonObjectAlive.createNestedObject("PublishQueue");
+    jsonObjectPublishQueue["Depth"]            = publishQueue.size();
+    jsonObjectPublishQueue["HighWaterMark"]    = publishQueue.getHighWaterMark();
+    jsonObjectPublishQueue["Capacity"]         = publishQueue.capacity();
+    jsonObjectPublishQueue["Coalesced"]        = publishQueue.getCoalesced();
+    jsonObjectPublishQueue["DroppedTelemetry"] = publishQueue.getDroppedTelemetry();
+    jsonObjectPublishQueue["DroppedEvents"]    = publishQueue.getDroppedEvents();
+
+#ifdef USE_STORE_AND_FORWARD
+    const StoreAndForward* storeAndForward = mqttClient->getStoreAndForward();
+    if (nullptr != storeAndForward)
+    {
+        JsonObject jsonObjectStoreAndForward  = jsonObjectAlive.createNestedObject("StoreAndForward");
+        jsonObjectStoreAndForward["Pending"]  = storeAndForward->getPendingCount();
+        jsonObjectStoreAndForward["Spilled"]  = storeAndForward->getSpilled();
+        jsonObjectStoreAndForward["Replayed"] = storeAndForward->getReplayed();
+        jsonObjectStoreAndForward["Dropped"]  = storeAndForward->getDropped();
+    }
+#endif
+}
+
+#ifdef USE_PROFILER
+/// @brief Run time statistics per scheduled task and MQTT callback. Times in microseconds, measured in CPU cycles.
+void AddProfileNestedJsonObject(JsonDocument* jsonDocument)
+{
+    uint32_t   cpuFrequencyMHz      = ESP.getCpuFreqMHz();
+    JsonObject jsonObjectProfile    = jsonDocument->createNestedObject("Profile");
+    jsonObjectProfile["CpuFreqMHz"] = cpuFrequencyMHz;
+    JsonArray jsonArrayProbes       = jsonObjectProfile.createNestedArray("Probes");
+
+    for (size_t probeId = 0; probeId < profiler.getProbeCount(); probeId++)
+    {
+        LoopProfiler::Statistics statistics = profiler.getStatistics(probeId);
+        if (statistics.count == 0)
+        {
+            continue;
+        }
+        JsonObject jsonObjectProbe = jsonArrayProbes.createNestedObject();
+        jsonObjectProbe["Name"]    = profiler.getProbeName(probeId);
+        jsonObjectProbe["Count"]   = statistics.count;
+        jsonObjectProbe["MinUs"]   = LoopProfiler::cyclesToMicros(statistics.minCycles, cpuFrequencyMHz);
+        jsonObjectProbe["AvgUs"]   = LoopProfiler::cyclesToMicros(statistics.avgCycles, cpuFrequencyMHz);
+        jsonObjectProbe["MaxUs"]   = LoopProfiler::cyclesToMicros(statistics.maxCycles, cpuFrequencyMHz);
+        jsonObjectProbe["P99Us"]   = LoopProfiler::cyclesToMicros(statistics.p99Cycles, cpuFrequencyMHz);
+    }
 }
 
+/// @brief Capacity of the JSON document for the profile. The probe names are not copied (const char*).
+size_t getProfileJsonCapacity()
+{
+    return JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(profiler.getProbeCount()) + profiler.getProbeCount() * JSON_OBJECT_SIZE(6) + 64;
+}
+#endif
+
 void AddSupportedDevicesNestedJsonObject(JsonDocument* jsonDocument)
 {
     JsonObject jsonObjectSupportedDevices = jsonDocument->createNestedObject("SupportedDevices");
@@ -623,20 +754,25 @@ void publishDeviceConfigurations()
 
 void publishErrorMessage(const String& errorMessage)
 {
-    String topicError = getBaseTopic() + "/error";
-    mqttClient->publish(topicError, errorMessage);
+    mqttClient->publish(topicIdError, errorMessage);
 }
 
 /// @brief Create Json for alive message.
 /// @return Json for alive message
 String createAliveJson()
 {
+#ifdef USE_PROFILER
+    DynamicJsonDocument jsonDocument(4096 + getProfileJsonCapacity()); // on heap, grows with the count of probes.
+#else
     StaticJsonDocument<4096> jsonDocument; // on stack
-    // DynamicJsonDocument jsonDocument(4096); // on heap
+#endif
 
     AddMicrocontrollerNestedJsonObject(&jsonDocument);
     AddAliveNestedJsonObject(&jsonDocument);
     AddSupportedDevicesNestedJsonObject(&jsonDocument);
+#ifdef USE_PROFILER
+    AddProfileNestedJsonObject(&jsonDocument);
+#endif
 
     String json;
     serializeJson(jsonDocument, json);
@@ -651,12 +787,11 @@ String createAliveJson()
 #if defined(USE_MQTT)
 void publishAliveMessage()
 {
-    Serial.println("publishAliveMessage");
+    LOG_DEBUG(LogModuleMain, "publishAliveMessage");
 
     aliveCounter++;
-    String topicAlive = getBaseTopic() + "/alive";
-    String json       = createAliveJson();
-    mqttClient->publish(topicAlive, json);
+    String json = createAliveJson();
+    mqttClient->publish(topicIdAlive, json);
 
     lastAliveTime = millis();
 }
@@ -665,7 +800,7 @@ void publishAliveMessage()
 /// @param rawData
 void onAliveAck(const String& rawData)
 {
-    Serial.println("Received alive_ack: " + rawData + ", millis: " + String(millis()));
+    LOG_DEBUG(LogModuleMain, "Received alive_ack: " + rawData + ", millis: " + String(millis()));
 
     lastServerAliveMillis = millis();
     if (rawData.length() > 0)
@@ -748,127 +883,15 @@ void onConnectionEstablished() // do not rename! This method name is forced in E
     mqttClient->subscribe(macAddress + "/status", onStatusRequested);
     mqttClient->subscribe(getBaseTopic() + "/alive_ack", onAliveAck);
 
-#ifdef USE_LCD_160X
-    if (nullptr != lcdDisplay)
-    {
-        lcdDisplay->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_WS2818
-    // It seems that the library only supports one light strip!
-    if (nullptr != ws2812)
-    {
-        ws2812->onMqttConnectionEstablished();
-    }
-    else
-    {
-        Serial.println("ws2812 is nullptr!");
-    }
-#endif
-
-#ifdef USE_HW040
-    hw040Handling.onMqttConnectionEstablished(mqttClient, getBaseTopic());
-#endif
-
-#ifdef USE_STEPPER_MOTOR
-    if (nullptr != stepperMotor)
-    {
-        stepperMotor->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_OLED_SSD1306
-    if (nullptr != oled1306)
-    {
-        oled1306->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_STEPPER_MOTOR
-    if (nullptr != stepperMotor)
-    {
-        stepperMotor->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_BUTTON
-    buttonHandling.onMqttConnectionEstablished();
-#endif
-
-#ifdef USE_UV
-    if (nullptr != uvSensorGUVAS12SD)
-    {
-        uvSensorGUVAS12SD->onMqttConnectionEstablished();
-    }
-#endif // USE_UV
-
-#ifdef USE_AUDIO_STREAMER
-    if (nullptr != audioStreamer)
-    {
-        audioStreamer->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_GPS
-    if (nullptr != gps)
-    {
-        gps->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_BUZZER
-    if (nullptr != buzzer)
-    {
-        buzzer->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_TM1637_4
-    if (nullptr != tm1637_4Handling)
-    {
-        tm1637_4Handling->onMqttConnectionEstablished(mqttClient, getBaseTopic());
-    }
-#endif
-
-#ifdef USE_TM1637_6
-    tm1637_6Handling.onMqttConnectionEstablished(settings, mqttClient, getBaseTopic());
-#endif
-
-#ifdef USE_LED_AND_KEY
-    if (nullptr != tm1638)
-    {
-        tm1638->onMqttConnectionEstablished();
-    }
-#endif
-
-#ifdef USE_HT1621
-    if (nullptr != ht1621)
-    {
-        ht1621->onMqttConnectionEstablished();
-    }
-#endif // USE_HT1621
-
-#ifdef USE_MAX7219
-    if (nullptr != max7219)
-    {
-        max7219->onMqttConnectionEstablished();
-    }
-#endif // USE_MAX7219
-
-#ifdef USE_REMOTE_GPIOS
-    for (auto& remoteGpio : remoteGpios)
+    for (DeviceBase* device : deviceRegistry)
     {
-        remoteGpio.onMqttConnectionEstablished();
+        device->onMqttConnectionEstablished();
     }
-#endif // USE_REMOTE_GPIOS
 
-#ifdef USE_TRAFFIC_LIGHT_LEDS
-    for (auto& trafficLight : trafficLightLeds)
+    for (DeviceHandlingBase* deviceHandling : handlingRegistry)
     {
-        trafficLight.onMqttConnectionEstablished();
+        deviceHandling->onMqttConnectionEstablished(mqttClient, getBaseTopic());
     }
-#endif
 
     String topicReboot = getBaseTopic() + "/system";
 
@@ -914,6 +937,7 @@ void onConnectionEstablished() // do not rename! This method name is forced in E
 
                               settings->setAliveIntervalMillis(aliveIntervalMs);
                               Serial.println("aliveIntervalMs: " + String(settings->getAliveIntervalMillis()));
+                              scheduler.setInterval(taskIdAlive, settings->getAliveIntervalMillis());
 
                               settings->setAliveLedMode(aliveAckLedMode);
                               Serial.println("aliveAckLedEnabled " + String(settings->getAliveAckLedMode()));
@@ -978,665 +1002,871 @@ void onConnectionEstablished() // do not rename! This method name is forced in E
 
 #endif
 
-/**
- * @brief Loads the configuration for the connected devices and instantiates them.
- */
-void makeInstanceConfiguredDevices()
-{
-    Serial.println("Loading device configurations and instantiate devices...");
-
-    String jsonDeviceConfigurations = settings->loadDeviceConfigurations();
-    if (0 == jsonDeviceConfigurations.length())
-    {
-        Serial.println("Not yet configured!");
-    }
-    else // if (jsonDeviceConfigurations.length() > 0)
-    {
-        Serial.println("Config: " + jsonDeviceConfigurations);
-        DynamicJsonDocument jsonDocument(4096);
-
-        if (!deserializeStaticJsonAndPublishError(jsonDocument, jsonDeviceConfigurations))
-        {
-            return;
-        }
-
-        JsonArray arrDevices = jsonDocument.as<JsonArray>();
-
-        for (JsonVariant value : arrDevices)
-        {
-            String deviceType  = value["DeviceType"];
-            int    deviceIndex = value["DeviceIndex"];
-            bool   isEnabled   = value["IsEnabled"];
-
-            Serial.println("DeviceType: '" + deviceType + "', DeviceIndex: " + String(deviceIndex) + "', IsEnabled: " + String(isEnabled));
-
-            if (isEnabled)
-            {
-                JsonArray arrPins       = value["Pins"].as<JsonArray>();
-                JsonArray arrProperties = value["PropertyValues"].as<JsonArray>();
+// --------------------------------------------------------------------------------------------------------------------
+// Device factories. The device type of the configuration selects the factory, the factory creates the device and adds
+// it to the registry.
+// --------------------------------------------------------------------------------------------------------------------
 
 #ifdef USE_BUTTON
-                if (deviceType == "Button")
-                {
-                    int buttonPin = arrPins[0]["MicrocontrollerGpoPin"];
+bool createButton(const DeviceConfiguration& configuration)
+{
+    int buttonPin = configuration.getPin(0);
 
-                    buttonHandling.addDevice(deviceIndex, settings, mqttClient, getBaseTopic(), buttonPin);
+    buttonHandling.addDevice(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), buttonPin);
+    handlingRegistry.add(&buttonHandling, "Button");
 
-                    Serial.println("Button initialized.");
-                }
+    Serial.println("Button initialized.");
+    return true;
+}
 #endif // USE_BUTTON
 
 #ifdef USE_KY025
-                if (deviceType == "Reed-Contact")
-                {
-                    int dataPin = arrPins[0]["MicrocontrollerGpoPin"];
+bool createReedContact(const DeviceConfiguration& configuration)
+{
+    int dataPin = configuration.getPin(0);
 
-                    u16_t intervalMs = 10000;
+    u16_t intervalMs = 10000;
 
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName = property["Name"];
-                        if (propertyName == "IntervalMs")
-                        {
-                            intervalMs = property["Value"];
-                        }
-                    }
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
+        if (propertyName == "IntervalMs")
+        {
+            intervalMs = property["Value"];
+        }
+    }
 
-                    ky025 = new KY025(deviceIndex, settings, mqttClient, getBaseTopic(), intervalMs, dataPin);
+    deviceRegistry.add(new KY025(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), intervalMs, dataPin), "Reed-Contact");
 
-                    Serial.println("Reed contact KY-025 initialized.");
-                }
-#endif // USE_BUTTON
+    Serial.println("Reed contact KY-025 initialized.");
+    return true;
+}
+#endif // USE_KY025
 
 #ifdef USE_AUDIO_STREAMER
-                if (deviceType == "INMP441")
-                {
-                    int pinSd  = arrPins[0]["MicrocontrollerGpoPin"];
-                    int pinWs  = arrPins[1]["MicrocontrollerGpoPin"];
-                    int pinSck = arrPins[2]["MicrocontrollerGpoPin"];
+bool createAudioStreamer(const DeviceConfiguration& configuration)
+{
+    int pinSd  = configuration.getPin(0);
+    int pinWs  = configuration.getPin(1);
+    int pinSck = configuration.getPin(2);
 
-                    u8_t  features = AudioStreamerFeatures::Undefined;
-                    u16_t minRms   = 400;
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName = property["Name"];
+    u8_t  features = AudioStreamerFeatures::Undefined;
+    u16_t minRms   = 400;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
 
-                        if (propertyName == "AllowStreaming")
-                        {
-                            bool allowStreaming = property["Value"] == "true";
-                            if (allowStreaming)
-                            {
-                                features |= AudioStreamerFeatures::Streaming;
-                            }
-                        }
-                        else if (propertyName == "AllowSoundLevel")
-                        {
-                            bool allowSoundLevel = property["Value"] == "true";
-                            if (allowSoundLevel)
-                            {
-                                features |= AudioStreamerFeatures::SoundLevelRms;
-                                features |= AudioStreamerFeatures::SoundLevelDecibel;
-                            }
-                        }
-                        else if (propertyName == "MinRms")
-                        {
-                            u16_t minRms = property["Value"];
-                        }
-                    }
+        if (propertyName == "AllowStreaming")
+        {
+            bool allowStreaming = property["Value"] == "true";
+            if (allowStreaming)
+            {
+                features |= AudioStreamerFeatures::Streaming;
+            }
+        }
+        else if (propertyName == "AllowSoundLevel")
+        {
+            bool allowSoundLevel = property["Value"] == "true";
+            if (allowSoundLevel)
+            {
+                features |= AudioStreamerFeatures::SoundLevelRms;
+                features |= AudioStreamerFeatures::SoundLevelDecibel;
+            }
+        }
+        else if (propertyName == "MinRms")
+        {
+            u16_t minRms = property["Value"];
+        }
+    }
 
-                    audioStreamer =
-                        new IotZoo::AudioStreamer(deviceIndex, settings, mqttClient, getBaseTopic(), features, minRms, pinSd, pinWs, pinSck);
+    deviceRegistry.add(
+        new IotZoo::AudioStreamer(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), features, minRms, pinSd, pinWs, pinSck),
+        "INMP441");
 
-                    Serial.println("AudioStreamer initialized.");
-                }
+    Serial.println("AudioStreamer initialized.");
+    return true;
+}
 #endif // USE_AUDIO_STREAMER
 
 #ifdef USE_GPS
-                if (deviceType == "GPS")
-                {
-                    Serial.println("GPS is in the configuration.");
-                    int pinRx = arrPins[0]["MicrocontrollerGpoPin"];
-                    int pinTx = arrPins[1]["MicrocontrollerGpoPin"];
+bool createGps(const DeviceConfiguration& configuration)
+{
+    Serial.println("GPS is in the configuration.");
+    int pinRx = configuration.getPin(0);
+    int pinTx = configuration.getPin(1);
 
-                    gps = new Gps(deviceIndex, settings, mqttClient, getBaseTopic(), pinRx, pinTx);
-                }
+    uint32_t                 baud           = 9600;
+    size_t                   trackBatchSize = 0;
+    PositionFilterParameters filterParameters;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
+
+        if (propertyName == "Baud")
+        {
+            baud = property["Value"];
+        }
+        else if (propertyName == "MinDistanceMeters")
+        {
+            filterParameters.minDistanceMeters = property["Value"];
+        }
+        else if (propertyName == "MinHeadingDegrees")
+        {
+            filterParameters.minHeadingDegrees = property["Value"];
+        }
+        else if (propertyName == "MinIntervalMillis")
+        {
+            filterParameters.minIntervalMillis = property["Value"];
+        }
+        else if (propertyName == "MaxIntervalMillis")
+        {
+            filterParameters.maxIntervalMillis = property["Value"];
+        }
+        else if (propertyName == "TrackBatchSize")
+        {
+            trackBatchSize = property["Value"];
+        }
+    }
+
+    deviceRegistry.add(
+        new Gps(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), pinRx, pinTx, baud, filterParameters, trackBatchSize), "GPS");
+    return true;
+}
 #endif // USE_GPS
 
 #ifdef USE_BUZZER
-                if (deviceType == "Buzzer")
-                {
-                    uint8_t buzzerPin = arrPins[0]["MicrocontrollerGpoPin"];
-                    uint8_t ledPin    = arrPins[1]["MicrocontrollerGpoPin"];
+bool createBuzzer(const DeviceConfiguration& configuration)
+{
+    uint8_t buzzerPin = configuration.getPin(0);
+    uint8_t ledPin    = configuration.getPin(1);
 
-                    buzzer = new IotZoo::Buzzer(deviceIndex, settings, mqttClient, getBaseTopic(), buzzerPin, ledPin);
+    deviceRegistry.add(new IotZoo::Buzzer(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), buzzerPin, ledPin), "Buzzer");
 
-                    Serial.println("Buzzer initialized.");
-                }
+    Serial.println("Buzzer initialized.");
+    return true;
+}
 #endif // USE_BUZZER
 
 #ifdef USE_HT1621
-                if (deviceType == "HT1621")
-                {
-                    uint8_t csPin        = arrPins[0]["MicrocontrollerGpoPin"];
-                    uint8_t wsPin        = arrPins[1]["MicrocontrollerGpoPin"];
-                    uint8_t dataPin      = arrPins[2]["MicrocontrollerGpoPin"];
-                    uint8_t backlightPin = arrPins[3]["MicrocontrollerGpoPin"];
-
-                    ht1621 = new IotZoo::HT1621(deviceIndex, settings, mqttClient, getBaseTopic(), csPin, wsPin, dataPin, backlightPin);
-                    if (nullptr != ht1621)
-                    {
-                        Serial.println("HT1621 6 digit LED Display initialized.");
-                    }
-                }
+bool createHt1621(const DeviceConfiguration& configuration)
+{
+    uint8_t csPin        = configuration.getPin(0);
+    uint8_t wsPin        = configuration.getPin(1);
+    uint8_t dataPin      = configuration.getPin(2);
+    uint8_t backlightPin = configuration.getPin(3);
+
+    deviceRegistry.add(
+        new IotZoo::HT1621(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), csPin, wsPin, dataPin, backlightPin), "HT1621");
+    Serial.println("HT1621 6 digit LED Display initialized.");
+    return true;
+}
 #endif // USE_HT1621
 
 #ifdef USE_MAX7219
-                if (deviceType == "MAX7219")
-                {
-                    uint8_t dataPin         = arrPins[0]["MicrocontrollerGpoPin"];
-                    uint8_t clkPin          = arrPins[1]["MicrocontrollerGpoPin"];
-                    uint8_t csPin           = arrPins[2]["MicrocontrollerGpoPin"];
-                    uint8_t numberOfDevices = 1;
+bool createMax7219(const DeviceConfiguration& configuration)
+{
+    uint8_t dataPin         = configuration.getPin(0);
+    uint8_t clkPin          = configuration.getPin(1);
+    uint8_t csPin           = configuration.getPin(2);
+    uint8_t numberOfDevices = 1;
 
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName = property["Name"];
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
 
-                        if (propertyName == "numberOfDevices")
-                        {
-                            numberOfDevices = property["Value"];
-                        }
-                    }
+        if (propertyName == "numberOfDevices")
+        {
+            numberOfDevices = property["Value"];
+        }
+    }
 
-                    max7219 = new IotZoo::Max7219(deviceIndex, settings, mqttClient, getBaseTopic(), numberOfDevices, dataPin, clkPin, csPin);
-                    if (nullptr != max7219)
-                    {
-                        Serial.println("Max7219 8x8 LED Matrix initialized.");
-                    }
-                }
+    deviceRegistry.add(
+        new IotZoo::Max7219(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), numberOfDevices, dataPin, clkPin, csPin), "MAX7219");
+    Serial.println("Max7219 8x8 LED Matrix initialized.");
+    return true;
+}
 #endif // USE_MAX7219
 
 #ifdef USE_SWITCH
-                if (deviceType == "Switch")
-                {
-                    int switchPin = arrPins[0]["MicrocontrollerGpoPin"];
-                    switches.emplace_back(deviceIndex, settings, mqttClient, getBaseTopic(), switchPin);
-                    Serial.println("Switch initialized.");
-                }
+bool createSwitch(const DeviceConfiguration& configuration)
+{
+    int switchPin = configuration.getPin(0);
+    deviceRegistry.add(new Switch(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), switchPin), "Switch");
+    Serial.println("Switch initialized.");
+    return true;
+}
 #endif // USE_SWITCH
 
 #ifdef USE_KEYPAD
-                if (deviceType == "Keypad 4x4")
-                {
-                    int column3Pin = arrPins[0]["MicrocontrollerGpoPin"];
-                    int column2Pin = arrPins[1]["MicrocontrollerGpoPin"];
-                    int column1Pin = arrPins[2]["MicrocontrollerGpoPin"];
-                    int column0Pin = arrPins[3]["MicrocontrollerGpoPin"];
-                    int row0Pin    = arrPins[4]["MicrocontrollerGpoPin"];
-                    int row1Pin    = arrPins[5]["MicrocontrollerGpoPin"];
-                    int row2Pin    = arrPins[6]["MicrocontrollerGpoPin"];
-                    int row3Pin    = arrPins[7]["MicrocontrollerGpoPin"];
-
-                    ButtonMatrix* buttonMatrix = new ButtonMatrix(deviceIndex, settings, mqttClient, getBaseTopic());
-                    buttonMatrix->setRowPins(row0Pin, row1Pin, row2Pin, row3Pin);
-                    buttonMatrix->setColPins(column0Pin, column1Pin, column2Pin, column3Pin);
-
-                    buttonMatrixHandling.AddDevice(buttonMatrix);
-
-                    Serial.println("Buttonmatrix initialized.");
-                }
+bool createKeypad(const DeviceConfiguration& configuration)
+{
+    int column3Pin = configuration.getPin(0);
+    int column2Pin = configuration.getPin(1);
+    int column1Pin = configuration.getPin(2);
+    int column0Pin = configuration.getPin(3);
+    int row0Pin    = configuration.getPin(4);
+    int row1Pin    = configuration.getPin(5);
+    int row2Pin    = configuration.getPin(6);
+    int row3Pin    = configuration.getPin(7);
+
+    ButtonMatrix* buttonMatrix = new ButtonMatrix(configuration.DeviceIndex, settings, mqttClient, getBaseTopic());
+    buttonMatrix->setRowPins(row0Pin, row1Pin, row2Pin, row3Pin);
+    buttonMatrix->setColPins(column0Pin, column1Pin, column2Pin, column3Pin);
+
+    buttonMatrixHandling.AddDevice(buttonMatrix);
+    handlingRegistry.add(&buttonMatrixHandling, "Keypad 4x4");
+
+    Serial.println("Buttonmatrix initialized.");
+    return true;
+}
 #endif // USE_KEYPAD
 
 #ifdef USE_UV
-                if (deviceType == "UV")
-                {
-                    int analogPin     = arrPins[0]["MicrocontrollerGpoPin"];
-                    uvSensorGUVAS12SD = new UvSensorGUVAS12SD(deviceIndex, settings, mqttClient, getBaseTopic(), analogPin);
-                    Serial.println("UV Sensor initialized on pin " + String(analogPin) + ".");
-                }
+bool createUvSensor(const DeviceConfiguration& configuration)
+{
+    int      analogPin            = configuration.getPin(0);
+    uint16_t sampleIntervalMillis = 100;
+    uint32_t windowMillis         = 10000;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
+
+        if (propertyName == "SampleIntervalMillis")
+        {
+            sampleIntervalMillis = property["Value"];
+        }
+        else if (propertyName == "WindowMillis")
+        {
+            windowMillis = property["Value"];
+        }
+    }
+    deviceRegistry.add(
+        new UvSensorGUVAS12SD(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), &adcService, analogPin, sampleIntervalMillis, windowMillis),
+        "UV");
+    Serial.println("UV Sensor initialized on pin " + String(analogPin) + ".");
+    return true;
+}
 #endif // USE_UV
 
 #ifdef USE_STEPPER_MOTOR
-                if (deviceType == "28BY48Stepper")
-                {
-                    int pin1 = arrPins[0]["MicrocontrollerGpoPin"];
-                    int pin2 = arrPins[1]["MicrocontrollerGpoPin"];
-                    int pin3 = arrPins[2]["MicrocontrollerGpoPin"];
-                    int pin4 = arrPins[3]["MicrocontrollerGpoPin"];
+bool createStepperMotor(const DeviceConfiguration& configuration)
+{
+    int pin1 = configuration.getPin(0);
+    int pin2 = configuration.getPin(1);
+    int pin3 = configuration.getPin(2);
+    int pin4 = configuration.getPin(3);
 
-                    stepperMotor = new StepperMotor(deviceIndex, settings, mqttClient, getBaseTopic(), pin1, pin2, pin3, pin4);
+    deviceRegistry.add(new StepperMotor(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), pin1, pin2, pin3, pin4), "28BY48Stepper");
 
-                    Serial.println("28BY48 Stepper initialized.");
-                }
+    Serial.println("28BY48 Stepper initialized.");
+    return true;
+}
 #endif // USE_STEPPER_MOTOR
 
 #ifdef USE_HC_SR501
-                // Add 1..3 HC-SR501 motion detectors.
-                if (deviceType == "HC-SR501")
-                {
-                    int pinMotionDetector = arrPins[0]["MicrocontrollerGpoPin"];
-                    motionDetectorsHrsc501Handling.addDevice(deviceIndex, settings, mqttClient, getBaseTopic(), pinMotionDetector);
-                }
+// Add 1..3 HC-SR501 motion detectors.
+bool createMotionDetector(const DeviceConfiguration& configuration)
+{
+    int pinMotionDetector = configuration.getPin(0);
+    motionDetectorsHrsc501Handling.addDevice(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), pinMotionDetector);
+    handlingRegistry.add(&motionDetectorsHrsc501Handling, "HC-SR501");
+    return true;
+}
 #endif // USE_HC_SR501
 
 #ifdef USE_RD_03D
-                if (deviceType == "Rd-03D")
-                {
-                    uint8_t pinRx = arrPins[0]["MicrocontrollerGpoPin"];
-                    uint8_t pinTx = arrPins[1]["MicrocontrollerGpoPin"];
+bool createRd03D(const DeviceConfiguration& configuration)
+{
+    uint8_t pinRx = configuration.getPin(0);
+    uint8_t pinTx = configuration.getPin(1);
 
-                    u_int16_t timeoutMillis          = 30000;
-                    u_int16_t maxDistanceMillimeters = 60000;
-                    bool      multiTargetMode        = false;
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName = property["Name"];
+    u_int16_t timeoutMillis          = 30000;
+    u_int16_t maxDistanceMillimeters = 60000;
+    bool      multiTargetMode        = false;
+    u_int16_t publishIntervalMillis  = 500;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
 
-                        if (propertyName == "TimeoutMillis")
-                        {
-                            timeoutMillis = property["Value"];
-                        }
-                        else if (propertyName == "MaxDistanceMillimeters")
-                        {
-                            maxDistanceMillimeters = property["Value"];
-                        }
-                        else if (propertyName == "MultiTargetMode")
-                        {
-                            multiTargetMode = property["Value"];
-                        }
-                    }
+        if (propertyName == "TimeoutMillis")
+        {
+            timeoutMillis = property["Value"];
+        }
+        else if (propertyName == "MaxDistanceMillimeters")
+        {
+            maxDistanceMillimeters = property["Value"];
+        }
+        else if (propertyName == "MultiTargetMode")
+        {
+            multiTargetMode = property["Value"];
+        }
+        else if (propertyName == "PublishIntervalMillis")
+        {
+            publishIntervalMillis = property["Value"];
+        }
+    }
 
-                    rd03d = new Rd03D(deviceIndex, settings, mqttClient, getBaseTopic(), pinRx, pinTx, timeoutMillis, maxDistanceMillimeters,
-                                      multiTargetMode);
-                    Serial.print("Rd-03d configuration added! pinRx: " + String(pinRx) + ", pinTx: " + String(pinTx));
-                    Serial.println(", TimeOutMillis: " + String(timeoutMillis) + ", MaxDistanceMillimeters: " + String(maxDistanceMillimeters));
-                }
+    deviceRegistry.add(new Rd03D(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), pinRx, pinTx, timeoutMillis,
+                                 maxDistanceMillimeters, multiTargetMode, publishIntervalMillis),
+                       "Rd-03D");
+    Serial.print("Rd-03d configuration added! pinRx: " + String(pinRx) + ", pinTx: " + String(pinTx));
+    Serial.println(", TimeOutMillis: " + String(timeoutMillis) + ", MaxDistanceMillimeters: " + String(maxDistanceMillimeters));
+    return true;
+}
 #endif // USE_RD_03D
 
 #ifdef USE_LCD_160X
-                // Add USE_LCD_160X display.
-                if (deviceType == "LCD160x")
-                {
-                    Serial.println("Initializing LCD160x display.");
-                    uint8_t columns    = 20;
-                    uint8_t rows       = 4;
-                    uint8_t i2cAddress = 0x27;
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName  = property["Name"];
-                        String propertyValue = property["Value"];
+bool createLcdDisplay(const DeviceConfiguration& configuration)
+{
+    Serial.println("Initializing LCD160x display.");
+    uint8_t columns    = 20;
+    uint8_t rows       = 4;
+    uint8_t i2cAddress = 0x27;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName  = property["Name"];
+        String propertyValue = property["Value"];
 
-                        if (propertyName == "Columns")
-                        {
-                            columns = std::stoi(propertyValue.c_str());
-                        }
-                        else if (propertyName == "Rows")
-                        {
-                            columns = std::stoi(propertyValue.c_str());
-                        }
-                        else if (propertyName == "I2CAddress")
-                        {
-                            i2cAddress = std::stoi(propertyValue.c_str());
-                        }
-                    }
+        if (propertyName == "Columns")
+        {
+            columns = std::stoi(propertyValue.c_str());
+        }
+        else if (propertyName == "Rows")
+        {
+            columns = std::stoi(propertyValue.c_str());
+        }
+        else if (propertyName == "I2CAddress")
+        {
+            i2cAddress = std::stoi(propertyValue.c_str());
+        }
+    }
 
-                    lcdDisplay = new LcdDisplay(deviceIndex, settings, mqttClient, getBaseTopic(),
-                                                i2cAddress, // set the LCD address to 0x27
-                                                columns, rows);
+    deviceRegistry.add(new LcdDisplay(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(),
+                                      i2cAddress, // set the LCD address to 0x27
+                                      columns, rows),
+                       "LCD160x");
 
-                    Serial.println("LCD160x configuration added! I2C-Address: " + String(i2cAddress));
-                }
+    Serial.println("LCD160x configuration added! I2C-Address: " + String(i2cAddress));
+    return true;
+}
 #endif // USE_LCD_160X
 
 #ifdef USE_OLED_SSD1306
+// SDA must be connected to pin 21 and SCL to pin 22.
+bool createOledSsd1306(const DeviceConfiguration& configuration)
+{
+    Serial.println("Initializing OLED_SSD1306 display.");
+    u_int8_t i2cAddress = 0x3C;
 
-                // SDA must be connected to pin 21 and SCL to pin 22.
-                if (deviceType == "OLED_SSD1306")
-                {
-                    Serial.println("Initializing OLED_SSD1306 display.");
-                    // u_int8_t sclPin = arrPins[0]["MicrocontrollerGpoPin"];
-                    // u_int8_t sdaPin = arrPins[1]["MicrocontrollerGpoPin"];
-                    u_int8_t i2cAddress = 0x3C;
-
-                    oled1306 = new OledSsd1306Display(deviceIndex, settings, mqttClient, getBaseTopic(), i2cAddress);
-                    Serial.println("Oled display SSD1306 initialized! I2C-Address: " + String(i2cAddress));
-                }
+    oled1306 = new OledSsd1306Display(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), i2cAddress);
+    deviceRegistry.add(oled1306, "OLED_SSD1306");
+    Serial.println("Oled display SSD1306 initialized! I2C-Address: " + String(i2cAddress));
+    return true;
+}
 #endif // USE_OLED_SSD1306
 
 #ifdef USE_DS18B20
-                if (deviceType == "DS18B20")
-                {
-
-                    int datPin = arrPins[0]["MicrocontrollerGpoPin"];
+bool createDs18b20(const DeviceConfiguration& configuration)
+{
+    int datPin = configuration.getPin(0);
 
-                    int transmissionInterval = 20000;
-                    int resolution           = 11;
+    int transmissionInterval = 20000;
+    int resolution           = 11;
 
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName  = property["Name"];
-                        String propertyValue = property["Value"];
-                        if (propertyName == "Interval")
-                        {
-                            transmissionInterval = std::stoi(propertyValue.c_str());
-                        }
-                        else if (propertyName == "Resolution")
-                        {
-                            resolution = std::stoi(propertyValue.c_str());
-                        }
-                        if (transmissionInterval < 5000)
-                        {
-                            transmissionInterval = 5000;
-                        }
-                        if (transmissionInterval > 900000) // 15 min
-                        {
-                            transmissionInterval = 900000;
-                        }
-                        if (resolution < 9)
-                        {
-                            resolution = 9;
-                        }
-                        if (resolution > 11)
-                        {
-                            resolution = 11;
-                        }
-                    }
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName  = property["Name"];
+        String propertyValue = property["Value"];
+        if (propertyName == "Interval")
+        {
+            transmissionInterval = std::stoi(propertyValue.c_str());
+        }
+        else if (propertyName == "Resolution")
+        {
+            resolution = std::stoi(propertyValue.c_str());
+        }
+        if (transmissionInterval < 5000)
+        {
+            transmissionInterval = 5000;
+        }
+        if (transmissionInterval > 900000) // 15 min
+        {
+            transmissionInterval = 900000;
+        }
+        if (resolution < 9)
+        {
+            resolution = 9;
+        }
+        if (resolution > 12) // 750 ms conversion time, the conversion does not block the loop.
+        {
+            resolution = 12;
+        }
+    }
 
-                    // Add 1 DS18B20 temperature sensors manager which can support 1..64 DS18B20 temperature sensors.
-                    ds18B20SensorManager = new DS18B20(deviceIndex, settings, mqttClient, getBaseTopic(), datPin, resolution, transmissionInterval);
+    // Add 1 DS18B20 temperature sensors manager which can support 1..64 DS18B20 temperature sensors.
+    deviceRegistry.add(new DS18B20(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), datPin, resolution, transmissionInterval),
+                       "DS18B20");
 
-                    Serial.println("DS18B20 sensors configuration loaded! Dat Pin is " + String(datPin) + ", Resolution: " + String(resolution) +
-                                   ", Transmission interval ms: " + String(transmissionInterval));
-                }
+    Serial.println("DS18B20 sensors configuration loaded! Dat Pin is " + String(datPin) + ", Resolution: " + String(resolution) +
+                   ", Transmission interval ms: " + String(transmissionInterval));
+    return true;
+}
 #endif // USE_DS18B20
 
 #ifdef USE_HW507
-                if (deviceType == "HW507")
-                {
-                    uint8_t dataPin    = arrPins[0]["MicrocontrollerGpoPin"];
-                    u16_t   intervalMs = 10000;
-                    uint8_t deviceType = DHT11;
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName = property["Name"];
+bool createHw507(const DeviceConfiguration& configuration)
+{
+    uint8_t dataPin    = configuration.getPin(0);
+    u16_t   intervalMs = 10000;
+    uint8_t deviceType = DHT11;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
 
-                        if (propertyName == "DeviceType")
-                        {
-                            deviceType = property["Value"];
-                        }
-                        else if (propertyName == "IntervalMs")
-                        {
-                            intervalMs = property["Value"];
-                        }
-                    }
-                    hw507HumiditySensor = new IotZoo::HW507(deviceIndex, settings, mqttClient, getBaseTopic(), deviceType, dataPin, intervalMs);
-                }
+        if (propertyName == "DeviceType")
+        {
+            deviceType = property["Value"];
+        }
+        else if (propertyName == "IntervalMs")
+        {
+            intervalMs = property["Value"];
+        }
+    }
+    deviceRegistry.add(new IotZoo::HW507(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), deviceType, dataPin, intervalMs),
+                       "HW507");
+    return true;
+}
 #endif // USE_HW507
 
 #ifdef USE_WS2818
-                if (deviceType == "NEO")
-                {
-                    Serial.println("Configuration of NEO pixels...");
-                    int dioPin       = arrPins[0]["MicrocontrollerGpoPin"];
-                    int numberOfLeds = 256;
+bool createNeoPixels(const DeviceConfiguration& configuration)
+{
+    Serial.println("Configuration of NEO pixels...");
+    int dioPin       = configuration.getPin(0);
+    int numberOfLeds = 256;
+
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName  = property["Name"];
+        String propertyValue = property["Value"];
+        if (propertyName == "numberOfLeds")
+        {
+            numberOfLeds = std::stoi(propertyValue.c_str());
+        }
+    }
+    // The show() of the Adafruit_NeoPixel supports only one light strip. With USE_WS2818_RMT every strip gets its own RMT channel.
+    deviceRegistry.add(new WS2818(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), dioPin, numberOfLeds), "NEO");
+    Serial.println("Neo pixel configuration loaded! DIO Pin is " + String(dioPin) + ", Leds: " + String(numberOfLeds));
+    return true;
+}
 
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName  = property["Name"];
-                        String propertyValue = property["Value"];
-                        if (propertyName == "numberOfLeds")
-                        {
-                            numberOfLeds = std::stoi(propertyValue.c_str());
-                        }
-                    }
-                    ws2812 = new WS2818(deviceIndex, settings, mqttClient, getBaseTopic(), dioPin, numberOfLeds);
-                    Serial.println("Neo pixel configuration loaded! DIO Pin is " + String(dioPin) + ", Leds: " + String(numberOfLeds));
-                }
 #ifdef USE_WS2818_PIXEL_MATRIX
-                else if (deviceType == "PixelMatrix")
-                {
-                    Serial.println("Configuration of NEO pixel matrix...");
-                    int  dioPin                = arrPins[0]["MicrocontrollerGpoPin"];
-                    uint numberOfLedsPerColumn = 8;
-                    uint numberOfLedsPerRow    = 8;
-                    uint extensions            = 0;
+bool createPixelMatrix(const DeviceConfiguration& configuration)
+{
+    Serial.println("Configuration of NEO pixel matrix...");
+    int  dioPin                = configuration.getPin(0);
+    uint numberOfLedsPerColumn = 8;
+    uint numberOfLedsPerRow    = 8;
+    uint extensions            = 0;
 
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName  = property["Name"];
-                        String propertyValue = property["Value"];
-                        if (propertyName == "numberOfLedsPerColumn")
-                        {
-                            numberOfLedsPerColumn = std::stoi(propertyValue.c_str());
-                        }
-                        else if (propertyName == "numberOfLedsPerRow")
-                        {
-                            numberOfLedsPerRow = std::stoi(propertyValue.c_str());
-                        }
-                        else if (propertyName == "extensions")
-                        {
-                            extensions = std::stoi(propertyValue.c_str());
-                        }
-                        extensions = 1;
-                    }
-                    ws2812 = new PixelMatrix(deviceIndex, settings, mqttClient, getBaseTopic(), dioPin, numberOfLedsPerColumn, numberOfLedsPerRow,
-                                             (PixelMatrixExtensions)extensions);
-                    Serial.println("Neo pixel matrix configuration loaded! DIO Pin is " + String(dioPin) +
-                                   ", numberOfLedsPerColumn: " + String(numberOfLedsPerColumn) +
-                                   ", numberOfLedsPerRow: " + String(numberOfLedsPerRow) + ", Extensions: " + String(extensions));
-                }
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName  = property["Name"];
+        String propertyValue = property["Value"];
+        if (propertyName == "numberOfLedsPerColumn")
+        {
+            numberOfLedsPerColumn = std::stoi(propertyValue.c_str());
+        }
+        else if (propertyName == "numberOfLedsPerRow")
+        {
+            numberOfLedsPerRow = std::stoi(propertyValue.c_str());
+        }
+        else if (propertyName == "extensions")
+        {
+            extensions = std::stoi(propertyValue.c_str());
+        }
+        extensions = 1;
+    }
+    deviceRegistry.add(new PixelMatrix(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), dioPin, numberOfLedsPerColumn,
+                                       numberOfLedsPerRow, (PixelMatrixExtensions)extensions),
+                       "PixelMatrix");
+    Serial.println("Neo pixel matrix configuration loaded! DIO Pin is " + String(dioPin) +
+                   ", numberOfLedsPerColumn: " + String(numberOfLedsPerColumn) + ", numberOfLedsPerRow: " + String(numberOfLedsPerRow) +
+                   ", Extensions: " + String(extensions));
+    return true;
+}
 #endif // USE_WS2818_PIXEL_MATRIX
 #endif // USE_WS2818
 
+#if defined(USE_TM1637_4) || defined(USE_TM1637_6)
+/// @brief Reads the properties of a TM1637 display.
+void readTm1637Properties(const DeviceConfiguration& configuration, bool& flipDisplay, String& serverDownText)
+{
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName  = property["Name"];
+        String propertyValue = property["Value"];
+
+        if (propertyName == "flipDisplay")
+        {
+            propertyValue.toLowerCase();
+            flipDisplay = propertyValue == "true";
+        }
+        else if (propertyName == "serverDownText")
+        {
+            propertyValue.toLowerCase();
+            serverDownText = propertyValue;
+        }
+    }
+}
+#endif
+
 #ifdef USE_TM1637_4
-                if (deviceType == "TM1637_4")
-                {
-                    Serial.println("TM1637_4 display");
+bool createTm1637_4(const DeviceConfiguration& configuration)
+{
+    Serial.println("TM1637_4 display");
 
-                    int clkPin = arrPins[0]["MicrocontrollerGpoPin"];
-                    int dioPin = arrPins[1]["MicrocontrollerGpoPin"];
+    int clkPin = configuration.getPin(0);
+    int dioPin = configuration.getPin(1);
 
-                    bool   flipDisplay = false;
-                    String serverDownText;
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName  = property["Name"];
-                        String propertyValue = property["Value"];
+    bool   flipDisplay = false;
+    String serverDownText;
+    readTm1637Properties(configuration, flipDisplay, serverDownText);
 
-                        if (propertyName == "flipDisplay")
-                        {
-                            propertyValue.toLowerCase();
-                            flipDisplay = propertyValue == "true";
-                        }
-                        else if (propertyName == "serverDownText")
-                        {
-                            propertyValue.toLowerCase();
-                            serverDownText = propertyValue;
-                        }
-                    }
-                    tm1637_4Handling = new TM1637_4_Handling();
-                    if (nullptr != tm1637_4Handling)
-                    {
-                        tm1637_4Handling->addDevice(getBaseTopic(), deviceIndex, clkPin, dioPin, flipDisplay, serverDownText);
-                        Serial.println("TM1637_4 display with deviceIndex " + String(deviceIndex) + " initialized! CLK Pin is " + String(clkPin) +
-                                       ", DIO Pin is " + String(dioPin) + ", FlipDisplay: " + String(flipDisplay));
-                    }
-                }
+    tm1637_4Handling.addDevice(getBaseTopic(), configuration.DeviceIndex, clkPin, dioPin, flipDisplay, serverDownText);
+    handlingRegistry.add(&tm1637_4Handling, "TM1637_4");
+    Serial.println("TM1637_4 display with deviceIndex " + String(configuration.DeviceIndex) + " initialized! CLK Pin is " + String(clkPin) +
+                   ", DIO Pin is " + String(dioPin) + ", FlipDisplay: " + String(flipDisplay));
+    return true;
+}
 #endif // USE_TM1637_4
 
 #ifdef USE_TM1637_6
-                if (deviceType == "TM1637_6")
-                {
-                    Serial.println("TM1637_6 display");
-
-                    int clkPin = arrPins[0]["MicrocontrollerGpoPin"];
-                    int dioPin = arrPins[1]["MicrocontrollerGpoPin"];
+bool createTm1637_6(const DeviceConfiguration& configuration)
+{
+    Serial.println("TM1637_6 display");
 
-                    bool   flipDisplay = false;
-                    String serverDownText;
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName  = property["Name"];
-                        String propertyValue = property["Value"];
+    int clkPin = configuration.getPin(0);
+    int dioPin = configuration.getPin(1);
 
-                        if (propertyName == "flipDisplay")
-                        {
-                            propertyValue.toLowerCase();
-                            flipDisplay = propertyValue == "true";
-                        }
-                        else if (propertyName == "serverDownText")
-                        {
-                            propertyValue.toLowerCase();
-                            serverDownText = propertyValue;
-                        }
-                    }
+    bool   flipDisplay = false;
+    String serverDownText;
+    readTm1637Properties(configuration, flipDisplay, serverDownText);
 
-                    tm1637_6Handling.addDevice(getBaseTopic(), deviceIndex, clkPin, dioPin, flipDisplay, serverDownText);
+    tm1637_6Handling.addDevice(getBaseTopic(), configuration.DeviceIndex, clkPin, dioPin, flipDisplay, serverDownText);
+    handlingRegistry.add(&tm1637_6Handling, "TM1637_6");
 
-                    Serial.println("TM1637_6 display initialized! CLK Pin is " + String(clkPin) + ", DIO Pin is " + String(dioPin));
-                }
+    Serial.println("TM1637_6 display initialized! CLK Pin is " + String(clkPin) + ", DIO Pin is " + String(dioPin));
+    return true;
+}
 #endif // USE_TM1637_6
 
 #ifdef USE_LED_AND_KEY
-                if (deviceType == "TM1638")
-                {
-                    Serial.println("TM1638_8 display");
+bool createTm1638(const DeviceConfiguration& configuration)
+{
+    Serial.println("TM1638_8 display");
 
-                    int strobePin = arrPins[0]["MicrocontrollerGpoPin"];
-                    int clkPin    = arrPins[1]["MicrocontrollerGpoPin"];
-                    int dioPin    = arrPins[2]["MicrocontrollerGpoPin"];
+    int strobePin = configuration.getPin(0);
+    int clkPin    = configuration.getPin(1);
+    int dioPin    = configuration.getPin(2);
 
-                    tm1638 = new TM1638(deviceIndex, settings, mqttClient, getBaseTopic(), strobePin, clkPin, dioPin);
+    deviceRegistry.add(new TM1638(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), strobePin, clkPin, dioPin), "TM1638");
 
-                    Serial.println("TM1638 display initialized! Strobe Pin is " + String(strobePin) + ", CLK Pin is " + String(clkPin) +
-                                   ", DIO Pin is " + String(dioPin));
-                }
+    Serial.println("TM1638 display initialized! Strobe Pin is " + String(strobePin) + ", CLK Pin is " + String(clkPin) + ", DIO Pin is " +
+                   String(dioPin));
+    return true;
+}
 #endif // USE_LED_AND_KEY
 
 #ifdef USE_REMOTE_GPIOS
-                if (deviceType == "Remote GPIO")
-                {
-                    Serial.println("Remote GPIO");
+bool createRemoteGpio(const DeviceConfiguration& configuration)
+{
+    Serial.println("Remote GPIO");
 
-                    int gpioPin = arrPins[0]["MicrocontrollerGpoPin"];
-                    remoteGpios.emplace_back(deviceIndex, settings, mqttClient, getBaseTopic(), gpioPin);
-                    Serial.println("Remote GPIO PIN configuration loaded! Pin is " + String(gpioPin) + ". Size remoteGpios: " + remoteGpios.size());
-                }
+    int         gpioPin    = configuration.getPin(0);
+    RemoteGpio* remoteGpio = new RemoteGpio(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), gpioPin);
+    remoteGpios.push_back(remoteGpio);
+    deviceRegistry.add(remoteGpio, "Remote GPIO");
+    Serial.println("Remote GPIO PIN configuration loaded! Pin is " + String(gpioPin) + ". Size remoteGpios: " + remoteGpios.size());
+    return true;
+}
 #endif // USE_REMOTE_GPIOS
 
 #ifdef USE_TRAFFIC_LIGHT_LEDS
-                if (deviceType == "LEDS Traffic Light")
-                {
-                    Serial.println("LEDS Traffic Light");
+bool createTrafficLight(const DeviceConfiguration& configuration)
+{
+    Serial.println("LEDS Traffic Light");
 
-                    int gpioLedRed    = -1;
-                    int gpioLedYellow = -1;
-                    int gpioLedGreen  = -1;
+    int gpioLedRed    = -1;
+    int gpioLedYellow = -1;
+    int gpioLedGreen  = -1;
 
-                    for (JsonVariant property : arrPins)
-                    {
-                        String propertyName  = property["PinName"];
-                        String propertyValue = property["MicrocontrollerGpoPin"];
-                        Serial.println("propertyName: " + propertyName + ", propertyValue: " + propertyValue);
+    for (JsonVariant property : configuration.Pins)
+    {
+        String propertyName  = property["PinName"];
+        String propertyValue = property["MicrocontrollerGpoPin"];
+        Serial.println("propertyName: " + propertyName + ", propertyValue: " + propertyValue);
 
-                        if (propertyName == "R")
-                        {
-                            gpioLedRed = std::stoi(propertyValue.c_str());
-                            Serial.println("Red Gpio: " + gpioLedRed);
-                        }
-                        else if (propertyName == "Y")
-                        {
-                            gpioLedYellow = std::stoi(propertyValue.c_str());
-                            Serial.println("Yellow Gpio: " + gpioLedYellow);
-                        }
-                        else if (propertyName == "G")
-                        {
-                            gpioLedGreen = std::stoi(propertyValue.c_str());
-                            Serial.println("Green Gpio: " + gpioLedGreen);
-                        }
-                    }
+        if (propertyName == "R")
+        {
+            gpioLedRed = std::stoi(propertyValue.c_str());
+            Serial.println("Red Gpio: " + gpioLedRed);
+        }
+        else if (propertyName == "Y")
+        {
+            gpioLedYellow = std::stoi(propertyValue.c_str());
+            Serial.println("Yellow Gpio: " + gpioLedYellow);
+        }
+        else if (propertyName == "G")
+        {
+            gpioLedGreen = std::stoi(propertyValue.c_str());
+            Serial.println("Green Gpio: " + gpioLedGreen);
+        }
+    }
 
-                    if (gpioLedRed != -1 && gpioLedYellow != -1 && gpioLedGreen != -1)
-                    {
-                        trafficLightLeds.emplace_back(deviceIndex, settings, mqttClient, getBaseTopic(), gpioLedRed, gpioLedYellow, gpioLedGreen);
-                    }
-                }
+    if (gpioLedRed == -1 || gpioLedYellow == -1 || gpioLedGreen == -1)
+    {
+        return false;
+    }
+    deviceRegistry.add(
+        new TrafficLight(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), gpioLedRed, gpioLedYellow, gpioLedGreen),
+        "LEDS Traffic Light");
+    return true;
+}
 #endif // USE_TRAFFIC_LIGHT_LEDS
 
 #ifdef USE_HW040
-                if (deviceType == "HW-040")
-                {
-                    Serial.println("HW-040 rotary encoder");
-                    int clkPin = arrPins[0]["MicrocontrollerGpoPin"];
-                    int dtPin  = arrPins[1]["MicrocontrollerGpoPin"];
-                    int swPin  = arrPins[2]["MicrocontrollerGpoPin"];
-
-                    int  boundaryMinValue = 0;
-                    int  boundaryMaxValue = 255;
-                    bool circleValues     = false;
-                    int  acceleration     = 250;
-                    int  encoderSteps     = 2;
-                    for (JsonVariant property : arrProperties)
-                    {
-                        String propertyName  = property["Name"];
-                        String propertyValue = property["Value"];
-
-                        if (propertyName == "BoundaryMinValue")
-                        {
-                            boundaryMinValue = std::stoi(propertyValue.c_str());
-                        }
+bool createRotaryEncoder(const DeviceConfiguration& configuration)
+{
+    Serial.println("HW-040 rotary encoder");
+    int clkPin = configuration.getPin(0);
+    int dtPin  = configuration.getPin(1);
+    int swPin  = configuration.getPin(2);
+
+    int  boundaryMinValue = 0;
+    int  boundaryMaxValue = 255;
+    bool circleValues     = false;
+    int  acceleration     = 250;
+    int  encoderSteps     = 2;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName  = property["Name"];
+        String propertyValue = property["Value"];
+
+        if (propertyName == "BoundaryMinValue")
+        {
+            boundaryMinValue = std::stoi(propertyValue.c_str());
+        }
 
-                        if (propertyName == "BoundaryMaxValue")
-                        {
-                            boundaryMaxValue = std::stoi(propertyValue.c_str());
-                        }
+        if (propertyName == "BoundaryMaxValue")
+        {
+            boundaryMaxValue = std::stoi(propertyValue.c_str());
+        }
 
-                        if (propertyName == "Acceleration")
-                        {
-                            acceleration = std::stoi(propertyValue.c_str());
-                        }
+        if (propertyName == "Acceleration")
+        {
+            acceleration = std::stoi(propertyValue.c_str());
+        }
 
-                        if (propertyName == "EncoderSteps")
-                        {
-                            encoderSteps = std::stoi(propertyValue.c_str());
-                        }
+        if (propertyName == "EncoderSteps")
+        {
+            encoderSteps = std::stoi(propertyValue.c_str());
+        }
 
-                        if (propertyName == "CircleValue")
-                        {
-                            circleValues = propertyValue == "true";
-                        }
-                    }
+        if (propertyName == "CircleValue")
+        {
+            circleValues = propertyValue == "true";
+        }
+    }
 
-                    hw040Handling.addDevice(deviceIndex, settings, mqttClient, getBaseTopic(), boundaryMinValue, boundaryMaxValue, circleValues,
-                                            acceleration, encoderSteps, clkPin, dtPin, swPin, -1);
-                    Serial.println("HW-040 rotary encoder initialized! CLK Pin is " + String(clkPin) + ", DT Pin is " + String(dtPin) +
-                                   ", MS Pin is " + String(swPin) + ", boundaryMinValue is " + String(boundaryMinValue) + ", boundaryMaxValue is " +
-                                   String(boundaryMaxValue) + ", acceleration is " + String(acceleration) + ", circleValues is " +
-                                   String(circleValues) + ", encoderSteps is " + String(encoderSteps));
-                }
+    hw040Handling.addDevice(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), boundaryMinValue, boundaryMaxValue, circleValues,
+                            acceleration, encoderSteps, clkPin, dtPin, swPin, -1);
+    handlingRegistry.add(&hw040Handling, "HW-040");
+    Serial.println("HW-040 rotary encoder initialized! CLK Pin is " + String(clkPin) + ", DT Pin is " + String(dtPin) + ", MS Pin is " +
+                   String(swPin) + ", boundaryMinValue is " + String(boundaryMinValue) + ", boundaryMaxValue is " + String(boundaryMaxValue) +
+                   ", acceleration is " + String(acceleration) + ", circleValues is " + String(circleValues) + ", encoderSteps is " +
+                   String(encoderSteps));
+    return true;
+}
 #endif // USE_HW040
 
 #ifdef USE_BLE_HEART_RATE_SENSOR
-                if (deviceType == "BleHeartRateSensor")
+bool createHeartRateSensor(const DeviceConfiguration& configuration)
+{
+    uint8_t advertisingTimeoutSeconds = 30;
+    for (JsonVariant property : configuration.PropertyValues)
+    {
+        String propertyName = property["Name"];
+
+        if (propertyName == "AdvertisingTimeoutSeconds")
+        {
+            advertisingTimeoutSeconds = property["Value"].as<uint8_t>();
+        }
+    }
+
+    heartRateSensor = new HeartRateSensor(configuration.DeviceIndex, settings, mqttClient, getBaseTopic(), advertisingTimeoutSeconds);
+    deviceRegistry.add(heartRateSensor, "BleHeartRateSensor");
+    connectToHeartRateSensor(advertisingTimeoutSeconds);
+    return true;
+}
+#endif // USE_BLE_HEART_RATE_SENSOR
+
+/// @brief Only the compiled in device types get a factory.
+void registerDeviceFactories()
+{
+#ifdef USE_BUTTON
+    deviceFactories.add("Button", createButton);
+#endif
+#ifdef USE_KY025
+    deviceFactories.add("Reed-Contact", createReedContact);
+#endif
+#ifdef USE_AUDIO_STREAMER
+    deviceFactories.add("INMP441", createAudioStreamer);
+#endif
+#ifdef USE_GPS
+    deviceFactories.add("GPS", createGps);
+#endif
+#ifdef USE_BUZZER
+    deviceFactories.add("Buzzer", createBuzzer);
+#endif
+#ifdef USE_HT1621
+    deviceFactories.add("HT1621", createHt1621);
+#endif
+#ifdef USE_MAX7219
+    deviceFactories.add("MAX7219", createMax7219);
+#endif
+#ifdef USE_SWITCH
+    deviceFactories.add("Switch", createSwitch);
+#endif
+#ifdef USE_KEYPAD
+    deviceFactories.add("Keypad 4x4", createKeypad);
+#endif
+#ifdef USE_UV
+    deviceFactories.add("UV", createUvSensor);
+#endif
+#ifdef USE_STEPPER_MOTOR
+    deviceFactories.add("28BY48Stepper", createStepperMotor);
+#endif
+#ifdef USE_HC_SR501
+    deviceFactories.add("HC-SR501", createMotionDetector);
+#endif
+#ifdef USE_RD_03D
+    deviceFactories.add("Rd-03D", createRd03D);
+#endif
+#ifdef USE_LCD_160X
+    deviceFactories.add("LCD160x", createLcdDisplay);
+#endif
+#ifdef USE_OLED_SSD1306
+    deviceFactories.add("OLED_SSD1306", createOledSsd1306);
+#endif
+#ifdef USE_DS18B20
+    deviceFactories.add("DS18B20", createDs18b20);
+#endif
+#ifdef USE_HW507
+    deviceFactories.add("HW507", createHw507);
+#endif
+#ifdef USE_WS2818
+    deviceFactories.add("NEO", createNeoPixels);
+#ifdef USE_WS2818_PIXEL_MATRIX
+    deviceFactories.add("PixelMatrix", createPixelMatrix);
+#endif
+#endif
+#ifdef USE_TM1637_4
+    deviceFactories.add("TM1637_4", createTm1637_4);
+#endif
+#ifdef USE_TM1637_6
+    deviceFactories.add("TM1637_6", createTm1637_6);
+#endif
+#ifdef USE_LED_AND_KEY
+    deviceFactories.add("TM1638", createTm1638);
+#endif
+#ifdef USE_REMOTE_GPIOS
+    deviceFactories.add("Remote GPIO", createRemoteGpio);
+#endif
+#ifdef USE_TRAFFIC_LIGHT_LEDS
+    deviceFactories.add("LEDS Traffic Light", createTrafficLight);
+#endif
+#ifdef USE_HW040
+    deviceFactories.add("HW-040", createRotaryEncoder);
+#endif
+#ifdef USE_BLE_HEART_RATE_SENSOR
+    deviceFactories.add("BleHeartRateSensor", createHeartRateSensor);
+#endif
+}
+
+/**
+ * @brief Loads the configuration for the connected devices and instantiates them.
+ */
+void makeInstanceConfiguredDevices()
+{
+    Serial.println("Loading device configurations and instantiate devices...");
+
+    registerDeviceFactories();
+
+    String jsonDeviceConfigurations = settings->loadDeviceConfigurations();
+    if (0 == jsonDeviceConfigurations.length())
+    {
+        Serial.println("Not yet configured!");
+    }
+    else // if (jsonDeviceConfigurations.length() > 0)
+    {
+        Serial.println("Config: " + jsonDeviceConfigurations);
+        DynamicJsonDocument jsonDocument(4096);
+
+        if (!deserializeStaticJsonAndPublishError(jsonDocument, jsonDeviceConfigurations))
+        {
+            return;
+        }
+
+        JsonArray arrDevices = jsonDocument.as<JsonArray>();
+        deviceRegistry.reserve(arrDevices.size());
+
+        for (JsonVariant value : arrDevices)
+        {
+            String deviceType  = value["DeviceType"];
+            int    deviceIndex = value["DeviceIndex"];
+            bool   isEnabled   = value["IsEnabled"];
+
+            Serial.println("DeviceType: '" + deviceType + "', DeviceIndex: " + String(deviceIndex) + "', IsEnabled: " + String(isEnabled));
+
+            if (isEnabled)
+            {
+                DeviceConfiguration configuration;
+                configuration.DeviceIndex    = deviceIndex;
+                configuration.Pins           = value["Pins"].as<JsonArray>();
+                configuration.PropertyValues = value["PropertyValues"].as<JsonArray>();
+
+                size_t deviceCount = deviceRegistry.size();
+                if (!deviceFactories.isSupported(deviceType.c_str()))
+                {
+                    Serial.println("DeviceType '" + deviceType + "' is not supported by this firmware.");
+                }
+                else if (!deviceFactories.create(deviceType.c_str(), configuration))
+                {
+                    Serial.println("DeviceType '" + deviceType + "' with DeviceIndex " + String(deviceIndex) + " not created!");
+                }
+                else
                 {
-                    uint8_t advertisingTimeoutSeconds = 30;
-                    for (JsonVariant property : arrProperties)
+                    // e.g. "DeadbandAbsolute", "humidity.MaxPublishIntervalMillis": the publish policy of the channels of the new devices.
+                    for (size_t index = deviceCount; index < deviceRegistry.size(); index++)
                     {
-                        String propertyName = property["Name"];
-
-                        if (propertyName == "AdvertisingTimeoutSeconds")
+                        for (JsonVariant property : configuration.PropertyValues)
                         {
-                            advertisingTimeoutSeconds = property["Value"].as<uint8_t>();
+                            String propertyName = property["Name"];
+                            if (deviceRegistry[index]->setPublishPolicyParameter(propertyName.c_str(), property["Value"].as<float>()))
+                            {
+                                Serial.println("Publish policy: " + propertyName + " = " + property["Value"].as<String>());
+                            }
                         }
                     }
-
-                    heartRateSensor = new HeartRateSensor(deviceIndex, settings, mqttClient, getBaseTopic(), advertisingTimeoutSeconds);
-                    connectToHeartRateSensor(advertisingTimeoutSeconds);
                 }
-#endif // USE_BLE_HEART_RATE_SENSOR
             }
         }
     }
+    Serial.println("Devices: " + String(deviceRegistry.size()) + ", device handlings: " + String(handlingRegistry.size()));
+#ifdef USE_UV
+    adcService.begin(); // the analog pins of all devices are registered now.
+#endif
 }
 
 #if defined(USE_REST_SERVER)
@@ -1647,8 +1877,27 @@ void handleGetAlive()
     String json = createAliveJson();
     webServer.send(200, "application/json", json.c_str());
 }
-#endif
-#endif
+
+#ifdef USE_PROFILER
+/// @brief http get delivers the run time statistics of the scheduled tasks and MQTT callbacks. http://<ip>/profile
+/// http://<ip>/profile?reset=true clears the statistics afterwards.
+void handleGetProfile()
+{
+    Serial.println("Get profile");
+    DynamicJsonDocument jsonDocument(getProfileJsonCapacity());
+    AddProfileNestedJsonObject(&jsonDocument);
+    String json;
+    serializeJson(jsonDocument, json);
+    webServer.send(200, "application/json", json.c_str());
+
+    if (webServer.arg("reset") == "true")
+    {
+        profiler.reset();
+    }
+}
+#endif // USE_PROFILER
+#endif // USE_MQTT
+#endif // USE_REST_SERVER
 
 #ifdef USE_REST_SERVER
 /// @brief http get delivers the configuration of the connected sensors/devices. http://raspberrypi/deviceConfig
@@ -1665,9 +1914,13 @@ void handleGetDeviceConfig()
 void handleGetGpioState(int index)
 {
 #ifdef USE_REMOTE_GPIOS
-    auto remoteGpio = remoteGpios.begin();
-    std::advance(remoteGpio, index);
-    int data = remoteGpio->readDigitalValue();
+    if (index < 0 || index >= (int)remoteGpios.size())
+    {
+        webServer.send(404, "text/plain", "GPIO " + String(index) + " is not configured.");
+        return;
+    }
+    RemoteGpio* remoteGpio = remoteGpios[index];
+    int         data       = remoteGpio->readDigitalValue();
     Serial.println("GPIO Pin " + String(remoteGpio->getGpioPin()) + " is in state " + String(data));
     webServer.send(200, "text/plain", String(data));
 #endif
@@ -1753,6 +2006,9 @@ void handlePostMicrocontrollerConfig()
     {
         Serial.println("ProjectName not saved!");
     }
+#if defined(USE_MQTT)
+    invalidateTopicCache();
+#endif
     // Respond to the client
     webServer.send(200, "application/json", "{}");
 
@@ -1846,6 +2102,9 @@ void setup()
     // REST interface
 #if defined(USE_MQTT)
     webServer.on("/alive", HTTP_GET, handleGetAlive);
+#ifdef USE_PROFILER
+    webServer.on("/profile", HTTP_GET, handleGetProfile);
+#endif
 #endif
     webServer.on("/deviceConfig", HTTP_GET, handleGetDeviceConfig);
     webServer.on("/deviceConfig", HTTP_POST, handlePostDeviceConfig);
@@ -1858,17 +2117,6 @@ void setup()
     webServer.begin();
 #endif
 
-#ifdef USE_TM1637_4
-    if (nullptr != tm1637_4Handling)
-    {
-        tm1637_4Handling->setup();
-    }
-#endif
-
-#ifdef USE_TM1637_6
-    tm1637_6Handling.setup();
-#endif
-
 #if defined(USE_MQTT)
     char* mqttClientName = new char[18]();
 
@@ -1886,11 +2134,30 @@ void setup()
     }
 
     mqttClient = new MqttClient(mqttClientName, ssid, password, mqttBrokerIp, nullptr, nullptr, 1883);
+#ifdef USE_PROFILER
+    mqttClient->setProfiler(&profiler);
+#endif
+#ifdef USE_STORE_AND_FORWARD
+    // Without the partition the messages of short outages are kept in RAM only.
+    bool hasTelemetryLog = telemetryPartition.begin(ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr, 256 * 1024) && telemetryLog.begin();
+    storeAndForward      = new IotZoo::StoreAndForward(hasTelemetryLog ? &telemetryLog : nullptr);
+    mqttClient->setStoreAndForward(storeAndForward);
+    Serial.println("Store and forward: " + String(telemetryLog.getPendingCount()) + " stored messages to replay.");
+#endif
+#ifdef USE_WILDCARD_SUBSCRIPTION
+    // The topics of the devices and of main are below the base topic: one subscription per sub-tree the device does not publish to.
+    mqttClient->setWildcardPrefix(getBaseTopic());
+#endif
+    addTopics();
 
     Serial.println("BaseTopic: " + getBaseTopic());
 #endif
     makeInstanceConfiguredDevices();
-    lastAliveTime = millis() - settings->getAliveIntervalMillis();
+    for (DeviceHandlingBase* deviceHandling : handlingRegistry)
+    {
+        deviceHandling->setup();
+    }
+    scheduleTasks();
 
 #ifdef USE_HB0014
     pinMode(digitalPinInfraredLed, INPUT);
@@ -1955,211 +2222,169 @@ void registerTopics()
 
         topics.emplace_back(getBaseTopic() + "/settings/save", "{\"key\": \"data\"}", MessageDirection::IotZooClientOutbound);
     }
-#ifdef USE_BLE_HEART_RATE_SENSOR
-    if (nullptr != heartRateSensor)
+    for (const DeviceBase* device : deviceRegistry)
     {
-        heartRateSensor->addMqttTopicsToRegister(&topics);
+        device->addMqttTopicsToRegister(&topics);
     }
-#endif
 
-#ifdef USE_STEPPER_MOTOR
-    if (nullptr != stepperMotor)
+    for (const DeviceHandlingBase* deviceHandling : handlingRegistry)
     {
-        stepperMotor->addMqttTopicsToRegister(&topics);
+        deviceHandling->addMqttTopicsToRegister(&topics);
     }
-#endif
-
-#ifdef USE_BUTTON
-    buttonHandling.addMqttTopicsToRegister(&topics);
-#endif
 
-#ifdef USE_KY025
-    if (nullptr != ky025)
-    {
-        ky025->addMqttTopicsToRegister(&topics);
-    }
-#endif
+    pushTopicsToIotZooClient(topics);
+#endif // USE_MQTT
+    topicsRegistered = true;
+}
 
-#ifdef USE_BUZZER
-    if (nullptr != buzzer)
-    {
-        buzzer->addMqttTopicsToRegister(&topics);
-    }
-#endif
+/// @brief Called when the IotZoo Client has not responded to the alive message.
+void onIotZooClientUnavailable()
+{
+    Serial.println("*** IoT-Zoo client is unavailable! Please start it! ***");
 
-#ifdef USE_SWITCH
-    for (auto& buttonSwitch : switches)
-    {
-        buttonSwitch.addMqttTopicsToRegister(&topics);
-    }
-#endif
+    String jsonMicrocontroller = serializeMicrocontroller();
 
-#ifdef USE_REMOTE_GPIOS
-    for (auto& remoteGpio : remoteGpios)
+    mqttClient->publish("i_am_lost", jsonMicrocontroller);
+    // server dead?
+    for (DeviceBase* device : deviceRegistry)
     {
-        remoteGpio.addMqttTopicsToRegister(&topics);
+        device->onIotZooClientUnavailable();
     }
-#endif
 
-#ifdef USE_LCD_160X
-    if (nullptr != lcdDisplay)
+    for (DeviceHandlingBase* deviceHandling : handlingRegistry)
     {
-        lcdDisplay->addMqttTopicsToRegister(&topics);
+        deviceHandling->onIotZooClientUnavailable();
     }
-#endif
+}
 
-#ifdef USE_OLED_SSD1306
-    if (nullptr != oled1306)
-    {
-        oled1306->addMqttTopicsToRegister(&topics);
-    }
-#endif
+#ifdef USE_HB0014
+void loopHB0014()
+{
+    digitalValueInfrared = digitalRead(digitalPinInfraredLed);
 
-#ifdef USE_TM1637_4
-    if (nullptr != tm1637_4Handling)
+    if (digitalValueInfrared == HIGH && digitalValueOldInfrared == LOW)
     {
-        tm1637_4Handling->addMqttTopicsToRegister(&topics);
-    }
+        long diff = millis() - lastMillisInfrared;
+#ifdef USE_OLED_SSD1306
+        if (nullptr != oled1306)
+        {
+            oled1306->setTextLine(3, String(diff) + " ms");
+        }
 #endif
-
-#ifdef USE_TM1637_6
-    tm1637_6Handling.addMqttTopicsToRegister(&topics);
+        if (diff > 30)
+        {
+            lastMillisInfrared = millis();
+            // 10000 impulses per kWh: 0.1 Wh since the previous impulse.
+            float watt = powerMeter.addImpulse(lastMillisInfrared);
+            LOG_DEBUG(LogModuleSensors, String(watt) + " watt");
+#ifdef USE_OLED_SSD1306
+            if (nullptr != oled1306)
+            {
+                oled1306->setTextLine(1, String(watt, 0));
+            }
 #endif
-
-#ifdef USE_HT1621
-    if (nullptr != ht1621)
-    {
-        ht1621->addMqttTopicsToRegister(&topics);
+        }
     }
-#endif
-
-#ifdef USE_MAX7219
-    if (nullptr != max7219)
+    // Also without impulses: at no load the window closes with 0 W.
+    IotZoo::AggregateSummary summary;
+    if (powerMeter.poll(millis(), summary))
     {
-        max7219->addMqttTopicsToRegister(&topics);
+        String topic = getBaseTopic() + "/power/0";
+        mqttClient->publish(topic, String(summary.mean, 0));
+        char json[128];
+        if (summary.toJson(json, sizeof(json), 0) > 0)
+        {
+            mqttClient->publish(topic + "/stats", json);
+        }
     }
+    digitalValueOldInfrared = digitalValueInfrared;
+}
 #endif
 
-#ifdef USE_HW040
-    hw040Handling.addMqttTopicsToRegister(&topics);
-#endif
-
-#ifdef USE_HC_SR501
-    motionDetectorsHrsc501Handling.addMqttTopicsToRegister(&topics);
-#endif
-
-#ifdef USE_RD_03D
-    if (nullptr != rd03d)
-    {
-        rd03d->addMqttTopicsToRegister(&topics);
-    }
-#endif // USE_RD_03D
-
-#ifdef USE_LED_AND_KEY
-    if (nullptr != tm1638)
+/// @brief Adds a periodic task to the scheduler. With USE_PROFILER the CPU cycles of every run are recorded.
+/// @param name Name of the task. Must outlive the scheduler (string literal).
+/// @param probeName Name in the profile, default is the name of the task.
+/// @return task id
+int scheduleTask(const char* name, uint32_t intervalMillis, Scheduler::TaskCallback callback, const String& probeName = "")
+{
+#ifdef USE_PROFILER
+    int probeId = profiler.addProbe(probeName.isEmpty() ? name : probeName.c_str());
+    callback    = [probeId, callback]()
     {
-        tm1638->addMqttTopicsToRegister(&topics);
-    }
-#endif
-
-#ifdef USE_KEYPAD
-    buttonMatrixHandling.addMqttTopicsToRegister(&topics);
+        uint32_t startCycles = ESP.getCycleCount();
+        callback();
+        profiler.record(probeId, ESP.getCycleCount() - startCycles); // unsigned difference, survives one wrap-around.
+    };
 #endif
+    return scheduler.addTask(name, intervalMillis, callback, millis());
+}
 
-#ifdef USE_DS18B20
-    if (nullptr != ds18B20SensorManager)
+/// @brief The scheduler calls device->loop() every device->getLoopIntervalMillis(). Devices without periodic work
+/// (loop interval 0) are not scheduled.
+/// @tparam TDevice DeviceBase or DeviceHandlingBase
+/// @param index Index in the registry, distinguishes devices of the same type in the profile, e.g. "DS18B20#1".
+template <typename TDevice> void scheduleDeviceLoop(const char* name, size_t index, TDevice* const device)
+{
+    if (device->getLoopIntervalMillis() > 0)
     {
-        ds18B20SensorManager->addMqttTopicsToRegister(&topics);
+        scheduleTask(name, device->getLoopIntervalMillis(), [device]() { device->loop(); }, String(name) + "#" + String(index));
     }
-#endif // USE_DS18B20
+}
 
-#ifdef USE_HW507
-    if (nullptr != hw507HumiditySensor)
+/// @brief Register the periodic work of the microcontroller and of the configured devices at the scheduler.
+void scheduleTasks()
+{
+    for (size_t index = 0; index < deviceRegistry.size(); index++)
     {
-        hw507HumiditySensor->addMqttTopicsToRegister(&topics);
+        scheduleDeviceLoop(deviceRegistry.getName(index), index, deviceRegistry[index]);
     }
-#endif // USE_HW507
 
-#ifdef USE_WS2818
-    if (nullptr != ws2812)
+    for (size_t index = 0; index < handlingRegistry.size(); index++)
     {
-        ws2812->addMqttTopicsToRegister(&topics);
+        scheduleDeviceLoop(handlingRegistry.getName(index), index, handlingRegistry[index]);
     }
-#endif
 
-#ifdef USE_AUDIO_STREAMER
-    if (nullptr != audioStreamer)
-    {
-        audioStreamer->addMqttTopicsToRegister(&topics);
-    }
+#ifdef USE_REST_SERVER
+    scheduleTask("webServer", 10, []() { webServer.handleClient(); });
 #endif
 
-#ifdef USE_TRAFFIC_LIGHT_LEDS
-    for (auto& trafficLight : trafficLightLeds)
-    {
-        trafficLight.addMqttTopicsToRegister(&topics);
-    }
+#ifdef USE_HB0014
+    scheduleTask("hb0014", 5, loopHB0014);
 #endif
 
-    pushTopicsToIotZooClient(topics);
+#if defined(USE_MQTT)
+    taskIdAlive = scheduleTask("alive", settings->getAliveIntervalMillis(),
+                               []()
+                               {
+                                   try
+                                   {
+                                       publishAliveMessage();
+                                   }
+                                   catch (const std::exception& e)
+                                   {
+                                       Serial.println(e.what()); // Exception handling does only work with build_flags
+                                                                 // -DPIO_FRAMEWORK_ARDUINO_ENABLE_EXCEPTIONS
+                                   }
+                               });
 #endif // USE_MQTT
-    topicsRegistered = true;
-}
-
-/// @brief Called when the IotZoo Client has not responded to the alive message.
-void onIotZooClientUnavailable()
-{
-    Serial.println("*** IoT-Zoo client is unavailable! Please start it! ***");
-
-    String jsonMicrocontroller = serializeMicrocontroller();
 
-    mqttClient->publish("i_am_lost", jsonMicrocontroller);
-    // server dead?
-#ifdef USE_TM1637_4
-    if (nullptr != tm1637_4Handling)
-    {
-        tm1637_4Handling->onIotZooClientUnavailable();
-    }
-#endif
-
-#ifdef USE_TM1637_6
-    tm1637_6Handling.onIotZooClientUnavailable();
-#endif
-
-#ifdef USE_LED_AND_KEY
-    if (nullptr != tm1638)
-    {
-        tm1638->onIotZooClientUnavailable();
-    }
-#endif // USE_LED_AND_KEY
-
-#ifdef USE_HT1621
-    if (nullptr != ht1621)
-    {
-        ht1621->onIotZooClientUnavailable();
-    }
-#endif
+    scheduleTask("aliveCheck", 1000,
+                 []()
+                 {
+                     if (millis() - lastServerAliveMillis > (settings->getAliveIntervalMillis() * 2))
+                     {
+                         onIotZooClientUnavailable();
+                         lastServerAliveMillis = millis();
+                     }
+                 });
 
-#ifdef USE_OLED_SSD1306
-    if (nullptr != oled1306)
-    {
-        oled1306->onIotZooClientUnavailable();
-    }
-#endif
+    // turn the LED off to indicate that the device is offline.
+    scheduleTask("aliveLed", 100, []() { digitalWrite(LED_BUILTIN, LOW); });
 
-#ifdef USE_LCD_160X
-    if (nullptr != lcdDisplay)
-    {
-        lcdDisplay->onIotZooClientUnavailable();
-    }
-#endif
+    // write changed settings back to the flash.
+    scheduleTask("settings", 1000, []() { settings->flushIfDue(); });
 
-#ifdef USE_STEPPER_MOTOR
-    if (nullptr != stepperMotor)
-    {
-        stepperMotor->onIotZooClientUnavailable();
-    }
-#endif
+    Serial.println("Scheduled tasks: " + String(scheduler.getTaskCount()));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2170,7 +2395,6 @@ void loop()
     try
     {
         lastLoopStartTime = millis();
-        Serial.print("_");
         loopCounter++;
 
         if (doRestart)
@@ -2182,193 +2406,52 @@ void loop()
         mqttClient->loop();
         if (millis() - lastLoopStartTime > 10000)
         {
-            Serial.print("BROKEN MQTT");
+            LOG_ERROR(LogModuleMain, "BROKEN MQTT");
             restart();
         }
         if (!mqttClient->isConnected())
         {
-            Serial.print("⚠");
-            delay(200);
-            return;
-        }
-
-        if (!topicsRegistered)
-        {
-            registerTopics();
-            String topic = getBaseTopic() + "/started";
-            mqttClient->publish(topic, "STARTED");
-        }
-#endif
-
-#ifdef USE_BLE_HEART_RATE_SENSOR
-        if (nullptr != heartRateSensor)
-        {
-            heartRateSensor->loop();
-        }
-#endif // USE_BLE_HEART_RATE_SENSOR
-
-#ifdef USE_BUTTON
-        buttonHandling.loop();
-#endif
-
-#ifdef USE_UV
-        if (nullptr != uvSensorGUVAS12SD)
-        {
-            uvSensorGUVAS12SD->loop();
-        }
-#endif // USE_UV
-
-#ifdef USE_KY025
-        if (nullptr != ky025)
-        {
-            ky025->loop();
-        }
-#endif
-
-#ifdef USE_AUDIO_STREAMER
-        if (nullptr != audioStreamer)
-        {
-            audioStreamer->loop();
-        }
-#endif
-
-#ifdef USE_WS2818
-        if (nullptr != ws2812)
-        {
-            ws2812->loop();
-        }
-#endif
-
-#ifdef USE_HW507
-        if (nullptr != hw507HumiditySensor)
-        {
-            hw507HumiditySensor->loop();
-        }
-#endif
-
-#ifdef USE_GPS
-        if (nullptr != gps)
-        {
-            gps->loop();
-        }
-#endif
-
-#ifdef USE_SWITCH
-        for (auto& buttonSwitch : switches)
-        {
-            buttonSwitch.loop();
-        }
-#endif
-
-#ifdef USE_LED_AND_KEY
-        if (nullptr != tm1638)
-        {
-            tm1638->loop();
-        }
-#endif // USE_LED_AND_KEY
-
-#ifdef USE_REST_SERVER
-        webServer.handleClient();
-#endif
-
-        // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-        // The preconditions are fulfilled (MQTT connected).
-
-#ifdef USE_HW040
-        hw040Handling.loop();
-#endif
-
-#ifdef USE_STEPPER_MOTOR
-        if (nullptr != stepperMotor)
-        {
-            stepperMotor->loop();
-        }
-#endif
-
-#ifdef USE_DS18B20
-        if (nullptr != ds18B20SensorManager)
-        {
-            ds18B20SensorManager->loop();
-        }
-#endif // USE_DS18B20
-
-#ifdef USE_HB0014
-        digitalValueInfrared = digitalRead(digitalPinInfraredLed);
-
-        if (digitalValueInfrared == HIGH && digitalValueOldInfrared == LOW)
-        {
-            long diff = millis() - lastMillisInfrared;
-#ifdef USE_OLED_SSD1306
-            if (nullptr != oled1306)
-            {
-                oled1306->setTextLine(3, String(diff) + " ms");
-            }
-#endif
-            if (diff > 30)
+#ifdef USE_STORE_AND_FORWARD
+            // Once the devices are set up they keep running, their messages are stored until the broker is back.
+            if (topicsRegistered)
             {
-                // Umrechnen in Watt
-
-                // 10000 Impulse entsprechen 1 KW/h.
-
-                // Hochrechnen auf 10000 Impulse = 1000 Watt pro Stunde
-                double watt = 360000.0 / diff;
-                Serial.println(String(watt) + " watt");
-#ifdef USE_OLED_SSD1306
-                if (nullptr != oled1306)
+                if (millis() - millisLastOutageWarning >= 1000)
                 {
-                    oled1306->setTextLine(1, String(watt, 0));
+                    millisLastOutageWarning = millis();
+                    LOG_PRINT(LogModuleMain, LogLevelWarning, "⚠ " + String(storeAndForward->getPendingCount()) + " stored");
                 }
-#endif
-                String topic = getBaseTopic() + "/power/0";
-                mqttClient->publish(topic, String(watt, 0));
-                lastMillisInfrared = millis();
             }
-        }
-        digitalValueOldInfrared = digitalValueInfrared;
-#endif
-
-#ifdef USE_KEYPAD
-        buttonMatrixHandling.loop();
+            else
 #endif
-
-#ifdef USE_HC_SR501
-        motionDetectorsHrsc501Handling.loop();
-#endif
-
-#ifdef USE_RD_03D
-        if (nullptr != rd03d)
-        {
-            rd03d->loop();
-        }
-#endif // USE_RD_03D
-
-#if defined(USE_MQTT)
-        try
-        {
-            if (millis() - lastAliveTime > settings->getAliveIntervalMillis())
             {
-                publishAliveMessage();
+                LOG_PRINT(LogModuleMain, LogLevelWarning, "⚠");
+                delay(200);
+                return;
             }
         }
-        catch (const std::exception& e)
+
+        if (!topicsRegistered)
         {
-            Serial.println(e.what()); // Exception handling does only work with build_flags -DPIO_FRAMEWORK_ARDUINO_ENABLE_EXCEPTIONS
+            registerTopics();
+            String topic = getBaseTopic() + "/started";
+            mqttClient->publish(topic, "STARTED");
         }
-#endif // USE_HC_SR501
+#endif
+
+        // The preconditions are fulfilled (MQTT connected). Run only the devices which are due.
+        scheduler.runDueTasks(millis());
 
         loopDurationMs = millis() - lastLoopStartTime;
 
-        if (millis() - lastServerAliveMillis > (settings->getAliveIntervalMillis() * 2))
+        uint32_t idleMillis = scheduler.millisUntilNextDeadline(millis());
+        if (idleMillis > MaxIdleMillis)
         {
-            onIotZooClientUnavailable();
-            lastServerAliveMillis = millis();
+            idleMillis = MaxIdleMillis;
         }
-
-        if (loopDurationMs < 100)
+        if (idleMillis > 0)
         {
-            delay(100 - loopDurationMs);
+            delay(idleMillis);
         }
-        digitalWrite(LED_BUILTIN, LOW); // turn the LED off to indicate that the device is offline.
     }
     catch (const std::exception& e)
     {
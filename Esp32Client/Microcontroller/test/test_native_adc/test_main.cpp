@@ -0,0 +1,163 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the ADC demultiplexer: pio test -e native -f test_native_adc
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/AdcDemultiplexer.hpp"
+
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/// @brief A DMA record: 12 bit value, 4 bit channel, little endian.
+static void appendRecord(std::vector<uint8_t>& buffer, uint8_t channel, uint16_t value)
+{
+    uint16_t record = static_cast<uint16_t>((channel << 12) | (value & 0x0FFF));
+    buffer.push_back(record & 0xFF);
+    buffer.push_back(record >> 8);
+}
+
+void test_add_channel(void)
+{
+    AdcDemultiplexer adc;
+    TEST_ASSERT_TRUE(adc.addChannel(7, 2));
+    TEST_ASSERT_FALSE(adc.addChannel(7, 2)); // known
+    TEST_ASSERT_FALSE(adc.addChannel(16, 0));
+    TEST_ASSERT_FALSE(adc.addChannel(3, AdcDemultiplexer::MaxOversamplingBits + 1));
+    TEST_ASSERT_FALSE(adc.addChannel(3, 0, 0));
+    TEST_ASSERT_FALSE(adc.addChannel(3, 0, AdcDemultiplexer::MaxDecimation + 1));
+    for (uint8_t channel = 0; channel < 7; channel++)
+    {
+        TEST_ASSERT_TRUE(adc.addChannel(channel, 0));
+    }
+    TEST_ASSERT_FALSE(adc.addChannel(8, 0)); // MaxChannels
+    TEST_ASSERT_EQUAL(8, adc.getChannelCount());
+    TEST_ASSERT_EQUAL(4095u << 2, adc.getFullScale(7));
+    TEST_ASSERT_EQUAL(0, adc.getFullScale(9));
+}
+
+void test_demultiplex(void)
+{
+    AdcDemultiplexer adc;
+    adc.addChannel(6, 0);
+    adc.addChannel(7, 0);
+
+    std::vector<uint8_t> buffer;
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        appendRecord(buffer, 6, 100 + i);
+        appendRecord(buffer, 7, 4000 - i);
+        appendRecord(buffer, 3, 1); // not added
+    }
+    buffer.push_back(0xFF); // an odd byte
+    adc.write(buffer.data(), buffer.size());
+
+    uint16_t values[8];
+    TEST_ASSERT_EQUAL(4, adc.read(6, values, 8));
+    TEST_ASSERT_EQUAL(100, values[0]);
+    TEST_ASSERT_EQUAL(103, values[3]);
+    uint16_t latest = 0;
+    TEST_ASSERT_TRUE(adc.readLatest(7, latest));
+    TEST_ASSERT_EQUAL(3997, latest);
+    TEST_ASSERT_FALSE(adc.readLatest(7, latest));
+    TEST_ASSERT_EQUAL(0, adc.read(3, values, 8));
+    TEST_ASSERT_EQUAL(4, adc.getUnknownRecords());
+}
+
+void test_oversampling_and_decimation(void)
+{
+    // 2 oversampling bits: 16 raw values of 1000 and 1001 in turn are 4002 (14 bit), the half LSB is resolved.
+    AdcDemultiplexer adc;
+    adc.addChannel(0, 2);
+    adc.addChannel(1, 1, 3);
+    for (int i = 0; i < 16; i++)
+    {
+        adc.writeSample(0, 1000 + (i & 1));
+    }
+    uint16_t value = 0;
+    TEST_ASSERT_TRUE(adc.readLatest(0, value));
+    TEST_ASSERT_EQUAL(4002, value);
+    TEST_ASSERT_EQUAL(4095u * 4, adc.getFullScale(0));
+
+    // 1 oversampling bit, decimation 3: 12 raw values per output value.
+    for (int i = 0; i < 11; i++)
+    {
+        adc.writeSample(1, 4095);
+    }
+    TEST_ASSERT_FALSE(adc.readLatest(1, value));
+    adc.writeSample(1, 4095);
+    TEST_ASSERT_TRUE(adc.readLatest(1, value));
+    TEST_ASSERT_EQUAL(adc.getFullScale(1), value);
+
+    // The queue is full if loop() does not read.
+    for (size_t i = 0; i < (AdcDemultiplexer::QueueSize + 5) * 16; i++)
+    {
+        adc.writeSample(0, 0);
+    }
+    TEST_ASSERT_EQUAL(5, adc.getOverruns(0));
+}
+
+void test_reader_task(void)
+{
+    // The reader task writes DMA frames while loop() reads: the values arrive in order, dropped ones are counted.
+    AdcDemultiplexer  adc;
+    std::atomic<bool> done{false};
+    const uint16_t    count = 4000;
+    adc.addChannel(4, 0);
+    std::thread readerTask(
+        [&]()
+        {
+            std::vector<uint8_t> frame;
+            for (uint16_t i = 0; i < count; i++)
+            {
+                appendRecord(frame, 4, i);
+                if (frame.size() == 32 || i == count - 1)
+                {
+                    adc.write(frame.data(), frame.size());
+                    frame.clear();
+                    std::this_thread::yield();
+                }
+            }
+            done = true;
+        });
+
+    size_t   received = 0;
+    int32_t  previous = -1;
+    uint16_t values[16];
+    while (true)
+    {
+        bool   finished = done;
+        size_t n        = adc.read(4, values, 16);
+        for (size_t i = 0; i < n; i++)
+        {
+            TEST_ASSERT_TRUE(values[i] > previous);
+            previous = values[i];
+        }
+        received += n;
+        if (finished && 0 == n)
+        {
+            break;
+        }
+    }
+    readerTask.join();
+    TEST_ASSERT_EQUAL(count, received + adc.getOverruns(4));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_add_channel);
+    RUN_TEST(test_demultiplex);
+    RUN_TEST(test_oversampling_and_decimation);
+    RUN_TEST(test_reader_task);
+    return UNITY_END();
+}
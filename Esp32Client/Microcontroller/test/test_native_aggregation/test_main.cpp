@@ -0,0 +1,200 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the windowed aggregation: pio test -e native -f test_native_aggregation
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/WindowAggregator.hpp"
+
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_running_statistics(void)
+{
+    RunningStatistics statistics;
+    TEST_ASSERT_EQUAL(0, statistics.getCount());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0, statistics.getVariance());
+
+    for (float value : {2.0f, 4.0f, 4.0f, 4.0f, 5.0f, 5.0f, 7.0f, 9.0f})
+    {
+        statistics.add(value);
+    }
+    TEST_ASSERT_EQUAL(8, statistics.getCount());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 5.0f, statistics.getMean());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 32.0f / 7.0f, statistics.getVariance()); // sample variance
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2.0f, statistics.getMin());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 9.0f, statistics.getMax());
+
+    statistics.reset();
+    statistics.add(-3);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -3, statistics.getMin());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -3, statistics.getMax());
+}
+
+void test_numerically_stable(void)
+{
+    // A large offset with a small variance: the naive sum of squares loses all digits in float.
+    RunningStatistics statistics;
+    srand(3);
+    double sum = 0, sumOfSquares = 0;
+    const int count = 100000;
+    std::vector<float> values;
+    for (int i = 0; i < count; i++)
+    {
+        float value = 4000.0f + (rand() % 2001 - 1000) * 0.001f;
+        values.push_back(value);
+        statistics.add(value);
+        sum += value;
+    }
+    double mean = sum / count;
+    for (float value : values)
+    {
+        sumOfSquares += (value - mean) * (value - mean);
+    }
+    double stddev = std::sqrt(sumOfSquares / (count - 1));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, static_cast<float>(mean), statistics.getMean());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, static_cast<float>(stddev), statistics.getStandardDeviation());
+}
+
+void test_window(void)
+{
+    WindowAggregator aggregator(1000);
+    AggregateSummary summary;
+    int              windows = 0;
+    for (uint32_t now = 500; now <= 3500; now += 100)
+    {
+        if (aggregator.add(static_cast<float>(now / 1000), now, summary))
+        {
+            windows++;
+            TEST_ASSERT_EQUAL(10, summary.count);
+        }
+    }
+    TEST_ASSERT_EQUAL(3, windows); // 500 ... 1400, 1500 ... 2400, 2500 ... 3400
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 3, summary.max);
+    TEST_ASSERT_EQUAL(1, aggregator.getStatistics().getCount()); // 3500 started the next window.
+
+    char   buffer[128];
+    size_t length = summary.toJson(buffer, sizeof(buffer), 2);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+    TEST_ASSERT_EQUAL_STRING("{\"mean\":2.50,\"min\":2.00,\"max\":3.00,\"stddev\":0.53,\"count\":10}", buffer);
+    TEST_ASSERT_EQUAL(0, summary.toJson(buffer, 16, 2));
+
+    // Sampled at the window length: every sample is a window of its own.
+    WindowAggregator slow(1000);
+    TEST_ASSERT_FALSE(slow.add(1, 0, summary));
+    TEST_ASSERT_TRUE(slow.add(2, 1000, summary));
+    TEST_ASSERT_EQUAL(1, summary.count);
+    TEST_ASSERT_TRUE(slow.add(3, 2000, summary));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 2, summary.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0, summary.stddev);
+}
+
+void test_invalid_samples(void)
+{
+    // A sensor which does not answer: one summary per window, not one error per sample.
+    WindowAggregator aggregator(1000);
+    AggregateSummary summary;
+    int              windows = 0;
+    for (uint32_t now = 0; now < 3000; now += 100)
+    {
+        if (aggregator.addInvalid(now, summary))
+        {
+            windows++;
+            TEST_ASSERT_EQUAL(0, summary.count);
+            TEST_ASSERT_EQUAL(10, summary.invalid);
+        }
+    }
+    TEST_ASSERT_EQUAL(2, windows);
+
+    // Mixed: the invalid samples are counted in the window of the valid ones.
+    TEST_ASSERT_TRUE(aggregator.add(50, 3000, summary));
+    TEST_ASSERT_FALSE(aggregator.addInvalid(3500, summary));
+    TEST_ASSERT_FALSE(aggregator.add(52, 3900, summary));
+    TEST_ASSERT_TRUE(aggregator.add(60, 4000, summary));
+    TEST_ASSERT_EQUAL(2, summary.count);
+    TEST_ASSERT_EQUAL(1, summary.invalid);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 51, summary.mean);
+
+    char buffer[128];
+    TEST_ASSERT_TRUE(summary.toJson(buffer, sizeof(buffer), 1) > 0);
+    TEST_ASSERT_EQUAL_STRING("{\"mean\":51.0,\"min\":50.0,\"max\":52.0,\"stddev\":1.4,\"count\":2,\"invalid\":1}", buffer);
+}
+
+void test_impulse_power_meter(void)
+{
+    // 10000 impulses per kWh: 30 s at 3600 W (an impulse every 100 ms), then 30 s at 36 W (every 10 s).
+    ImpulsePowerMeter meter(60000, 0.1f);
+    AggregateSummary  summary;
+    int               windows     = 0;
+    uint32_t          nextImpulse = 0;
+    for (uint32_t now = 0; now <= 60000; now += 5)
+    {
+        if (now == nextImpulse)
+        {
+            meter.addImpulse(now);
+            nextImpulse += now < 29900 ? 100 : 10000;
+        }
+        windows += meter.poll(now, summary) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(1, windows);
+    TEST_ASSERT_EQUAL(303, summary.count);
+    // The energy of the window, not the mean of the per impulse powers (which is about 3565 W).
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 1818, summary.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 36, summary.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 3600, summary.max);
+
+    // No load: the window closes without impulses.
+    TEST_ASSERT_FALSE(meter.poll(119995, summary));
+    TEST_ASSERT_TRUE(meter.poll(120000, summary));
+    TEST_ASSERT_EQUAL(0, summary.count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0, summary.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0, summary.max);
+}
+
+#ifdef IOTZOO_BENCHMARK
+void test_benchmark(void)
+{
+    WindowAggregator aggregator(60000);
+    AggregateSummary summary;
+    const int        samples = 1000000;
+    int              windows = 0;
+    srand(1);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++)
+    {
+        // 100 samples per second, e.g. an ADC channel.
+        windows += aggregator.add(1.0f + (rand() % 100) * 0.01f, static_cast<uint32_t>(i) * 10u, summary) ? 1 : 0;
+    }
+    auto   end   = std::chrono::steady_clock::now();
+    double nanos = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("%.1f ns per sample (host), %d summaries instead of %d samples, %u bytes of state\n", nanos / samples, windows, samples,
+           static_cast<unsigned>(sizeof(aggregator)));
+    TEST_ASSERT_EQUAL(166, windows);
+}
+#endif
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_running_statistics);
+    RUN_TEST(test_numerically_stable);
+    RUN_TEST(test_window);
+    RUN_TEST(test_invalid_samples);
+    RUN_TEST(test_impulse_power_meter);
+#ifdef IOTZOO_BENCHMARK
+    RUN_TEST(test_benchmark);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the alarm zone map: pio test -e native -f test_native_alarm_zones
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/AlarmZoneMap.hpp"
+
+#include <unity.h>
+#include <cstring>
+#include <string>
+
+using namespace IotZoo;
+
+static bool lookup(const AlarmZoneMap& map, const char* subject, Alarm& alarm)
+{
+    return map.lookup(subject, strlen(subject), alarm);
+}
+
+static void createMap(AlarmZoneMap& map)
+{
+    map.addLevel("motion", 0xFFAF00);
+    map.addLevel("animal", 0x00FF00);
+    map.addLevel("vehicle", 0x0000FF);
+    map.addLevel("person", 0xFF0000);
+    map.addLevel("rang", 0x800080);
+
+    map.addZone("dachboden");
+    map.addRun(27, 3);
+    map.addRun(34, 3);
+    map.addZone("westen");
+    map.addRun(52, 3);
+    map.addZone("osten");
+    map.addRun(21, 3);
+    map.addRun(24, 3);
+    map.addRun(37, 3);
+    map.addZone("klingel");
+    map.addRun(4, 3);
+    map.build();
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_matcher_overlapping_keywords(void)
+{
+    KeywordMatcher matcher;
+    TEST_ASSERT_EQUAL(0, matcher.add("he"));
+    TEST_ASSERT_EQUAL(1, matcher.add("she"));
+    TEST_ASSERT_EQUAL(2, matcher.add("his"));
+    TEST_ASSERT_EQUAL(3, matcher.add("hers"));
+    TEST_ASSERT_EQUAL(-1, matcher.add(""));
+    matcher.build();
+
+    const char* text = "USHERS";
+    TEST_ASSERT_TRUE(0b1011 == matcher.match(text, strlen(text))); // she, he, hers
+    TEST_ASSERT_TRUE(0b0100 == matcher.match("ahisx", 5));
+    TEST_ASSERT_TRUE(0 == matcher.match("h e r s", 7));
+    TEST_ASSERT_TRUE(0 == matcher.match("", 0));
+}
+
+void test_level_and_zone_priority(void)
+{
+    AlarmZoneMap map;
+    createMap(map);
+    TEST_ASSERT_EQUAL(5, map.getLevelCount());
+    TEST_ASSERT_EQUAL(4, map.getZoneCount());
+
+    Alarm alarm;
+    TEST_ASSERT_TRUE(lookup(map, "Person detected: Osten", alarm));
+    TEST_ASSERT_EQUAL(3, alarm.level);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, alarm.color);
+    TEST_ASSERT_EQUAL(2, alarm.zone);
+    TEST_ASSERT_EQUAL(3, alarm.runCount);
+    TEST_ASSERT_EQUAL(37, alarm.runs[2].startIndex);
+
+    // "motion" comes first like in the former if-chain, although "person" occurs too.
+    TEST_ASSERT_TRUE(lookup(map, "PERSON MOTION westen", alarm));
+    TEST_ASSERT_EQUAL(0, alarm.level);
+    TEST_ASSERT_EQUAL(1, alarm.zone);
+    TEST_ASSERT_EQUAL(1, alarm.runCount);
+
+    // a level without a zone lights nothing.
+    TEST_ASSERT_TRUE(lookup(map, "vehicle", alarm));
+    TEST_ASSERT_EQUAL(-1, alarm.zone);
+    TEST_ASSERT_EQUAL(0, alarm.runCount);
+
+    TEST_ASSERT_FALSE(lookup(map, "Klingel", alarm)); // no level
+    TEST_ASSERT_TRUE(lookup(map, "Klingel rang", alarm));
+    TEST_ASSERT_EQUAL(4, alarm.level);
+    TEST_ASSERT_EQUAL(3, alarm.zone);
+}
+
+void test_limits(void)
+{
+    AlarmZoneMap map;
+    TEST_ASSERT_FALSE(map.addRun(0, 1)); // no zone yet
+    for (size_t i = 0; i < AlarmZoneMap::MaxLevels; i++)
+    {
+        TEST_ASSERT_TRUE(map.addLevel(("level" + std::to_string(i) + "#").c_str(), i));
+    }
+    TEST_ASSERT_FALSE(map.addLevel("one too many", 0));
+    for (size_t i = 0; i < AlarmZoneMap::MaxZones; i++)
+    {
+        TEST_ASSERT_TRUE(map.addZone(("zone" + std::to_string(i) + "#").c_str()));
+        TEST_ASSERT_TRUE(map.addRun(i, 1));
+    }
+    TEST_ASSERT_FALSE(map.addZone("one too many"));
+    map.build();
+
+    Alarm alarm;
+    TEST_ASSERT_TRUE(lookup(map, "LEVEL15# zone47#", alarm));
+    TEST_ASSERT_EQUAL(15, alarm.level);
+    TEST_ASSERT_EQUAL(47, alarm.zone);
+    TEST_ASSERT_EQUAL(47, alarm.runs[0].startIndex);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_matcher_overlapping_keywords);
+    RUN_TEST(test_level_and_zone_priority);
+    RUN_TEST(test_limits);
+    return UNITY_END();
+}
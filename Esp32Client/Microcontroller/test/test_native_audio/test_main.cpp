@@ -0,0 +1,131 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the audio pipeline: pio test -e native -f test_native_audio
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/AudioLevel.hpp"
+#include "core/SpscRingBuffer.hpp"
+
+#include <unity.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_ring_buffer_push_pop(void)
+{
+    SpscRingBuffer<int16_t, 8> ringBuffer;
+    int16_t                    in[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    int16_t                    out[10]{};
+
+    TEST_ASSERT_EQUAL(5, ringBuffer.push(in, 5));
+    TEST_ASSERT_EQUAL(3, ringBuffer.pop(out, 3));
+    TEST_ASSERT_EQUAL(3, out[2]);
+
+    // wraps around, the last two samples do not fit.
+    TEST_ASSERT_EQUAL(6, ringBuffer.push(in + 2, 8));
+    TEST_ASSERT_EQUAL(2, ringBuffer.getOverruns());
+    TEST_ASSERT_EQUAL(8, ringBuffer.size());
+
+    TEST_ASSERT_EQUAL(8, ringBuffer.pop(out, 10));
+    int16_t expected[] = {4, 5, 3, 4, 5, 6, 7, 8};
+    TEST_ASSERT_EQUAL_INT16_ARRAY(expected, out, 8);
+    TEST_ASSERT_EQUAL(0, ringBuffer.pop(out, 10));
+}
+
+/// @brief Producer thread like the capture task, consumer like the loop. Checks that no sample is lost or reordered.
+void test_ring_buffer_producer_consumer(void)
+{
+    static SpscRingBuffer<int16_t, 8192> ringBuffer;
+    const size_t                         totalSamples = 16000 * 60; // 1 minute of audio
+    bool                                 inOrder      = true;
+
+    std::thread producer(
+        [&]()
+        {
+            int16_t block[256];
+            size_t  written = 0;
+            while (written < totalSamples)
+            {
+                for (size_t i = 0; i < 256; i++)
+                {
+                    block[i] = (int16_t)(written + i);
+                }
+                size_t n = 0;
+                while (n < 256)
+                {
+                    // the test must not lose samples, so wait instead of dropping them.
+                    size_t space = ringBuffer.capacity() - ringBuffer.size();
+                    size_t count = 256 - n < space ? 256 - n : space;
+                    n += ringBuffer.push(block + n, count);
+                    if (n < 256)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                written += 256;
+            }
+        });
+
+    int16_t chunk[800];
+    size_t  read = 0;
+    while (read < totalSamples)
+    {
+        size_t n = ringBuffer.pop(chunk, 800);
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            if (chunk[i] != (int16_t)(read + i))
+            {
+                inOrder = false;
+            }
+        }
+        read += n;
+    }
+    producer.join();
+    TEST_ASSERT_TRUE(inOrder);
+    TEST_ASSERT_EQUAL(0, ringBuffer.getOverruns());
+}
+
+void test_rms_and_decibel(void)
+{
+    std::vector<int16_t> samples(8000);
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (i % 2) ? 1000 : -1000;
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(0.001, 1000.0, calculateRms(samples.data(), samples.size()));
+
+    // in blocks, like the loop drains the ring buffer.
+    RmsAccumulator accumulator;
+    accumulator.add(samples.data(), 300);
+    accumulator.add(samples.data() + 300, 7700);
+    TEST_ASSERT_EQUAL(8000, accumulator.getSampleCount());
+    TEST_ASSERT_DOUBLE_WITHIN(0.001, 1000.0, accumulator.getRms());
+
+    TEST_ASSERT_DOUBLE_WITHIN(0.001, 0.0, rmsToDecibel(32768.0));
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, -20.0, rmsToDecibel(3276.8));
+    TEST_ASSERT_TRUE(std::isinf(rmsToDecibel(0.0)));
+
+    int16_t loudest[] = {-32768, -32768};
+    TEST_ASSERT_DOUBLE_WITHIN(0.001, 32768.0, calculateRms(loudest, 2));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_ring_buffer_push_pop);
+    RUN_TEST(test_ring_buffer_producer_consumer);
+    RUN_TEST(test_rms_and_decibel);
+    return UNITY_END();
+}
@@ -0,0 +1,111 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the binary topics: pio test -e native -f test_native_binary_subscriptions
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/BinarySubscriptions.hpp"
+#include "core/PixelFrame.hpp"
+
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace IotZoo;
+
+static const char* TopicSetFrame = "iotzoo/playground/esp32/A1:B2:C3:D4:E5:F6/neo/0/setFrame";
+
+/// @brief A PUBLISH packet as PubSubClient passes it to the callback: the topic and the payload point into its buffer.
+struct ReceivedPacket
+{
+    std::vector<uint8_t> buffer;
+    size_t               topicLength;
+
+    ReceivedPacket(const char* topic, const std::vector<uint8_t>& payload)
+    {
+        topicLength = strlen(topic);
+        buffer.assign(topic, topic + topicLength);
+        buffer.push_back(0); // PubSubClient moves the topic one byte and terminates it.
+        buffer.insert(buffer.end(), payload.begin(), payload.end());
+        buffer.push_back(0xAA); // whatever follows in the buffer.
+    }
+
+    char* getTopic()
+    {
+        return reinterpret_cast<char*>(buffer.data());
+    }
+
+    uint8_t* getPayload()
+    {
+        return buffer.data() + topicLength + 1;
+    }
+};
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_frame_with_zero_bytes(void)
+{
+    // RGB888 2 x 1 at (0, 0): format, flags, brightness, reserved, x and y are all 0.
+    std::vector<uint8_t> frame = {0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 1, 0, 255, 0, 0, 0, 0, 255};
+    ReceivedPacket       packet(TopicSetFrame, frame);
+
+    std::vector<uint8_t> leds(4 * 3, 0);
+    PixelBuffer          buffer;
+    buffer.data    = leds.data();
+    buffer.columns = 4;
+
+    BinarySubscriptions binarySubscriptions;
+    PixelFrame::Error   error          = PixelFrame::Error::TooShort;
+    size_t              receivedLength = 0;
+    binarySubscriptions.add(TopicSetFrame,
+                            [&](const uint8_t* payload, size_t length)
+                            {
+                                PixelFrameHeader header;
+                                receivedLength = length;
+                                error          = PixelFrame::apply(payload, length, buffer, header);
+                            });
+
+    TEST_ASSERT_TRUE(binarySubscriptions.dispatch(packet.getTopic(), packet.getPayload(), frame.size()));
+    TEST_ASSERT_EQUAL(frame.size(), receivedLength);
+    TEST_ASSERT_TRUE(PixelFrame::Error::None == error);
+    const uint8_t expected[] = {0, 255, 0, 0, 0, 255}; // red, blue in NEO_GRB order.
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, leds.data(), 6);
+
+    // A String built from the payload ends at the first zero byte: nothing of the frame would be left.
+    TEST_ASSERT_EQUAL(0, strlen(reinterpret_cast<const char*>(packet.getPayload())));
+}
+
+void test_other_topics_are_passed_on(void)
+{
+    BinarySubscriptions binarySubscriptions;
+    int                 calls = 0;
+    binarySubscriptions.add(TopicSetFrame, [&](const uint8_t*, size_t) { calls++; });
+
+    std::vector<uint8_t> payload = {'4', '2'};
+    ReceivedPacket       packet("iotzoo/playground/esp32/A1:B2:C3:D4:E5:F6/neo/0/setPixelColor", payload);
+    TEST_ASSERT_FALSE(binarySubscriptions.dispatch(packet.getTopic(), packet.getPayload(), payload.size()));
+    TEST_ASSERT_EQUAL(0, calls);
+
+    // Subscribed again on a reconnect: replaced.
+    binarySubscriptions.add(TopicSetFrame, [&](const uint8_t*, size_t) { calls += 10; });
+    TEST_ASSERT_EQUAL(1, binarySubscriptions.size());
+    TEST_ASSERT_TRUE(binarySubscriptions.dispatch(TopicSetFrame, payload.data(), payload.size()));
+    TEST_ASSERT_EQUAL(10, calls);
+
+    TEST_ASSERT_TRUE(binarySubscriptions.remove(TopicSetFrame));
+    TEST_ASSERT_FALSE(binarySubscriptions.remove(TopicSetFrame));
+    TEST_ASSERT_FALSE(binarySubscriptions.dispatch(TopicSetFrame, payload.data(), payload.size()));
+    TEST_ASSERT_FALSE(binarySubscriptions.add("", [&](const uint8_t*, size_t) {}));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_with_zero_bytes);
+    RUN_TEST(test_other_topics_are_passed_on);
+    return UNITY_END();
+}
@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the DS18B20 conversion state machine: pio test -e native -f test_native_ds18b20
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/DS18B20Poller.hpp"
+
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace IotZoo;
+
+/// @brief A OneWire bus with DS18B20 sensors. A sensor read before the conversion is complete returns the power on
+/// value 85 °C, like the real sensor.
+class FakeBus : public OneWireTemperatureBus
+{
+  public:
+    struct Sensor
+    {
+        RomAddress address;
+        float      celsius;
+        bool       connected;
+    };
+
+    std::vector<Sensor> sensors;
+    uint32_t            nowMillis         = 0;
+    uint32_t            conversionStart   = 0;
+    uint8_t             resolution        = 12;
+    bool                converting        = false;
+    bool                acceptConversions = true;
+    int                 conversions       = 0;
+    int                 earlyReads        = 0;
+
+    void add(uint8_t family, uint8_t serial, float celsius)
+    {
+        Sensor sensor;
+        sensor.address.bytes[0] = family;
+        sensor.address.bytes[1] = serial;
+        sensor.celsius          = celsius;
+        sensor.connected        = true;
+        sensors.push_back(sensor);
+    }
+
+    size_t search(RomAddress* addresses, size_t capacity) override
+    {
+        for (size_t i = 0; i < sensors.size() && i < capacity; i++)
+        {
+            addresses[i] = sensors[i].address;
+        }
+        return sensors.size();
+    }
+
+    bool setResolution(uint8_t resolution) override
+    {
+        this->resolution = resolution;
+        return true;
+    }
+
+    bool startConversion() override
+    {
+        if (!acceptConversions)
+        {
+            return false;
+        }
+        conversions++;
+        converting      = true;
+        conversionStart = nowMillis;
+        return true;
+    }
+
+    bool readCelsius(const RomAddress& address, float& celsius) override
+    {
+        for (const Sensor& sensor : sensors)
+        {
+            if (sensor.address == address && sensor.connected)
+            {
+                bool complete = nowMillis - conversionStart >= DS18B20Poller::getConversionMillis(resolution);
+                earlyReads += complete ? 0 : 1;
+                celsius = complete ? sensor.celsius : 85.0f;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+static std::vector<std::string> readings;
+
+static void onReading(void*, const TemperatureReading& reading)
+{
+    char hex[17];
+    reading.address.toHex(hex);
+    char text[64];
+    snprintf(text, sizeof(text), "%zu %s %.1f %s", reading.sensor, hex, reading.celsius, reading.valid ? "ok" : "invalid");
+    readings.push_back(text);
+}
+
+void setUp(void)
+{
+    readings.clear();
+}
+
+void tearDown(void)
+{
+}
+
+void test_conversion_time(void)
+{
+    TEST_ASSERT_EQUAL(94, DS18B20Poller::getConversionMillis(9));
+    TEST_ASSERT_EQUAL(188, DS18B20Poller::getConversionMillis(10));
+    TEST_ASSERT_EQUAL(375, DS18B20Poller::getConversionMillis(11));
+    TEST_ASSERT_EQUAL(750, DS18B20Poller::getConversionMillis(12));
+}
+
+void test_state_machine_never_reads_early(void)
+{
+    FakeBus bus;
+    bus.add(0x28, 0x02, 21.5f);
+    bus.add(0x28, 0x01, 19.0f);
+    DS18B20Poller poller(bus, 12, 5000);
+    TEST_ASSERT_EQUAL(2, poller.begin());
+    TEST_ASSERT_EQUAL(12, bus.resolution);
+
+    int completed = 0;
+    for (bus.nowMillis = 0; bus.nowMillis <= 12000; bus.nowMillis += 50)
+    {
+        completed += poller.loop(bus.nowMillis, onReading, nullptr) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(3, bus.conversions); // 0, 5000, 10000
+    TEST_ASSERT_EQUAL(3, completed);
+    TEST_ASSERT_EQUAL(0, bus.earlyReads);
+    TEST_ASSERT_EQUAL(6, readings.size());
+    // Sorted by ROM address, not by the order of the search.
+    TEST_ASSERT_EQUAL_STRING("0 2801000000000000 19.0 ok", readings[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("1 2802000000000000 21.5 ok", readings[1].c_str());
+    TEST_ASSERT_EQUAL(ConversionState::Idle, poller.getState());
+}
+
+void test_identity_stays_when_a_sensor_is_added(void)
+{
+    FakeBus bus;
+    bus.add(0x28, 0x30, 20.0f);
+    bus.add(0x28, 0x10, 22.0f);
+    DS18B20Poller poller(bus, 9, 1000);
+    poller.begin();
+    char before[17];
+    poller.getAddress(1).toHex(before);
+
+    bus.add(0x28, 0x40, 18.0f); // sorted behind the existing sensors
+    TEST_ASSERT_EQUAL(3, poller.begin());
+    char after[17];
+    poller.getAddress(1).toHex(after);
+    TEST_ASSERT_EQUAL_STRING(before, after);
+}
+
+void test_bus_errors_and_disconnected_sensors(void)
+{
+    FakeBus bus;
+    bus.add(0x28, 0x01, 20.0f);
+    bus.add(0x28, 0x02, 20.0f);
+    DS18B20Poller poller(bus, 10, 1000);
+    poller.begin();
+
+    bus.acceptConversions = false;
+    TEST_ASSERT_FALSE(poller.loop(0, onReading, nullptr));
+    TEST_ASSERT_EQUAL(1, poller.getBusErrors());
+    TEST_ASSERT_EQUAL(ConversionState::Idle, poller.getState());
+    TEST_ASSERT_FALSE(poller.loop(500, onReading, nullptr)); // no retry before the interval
+
+    bus.acceptConversions    = true;
+    bus.sensors[1].connected = false;
+    bus.nowMillis            = 1000;
+    TEST_ASSERT_FALSE(poller.loop(bus.nowMillis, onReading, nullptr));
+    bus.nowMillis = 1188;
+    TEST_ASSERT_TRUE(poller.loop(bus.nowMillis, [](const TemperatureReading& reading) { onReading(nullptr, reading); }));
+    TEST_ASSERT_EQUAL(2, readings.size());
+    TEST_ASSERT_EQUAL_STRING("1 2802000000000000 0.0 invalid", readings[1].c_str());
+
+    // Without sensors nothing is started.
+    FakeBus       empty;
+    DS18B20Poller idle(empty, 12, 1000);
+    TEST_ASSERT_EQUAL(0, idle.begin());
+    TEST_ASSERT_FALSE(idle.loop(0, onReading, nullptr));
+    TEST_ASSERT_EQUAL(0, empty.conversions);
+    TEST_ASSERT_EQUAL(0, idle.getBusErrors());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_conversion_time);
+    RUN_TEST(test_state_machine_never_reads_early);
+    RUN_TEST(test_identity_stays_when_a_sensor_is_added);
+    RUN_TEST(test_bus_errors_and_disconnected_sensors);
+    return UNITY_END();
+}
@@ -0,0 +1,122 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the pixel expiry heap: pio test -e native -f test_native_expiry
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/ExpiryHeap.hpp"
+
+#include <unity.h>
+#include <random>
+#include <vector>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_pops_in_deadline_order(void)
+{
+    ExpiryHeap heap(10);
+    heap.schedule(3, 300);
+    heap.schedule(1, 100);
+    heap.schedule(7, 200);
+    heap.schedule(5, 50);
+
+    TEST_ASSERT_EQUAL(4, heap.size());
+    TEST_ASSERT_EQUAL(ExpiryHeap::NoId, heap.popExpired(49));
+    TEST_ASSERT_EQUAL(1, heap.millisUntilNext(49));
+    TEST_ASSERT_EQUAL(5, heap.popExpired(50));
+    TEST_ASSERT_EQUAL(1, heap.popExpired(250));
+    TEST_ASSERT_EQUAL(7, heap.popExpired(250));
+    TEST_ASSERT_EQUAL(ExpiryHeap::NoId, heap.popExpired(250));
+    TEST_ASSERT_EQUAL(3, heap.popExpired(1000));
+    TEST_ASSERT_EQUAL(0, heap.size());
+    TEST_ASSERT_EQUAL(UINT32_MAX, heap.millisUntilNext(1000));
+}
+
+void test_reschedule_and_cancel(void)
+{
+    ExpiryHeap heap(10);
+    heap.schedule(1, 100);
+    heap.schedule(2, 200);
+    heap.schedule(3, 300);
+
+    heap.schedule(1, 400); // the pixel was set again with a new timeout.
+    heap.schedule(3, 50);
+    heap.cancel(2);        // the pixel was set without a timeout.
+    heap.cancel(9);        // not scheduled, nothing happens.
+    heap.schedule(42, 1);  // out of range, ignored.
+
+    TEST_ASSERT_FALSE(heap.isScheduled(2));
+    TEST_ASSERT_EQUAL(2, heap.size());
+    TEST_ASSERT_EQUAL(3, heap.popExpired(1000));
+    TEST_ASSERT_EQUAL(1, heap.popExpired(1000));
+    TEST_ASSERT_EQUAL(ExpiryHeap::NoId, heap.popExpired(1000));
+}
+
+void test_millis_overflow(void)
+{
+    ExpiryHeap heap(4);
+    uint32_t   now = 0xFFFFFF00u; // 256 ms before millis() overflows.
+    heap.schedule(0, now + 0x200); // after the overflow: 0x100
+    heap.schedule(1, now + 0x80);
+
+    TEST_ASSERT_EQUAL(ExpiryHeap::NoId, heap.popExpired(now));
+    TEST_ASSERT_EQUAL(1, heap.popExpired(now + 0x80));
+    // "millis() > MillisUntilTurnOff" would turn pixel 0 off right now: 0xFFFFFF80 > 0x100.
+    TEST_ASSERT_EQUAL(ExpiryHeap::NoId, heap.popExpired(now + 0x80));
+    TEST_ASSERT_EQUAL(0x180, heap.millisUntilNext(now + 0x80));
+    TEST_ASSERT_EQUAL(0, heap.popExpired(0x100));
+}
+
+void test_random_against_scan(void)
+{
+    constexpr int         Pixels = 200;
+    ExpiryHeap            heap(Pixels);
+    std::vector<uint32_t> reference(Pixels, 0); // 0 = stays on
+    std::mt19937          random(7);
+
+    uint32_t now = 0xFFFF0000u;
+    for (int step = 0; step < 20000; step++)
+    {
+        uint16_t pixel = random() % Pixels;
+        uint32_t value = random() % 4;
+        if (value == 0)
+        {
+            heap.cancel(pixel);
+            reference[pixel] = 0;
+        }
+        else
+        {
+            uint32_t deadline = now + 1 + random() % 5000;
+            heap.schedule(pixel, deadline);
+            reference[pixel] = deadline;
+        }
+        now += random() % 50;
+
+        int32_t id;
+        while ((id = heap.popExpired(now)) != ExpiryHeap::NoId)
+        {
+            TEST_ASSERT_NOT_EQUAL(0, reference[id]);
+            TEST_ASSERT_FALSE(ExpiryHeap::isBefore(now, reference[id]));
+            reference[id] = 0;
+        }
+        for (int i = 0; i < Pixels; i++)
+        {
+            TEST_ASSERT_TRUE(reference[i] == 0 || ExpiryHeap::isBefore(now, reference[i]));
+        }
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_pops_in_deadline_order);
+    RUN_TEST(test_reschedule_and_cancel);
+    RUN_TEST(test_millis_overflow);
+    RUN_TEST(test_random_against_scan);
+    return UNITY_END();
+}
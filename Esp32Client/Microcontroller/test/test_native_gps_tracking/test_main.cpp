@@ -0,0 +1,130 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the GPS publish filter, geofences and track batches: pio test -e native -f test_native_gps_tracking
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/GpsTracking.hpp"
+
+#include <unity.h>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace IotZoo;
+
+static const GeoPoint Origin = {52.63, 9.61};
+
+/// @brief The point north and east of the origin, in meters.
+static GeoPoint offset(double northMeters, double eastMeters)
+{
+    const double metersPerDegree = 6371000.0 * M_PI / 180.0;
+    return {Origin.latitude + northMeters / metersPerDegree, Origin.longitude + eastMeters / (metersPerDegree * std::cos(Origin.latitude * M_PI / 180.0))};
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_distance_and_heading(void)
+{
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, GeoMath::distanceMeters(Origin, offset(100, 0)));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 500.0f, GeoMath::distanceMeters(Origin, offset(300, -400)));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 1.1f, GeoMath::distanceMeters(Origin, {Origin.latitude + 1e-5, Origin.longitude})); // float would round this away
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, GeoMath::headingDifference(350, 10));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, GeoMath::headingDifference(10, 350));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 180.0f, GeoMath::headingDifference(90, 270));
+}
+
+void test_position_filter(void)
+{
+    PositionFilter filter;
+    filter.parameters.minDistanceMeters = 25;
+    filter.parameters.minHeadingDegrees = 30;
+    filter.parameters.minIntervalMillis = 1000;
+    filter.parameters.maxIntervalMillis = 60000;
+
+    TEST_ASSERT_EQUAL(PublishReason::First, filter.update(Origin, 0, 0, 0));
+    // Standing still with noise, course noise while standing.
+    TEST_ASSERT_EQUAL(PublishReason::None, filter.update(offset(5, 3), 170, 0.2f, 10000));
+    TEST_ASSERT_EQUAL(PublishReason::None, filter.update(offset(-4, 2), 80, 0.1f, 30000));
+    // Heartbeat.
+    TEST_ASSERT_EQUAL(PublishReason::Heartbeat, filter.update(offset(2, 2), 0, 0, 60000));
+    // Moving north, too fast in a row.
+    TEST_ASSERT_EQUAL(PublishReason::None, filter.update(offset(40, 0), 0, 10, 60500));
+    TEST_ASSERT_EQUAL(PublishReason::Distance, filter.update(offset(40, 0), 0, 10, 61000));
+    // Turning east, only 10 m away.
+    TEST_ASSERT_EQUAL(PublishReason::None, filter.update(offset(45, 2), 20, 5, 62000));
+    TEST_ASSERT_EQUAL(PublishReason::Heading, filter.update(offset(46, 6), 45, 5, 63000));
+}
+
+void test_geofences(void)
+{
+    Geofences fences;
+    fences.hysteresisMeters = 15;
+    TEST_ASSERT_TRUE(fences.addCircle("home", Origin, 100));
+    // L-shaped field east of home: concave.
+    GeoPoint field[] = {offset(0, 200), offset(0, 400), offset(300, 400), offset(300, 350), offset(50, 350), offset(50, 200)};
+    TEST_ASSERT_TRUE(fences.addPolygon("field", field, 6));
+    TEST_ASSERT_FALSE(fences.addPolygon("line", field, 2));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, -100.0f, fences.getSignedDistance(0, Origin));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, -25.0f, fences.getSignedDistance(1, offset(25, 300)));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 50.0f, fences.getSignedDistance(1, offset(150, 300))); // in the notch of the L
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, -25.0f, fences.getSignedDistance(1, offset(150, 375)));
+
+    std::vector<std::string> events;
+    auto                     walk = [&](double north, double east)
+    {
+        fences.update(offset(north, east), [&](const GeofenceEvent& event)
+                      { events.push_back(std::string(Geofences::getEventName(event.type)) + " " + fences.getName(event.fence)); });
+    };
+
+    walk(0, 0); // starts at home
+    walk(0, 105); // noise at the border: still at home
+    walk(0, 95);
+    walk(0, 120); // left home
+    walk(25, 250); // in the field
+    walk(150, 300); // notch: left the field
+    walk(150, 375); // back in the field
+    TEST_ASSERT_EQUAL(5, events.size());
+    TEST_ASSERT_EQUAL_STRING("enter home", events[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("exit home", events[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("enter field", events[2].c_str());
+    TEST_ASSERT_EQUAL_STRING("exit field", events[3].c_str());
+    TEST_ASSERT_EQUAL_STRING("enter field", events[4].c_str());
+    TEST_ASSERT_TRUE(fences.isInside(1));
+    TEST_ASSERT_FALSE(fences.isInside(0));
+}
+
+void test_track_batch(void)
+{
+    TrackBatch batch(3);
+    TEST_ASSERT_FALSE(batch.add({52.63, 9.61}, 1000));
+    TEST_ASSERT_FALSE(batch.add({52.63012, 9.60995}, 1005));
+    TEST_ASSERT_TRUE(batch.add({52.63030, 9.61001}, 1012));
+
+    char   buffer[128];
+    size_t length = batch.serialize(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING("{\"t\":[1000,5,7],\"lat\":[5263000,12,18],\"lon\":[961000,-5,6]}", buffer);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+    TEST_ASSERT_EQUAL(0, batch.serialize(buffer, 20)); // too small
+
+    // Not sent: the oldest point is dropped.
+    batch.add({52.63031, 9.61002}, 1013);
+    TEST_ASSERT_EQUAL(3, batch.size());
+    TEST_ASSERT_EQUAL(1005, batch[0].timeSeconds);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_distance_and_heading);
+    RUN_TEST(test_position_filter);
+    RUN_TEST(test_geofences);
+    RUN_TEST(test_track_batch);
+    return UNITY_END();
+}
@@ -0,0 +1,182 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the LED effects: pio test -e native -f test_native_led_effect
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/LedEffect.hpp"
+
+#include <unity.h>
+#include <vector>
+
+using namespace IotZoo;
+
+static PixelBuffer createBuffer(std::vector<uint8_t>& leds, uint16_t columns, uint16_t rows, bool serpentine)
+{
+    leds.assign(columns * rows * 3, 0);
+    PixelBuffer buffer;
+    buffer.data       = leds.data();
+    buffer.columns    = columns;
+    buffer.rows       = rows;
+    buffer.serpentine = serpentine;
+    return buffer;
+}
+
+/// @brief 0x00RRGGBB of the LED, the buffer is NEO_GRB.
+static uint32_t getColor(const std::vector<uint8_t>& leds, size_t index)
+{
+    return (leds[index * 3 + 1] << 16) | (leds[index * 3] << 8) | leds[index * 3 + 2];
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_fade_ends_at_color2_and_stops(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 10, 1, false);
+
+    LedEffectParameters parameters;
+    parameters.type         = LedEffectType::Fade;
+    parameters.color        = 0xFF0000;
+    parameters.color2       = 0x0000FF;
+    parameters.periodMillis = 1000;
+    parameters.startIndex   = 2;
+    parameters.count        = 3;
+
+    LedEffect effect;
+    effect.start(parameters, 5000);
+    TEST_ASSERT_TRUE(effect.loop(buffer, 5000));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, getColor(leds, 2));
+    TEST_ASSERT_EQUAL_HEX32(0, getColor(leds, 1)); // outside of the range
+    TEST_ASSERT_EQUAL_HEX32(0, getColor(leds, 5));
+
+    TEST_ASSERT_FALSE(effect.loop(buffer, 5010)); // next frame after 33 ms
+    TEST_ASSERT_TRUE(effect.loop(buffer, 5500));
+    TEST_ASSERT_EQUAL_HEX32(0x7F007F, getColor(leds, 4));
+
+    TEST_ASSERT_TRUE(effect.loop(buffer, 6100));
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, getColor(leds, 3));
+    TEST_ASSERT_FALSE(effect.isRunning());
+}
+
+void test_chase_wraps_around(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 8, 1, false);
+
+    LedEffectParameters parameters;
+    parameters.type         = LedEffectType::Chase;
+    parameters.color        = 0x00FF00;
+    parameters.color2       = 0x000010;
+    parameters.periodMillis = 800; // one pixel per 100 ms
+    parameters.length       = 3;
+
+    LedEffect effect;
+    effect.start(parameters, 0);
+    effect.render(buffer, 100); // head at 1: pixels 1, 0, 7
+    uint32_t expected[] = {0x00FF00, 0x00FF00, 0x000010, 0x000010, 0x000010, 0x000010, 0x000010, 0x00FF00};
+    for (size_t i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(expected[i], getColor(leds, i));
+    }
+}
+
+void test_rainbow_blink_breathe(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, LedEffect::hueToColor(0));
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, LedEffect::hueToColor(0x5556));
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, LedEffect::hueToColor(0xAAAC));
+
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 6, 1, false);
+    LedEffectParameters  parameters;
+    parameters.type         = LedEffectType::Rainbow;
+    parameters.periodMillis = 3000;
+    LedEffect effect;
+    effect.start(parameters, 0);
+    effect.render(buffer, 0);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, getColor(leds, 0));
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, getColor(leds, 2) & 0x00FF00);
+    effect.render(buffer, 1000); // turned by a third
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, getColor(leds, 0) & 0x00FF00);
+
+    parameters.type   = LedEffectType::Blink;
+    parameters.color  = 0x123456;
+    parameters.color2 = 0x000000;
+    effect.start(parameters, 0);
+    effect.render(buffer, 1499);
+    TEST_ASSERT_EQUAL_HEX32(0x123456, getColor(leds, 5));
+    effect.render(buffer, 1500);
+    TEST_ASSERT_EQUAL_HEX32(0, getColor(leds, 5));
+
+    parameters.type  = LedEffectType::Breathe;
+    parameters.color = 0xFFFFFF;
+    effect.start(parameters, 0);
+    effect.render(buffer, 0);
+    TEST_ASSERT_EQUAL_HEX32(0, getColor(leds, 0));
+    effect.render(buffer, 1500);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, getColor(leds, 0));
+}
+
+void test_scroll_sprite_on_serpentine_matrix(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 8, 4, true);
+
+    LedEffectParameters parameters;
+    parameters.type         = LedEffectType::Scroll;
+    parameters.color        = 0xFFFFFF;
+    parameters.periodMillis = 1000;
+    TEST_ASSERT_FALSE(LedEffect::parseSprite("0G", parameters));
+    TEST_ASSERT_TRUE(LedEffect::parseSprite("0102", parameters)); // column 0: top row, column 1: second row
+    TEST_ASSERT_EQUAL(2, parameters.spriteColumns);
+
+    LedEffect effect;
+    effect.start(parameters, 0);
+    effect.render(buffer, 500); // 10 columns to go, half way: sprite at x = 3
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, getColor(leds, PixelFrame::getLedIndex(buffer, 3, 0)));
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, getColor(leds, PixelFrame::getLedIndex(buffer, 4, 1)));
+    TEST_ASSERT_EQUAL_HEX32(0, getColor(leds, PixelFrame::getLedIndex(buffer, 4, 0)));
+    TEST_ASSERT_EQUAL_HEX32(0, getColor(leds, PixelFrame::getLedIndex(buffer, 3, 1)));
+
+    size_t lit = 0;
+    for (size_t i = 0; i < 32; i++)
+    {
+        lit += getColor(leds, i) != 0;
+    }
+    TEST_ASSERT_EQUAL(2, lit);
+
+    TEST_ASSERT_TRUE(LedEffectType::Scroll == LedEffect::parseType("scroll"));
+    TEST_ASSERT_TRUE(LedEffectType::None == LedEffect::parseType("sparkle"));
+    TEST_ASSERT_EQUAL_STRING("rainbow", LedEffect::getTypeName(LedEffectType::Rainbow));
+}
+
+void test_frames_per_second_clamped(void)
+{
+    // "fps" is read as uint32_t: 300 must not wrap to 44.
+    TEST_ASSERT_EQUAL(LedEffect::MaxFramesPerSecond, LedEffect::clampFramesPerSecond(300));
+    TEST_ASSERT_EQUAL(LedEffect::MaxFramesPerSecond, LedEffect::clampFramesPerSecond(UINT32_MAX));
+    TEST_ASSERT_EQUAL(1, LedEffect::clampFramesPerSecond(0));
+    TEST_ASSERT_EQUAL(25, LedEffect::clampFramesPerSecond(25));
+
+    LedEffectParameters parameters;
+    parameters.type            = LedEffectType::Blink;
+    parameters.framesPerSecond = 0;
+    LedEffect effect;
+    effect.start(parameters, 0);
+    TEST_ASSERT_EQUAL(1, effect.getParameters().framesPerSecond);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fade_ends_at_color2_and_stops);
+    RUN_TEST(test_chase_wraps_around);
+    RUN_TEST(test_rainbow_blink_breathe);
+    RUN_TEST(test_scroll_sprite_on_serpentine_matrix);
+    RUN_TEST(test_frames_per_second_clamped);
+    return UNITY_END();
+}
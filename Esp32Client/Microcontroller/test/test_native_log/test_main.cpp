@@ -0,0 +1,85 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the compile time logging: pio test -e native -f test_native_log
+// --------------------------------------------------------------------------------------------------------------------
+#include <string>
+
+static std::string output;
+
+// info and higher, main and mqtt only.
+#define IOTZOO_LOG_LEVEL 3
+#define IOTZOO_LOG_MODULES (IotZoo::LogModuleMain | IotZoo::LogModuleMqtt)
+#define IOTZOO_LOG_PRINT(message) output += (message)
+#define IOTZOO_LOG_PRINTLN(message) (output += (message), output += "\n")
+
+#include "core/Log.hpp"
+
+#include <unity.h>
+
+using namespace IotZoo;
+
+static int formatted = 0;
+
+/// @brief Stands for the String concatenation of a log message.
+static std::string format(const std::string& text)
+{
+    formatted++;
+    return text;
+}
+
+void setUp(void)
+{
+    output.clear();
+    formatted = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_levels(void)
+{
+    LOG_ERROR(LogModuleMqtt, format("error"));
+    LOG_WARNING(LogModuleMqtt, format("warning"));
+    LOG_INFO(LogModuleMqtt, format("info"));
+    LOG_DEBUG(LogModuleMqtt, format("debug"));
+    LOG_VERBOSE(LogModuleMqtt, format("verbose"));
+
+    TEST_ASSERT_EQUAL_STRING("error\nwarning\ninfo\n", output.c_str());
+    // The messages of the disabled levels are not even formatted.
+    TEST_ASSERT_EQUAL(3, formatted);
+}
+
+void test_module_mask(void)
+{
+    LOG_ERROR(LogModuleMain, format("main"));
+    LOG_ERROR(LogModuleWs2818, format("ws2818"));
+    LOG_ERROR(LogModuleAudio | LogModuleMqtt, format("audio or mqtt"));
+
+    TEST_ASSERT_EQUAL_STRING("main\naudio or mqtt\n", output.c_str());
+    TEST_ASSERT_EQUAL(2, formatted);
+}
+
+void test_print_and_blocks(void)
+{
+    LOG_PRINT(LogModuleMain, LogLevelInfo, "a");
+    LOG_PRINT(LogModuleMain, LogLevelInfo, "b");
+    LOG_PRINT(LogModuleMain, LogLevelDebug, format("c"));
+    if constexpr (IOTZOO_LOG_ENABLED(LogModuleWs2818, LogLevelError))
+    {
+        output += format("block");
+    }
+    static_assert(IOTZOO_LOG_ENABLED(LogModuleMain, LogLevelInfo), "");
+    static_assert(!IOTZOO_LOG_ENABLED(LogModuleSettings, LogLevelError), "");
+
+    TEST_ASSERT_EQUAL_STRING("ab", output.c_str());
+    TEST_ASSERT_EQUAL(0, formatted);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_levels);
+    RUN_TEST(test_module_mask);
+    RUN_TEST(test_print_and_blocks);
+    return UNITY_END();
+}
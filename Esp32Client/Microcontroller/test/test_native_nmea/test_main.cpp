@@ -0,0 +1,100 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the NMEA sentence framer: pio test -e native -f test_native_nmea
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/NmeaFramer.hpp"
+
+#include <unity.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace IotZoo;
+
+static const char* Gga = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47";
+static const char* Rmc = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+
+static std::vector<std::string> sentences;
+
+/// @brief Writes the stream in chunks of chunkSize bytes, like the UART delivers them.
+static void feed(NmeaFramer& framer, const std::string& stream, size_t chunkSize)
+{
+    for (size_t position = 0; position < stream.size(); position += chunkSize)
+    {
+        size_t length = stream.size() - position < chunkSize ? stream.size() - position : chunkSize;
+        framer.write(reinterpret_cast<const uint8_t*>(stream.data()) + position, length,
+                     [](const NmeaSentence& sentence)
+                     {
+                         TEST_ASSERT_EQUAL(strlen(sentence.text), sentence.length);
+                         sentences.emplace_back(sentence.text, sentence.length);
+                     });
+    }
+}
+
+void setUp(void)
+{
+    sentences.clear();
+}
+
+void tearDown(void)
+{
+}
+
+void test_checksum(void)
+{
+    TEST_ASSERT_TRUE(NmeaFramer::hasValidChecksum(Gga, strlen(Gga)));
+    TEST_ASSERT_TRUE(NmeaFramer::hasValidChecksum(Rmc, strlen(Rmc)));
+    TEST_ASSERT_TRUE(NmeaFramer::hasValidChecksum("$GPTXT,x*1b", 11)); // lower case hex digits
+
+    std::string wrong = Gga;
+    wrong[10]         = '9';
+    TEST_ASSERT_FALSE(NmeaFramer::hasValidChecksum(wrong.c_str(), wrong.size()));
+    TEST_ASSERT_FALSE(NmeaFramer::hasValidChecksum("$GPGGA,123519", 13)); // no checksum
+    TEST_ASSERT_FALSE(NmeaFramer::hasValidChecksum("$*", 2));
+}
+
+void test_sentences_in_any_chunks(void)
+{
+    std::string stream = std::string(Gga) + "\r\n" + Rmc + "\r\n" + Gga + "\n";
+    for (size_t chunkSize : {1, 7, 64, 1024})
+    {
+        NmeaFramer framer;
+        sentences.clear();
+        feed(framer, stream, chunkSize);
+        TEST_ASSERT_EQUAL(3, sentences.size());
+        TEST_ASSERT_EQUAL_STRING(Gga, sentences[0].c_str());
+        TEST_ASSERT_EQUAL_STRING(Rmc, sentences[1].c_str());
+        TEST_ASSERT_EQUAL_STRING(Gga, sentences[2].c_str());
+        TEST_ASSERT_EQUAL(3, framer.getSentenceCount());
+        TEST_ASSERT_EQUAL(0, framer.getSkippedBytes());
+    }
+}
+
+void test_noise_and_broken_sentences(void)
+{
+    std::string corrupted = Rmc;
+    corrupted[20]         = 'X';
+
+    std::string stream = std::string("\xFF\x00garbage", 9) + Gga + "\r\n"    // noise after a restart of the receiver
+                         + "$GPGSV,3,1,11,03,03,111,00" + Rmc + "\r\n"      // truncated sentence, followed by a good one
+                         + corrupted + "\r\n"                              // wrong checksum
+                         + "$" + std::string(100, 'A') + "\r\n" + Gga + "\r\n"; // overlong
+    NmeaFramer framer;
+    feed(framer, stream, 5);
+    TEST_ASSERT_EQUAL(3, sentences.size());
+    TEST_ASSERT_EQUAL_STRING(Gga, sentences[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(Rmc, sentences[1].c_str());
+    TEST_ASSERT_EQUAL_STRING(Gga, sentences[2].c_str());
+    TEST_ASSERT_EQUAL(1, framer.getChecksumErrors());
+    TEST_ASSERT_EQUAL(1, framer.getOverlongSentences());
+    // noise, truncated sentence, the rest of the overlong sentence behind the 81st character and its <CR><LF>.
+    TEST_ASSERT_EQUAL(9 + 26 + 20 + 2, framer.getSkippedBytes());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_checksum);
+    RUN_TEST(test_sentences_in_any_chunks);
+    RUN_TEST(test_noise_and_broken_sentences);
+    return UNITY_END();
+}
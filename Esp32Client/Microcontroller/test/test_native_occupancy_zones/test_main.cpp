@@ -0,0 +1,153 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the occupancy zones: pio test -e native -f test_native_occupancy_zones
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/OccupancyZones.hpp"
+
+#include <unity.h>
+#include <cstdlib>
+#include <vector>
+
+using namespace IotZoo;
+
+static std::vector<ZoneEvent> events;
+
+static void update(OccupancyZones& zones, std::vector<TrackPosition> tracks, uint32_t nowMillis)
+{
+    zones.update(tracks.data(), tracks.size(), nowMillis, [](const ZoneEvent& event) { events.push_back(event); });
+}
+
+/// @brief Reference: the crossing number test in floating point.
+static bool containsFloat(const std::vector<ZonePoint>& polygon, float x, float y)
+{
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+    {
+        float xi = polygon[i].x, yi = polygon[i].y, xj = polygon[j].x, yj = polygon[j].y;
+        if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi)
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+void setUp(void)
+{
+    events.clear();
+}
+
+void tearDown(void)
+{
+}
+
+void test_concave_polygon(void)
+{
+    OccupancyZones zones;
+    // an L: the couch and the corner next to it.
+    ZonePoint l[] = {{-2000, 1000}, {0, 1000}, {0, 2000}, {-1000, 2000}, {-1000, 4000}, {-2000, 4000}};
+    TEST_ASSERT_TRUE(zones.addZone("couch", l, 6, 0));
+    TEST_ASSERT_FALSE(zones.addZone("line", l, 2, 0));
+
+    TEST_ASSERT_TRUE(zones.contains(0, -1500, 3500));
+    TEST_ASSERT_TRUE(zones.contains(0, -500, 1500));
+    TEST_ASSERT_FALSE(zones.contains(0, -500, 3000)); // in the notch of the L
+    TEST_ASSERT_FALSE(zones.contains(0, 500, 1500));  // outside of the bounding box
+
+    // fixed point versus floating point on random points around a skewed polygon.
+    std::vector<ZonePoint> skewed = {{-3000, 500}, {2500, 900}, {2900, 5100}, {100, 2500}, {-2700, 6000}};
+    zones.addZone("skewed", skewed.data(), skewed.size(), 0);
+    srand(3);
+    int mismatches = 0;
+    for (int i = 0; i < 100000; i++)
+    {
+        int16_t x = static_cast<int16_t>(rand() % 8000 - 4000);
+        int16_t y = static_cast<int16_t>(rand() % 7000);
+        bool nearEdge = containsFloat(skewed, x - 1, y) != containsFloat(skewed, x + 1, y);
+        mismatches += !nearEdge && zones.contains(1, x, y) != containsFloat(skewed, x, y);
+    }
+    TEST_ASSERT_EQUAL(0, mismatches); // only points within a millimeter of an edge may differ.
+}
+
+void test_enter_dwell_exit(void)
+{
+    OccupancyZones zones;
+    ZonePoint      door[] = {{-500, 0}, {500, 0}, {500, 1000}, {-500, 1000}};
+    zones.addZone("door", door, 4, 5000);
+
+    update(zones, {{7, 2000, 3000}}, 0);
+    TEST_ASSERT_EQUAL(0, events.size());
+
+    update(zones, {{7, 0, 500}}, 100);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_TRUE(ZoneEventType::Enter == events[0].type);
+    TEST_ASSERT_EQUAL(7, events[0].trackId);
+    TEST_ASSERT_EQUAL(1, events[0].occupancy);
+
+    update(zones, {{7, 100, 600}, {8, -100, 400}}, 200);
+    TEST_ASSERT_EQUAL(2, events.size());
+    TEST_ASSERT_EQUAL(2, zones.getOccupancy(0));
+
+    // staying: no events until the dwell time is over, then one dwell event.
+    update(zones, {{7, 100, 600}, {8, -100, 400}}, 4000);
+    TEST_ASSERT_EQUAL(2, events.size());
+    update(zones, {{7, 100, 600}, {8, -100, 400}}, 5100);
+    TEST_ASSERT_EQUAL(3, events.size());
+    TEST_ASSERT_TRUE(ZoneEventType::Dwell == events[2].type);
+    TEST_ASSERT_EQUAL(7, events[2].trackId);
+    TEST_ASSERT_EQUAL(5000, events[2].dwellMillis);
+    update(zones, {{7, 100, 600}, {8, -100, 400}}, 6000);
+    update(zones, {{7, 100, 600}, {8, -100, 400}}, 6100);
+    TEST_ASSERT_EQUAL(4, events.size()); // dwell of 8, once
+    TEST_ASSERT_EQUAL(8, events[3].trackId);
+
+    // 7 walks out, 8 disappears (track deleted).
+    update(zones, {{7, 900, 600}}, 7000);
+    TEST_ASSERT_EQUAL(6, events.size());
+    TEST_ASSERT_TRUE(ZoneEventType::Exit == events[4].type);
+    TEST_ASSERT_TRUE(ZoneEventType::Exit == events[5].type);
+    TEST_ASSERT_EQUAL(0, events[5].occupancy);
+    TEST_ASSERT_EQUAL(0, zones.getOccupancy(0));
+    TEST_ASSERT_EQUAL_STRING("dwell", OccupancyZones::getEventName(ZoneEventType::Dwell));
+}
+
+void test_zone_names_and_exit_all(void)
+{
+    OccupancyZones zones;
+    ZonePoint      square[] = {{0, 0}, {1000, 0}, {1000, 1000}, {0, 1000}};
+
+    // The name is a level of the MQTT topic.
+    TEST_ASSERT_FALSE(zones.addZone("", square, 4, 0));
+    TEST_ASSERT_FALSE(zones.addZone("couch/left", square, 4, 0));
+    TEST_ASSERT_FALSE(zones.addZone("+", square, 4, 0));
+    TEST_ASSERT_FALSE(zones.addZone("door#1", square, 4, 0));
+    TEST_ASSERT_FALSE(zones.addZone("line\nbreak", square, 4, 0));
+    TEST_ASSERT_FALSE(zones.addZone("a_name_longer_than_thirty_two_chars", square, 4, 0));
+    TEST_ASSERT_EQUAL(0, zones.getZoneCount());
+    TEST_ASSERT_TRUE(zones.addZone("living room", square, 4, 0));
+    TEST_ASSERT_TRUE(zones.addZone("Küche-2.1", square, 4, 0));
+
+    update(zones, {{3, 500, 500}, {4, 600, 600}}, 100);
+    TEST_ASSERT_EQUAL(4, events.size());
+    events.clear();
+
+    // Replacing the zones: every occupant exits.
+    zones.exitAll(1100, [](const ZoneEvent& event) { events.push_back(event); });
+    TEST_ASSERT_EQUAL(4, events.size());
+    for (const ZoneEvent& event : events)
+    {
+        TEST_ASSERT_TRUE(ZoneEventType::Exit == event.type);
+        TEST_ASSERT_EQUAL(1000, event.dwellMillis);
+    }
+    TEST_ASSERT_EQUAL(0, events[1].occupancy);
+    TEST_ASSERT_EQUAL(0, zones.getOccupancy(0));
+    TEST_ASSERT_EQUAL(0, zones.getOccupancy(1));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_concave_polygon);
+    RUN_TEST(test_enter_dwell_exit);
+    RUN_TEST(test_zone_names_and_exit_all);
+    return UNITY_END();
+}
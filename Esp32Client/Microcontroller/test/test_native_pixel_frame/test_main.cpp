@@ -0,0 +1,199 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the binary pixel frames: pio test -e native -f test_native_pixel_frame
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PixelFrame.hpp"
+#include "core/PixelJsonParser.hpp"
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace IotZoo;
+
+static std::vector<uint8_t> createFrame(PixelFrameFormat format, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+    std::vector<uint8_t> frame = {static_cast<uint8_t>(format), 0, 0, 0, static_cast<uint8_t>(x), static_cast<uint8_t>(x >> 8),
+                                  static_cast<uint8_t>(y), static_cast<uint8_t>(y >> 8), static_cast<uint8_t>(width),
+                                  static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(height), static_cast<uint8_t>(height >> 8)};
+    return frame;
+}
+
+static PixelBuffer createBuffer(std::vector<uint8_t>& leds, uint16_t columns, uint16_t rows, bool serpentine)
+{
+    leds.assign(columns * rows * 3, 0);
+    PixelBuffer buffer;
+    buffer.data       = leds.data();
+    buffer.columns    = columns;
+    buffer.rows       = rows;
+    buffer.serpentine = serpentine;
+    return buffer;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_rgb888_partial_rect_serpentine(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 4, 4, true);
+
+    // 2 x 2 at (1, 1): red, green / blue, white
+    std::vector<uint8_t> frame = createFrame(PixelFrameFormat::Rgb888, 1, 1, 2, 2);
+    frame.insert(frame.end(), {255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255});
+
+    PixelFrameHeader header;
+    TEST_ASSERT_TRUE(PixelFrame::Error::None == PixelFrame::apply(frame.data(), frame.size(), buffer, header));
+    TEST_ASSERT_EQUAL(2, header.width);
+
+    // row 1 runs backwards: (1,1) -> 6, (2,1) -> 5. row 2 forwards: (1,2) -> 9, (2,2) -> 10. NEO_GRB order.
+    TEST_ASSERT_EQUAL(6, PixelFrame::getLedIndex(buffer, 1, 1));
+    const uint8_t red[]   = {0, 255, 0};
+    const uint8_t green[] = {255, 0, 0};
+    const uint8_t blue[]  = {0, 0, 255};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(red, &leds[6 * 3], 3);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(green, &leds[5 * 3], 3);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(blue, &leds[9 * 3], 3);
+    TEST_ASSERT_EQUAL(255, leds[10 * 3]);
+    TEST_ASSERT_EQUAL(0, leds[0]);
+    TEST_ASSERT_EQUAL(0, leds[7 * 3]);
+}
+
+void test_rgb565_and_brightness(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 3, 1, false);
+    buffer.brightnessScale      = 128;
+
+    std::vector<uint8_t> frame = createFrame(PixelFrameFormat::Rgb565, 0, 0, 3, 1);
+    frame.insert(frame.end(), {0x00, 0xF8, 0xE0, 0x07, 0xFF, 0xFF}); // red, green, white
+
+    PixelFrameHeader header;
+    TEST_ASSERT_TRUE(PixelFrame::Error::None == PixelFrame::apply(frame.data(), frame.size(), buffer, header));
+    TEST_ASSERT_EQUAL(127, leds[1]); // red of pixel 0, scaled by 128 / 256
+    TEST_ASSERT_EQUAL(0, leds[0]);
+    TEST_ASSERT_EQUAL(127, leds[3]); // green of pixel 1
+    TEST_ASSERT_EQUAL(127, leds[8]);
+}
+
+void test_palette(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 4, 1, false);
+
+    std::vector<uint8_t> frame = createFrame(PixelFrameFormat::Palette, 0, 0, 4, 1);
+    frame.insert(frame.end(), {2, 0, 10, 20, 30, 40, 50, 60, 0, 1, 1, 0});
+
+    PixelFrameHeader header;
+    TEST_ASSERT_TRUE(PixelFrame::Error::None == PixelFrame::apply(frame.data(), frame.size(), buffer, header));
+    TEST_ASSERT_EQUAL(10, leds[1]);
+    TEST_ASSERT_EQUAL(20, leds[0]);
+    TEST_ASSERT_EQUAL(40, leds[3 + 1]);
+    TEST_ASSERT_EQUAL(60, leds[6 + 2]);
+    TEST_ASSERT_EQUAL(30, leds[9 + 2]);
+
+    // index 2 is not in the palette: nothing is written.
+    frame.back() = 2;
+    leds.assign(leds.size(), 0);
+    TEST_ASSERT_TRUE(PixelFrame::Error::InvalidPalette == PixelFrame::apply(frame.data(), frame.size(), buffer, header));
+    TEST_ASSERT_EQUAL(0, leds[1]);
+}
+
+void test_errors(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 8, 8, true);
+    PixelFrameHeader     header;
+
+    std::vector<uint8_t> frame = createFrame(PixelFrameFormat::Rgb888, 0, 0, 2, 1);
+    TEST_ASSERT_TRUE(PixelFrame::Error::TooShort == PixelFrame::apply(frame.data(), 5, buffer, header));
+    TEST_ASSERT_TRUE(PixelFrame::Error::LengthMismatch == PixelFrame::apply(frame.data(), frame.size(), buffer, header));
+
+    frame = createFrame(PixelFrameFormat::Rgb888, 7, 0, 2, 1);
+    frame.resize(frame.size() + 6);
+    TEST_ASSERT_TRUE(PixelFrame::Error::OutOfRange == PixelFrame::apply(frame.data(), frame.size(), buffer, header));
+
+    frame[0] = 7;
+    TEST_ASSERT_TRUE(PixelFrame::Error::UnknownFormat == PixelFrame::apply(frame.data(), frame.size(), buffer, header));
+}
+
+#ifdef IOTZOO_BENCHMARK
+/// @brief One 16 x 16 frame: size and decode time as JSON (setPixelColor), RGB888, RGB565 and palette.
+void test_benchmark_16x16(void)
+{
+    std::vector<uint8_t> leds;
+    PixelBuffer          buffer = createBuffer(leds, 16, 16, true);
+
+    std::string json = R"({"brightness":10,"pixels":[)";
+    char        pixel[64];
+    for (int i = 0; i < 256; i++)
+    {
+        snprintf(pixel, sizeof(pixel), R"(%s{"color":"#%06X","index":%d})", i == 0 ? "" : ",", (i * 2654435761u) & 0xFFFFFF, i);
+        json += pixel;
+    }
+    json += "]}";
+
+    std::vector<uint8_t> rgb888  = createFrame(PixelFrameFormat::Rgb888, 0, 0, 16, 16);
+    std::vector<uint8_t> rgb565  = createFrame(PixelFrameFormat::Rgb565, 0, 0, 16, 16);
+    std::vector<uint8_t> palette = createFrame(PixelFrameFormat::Palette, 0, 0, 16, 16);
+    palette.insert(palette.end(), {16, 0});
+    for (int i = 0; i < 16 * 3; i++)
+    {
+        palette.push_back(static_cast<uint8_t>(i * 5));
+    }
+    for (int i = 0; i < 256; i++)
+    {
+        uint32_t color = (i * 2654435761u) & 0xFFFFFF;
+        rgb888.insert(rgb888.end(), {static_cast<uint8_t>(color >> 16), static_cast<uint8_t>(color >> 8), static_cast<uint8_t>(color)});
+        rgb565.insert(rgb565.end(), {static_cast<uint8_t>(color), static_cast<uint8_t>(color >> 8)});
+        palette.push_back(static_cast<uint8_t>(i & 15));
+    }
+
+    constexpr int Frames   = 20000;
+    uint32_t      checksum = 0;
+    auto          start    = std::chrono::steady_clock::now();
+    for (int i = 0; i < Frames; i++)
+    {
+        PixelJsonParser::parse(json.c_str(), json.length(), [&](const PixelRange& range) { leds[range.startIndex * 3] = range.color; });
+    }
+    double jsonMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / Frames;
+    printf("json:    %5zu bytes, %6.2f us per frame\n", json.length(), jsonMicros);
+
+    for (const auto* frame : {&rgb888, &rgb565, &palette})
+    {
+        PixelFrameHeader header;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < Frames; i++)
+        {
+            TEST_ASSERT_TRUE(PixelFrame::Error::None == PixelFrame::apply(frame->data(), frame->size(), buffer, header));
+            checksum += leds[i & 255];
+        }
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / Frames;
+        printf("%s: %5zu bytes, %6.2f us per frame\n",
+               header.format == PixelFrameFormat::Rgb888   ? "rgb888 "
+               : header.format == PixelFrameFormat::Rgb565 ? "rgb565 "
+                                                           : "palette",
+               frame->size(), micros);
+    }
+    printf("checksum %u\n", checksum);
+}
+#endif
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rgb888_partial_rect_serpentine);
+    RUN_TEST(test_rgb565_and_brightness);
+    RUN_TEST(test_palette);
+    RUN_TEST(test_errors);
+#ifdef IOTZOO_BENCHMARK
+    RUN_TEST(test_benchmark_16x16);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,180 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the streaming setPixelColor parser: pio test -e native -f test_native_pixel_json
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PixelJsonParser.hpp"
+
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+using namespace IotZoo;
+
+static std::vector<PixelRange> ranges;
+
+static PixelJsonParser::Error parse(const std::string& json)
+{
+    ranges.clear();
+    return PixelJsonParser::parse(json.c_str(), json.length(), [](const PixelRange& range) { ranges.push_back(range); });
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_example_message(void)
+{
+    // The example registered by WS2818::addMqttTopicsToRegister().
+    std::string json = R"({
+        "brightness": 10,
+        "color": "#FFFF00",
+        "pixels": [
+            { "r": "255", "g": "0", "b": 125, "index": 0, "length": 10, "brightness": 10, "millisUntilTurnOff": 2000 },
+            { "color": "#FFFFFF", "index": 30, "length": 8, "millisUntilTurnOff": 1000 },
+            { "index": 50, "length": 8, "millisUntilTurnOff": 3000 }
+        ]
+    })";
+
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::None == parse(json));
+    TEST_ASSERT_EQUAL(3, ranges.size());
+
+    TEST_ASSERT_EQUAL_HEX32(0xFF007D, ranges[0].color);
+    TEST_ASSERT_EQUAL(0, ranges[0].startIndex);
+    TEST_ASSERT_EQUAL(10, ranges[0].length);
+    TEST_ASSERT_EQUAL(10, ranges[0].brightness);
+    TEST_ASSERT_EQUAL(2000, ranges[0].millisUntilTurnOff);
+
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, ranges[1].color);
+    TEST_ASSERT_EQUAL(30, ranges[1].startIndex);
+    TEST_ASSERT_EQUAL(8, ranges[1].length);
+
+    // message color
+    TEST_ASSERT_EQUAL_HEX32(0xFFFF00, ranges[2].color);
+    TEST_ASSERT_EQUAL(50, ranges[2].startIndex);
+    TEST_ASSERT_EQUAL(3000, ranges[2].millisUntilTurnOff);
+}
+
+void test_defaults_after_pixels(void)
+{
+    std::string json = R"({"pixels":[{"index":3},{"index":4,"length":0,"unknown":{"a":[1,{"b":"]"}]}}],"r":1,"g":2,"b":3,
+                          "brightness":1,"millisUntilTurnOff":500,"comment":"x\"y"})";
+
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::None == parse(json));
+    TEST_ASSERT_EQUAL(2, ranges.size());
+    TEST_ASSERT_EQUAL_HEX32(0x010203, ranges[0].color);
+    TEST_ASSERT_EQUAL(3, ranges[0].startIndex);
+    TEST_ASSERT_EQUAL(1, ranges[0].length);
+    TEST_ASSERT_EQUAL(2, ranges[0].brightness); // 1 is raised to 2, as before.
+    TEST_ASSERT_EQUAL(500, ranges[0].millisUntilTurnOff);
+    TEST_ASSERT_EQUAL(1, ranges[1].length);
+}
+
+void test_errors(void)
+{
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::Syntax == parse(""));
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::Syntax == parse(R"({"pixels":[{"index":1})"));
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::Syntax == parse(R"({"color":"#FF0000" "pixels":[]})"));
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::PixelsMissing == parse(R"({"color":"#FF0000"})"));
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::PixelsMissing == parse(R"({"pixels":5})"));
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::InvalidColor == parse(R"({"color":"#GG0000","pixels":[]})"));
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::ColorMissing == parse(R"({"r":1,"g":2,"pixels":[{"index":1}]})"));
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::None == parse(R"({"pixels":[]})"));
+
+    // ranges in front of the error are reported.
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::Syntax == parse(R"({"color":"#FF0000","pixels":[{"index":1},{"index":x}]})"));
+    TEST_ASSERT_EQUAL(1, ranges.size());
+    TEST_ASSERT_EQUAL_STRING("\"pixels\":[] missing", PixelJsonParser::getErrorText(PixelJsonParser::Error::PixelsMissing));
+}
+
+static std::string createMessage(int pixelCount)
+{
+    std::string json = R"({"brightness":10,"color":"#FFFF00","pixels":[)";
+    char        pixel[96];
+    for (int i = 0; i < pixelCount; i++)
+    {
+        snprintf(pixel, sizeof(pixel), R"(%s{"color":"#%06X","index":%d,"length":1,"millisUntilTurnOff":2000})", i == 0 ? "" : ",",
+                 (i * 2654435761u) & 0xFFFFFF, i);
+        json += pixel;
+    }
+    return json + "]}";
+}
+
+void test_large_message(void)
+{
+    // A 16 x 16 matrix pixel by pixel: ~17 KB, more than the 4 KB StaticJsonDocument could hold.
+    std::string json = createMessage(256);
+    TEST_ASSERT_GREATER_THAN(16000, json.length());
+    TEST_ASSERT_TRUE(PixelJsonParser::Error::None == parse(json));
+    TEST_ASSERT_EQUAL(256, ranges.size());
+    TEST_ASSERT_EQUAL(255, ranges[255].startIndex);
+}
+
+// --- stack measurement: run the parser on a painted stack and count the bytes that were touched.
+
+static constexpr size_t   StackSize  = 64 * 1024;
+static constexpr uint8_t  StackPaint = 0xA5;
+static const std::string* stackJson  = nullptr;
+static uint32_t           stackSum   = 0;
+
+static void* parseOnPaintedStack(void*)
+{
+    if (nullptr == stackJson)
+    {
+        return nullptr; // baseline: the thread without parser.
+    }
+    PixelJsonParser::parse(stackJson->c_str(), stackJson->length(), [](const PixelRange& range) { stackSum += range.color; });
+    return nullptr;
+}
+
+static size_t measurePeakStack(const std::string* json)
+{
+    std::vector<uint8_t> stack(StackSize, StackPaint);
+    stackJson = json;
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstack(&attributes, stack.data(), stack.size());
+    pthread_t thread;
+    pthread_create(&thread, &attributes, parseOnPaintedStack, nullptr);
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attributes);
+
+    // The stack grows down: the untouched bytes are at the low end.
+    size_t untouched = 0;
+    while (untouched < stack.size() && stack[untouched] == StackPaint)
+    {
+        untouched++;
+    }
+    return stack.size() - untouched;
+}
+
+void test_parser_stack(void)
+{
+    std::string small = createMessage(8);   // ~0.5 KB
+    std::string large = createMessage(256); // ~17 KB
+
+    // The thread itself is part of the measured stack: compare with a thread that does not parse.
+    size_t baseline = measurePeakStack(nullptr);
+    for (const std::string* json : {&small, &large})
+    {
+        size_t peakStack = measurePeakStack(json);
+        TEST_ASSERT_LESS_THAN(1024, peakStack - baseline);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_example_message);
+    RUN_TEST(test_defaults_after_pixels);
+    RUN_TEST(test_errors);
+    RUN_TEST(test_large_message);
+    RUN_TEST(test_parser_stack);
+    return UNITY_END();
+}
@@ -0,0 +1,106 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the loop profiler: pio test -e native -f test_native_profiler
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/LoopProfiler.hpp"
+
+#include <unity.h>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_bucket_bounds(void)
+{
+    // every value lies within the bounds of its bucket and the buckets are contiguous.
+    uint32_t values[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 100, 1000, 240000, 0x7FFFFFFF, 0x80000000, UINT32_MAX};
+    for (uint32_t value : values)
+    {
+        size_t bucketIndex = CycleHistogram::getBucketIndex(value);
+        TEST_ASSERT_TRUE(bucketIndex < CycleHistogram::Buckets);
+        TEST_ASSERT_TRUE(value <= CycleHistogram::getBucketUpperBound(bucketIndex));
+        if (bucketIndex > 0)
+        {
+            TEST_ASSERT_TRUE(value > CycleHistogram::getBucketUpperBound(bucketIndex - 1));
+        }
+    }
+    TEST_ASSERT_EQUAL(CycleHistogram::Buckets - 1, CycleHistogram::getBucketIndex(UINT32_MAX));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, CycleHistogram::getBucketUpperBound(CycleHistogram::Buckets - 1));
+}
+
+void test_statistics(void)
+{
+    LoopProfiler profiler;
+    int          probeId = profiler.addProbe("DS18B20#0");
+
+    // 99 fast runs and one slow run.
+    for (int i = 0; i < 99; i++)
+    {
+        profiler.record(probeId, 1000);
+    }
+    profiler.record(probeId, 2400000);
+
+    LoopProfiler::Statistics statistics = profiler.getStatistics(probeId);
+    TEST_ASSERT_EQUAL_UINT32(100, statistics.count);
+    TEST_ASSERT_EQUAL_UINT32(1000, statistics.minCycles);
+    TEST_ASSERT_EQUAL_UINT32(2400000, statistics.maxCycles);
+    TEST_ASSERT_EQUAL_UINT32(24990, statistics.avgCycles);
+    // the 99th value is a fast one, reported as the upper bound of its bucket.
+    TEST_ASSERT_TRUE(statistics.p99Cycles >= 1000);
+    TEST_ASSERT_TRUE(statistics.p99Cycles <= 1250);
+
+    profiler.record(probeId, 2400000);
+    TEST_ASSERT_EQUAL_UINT32(2400000, profiler.getStatistics(probeId).p99Cycles); // clamped to the maximum
+}
+
+void test_probes_are_reused_by_name(void)
+{
+    LoopProfiler profiler;
+    int          first  = profiler.addProbe("iotzoo/alive_ack");
+    int          second = profiler.addProbe("WS2818#1");
+    TEST_ASSERT_EQUAL(first, profiler.addProbe("iotzoo/alive_ack"));
+    TEST_ASSERT_NOT_EQUAL(first, second);
+    TEST_ASSERT_EQUAL(2, profiler.getProbeCount());
+    TEST_ASSERT_EQUAL_STRING("WS2818#1", profiler.getProbeName(second));
+    TEST_ASSERT_EQUAL_STRING("", profiler.getProbeName(LoopProfiler::InvalidProbeId));
+
+    profiler.record(LoopProfiler::InvalidProbeId, 100); // ignored
+    profiler.record(second, 100);
+    profiler.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.getStatistics(second).count);
+    TEST_ASSERT_EQUAL(2, profiler.getProbeCount());
+}
+
+void test_histogram_saturation_keeps_shape(void)
+{
+    CycleHistogram histogram;
+    for (uint32_t i = 0; i < 200000; i++)
+    {
+        histogram.add(i % 100 == 0 ? 1000000 : 500);
+    }
+    // 1 % slow runs: p99 is still fast, p99.5 is slow, after several halvings.
+    TEST_ASSERT_TRUE(histogram.getPercentile(99) < 1000);
+    TEST_ASSERT_TRUE(histogram.getPercentile(99.5f) >= 1000000);
+}
+
+void test_cycles_to_micros(void)
+{
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, LoopProfiler::cyclesToMicros(2400, 240));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, LoopProfiler::cyclesToMicros(2400, 0));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bucket_bounds);
+    RUN_TEST(test_statistics);
+    RUN_TEST(test_probes_are_reused_by_name);
+    RUN_TEST(test_histogram_saturation_keeps_shape);
+    RUN_TEST(test_cycles_to_micros);
+    return UNITY_END();
+}
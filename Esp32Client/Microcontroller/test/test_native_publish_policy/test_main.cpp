@@ -0,0 +1,112 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the deadband / heartbeat publish policy: pio test -e native -f test_native_publish_policy
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PublishPolicy.hpp"
+
+#include <unity.h>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_change_only_without_deadband(void)
+{
+    PublishPolicy policy;
+    TEST_ASSERT_TRUE(policy.update(21.5f, 0));
+    TEST_ASSERT_FALSE(policy.update(21.5f, 5000));
+    TEST_ASSERT_TRUE(policy.update(21.6f, 10000));
+    TEST_ASSERT_FALSE(policy.update(21.6f, 15000));
+    TEST_ASSERT_TRUE(policy.update(NAN, 20000));
+    TEST_ASSERT_EQUAL(2, policy.getSuppressedCount());
+}
+
+void test_absolute_and_relative_deadband(void)
+{
+    PublishPolicyParameters parameters;
+    parameters.deadbandAbsolute = 0.5f;
+    PublishPolicy absolute(parameters);
+    TEST_ASSERT_TRUE(absolute.update(20.0f, 0));
+    TEST_ASSERT_FALSE(absolute.update(20.4f, 1000));
+    TEST_ASSERT_FALSE(absolute.update(19.6f, 2000));
+    TEST_ASSERT_TRUE(absolute.update(20.5f, 3000)); // compared with the published value, not with the last sample
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.5f, absolute.getPublishedValue());
+
+    parameters                  = PublishPolicyParameters();
+    parameters.deadbandPercent  = 10;
+    PublishPolicy relative(parameters);
+    TEST_ASSERT_TRUE(relative.update(1000, 0));
+    TEST_ASSERT_FALSE(relative.update(1090, 1000));
+    TEST_ASSERT_TRUE(relative.update(1100, 2000));
+    TEST_ASSERT_FALSE(relative.update(1200, 3000)); // 10 % of 1100
+    TEST_ASSERT_TRUE(relative.update(1210, 4000));
+}
+
+void test_heartbeat_and_rate_limit(void)
+{
+    PublishPolicyParameters parameters;
+    parameters.deadbandAbsolute  = 1;
+    parameters.minIntervalMillis = 2000;
+    parameters.maxAgeMillis      = 60000;
+    PublishPolicy policy(parameters);
+
+    TEST_ASSERT_TRUE(policy.update(50, 0));
+    TEST_ASSERT_FALSE(policy.update(80, 1000)); // rate limited
+    TEST_ASSERT_TRUE(policy.update(80, 2000));
+    TEST_ASSERT_FALSE(policy.update(80.2f, 30000));
+    TEST_ASSERT_TRUE(policy.update(80.2f, 62000)); // heartbeat
+    TEST_ASSERT_FALSE(policy.update(80.2f, 63000));
+
+    policy.reset();
+    TEST_ASSERT_TRUE(policy.update(80.2f, 63100));
+}
+
+void test_reset_after_dropped_publish(void)
+{
+    PublishPolicyParameters parameters;
+    parameters.deadbandAbsolute  = 1;
+    parameters.minIntervalMillis = 2000;
+    PublishPolicy policy(parameters);
+    TEST_ASSERT_TRUE(policy.update(20.0f, 0));
+    TEST_ASSERT_TRUE(policy.update(25.0f, 5000));
+    // The publish of 25 was dropped: the device resets the policy, the next sample goes out again.
+    policy.reset();
+    TEST_ASSERT_TRUE(policy.update(25.0f, 5500));
+    TEST_ASSERT_FALSE(policy.update(25.2f, 8000));
+}
+
+void test_parameters_by_property_name(void)
+{
+    PublishPolicy humidity;
+    PublishPolicy temperature;
+    TEST_ASSERT_TRUE(humidity.setParameter("humidity", "DeadbandAbsolute", 2));
+    TEST_ASSERT_TRUE(temperature.setParameter("temperature", "DeadbandAbsolute", 2));
+    TEST_ASSERT_TRUE(humidity.setParameter("humidity", "humidity.DeadbandPercent", 5));
+    TEST_ASSERT_FALSE(temperature.setParameter("temperature", "humidity.DeadbandPercent", 5));
+    TEST_ASSERT_FALSE(humidity.setParameter("humidity", "hum.DeadbandPercent", 7));
+    TEST_ASSERT_TRUE(humidity.setParameter("humidity", "MinPublishIntervalMillis", 1000));
+    TEST_ASSERT_TRUE(humidity.setParameter("humidity", "MaxPublishIntervalMillis", 600000));
+    TEST_ASSERT_FALSE(humidity.setParameter("humidity", "Interval", 5000));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2, humidity.parameters.deadbandAbsolute);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 5, humidity.parameters.deadbandPercent);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0, temperature.parameters.deadbandPercent);
+    TEST_ASSERT_EQUAL(1000, humidity.parameters.minIntervalMillis);
+    TEST_ASSERT_EQUAL(600000, humidity.parameters.maxAgeMillis);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_change_only_without_deadband);
+    RUN_TEST(test_absolute_and_relative_deadband);
+    RUN_TEST(test_heartbeat_and_rate_limit);
+    RUN_TEST(test_reset_after_dropped_publish);
+    RUN_TEST(test_parameters_by_property_name);
+    return UNITY_END();
+}
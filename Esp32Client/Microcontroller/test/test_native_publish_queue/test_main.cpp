@@ -0,0 +1,158 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the outgoing publish queue: pio test -e native -f test_native_publish_queue
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/PublishQueue.hpp"
+
+#include <unity.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace IotZoo;
+
+struct SentMessage
+{
+    std::string topic;
+    std::string payload;
+    bool        retain;
+};
+
+static std::vector<SentMessage> sent;
+static bool                     connected  = true;
+static uint32_t                 nowMicros  = 0;
+static uint32_t                 sendMicros = 0; // simulated duration of one publish
+
+static bool fakeSend(const char* topic, const uint8_t* payload, size_t length, bool retain)
+{
+    if (!connected)
+    {
+        return false;
+    }
+    nowMicros += sendMicros;
+    sent.push_back({topic, std::string(reinterpret_cast<const char*>(payload), length), retain});
+    return true;
+}
+
+static uint32_t fakeMicros()
+{
+    return nowMicros;
+}
+
+static PublishQueue::Result push(PublishQueue& queue, const char* topic, const char* payload, PublishClass publishClass)
+{
+    return queue.push(topic, reinterpret_cast<const uint8_t*>(payload), strlen(payload), false, publishClass);
+}
+
+void setUp(void)
+{
+    sent.clear();
+    connected  = true;
+    nowMicros  = 0;
+    sendMicros = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_telemetry_is_coalesced(void)
+{
+    PublishQueue queue(8);
+    TEST_ASSERT_TRUE(PublishQueue::Result::Queued == push(queue, "t/celsius", "20.5", PublishClass::Telemetry));
+    TEST_ASSERT_TRUE(PublishQueue::Result::Queued == push(queue, "t/button", "pressed", PublishClass::Event));
+    TEST_ASSERT_TRUE(PublishQueue::Result::Coalesced == push(queue, "t/celsius", "21.0", PublishClass::Telemetry));
+    TEST_ASSERT_TRUE(PublishQueue::Result::Queued == push(queue, "t/button", "pressed", PublishClass::Event));
+
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL(1, queue.getCoalesced());
+
+    TEST_ASSERT_EQUAL(3, queue.drain(fakeSend, fakeMicros, 1000));
+    TEST_ASSERT_EQUAL(0, queue.size());
+    // The coalesced value keeps its position, but has the latest value.
+    TEST_ASSERT_EQUAL_STRING("t/celsius", sent[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("21.0", sent[0].payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("t/button", sent[1].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("t/button", sent[2].topic.c_str());
+}
+
+void test_full_queue_drops_telemetry_first(void)
+{
+    PublishQueue queue(3);
+    push(queue, "t/celsius/0", "1", PublishClass::Telemetry);
+    push(queue, "t/event", "a", PublishClass::Event);
+    push(queue, "t/celsius/1", "2", PublishClass::Telemetry);
+
+    // An event replaces the oldest telemetry value.
+    TEST_ASSERT_TRUE(PublishQueue::Result::Queued == push(queue, "t/event", "b", PublishClass::Event));
+    TEST_ASSERT_EQUAL(1, queue.getDroppedTelemetry());
+    // So does new telemetry.
+    TEST_ASSERT_TRUE(PublishQueue::Result::Queued == push(queue, "t/celsius/2", "3", PublishClass::Telemetry));
+    TEST_ASSERT_EQUAL(2, queue.getDroppedTelemetry());
+    TEST_ASSERT_TRUE(PublishQueue::Result::Queued == push(queue, "t/event", "c", PublishClass::Event));
+    TEST_ASSERT_EQUAL(3, queue.getDroppedTelemetry());
+
+    // Only events are queued: events are never dropped in favour of other messages.
+    TEST_ASSERT_TRUE(PublishQueue::Result::Dropped == push(queue, "t/celsius/3", "4", PublishClass::Telemetry));
+    TEST_ASSERT_TRUE(PublishQueue::Result::Dropped == push(queue, "t/event", "d", PublishClass::Event));
+    TEST_ASSERT_EQUAL(4, queue.getDroppedTelemetry());
+    TEST_ASSERT_EQUAL(1, queue.getDroppedEvents());
+    TEST_ASSERT_EQUAL(3, queue.getHighWaterMark());
+
+    queue.drain(fakeSend, fakeMicros, 1000);
+    TEST_ASSERT_EQUAL(3, sent.size());
+    TEST_ASSERT_EQUAL_STRING("a", sent[0].payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("b", sent[1].payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("c", sent[2].payload.c_str());
+}
+
+void test_drain_budget_and_disconnect(void)
+{
+    PublishQueue queue(16);
+    for (int i = 0; i < 10; i++)
+    {
+        push(queue, "t/event", std::to_string(i).c_str(), PublishClass::Event);
+    }
+
+    connected = false;
+    TEST_ASSERT_EQUAL(0, queue.drain(fakeSend, fakeMicros, 1000));
+    TEST_ASSERT_EQUAL(10, queue.size());
+
+    connected  = true;
+    sendMicros = 300;
+    // 0, 300, 600, 900 µs: the 4th publish starts within the budget.
+    TEST_ASSERT_EQUAL(4, queue.drain(fakeSend, fakeMicros, 1000));
+    TEST_ASSERT_EQUAL(6, queue.size());
+
+    // A single publish longer than the budget still makes progress.
+    sendMicros = 5000;
+    TEST_ASSERT_EQUAL(1, queue.drain(fakeSend, fakeMicros, 1000));
+
+    sendMicros = 0;
+    TEST_ASSERT_EQUAL(5, queue.drain(fakeSend, fakeMicros, 1000));
+    for (int i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(std::to_string(i).c_str(), sent[i].payload.c_str());
+    }
+}
+
+void test_too_large(void)
+{
+    PublishQueue queue(4);
+    std::string  payload(PublishQueue::MaxPayloadLength + 1, 'x');
+    std::string  topic(PublishQueue::MaxTopicLength + 1, 't');
+    TEST_ASSERT_TRUE(PublishQueue::Result::TooLarge == push(queue, "t/config", payload.c_str(), PublishClass::Event));
+    TEST_ASSERT_TRUE(PublishQueue::Result::TooLarge == push(queue, topic.c_str(), "1", PublishClass::Event));
+    payload.pop_back();
+    TEST_ASSERT_TRUE(PublishQueue::Result::Queued == push(queue, "t/config", payload.c_str(), PublishClass::Event));
+    TEST_ASSERT_EQUAL(1, queue.size());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_telemetry_is_coalesced);
+    RUN_TEST(test_full_queue_drops_telemetry_first);
+    RUN_TEST(test_drain_budget_and_disconnect);
+    RUN_TEST(test_too_large);
+    return UNITY_END();
+}
@@ -0,0 +1,124 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the Rd-03D frame parser: pio test -e native -f test_native_rd03d
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/Rd03DParser.hpp"
+
+#include <unity.h>
+#include <cstring>
+#include <vector>
+
+using namespace IotZoo;
+
+// Frame of the specification: target 1 at x = -261 mm, y = 537 mm, target 2, no target 3.
+static const std::vector<uint8_t> SpecificationFrame = {0xAA, 0xFF, 0x03, 0x00, 0x05, 0x01, 0x19, 0x82, 0x00, 0x00, 0x68, 0x01, 0xE3, 0x81, 0x33,
+                                                        0x88, 0x20, 0x80, 0x68, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0xCC};
+
+static std::vector<Rd03DFrame> frames;
+
+/// @brief Writes the stream in chunks of chunkSize bytes, like the UART delivers them, and parses after every chunk.
+static void feed(Rd03DParser& parser, const std::vector<uint8_t>& stream, size_t chunkSize)
+{
+    for (size_t position = 0; position < stream.size(); position += chunkSize)
+    {
+        size_t length = stream.size() - position < chunkSize ? stream.size() - position : chunkSize;
+        TEST_ASSERT_EQUAL(length, parser.write(stream.data() + position, length));
+        parser.parse([](const Rd03DFrame& frame) { frames.push_back(frame); });
+    }
+}
+
+void setUp(void)
+{
+    frames.clear();
+}
+
+void tearDown(void)
+{
+}
+
+void test_specification_frame(void)
+{
+    Rd03DParser parser;
+    feed(parser, SpecificationFrame, 64);
+    TEST_ASSERT_EQUAL(1, frames.size());
+
+    const Target& target = frames[0].targets[0];
+    TEST_ASSERT_EQUAL(-261, target.x);
+    TEST_ASSERT_EQUAL(537, target.y);
+    TEST_ASSERT_EQUAL(0, target.speedCentimetersPerSecond);
+    TEST_ASSERT_EQUAL(360, target.distanceResolutionMillimeters);
+    TEST_ASSERT_EQUAL(597, target.distanceMillimeters);
+    TEST_ASSERT_EQUAL(115, static_cast<int>(target.angle));
+
+    TEST_ASSERT_EQUAL(483, frames[0].targets[1].x);
+    TEST_ASSERT_EQUAL(2099, frames[0].targets[1].y);
+    TEST_ASSERT_EQUAL(32, frames[0].targets[1].speedCentimetersPerSecond);
+    TEST_ASSERT_EQUAL(0, frames[0].targets[2].distanceMillimeters); // no target 3
+    TEST_ASSERT_EQUAL(0, parser.available());
+}
+
+void test_partial_frames_byte_by_byte(void)
+{
+    Rd03DParser          parser;
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 20; i++)
+    {
+        stream.insert(stream.end(), SpecificationFrame.begin(), SpecificationFrame.end());
+    }
+    feed(parser, stream, 1);
+    TEST_ASSERT_EQUAL(20, frames.size());
+    TEST_ASSERT_EQUAL(0, parser.getSkippedBytes());
+    TEST_ASSERT_EQUAL(0, parser.getBadFrames());
+}
+
+void test_resync_after_noise_and_truncated_frame(void)
+{
+    Rd03DParser          parser;
+    std::vector<uint8_t> stream = {0x12, 0xAA, 0xFF, 0x55, 0xCC}; // noise, a broken header and a trailer
+    // a truncated frame: the next frame starts within its payload.
+    stream.insert(stream.end(), SpecificationFrame.begin(), SpecificationFrame.begin() + 14);
+    stream.insert(stream.end(), SpecificationFrame.begin(), SpecificationFrame.end());
+    // a frame with a corrupted trailer
+    stream.insert(stream.end(), SpecificationFrame.begin(), SpecificationFrame.end() - 1);
+    stream.push_back(0x00);
+    stream.insert(stream.end(), SpecificationFrame.begin(), SpecificationFrame.end());
+
+    feed(parser, stream, 7);
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_EQUAL(-261, frames[1].targets[0].x);
+    TEST_ASSERT_EQUAL(2, parser.getBadFrames());
+    TEST_ASSERT_EQUAL(0, parser.available());
+}
+
+void test_ring_buffer_full_and_wrap(void)
+{
+    Rd03DParser parser;
+    // 9 frames do not fit into 256 bytes: the writer has to wait for the parser.
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 9; i++)
+    {
+        stream.insert(stream.end(), SpecificationFrame.begin(), SpecificationFrame.end());
+    }
+    size_t written = parser.write(stream.data(), stream.size());
+    TEST_ASSERT_EQUAL(Rd03DParser::BufferSize, written);
+
+    size_t free;
+    parser.getWriteBuffer(free);
+    TEST_ASSERT_EQUAL(0, free);
+
+    parser.parse([](const Rd03DFrame& frame) { frames.push_back(frame); });
+    TEST_ASSERT_EQUAL(8, frames.size());
+    TEST_ASSERT_EQUAL(stream.size() - written, parser.write(stream.data() + written, stream.size() - written)); // wraps around
+    parser.parse([](const Rd03DFrame& frame) { frames.push_back(frame); });
+    TEST_ASSERT_EQUAL(9, frames.size());
+    TEST_ASSERT_EQUAL(537, frames[8].targets[0].y);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_specification_frame);
+    RUN_TEST(test_partial_frames_byte_by_byte);
+    RUN_TEST(test_resync_after_noise_and_truncated_frame);
+    RUN_TEST(test_ring_buffer_full_and_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,160 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the device registry with virtual fake devices: pio test -e native -f test_native_registry
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/DeviceRegistry.hpp"
+
+#include <unity.h>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/// @brief Same shape as DeviceBase: virtual lifecycle methods with empty defaults.
+class FakeDeviceBase
+{
+  public:
+    virtual ~FakeDeviceBase() = default;
+
+    virtual void onMqttConnectionEstablished()
+    {
+    }
+
+    virtual void loop()
+    {
+    }
+
+    int connected = 0;
+    int loops     = 0;
+};
+
+class FakeSensor : public FakeDeviceBase
+{
+  public:
+    void onMqttConnectionEstablished() override
+    {
+        connected++;
+    }
+
+    void loop() override
+    {
+        loops++;
+    }
+};
+
+class FakeDisplay : public FakeDeviceBase
+{
+  public:
+    void onMqttConnectionEstablished() override
+    {
+        connected += 2;
+    }
+};
+
+struct FakeConfiguration
+{
+    int DeviceIndex = 0;
+};
+
+static DeviceRegistry<FakeDeviceBase> registry;
+static FakeSensor                     sensors[8];
+static FakeDisplay                    displays[8];
+
+bool createSensor(const FakeConfiguration& configuration)
+{
+    return registry.add(&sensors[configuration.DeviceIndex], "Sensor");
+}
+
+bool createDisplay(const FakeConfiguration& configuration)
+{
+    return registry.add(&displays[configuration.DeviceIndex], "Display");
+}
+
+bool createNothing(const FakeConfiguration&)
+{
+    return false;
+}
+
+void test_add_ignores_null_and_duplicates(void)
+{
+    DeviceRegistry<FakeDeviceBase> devices;
+    FakeSensor                     sensor;
+
+    TEST_ASSERT_TRUE(devices.add(&sensor, "Sensor"));
+    TEST_ASSERT_FALSE(devices.add(&sensor, "Sensor"));
+    TEST_ASSERT_FALSE(devices.add(nullptr));
+    TEST_ASSERT_EQUAL(1, devices.size());
+    TEST_ASSERT_TRUE(devices.contains(&sensor));
+    TEST_ASSERT_EQUAL_STRING("Sensor", devices.getName(0));
+}
+
+void test_dispatch_reaches_every_device_once(void)
+{
+    DeviceRegistry<FakeDeviceBase> devices;
+    FakeSensor                     sensor;
+    FakeDisplay                    display;
+    devices.add(&sensor);
+    devices.add(&display);
+
+    for (FakeDeviceBase* device : devices)
+    {
+        device->onMqttConnectionEstablished();
+        device->loop();
+    }
+    devices.forEach([](FakeDeviceBase* device) { device->loop(); });
+
+    TEST_ASSERT_EQUAL(1, sensor.connected);
+    TEST_ASSERT_EQUAL(2, sensor.loops);
+    TEST_ASSERT_EQUAL(2, display.connected);
+    TEST_ASSERT_EQUAL(0, display.loops);
+}
+
+void test_factory_table(void)
+{
+    DeviceFactoryTable<FakeConfiguration> factories;
+    factories.add("Sensor", createSensor);
+    factories.add("Display", createDisplay);
+    factories.add("Broken", createNothing);
+
+    FakeConfiguration configuration;
+    configuration.DeviceIndex = 3;
+
+    TEST_ASSERT_EQUAL(3, factories.size());
+    TEST_ASSERT_TRUE(factories.isSupported("Sensor"));
+    TEST_ASSERT_FALSE(factories.isSupported("Sensor2"));
+    TEST_ASSERT_FALSE(factories.isSupported(""));
+
+    size_t sizeBefore = registry.size();
+    TEST_ASSERT_TRUE(factories.create("Sensor", configuration));
+    TEST_ASSERT_TRUE(factories.create("Display", configuration));
+    TEST_ASSERT_FALSE(factories.create("Broken", configuration));
+    TEST_ASSERT_FALSE(factories.create("DS18B20", configuration)); // not compiled in
+    TEST_ASSERT_EQUAL(sizeBefore + 2, registry.size());
+    TEST_ASSERT_TRUE(registry.contains(&sensors[3]));
+    TEST_ASSERT_TRUE(registry.contains(&displays[3]));
+}
+
+void test_fnv1a(void)
+{
+    // reference values of the 32 bit FNV-1a hash.
+    TEST_ASSERT_EQUAL_UINT32(0x811c9dc5u, fnv1a(""));
+    TEST_ASSERT_EQUAL_UINT32(0xe40c292cu, fnv1a("a"));
+    TEST_ASSERT_EQUAL_UINT32(0xbf9cf968u, fnv1a("foobar"));
+    TEST_ASSERT_EQUAL_UINT32(fnv1a("foobar"), fnv1a(reinterpret_cast<const uint8_t*>("foobar"), 6));
+    static_assert(fnv1a("a") == 0xe40c292cu, "fnv1a must be usable at compile time.");
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_add_ignores_null_and_duplicates);
+    RUN_TEST(test_dispatch_reaches_every_device_once);
+    RUN_TEST(test_factory_table);
+    RUN_TEST(test_fnv1a);
+    return UNITY_END();
+}
@@ -0,0 +1,124 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the scheduler with a fake clock: pio test -e native -f test_native_scheduler
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/Scheduler.hpp"
+
+#include <unity.h>
+
+using namespace IotZoo;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_new_task_is_due_immediately(void)
+{
+    Scheduler scheduler;
+    int       counter = 0;
+    scheduler.addTask("task", 100, [&]() { counter++; }, 1000);
+
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.millisUntilNextDeadline(1000));
+    TEST_ASSERT_EQUAL(1, scheduler.runDueTasks(1000));
+    TEST_ASSERT_EQUAL(1, counter);
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.millisUntilNextDeadline(1000));
+}
+
+void test_runs_only_due_tasks(void)
+{
+    Scheduler scheduler;
+    int       fast = 0;
+    int       slow = 0;
+    scheduler.addTask("keypad", 5, [&]() { fast++; }, 0);
+    scheduler.addTask("ds18b20", 30000, [&]() { slow++; }, 0);
+
+    for (uint32_t now = 0; now < 30000; now++)
+    {
+        scheduler.runDueTasks(now);
+    }
+    TEST_ASSERT_EQUAL(6000, fast);
+    TEST_ASSERT_EQUAL(1, slow);
+}
+
+void test_idle_until_earliest_deadline(void)
+{
+    Scheduler scheduler;
+    scheduler.addTask("a", 50, []() {}, 0);
+    scheduler.addTask("b", 20, []() {}, 0);
+    scheduler.runDueTasks(0);
+
+    TEST_ASSERT_EQUAL_UINT32(20, scheduler.millisUntilNextDeadline(0));
+    TEST_ASSERT_EQUAL_UINT32(7, scheduler.millisUntilNextDeadline(13));
+    TEST_ASSERT_EQUAL(1, scheduler.runDueTasks(20));
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.millisUntilNextDeadline(30));
+}
+
+void test_overrun_skips_missed_periods(void)
+{
+    Scheduler scheduler;
+    int       counter = 0;
+    scheduler.addTask("task", 10, [&]() { counter++; }, 0);
+    scheduler.runDueTasks(0);
+
+    // the loop was blocked for 95 ms: run once, not 9 times in a row.
+    TEST_ASSERT_EQUAL(1, scheduler.runDueTasks(95));
+    TEST_ASSERT_EQUAL(0, scheduler.runDueTasks(96));
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.millisUntilNextDeadline(95));
+    TEST_ASSERT_EQUAL(2, counter);
+}
+
+void test_millis_overflow(void)
+{
+    Scheduler scheduler;
+    int       counter = 0;
+    uint32_t  start   = UINT32_MAX - 15;
+    scheduler.addTask("task", 10, [&]() { counter++; }, start);
+    scheduler.runDueTasks(start);
+
+    TEST_ASSERT_EQUAL(0, scheduler.runDueTasks(start + 9));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.millisUntilNextDeadline(start + 9));
+    TEST_ASSERT_EQUAL(1, scheduler.runDueTasks(start + 10));
+    TEST_ASSERT_EQUAL(1, scheduler.runDueTasks(start + 20)); // millis() wrapped around
+    TEST_ASSERT_EQUAL(3, counter);
+}
+
+void test_set_interval(void)
+{
+    Scheduler scheduler;
+    int       counter = 0;
+    int       taskId  = scheduler.addTask("alive", 15000, [&]() { counter++; }, 0);
+    scheduler.runDueTasks(0);
+
+    scheduler.setInterval(taskId, 5000);
+    TEST_ASSERT_EQUAL_UINT32(5000, scheduler.getInterval(taskId));
+    TEST_ASSERT_EQUAL_UINT32(4000, scheduler.millisUntilNextDeadline(1000));
+
+    scheduler.wakeUp(taskId, 2000);
+    TEST_ASSERT_EQUAL(1, scheduler.runDueTasks(2000));
+    TEST_ASSERT_EQUAL(2, counter);
+}
+
+void test_invalid_task_id(void)
+{
+    Scheduler scheduler;
+    TEST_ASSERT_EQUAL(Scheduler::InvalidTaskId, scheduler.addTask("empty", 10, nullptr, 0));
+    scheduler.setInterval(Scheduler::InvalidTaskId, 10);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getInterval(42));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, scheduler.millisUntilNextDeadline(0));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_new_task_is_due_immediately);
+    RUN_TEST(test_runs_only_due_tasks);
+    RUN_TEST(test_idle_until_earliest_deadline);
+    RUN_TEST(test_overrun_skips_missed_periods);
+    RUN_TEST(test_millis_overflow);
+    RUN_TEST(test_set_interval);
+    RUN_TEST(test_invalid_task_id);
+    return UNITY_END();
+}
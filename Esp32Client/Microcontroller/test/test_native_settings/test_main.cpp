@@ -0,0 +1,198 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the settings cache with a mock of the Preferences (NVS): pio test -e native -f test_native_settings
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/SettingsCache.hpp"
+
+#include <unity.h>
+#include <map>
+
+using namespace IotZoo;
+
+/// @brief Preferences in RAM. Counts the accesses.
+class MockPreferences : public SettingsStorage
+{
+  public:
+    bool begin(bool) override
+    {
+        begins++;
+        isOpen = true;
+        return true;
+    }
+
+    void end() override
+    {
+        isOpen = false;
+    }
+
+    bool isKey(const char* key) override
+    {
+        if (!isOpen)
+        {
+            accessesWhileClosed++;
+        }
+        return strings.count(key) > 0 || numbers.count(key) > 0;
+    }
+
+    std::string getString(const char* key) override
+    {
+        reads++;
+        return strings[key];
+    }
+
+    int32_t getLong(const char* key) override
+    {
+        reads++;
+        return numbers[key];
+    }
+
+    uint16_t getUShort(const char* key) override
+    {
+        reads++;
+        return static_cast<uint16_t>(numbers[key]);
+    }
+
+    size_t putString(const char* key, const std::string& value) override
+    {
+        writes++;
+        strings[key] = value;
+        return value.length();
+    }
+
+    size_t putLong(const char* key, int32_t value) override
+    {
+        writes++;
+        numbers[key] = value;
+        return sizeof(int32_t);
+    }
+
+    size_t putUShort(const char* key, uint16_t value) override
+    {
+        writes++;
+        numbers[key] = value;
+        return failWrites ? 0 : sizeof(uint16_t);
+    }
+
+    std::map<std::string, std::string> strings;
+    std::map<std::string, int32_t>     numbers;
+
+    bool isOpen              = false;
+    bool failWrites          = false;
+    int  begins              = 0;
+    int  reads               = 0;
+    int  writes              = 0;
+    int  accessesWhileClosed = 0;
+};
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_load_serves_reads_from_ram(void)
+{
+    MockPreferences preferences;
+    preferences.numbers["interval_alive"] = 5000;
+    preferences.strings["ProjectName"]    = "playground";
+
+    SettingsCache cache(&preferences);
+    cache.load({{"interval_alive", SettingsCache::ValueType::Long},
+                {"alive_led", SettingsCache::ValueType::UShort},
+                {"ProjectName", SettingsCache::ValueType::String}});
+    TEST_ASSERT_EQUAL(1, preferences.begins);
+    int reads = preferences.reads;
+
+    for (int i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_EQUAL(5000, cache.getLong("interval_alive", 15000));
+        TEST_ASSERT_EQUAL(2, cache.getUShort("alive_led", 2)); // not in the flash: fallback
+        TEST_ASSERT_EQUAL_STRING("playground", cache.getString("ProjectName", "").c_str());
+    }
+    TEST_ASSERT_EQUAL(1, preferences.begins);
+    TEST_ASSERT_EQUAL(reads, preferences.reads);
+    TEST_ASSERT_EQUAL(0, preferences.accessesWhileClosed);
+}
+
+void test_unknown_key_is_read_through_once(void)
+{
+    MockPreferences preferences;
+    preferences.strings["my_key"] = "{\"a\": 1}";
+    SettingsCache cache(&preferences);
+
+    TEST_ASSERT_EQUAL_STRING("{\"a\": 1}", cache.getString("my_key", "").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\": 1}", cache.getString("my_key", "").c_str());
+    TEST_ASSERT_EQUAL(1, preferences.begins);
+    TEST_ASSERT_EQUAL(1, preferences.reads);
+}
+
+void test_write_back_is_coalesced(void)
+{
+    MockPreferences preferences;
+    SettingsCache   cache(&preferences, 2000);
+    cache.load({{"interval_alive", SettingsCache::ValueType::Long}});
+
+    cache.putLong("interval_alive", 1000, 0);
+    cache.putLong("interval_alive", 2000, 500);
+    cache.putLong("interval_alive", 3000, 1000);
+    TEST_ASSERT_EQUAL(3000, cache.getLong("interval_alive", 15000)); // visible immediately
+    TEST_ASSERT_EQUAL(0, preferences.writes);
+    TEST_ASSERT_EQUAL(1, cache.getDirtyCount());
+
+    TEST_ASSERT_EQUAL(0, cache.flushIfDue(2999)); // 2 s after the last change
+    TEST_ASSERT_EQUAL(1, cache.flushIfDue(3000));
+    TEST_ASSERT_EQUAL(1, preferences.writes);
+    TEST_ASSERT_EQUAL(3000, preferences.numbers["interval_alive"]);
+    TEST_ASSERT_EQUAL(0, cache.getDirtyCount());
+
+    cache.putLong("interval_alive", 3000, 4000); // unchanged: no flash write
+    TEST_ASSERT_EQUAL(0, cache.flush());
+    TEST_ASSERT_EQUAL(1, preferences.writes);
+}
+
+void test_flush_before_restart(void)
+{
+    MockPreferences preferences;
+    SettingsCache   cache(&preferences);
+
+    cache.putString("devices", "[{\"DeviceType\": \"DS18B20\"}]", 100);
+    cache.putString("NamespaceName", "iotzoo", 100);
+    cache.putUShort("alive_led", 1, 100);
+    int begins = preferences.begins;
+    TEST_ASSERT_EQUAL(3, cache.flush());
+    TEST_ASSERT_EQUAL(begins + 1, preferences.begins); // one begin()/end() for all keys
+    TEST_ASSERT_EQUAL(1, preferences.numbers["alive_led"]);
+    TEST_ASSERT_EQUAL_STRING("iotzoo", preferences.strings["NamespaceName"].c_str());
+
+    // after the restart
+    SettingsCache restarted(&preferences);
+    TEST_ASSERT_EQUAL(1, restarted.getUShort("alive_led", 2));
+}
+
+void test_failed_write_stays_dirty(void)
+{
+    MockPreferences preferences;
+    SettingsCache   cache(&preferences);
+    preferences.failWrites = true;
+    cache.putUShort("alive_led", 0, 0);
+
+    TEST_ASSERT_EQUAL(0, cache.flush());
+    TEST_ASSERT_EQUAL(1, cache.getWriteErrors());
+    TEST_ASSERT_EQUAL(1, cache.getDirtyCount());
+
+    preferences.failWrites = false;
+    TEST_ASSERT_EQUAL(1, cache.flush());
+    TEST_ASSERT_EQUAL(0, cache.getDirtyCount());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_load_serves_reads_from_ram);
+    RUN_TEST(test_unknown_key_is_read_through_once);
+    RUN_TEST(test_write_back_is_coalesced);
+    RUN_TEST(test_flush_before_restart);
+    RUN_TEST(test_failed_write_stays_dirty);
+    return UNITY_END();
+}
@@ -0,0 +1,320 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the store and forward queue and its log in a file backed partition:
+// pio test -e native -f test_native_store_and_forward
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/StoreAndForward.hpp"
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace IotZoo;
+
+static const char* PartitionPath = "test_store_and_forward.bin";
+
+void setUp(void)
+{
+    remove(PartitionPath);
+}
+
+void tearDown(void)
+{
+    remove(PartitionPath);
+}
+
+static StoredMessage makeMessage(const char* topic, int value, uint32_t timestamp = 0)
+{
+    StoredMessage message;
+    message.setTopic(topic);
+    message.timestamp = timestamp;
+    message.length    = static_cast<uint16_t>(snprintf(reinterpret_cast<char*>(message.payload), StoredMessage::MaxPayloadLength, "%d", value));
+    return message;
+}
+
+static int getValue(const StoredMessage& message)
+{
+    return atoi(std::string(reinterpret_cast<const char*>(message.payload), message.length).c_str());
+}
+
+void test_log_survives_restart(void)
+{
+    {
+        FilePartition partition(PartitionPath, 4 * 4096);
+        TEST_ASSERT_TRUE(partition.isOpen());
+        TelemetryLog log(partition);
+        TEST_ASSERT_TRUE(log.begin());
+        for (int value = 0; value < 10; value++)
+        {
+            TEST_ASSERT_TRUE(log.append(makeMessage("/celsius", value, value * 1000)));
+        }
+        StoredMessage message;
+        for (int value = 0; value < 3; value++)
+        {
+            TEST_ASSERT_TRUE(log.peek(message));
+            TEST_ASSERT_EQUAL(value, getValue(message));
+            log.markSent();
+        }
+        TEST_ASSERT_EQUAL(7, log.getPendingCount());
+    }
+
+    // Reset: the next start finds the messages not sent yet.
+    FilePartition partition(PartitionPath, 4 * 4096);
+    TelemetryLog  log(partition);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_EQUAL(7, log.getPendingCount());
+    TEST_ASSERT_TRUE(log.append(makeMessage("/humidity", 10, 10000)));
+
+    StoredMessage message;
+    for (int value = 3; value <= 10; value++)
+    {
+        TEST_ASSERT_TRUE(log.peek(message));
+        TEST_ASSERT_EQUAL(value, getValue(message));
+        TEST_ASSERT_EQUAL(value * 1000, message.timestamp);
+        TEST_ASSERT_EQUAL_STRING(value < 10 ? "/celsius" : "/humidity", message.topic);
+        TEST_ASSERT_EQUAL(strlen(message.topic), message.topicLength);
+        TEST_ASSERT_TRUE(message.restored == (value < 10)); // the timestamps before the restart are of the previous run.
+        TEST_ASSERT_EQUAL(value < 10 ? 10 - value : 0, log.getRestoredCount());
+        log.markSent();
+    }
+    TEST_ASSERT_FALSE(log.peek(message));
+    TEST_ASSERT_EQUAL(0, log.getPendingCount());
+}
+
+void test_log_evicts_oldest_and_levels_wear(void)
+{
+    // 4 sectors of 512 bytes: 21 records of 24 bytes per sector.
+    FilePartition partition(PartitionPath, 4 * 512, 512);
+    TelemetryLog  log(partition);
+    TEST_ASSERT_TRUE(log.begin());
+    const int count = 1000;
+    for (int value = 0; value < count; value++)
+    {
+        TEST_ASSERT_TRUE(log.append(makeMessage("/ppm", value % 10000)));
+    }
+    TEST_ASSERT_TRUE(log.getEvicted() > 0);
+    TEST_ASSERT_EQUAL(count, log.getPendingCount() + log.getEvicted());
+    TEST_ASSERT_TRUE(log.getPendingCount() <= 4 * 21);
+
+    // The newest messages are left, in order.
+    StoredMessage message;
+    int           expected = count - static_cast<int>(log.getPendingCount());
+    while (log.peek(message))
+    {
+        TEST_ASSERT_EQUAL(expected++, getValue(message));
+        log.markSent();
+    }
+    TEST_ASSERT_EQUAL(count, expected);
+
+    uint32_t minErases = UINT32_MAX, maxErases = 0;
+    for (size_t sector = 0; sector < 4; sector++)
+    {
+        minErases = partition.getEraseCount(sector) < minErases ? partition.getEraseCount(sector) : minErases;
+        maxErases = partition.getEraseCount(sector) > maxErases ? partition.getEraseCount(sector) : maxErases;
+    }
+    TEST_ASSERT_TRUE(maxErases - minErases <= 1);
+}
+
+void test_log_skips_torn_records(void)
+{
+    {
+        FilePartition partition(PartitionPath, 2 * 4096);
+        TelemetryLog  log(partition);
+        TEST_ASSERT_TRUE(log.begin());
+        TEST_ASSERT_TRUE(log.append(makeMessage("/celsius", 1)));
+        TEST_ASSERT_TRUE(log.append(makeMessage("/celsius", 2)));
+
+        // A bit flipped in the payload of the first record (behind the sector header, the record header and the topic).
+        uint8_t zero = 0;
+        TEST_ASSERT_TRUE(partition.write(8 + 16 + 8, &zero, 1));
+
+        // A reset while the third record is written: the header is there, the record is not committed.
+        StoredMessage torn = makeMessage("/celsius", 3);
+        uint8_t       header[16];
+        memset(header, 0xFF, sizeof(header));
+        header[0] = static_cast<uint8_t>(torn.length);
+        header[1] = 0;
+        header[4] = torn.topicLength;
+        TEST_ASSERT_TRUE(partition.write(8 + 2 * 28, header, sizeof(header)));
+    }
+    FilePartition partition(PartitionPath, 2 * 4096);
+    TelemetryLog  log(partition);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_TRUE(log.append(makeMessage("/celsius", 4)));
+
+    StoredMessage message;
+    TEST_ASSERT_TRUE(log.peek(message));
+    TEST_ASSERT_EQUAL(2, getValue(message));
+    log.markSent();
+    TEST_ASSERT_TRUE(log.peek(message));
+    TEST_ASSERT_EQUAL(4, getValue(message));
+    log.markSent();
+    TEST_ASSERT_FALSE(log.peek(message));
+    TEST_ASSERT_EQUAL(2, log.getCorrupted());
+}
+
+void test_short_outage_stays_in_ram(void)
+{
+    FilePartition   partition(PartitionPath, 4 * 4096);
+    TelemetryLog    log(partition);
+    StoreAndForward storeAndForward(&log);
+    TEST_ASSERT_TRUE(log.begin());
+
+    std::vector<int> sent;
+    auto             send = [&sent](const StoredMessage& message)
+    {
+        sent.push_back(getValue(message));
+        return true;
+    };
+
+    for (int value = 0; value < 8; value++)
+    {
+        TEST_ASSERT_TRUE(storeAndForward.store("/celsius", reinterpret_cast<const uint8_t*>(std::to_string(value).c_str()),
+                                               std::to_string(value).length(), false, 1000 + value * 500));
+        storeAndForward.loop(false, 1000 + value * 500, send);
+    }
+    TEST_ASSERT_EQUAL(8, storeAndForward.getRamCount());
+    TEST_ASSERT_EQUAL(0, storeAndForward.getSpilled());
+    TEST_ASSERT_EQUAL(0, partition.getEraseCount(1)); // no flash writes
+
+    // Reconnected: the burst first, then 20 messages per second.
+    TEST_ASSERT_EQUAL(5, storeAndForward.loop(true, 6000, send));
+    TEST_ASSERT_EQUAL(1, storeAndForward.loop(true, 6050, send));
+    TEST_ASSERT_EQUAL(0, storeAndForward.loop(true, 6060, send));
+    TEST_ASSERT_EQUAL(2, storeAndForward.loop(true, 6200, send));
+    TEST_ASSERT_EQUAL(8, sent.size());
+    for (int value = 0; value < 8; value++)
+    {
+        TEST_ASSERT_EQUAL(value, sent[value]);
+    }
+    TEST_ASSERT_EQUAL(0, storeAndForward.getPendingCount());
+}
+
+void test_long_outage_goes_to_flash(void)
+{
+    StoreAndForwardParameters parameters;
+    parameters.ramCapacity   = 4;
+    parameters.ramHoldMillis = 10000;
+    {
+        FilePartition   partition(PartitionPath, 4 * 4096);
+        TelemetryLog    log(partition);
+        StoreAndForward storeAndForward(&log, parameters);
+        TEST_ASSERT_TRUE(log.begin());
+
+        // More messages than the RAM holds: the oldest go to the flash.
+        for (int value = 0; value < 6; value++)
+        {
+            storeAndForward.store("/celsius", reinterpret_cast<const uint8_t*>("1"), 1, false, value * 100);
+        }
+        TEST_ASSERT_EQUAL(2, storeAndForward.getSpilled());
+        TEST_ASSERT_EQUAL(4, storeAndForward.getRamCount());
+
+        // The outage lasts: the RAM goes to the flash, new messages directly.
+        storeAndForward.loop(false, 10000, [](const StoredMessage&) { return true; });
+        TEST_ASSERT_EQUAL(0, storeAndForward.getRamCount());
+        storeAndForward.store("/celsius", reinterpret_cast<const uint8_t*>("2"), 1, true, 11000);
+        TEST_ASSERT_EQUAL(7, log.getPendingCount());
+    }
+
+    // A reset during the outage loses nothing.
+    FilePartition   partition(PartitionPath, 4 * 4096);
+    TelemetryLog    log(partition);
+    StoreAndForward storeAndForward(&log, parameters);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_EQUAL(7, storeAndForward.getPendingCount());
+
+    // The broker refuses a message: it is sent again in the next loop.
+    int  attempts = 0;
+    bool accept   = false;
+    bool topics   = true;
+    auto send     = [&](const StoredMessage& message)
+    {
+        topics = topics && 0 == strcmp("/celsius", message.topic);
+        attempts++;
+        return accept;
+    };
+    TEST_ASSERT_EQUAL(0, storeAndForward.loop(true, 20000, send));
+    accept = true;
+    TEST_ASSERT_EQUAL(5, storeAndForward.loop(true, 20000, send));
+    TEST_ASSERT_EQUAL(2, storeAndForward.loop(true, 30000, send));
+    TEST_ASSERT_EQUAL(8, attempts);
+    TEST_ASSERT_TRUE(topics);
+    TEST_ASSERT_EQUAL(7, storeAndForward.getReplayed());
+}
+
+void test_ram_only_drops_oldest(void)
+{
+    StoreAndForwardParameters parameters;
+    parameters.ramCapacity = 3;
+    StoreAndForward storeAndForward(nullptr, parameters);
+    for (int value = 0; value < 5; value++)
+    {
+        std::string payload = std::to_string(value);
+        storeAndForward.store("/ppm", reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length(), false, 0);
+    }
+    TEST_ASSERT_EQUAL(2, storeAndForward.getDropped());
+
+    std::vector<int> sent;
+    storeAndForward.loop(true, 100000,
+                         [&sent](const StoredMessage& message)
+                         {
+                             sent.push_back(getValue(message));
+                             return true;
+                         });
+    TEST_ASSERT_EQUAL(3, sent.size());
+    TEST_ASSERT_EQUAL(2, sent[0]);
+    TEST_ASSERT_EQUAL(4, sent[2]);
+
+    uint8_t tooLarge[StoredMessage::MaxPayloadLength + 1] = {0};
+    TEST_ASSERT_FALSE(storeAndForward.store("/ppm", tooLarge, sizeof(tooLarge), false, 0));
+    std::string longTopic(StoredMessage::MaxTopicLength + 1, 't');
+    TEST_ASSERT_FALSE(storeAndForward.store(longTopic.c_str(), tooLarge, 1, false, 0));
+    TEST_ASSERT_FALSE(storeAndForward.store("", tooLarge, 1, false, 0));
+}
+
+#ifdef IOTZOO_BENCHMARK
+void test_benchmark(void)
+{
+    FilePartition partition(PartitionPath, 64 * 4096);
+    TelemetryLog  log(partition);
+    TEST_ASSERT_TRUE(log.begin());
+    const int     count   = 2000; // 104 bytes per message: no eviction in 64 sectors.
+    StoredMessage message = makeMessage("iotzoo/playground/esp32/A1:B2:C3:D4:E5:F6/ds18b20_manager/0/sensor/28FF4A1C/celsius", 2150);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        log.append(message);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    int  read   = 0;
+    while (log.peek(message))
+    {
+        log.markSent();
+        read++;
+    }
+    auto   end          = std::chrono::steady_clock::now();
+    double appendMicros = std::chrono::duration<double, std::micro>(middle - start).count() / count;
+    double replayMicros = std::chrono::duration<double, std::micro>(end - middle).count() / count;
+    printf("append %.2f us, replay %.2f us per message (host, file backed), %zu bytes per message in the flash\n", appendMicros, replayMicros,
+           static_cast<size_t>(16 + ((message.topicLength + message.length + 3u) & ~3u)));
+    TEST_ASSERT_EQUAL(count, read);
+}
+#endif
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_log_survives_restart);
+    RUN_TEST(test_log_evicts_oldest_and_levels_wear);
+    RUN_TEST(test_log_skips_torn_records);
+    RUN_TEST(test_short_outage_stays_in_ram);
+    RUN_TEST(test_long_outage_goes_to_flash);
+    RUN_TEST(test_ram_only_drops_oldest);
+#ifdef IOTZOO_BENCHMARK
+    RUN_TEST(test_benchmark);
+#endif
+    return UNITY_END();
+}
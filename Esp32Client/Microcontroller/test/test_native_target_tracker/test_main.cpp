@@ -0,0 +1,125 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the radar target tracker: pio test -e native -f test_native_target_tracker
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/TargetTracker.hpp"
+
+#include <unity.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace IotZoo;
+
+using Measurement = TargetTracker::Measurement;
+
+static constexpr uint32_t FrameMillis = 100; // the Rd-03D sends ~10 frames per second
+
+/// @brief Uniform noise of +-amplitude mm.
+static float noise(float amplitude)
+{
+    return (static_cast<float>(rand()) / RAND_MAX * 2 - 1) * amplitude;
+}
+
+void setUp(void)
+{
+    srand(7);
+}
+
+void tearDown(void)
+{
+}
+
+void test_birth_hysteresis_and_death(void)
+{
+    TargetTracker tracker;
+    Measurement   person = {0, 2000};
+
+    tracker.update(&person, 1, 0);
+    tracker.update(&person, 1, 100);
+    TEST_ASSERT_EQUAL(0, tracker.getConfirmedTrackCount()); // 2 hits: tentative
+    tracker.update(&person, 1, 200);
+    TEST_ASSERT_EQUAL(1, tracker.getConfirmedTrackCount());
+
+    // a single noisy sample far away does not become a track.
+    Measurement ghost[] = {person, {3000, 500}};
+    tracker.update(ghost, 2, 300);
+    tracker.update(&person, 1, 400);
+    TEST_ASSERT_EQUAL(1, tracker.getConfirmedTrackCount());
+
+    // 4 frames without the person: still there. The 5th deletes the track.
+    for (uint32_t millis = 500; millis <= 800; millis += FrameMillis)
+    {
+        tracker.update(nullptr, 0, millis);
+    }
+    TEST_ASSERT_EQUAL(1, tracker.getConfirmedTrackCount());
+    tracker.update(nullptr, 0, 900);
+    TEST_ASSERT_EQUAL(0, tracker.getConfirmedTrackCount());
+}
+
+void test_stable_ids_when_slots_swap(void)
+{
+    TargetTracker tracker;
+    // two persons walking towards each other on parallel lines, the radar swaps the slots every frame.
+    uint16_t leftId  = 0;
+    uint16_t rightId = 0;
+    for (int frame = 0; frame < 30; frame++)
+    {
+        Measurement left  = {-1500.0f + frame * 50 + noise(60), 2000 + noise(60)};
+        Measurement right = {1500.0f - frame * 50 + noise(60), 3000 + noise(60)};
+        Measurement measurements[2];
+        measurements[frame % 2]       = left;
+        measurements[(frame + 1) % 2] = right;
+        tracker.update(measurements, 2, frame * FrameMillis);
+
+        const Track* tracks[TargetTracker::MaxTracks];
+        size_t       count = tracker.getConfirmedTracks(tracks, TargetTracker::MaxTracks);
+        if (count == 2)
+        {
+            const Track* leftTrack  = tracks[0]->y.position < 2500 ? tracks[0] : tracks[1];
+            const Track* rightTrack = leftTrack == tracks[0] ? tracks[1] : tracks[0];
+            if (0 == leftId)
+            {
+                leftId  = leftTrack->id;
+                rightId = rightTrack->id;
+            }
+            TEST_ASSERT_EQUAL(leftId, leftTrack->id);
+            TEST_ASSERT_EQUAL(rightId, rightTrack->id);
+            TEST_ASSERT_TRUE(tracks[0]->id < tracks[1]->id); // ordered by id
+        }
+    }
+    TEST_ASSERT_TRUE(leftId != 0);
+}
+
+void test_smoothing_and_velocity(void)
+{
+    TargetTracker tracker;
+    float         rawError      = 0;
+    float         filteredError = 0;
+    const Track*  track         = nullptr;
+    // walking away at 1 m/s
+    for (int frame = 0; frame < 50; frame++)
+    {
+        float       trueY    = 1000.0f + frame * 100;
+        Measurement measured = {noise(150), trueY + noise(150)};
+        tracker.update(&measured, 1, frame * FrameMillis);
+        tracker.getConfirmedTracks(&track, 1);
+        if (frame >= 20)
+        {
+            rawError += std::fabs(measured.y - trueY);
+            filteredError += std::fabs(track->y.position - trueY);
+        }
+    }
+    printf("mean position error: raw %.0f mm, filtered %.0f mm, velocity %.0f mm/s\n", rawError / 30, filteredError / 30, track->y.velocity);
+    TEST_ASSERT_TRUE(filteredError < rawError);
+    TEST_ASSERT_FLOAT_WITHIN(250, 1000, track->y.velocity);
+    TEST_ASSERT_FLOAT_WITHIN(250, 0, track->x.velocity);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_birth_hysteresis_and_death);
+    RUN_TEST(test_stable_ids_when_slots_swap);
+    RUN_TEST(test_smoothing_and_velocity);
+    return UNITY_END();
+}
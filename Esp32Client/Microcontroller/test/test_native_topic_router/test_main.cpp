@@ -0,0 +1,315 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the local dispatch of the routed subscriptions: pio test -e native -f test_native_topic_router
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/TopicRouter.hpp"
+
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace IotZoo;
+
+using Handler = std::function<void(const std::string& message)>;
+
+static const char* BaseTopic = "iotzoo/playground/esp32/A1:B2:C3:D4:E5:F6";
+
+static std::string topicOf(const char* suffix)
+{
+    return std::string(BaseTopic) + suffix;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_routable_topics(void)
+{
+    TopicRouter<Handler> router;
+    TEST_ASSERT_FALSE(router.isRoutable(topicOf("/alive_ack").c_str())); // no prefix yet.
+
+    router.setPrefix(BaseTopic);
+    TEST_ASSERT_TRUE(router.isRoutable(topicOf("/alive_ack").c_str()));
+    TEST_ASSERT_TRUE(router.isRoutable(topicOf("/lcd160x/ ").c_str()));
+
+    TEST_ASSERT_FALSE(router.isRoutable(BaseTopic));
+    TEST_ASSERT_FALSE(router.isRoutable(topicOf("/").c_str()));
+    TEST_ASSERT_FALSE(router.isRoutable(topicOf("x/alive_ack").c_str()));
+    TEST_ASSERT_FALSE(router.isRoutable(topicOf("/+/number").c_str()));
+    TEST_ASSERT_FALSE(router.isRoutable(topicOf("/tm1637_4/#").c_str()));
+    TEST_ASSERT_FALSE(router.isRoutable("A1:B2:C3:D4:E5:F6/status"));
+    TEST_ASSERT_FALSE(router.isRoutable("iotzoo/playground/is_day_mode"));
+    TEST_ASSERT_FALSE(router.add("iotzoo/playground/is_day_mode", [](const std::string&) {}));
+    TEST_ASSERT_EQUAL(0, router.size());
+}
+
+void test_dispatch(void)
+{
+    TopicRouter<Handler> router;
+    router.setPrefix(BaseTopic);
+
+    std::string received;
+    int         calls = 0;
+    TEST_ASSERT_TRUE(router.add(topicOf("/tm1637_4/0/number").c_str(), [&](const std::string& message) { received = "number " + message; }));
+    TEST_ASSERT_TRUE(router.add(topicOf("/tm1637_4/0/text").c_str(), [&](const std::string& message) { received = "text " + message; }));
+    TEST_ASSERT_TRUE(router.add(topicOf("/alive_ack").c_str(), [&](const std::string&) { calls++; }));
+    TEST_ASSERT_EQUAL(3, router.size());
+
+    std::string topic   = topicOf("/tm1637_4/0/text");
+    Handler*    handler = router.find(topic.c_str(), topic.length());
+    TEST_ASSERT_NOT_NULL(handler);
+    (*handler)("hello");
+    TEST_ASSERT_EQUAL_STRING("text hello", received.c_str());
+
+    // The received topic is not zero terminated behind the length.
+    std::string buffer = topicOf("/tm1637_4/0/number") + "/ignored";
+    handler            = router.find(buffer.c_str(), buffer.length() - strlen("/ignored"));
+    TEST_ASSERT_NOT_NULL(handler);
+    (*handler)("42");
+    TEST_ASSERT_EQUAL_STRING("number 42", received.c_str());
+
+    // The echo of an own message, a topic of another microcontroller, a prefix of a topic.
+    topic = topicOf("/tm1637_4/0/number/echo");
+    TEST_ASSERT_NULL(router.find(topic.c_str(), topic.length()));
+    topic = "iotzoo/playground/esp32/00:00:00:00:00:00/alive_ack";
+    TEST_ASSERT_NULL(router.find(topic.c_str(), topic.length()));
+    topic = topicOf("/tm1637_4/0");
+    TEST_ASSERT_NULL(router.find(topic.c_str(), topic.length()));
+    TEST_ASSERT_NULL(router.find(BaseTopic, strlen(BaseTopic)));
+
+    // Subscribed again on reconnect: replaced, not called twice.
+    TEST_ASSERT_TRUE(router.add(topicOf("/alive_ack").c_str(), [&](const std::string&) { calls += 10; }));
+    TEST_ASSERT_EQUAL(3, router.size());
+    topic = topicOf("/alive_ack");
+    (*router.find(topic.c_str(), topic.length()))("");
+    TEST_ASSERT_EQUAL(10, calls);
+
+    // A new base topic, e.g. another project name.
+    router.setPrefix("iotzoo/other/esp32/A1:B2:C3:D4:E5:F6");
+    TEST_ASSERT_EQUAL(0, router.size());
+    TEST_ASSERT_NULL(router.find(topic.c_str(), topic.length()));
+}
+
+void test_add_and_remove_many(void)
+{
+    TopicRouter<Handler> router;
+    router.setPrefix(BaseTopic);
+
+    constexpr int Count       = 500;
+    int           calledIndex = -1;
+    for (int i = 0; i < Count; i++)
+    {
+        std::string topic = topicOf(("/button_matrix/" + std::to_string(i / 16) + "/button/" + std::to_string(i % 16) + "/pressed").c_str());
+        TEST_ASSERT_TRUE(router.add(topic.c_str(), [&calledIndex, i](const std::string&) { calledIndex = i; }));
+    }
+    TEST_ASSERT_EQUAL(Count, router.size());
+
+    for (int i = 0; i < Count; i += 2)
+    {
+        std::string topic = topicOf(("/button_matrix/" + std::to_string(i / 16) + "/button/" + std::to_string(i % 16) + "/pressed").c_str());
+        TEST_ASSERT_TRUE(router.remove(topic.c_str()));
+        TEST_ASSERT_FALSE(router.remove(topic.c_str()));
+    }
+    TEST_ASSERT_EQUAL(Count / 2, router.size());
+
+    for (int i = 0; i < Count; i++)
+    {
+        std::string topic   = topicOf(("/button_matrix/" + std::to_string(i / 16) + "/button/" + std::to_string(i % 16) + "/pressed").c_str());
+        Handler*    handler = router.find(topic.c_str(), topic.length());
+        if (i % 2 == 0)
+        {
+            TEST_ASSERT_NULL(handler);
+            continue;
+        }
+        TEST_ASSERT_NOT_NULL(handler);
+        (*handler)("");
+        TEST_ASSERT_EQUAL(i, calledIndex);
+    }
+}
+
+/// @brief MQTT topic matching of the broker, + and # only.
+static bool matches(const std::string& filter, const std::string& topic)
+{
+    size_t f = 0;
+    size_t t = 0;
+    while (f < filter.length())
+    {
+        if ('#' == filter[f])
+        {
+            return true;
+        }
+        if ('+' == filter[f])
+        {
+            t = std::min(topic.find('/', t), topic.length());
+            f++;
+            continue;
+        }
+        if (t >= topic.length() || filter[f] != topic[t])
+        {
+            // "a/#" also matches "a".
+            return t == topic.length() && 0 == filter.compare(f, std::string::npos, "/#");
+        }
+        f++;
+        t++;
+    }
+    return t == topic.length();
+}
+
+void test_echo_is_not_subscribed(void)
+{
+    TopicRouter<Handler> router;
+    router.setPrefix(BaseTopic);
+
+    const char* handlerSuffixes[] = {"/ws2818/0/setPixelColor", "/ws2818/0/setEffect", "/tm1638/0/led/1", "/alive_ack", "/status"};
+    for (const char* suffix : handlerSuffixes)
+    {
+        TEST_ASSERT_TRUE(router.add(topicOf(suffix).c_str(), [](const std::string&) {}));
+    }
+    const char* publishedSuffixes[] = {"/alive", "/tm1638/0/button/1", "/ds18b20/0/celsius", "/audio/pcm"};
+    for (const char* suffix : publishedSuffixes)
+    {
+        TEST_ASSERT_FALSE(router.addPublished(topicOf(suffix).c_str())); // no filters yet.
+    }
+    TEST_ASSERT_FALSE(router.addPublished("iotzoo/playground/is_day_mode")); // not below the prefix.
+    TEST_ASSERT_EQUAL(4, router.getPublishedCount());
+
+    std::vector<std::string> filters = router.updateFilters();
+    TEST_ASSERT_EQUAL(4, filters.size());
+    TEST_ASSERT_EQUAL_STRING(topicOf("/ws2818/#").c_str(), filters[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(topicOf("/tm1638/0/led/#").c_str(), filters[1].c_str());
+    TEST_ASSERT_EQUAL_STRING(topicOf("/alive_ack").c_str(), filters[2].c_str());
+    TEST_ASSERT_EQUAL_STRING(topicOf("/status").c_str(), filters[3].c_str());
+
+    // Every handler is covered, no published topic is sent back.
+    for (const char* suffix : handlerSuffixes)
+    {
+        bool covered = false;
+        for (const std::string& filter : filters)
+        {
+            covered = covered || matches(filter, topicOf(suffix));
+        }
+        TEST_ASSERT_TRUE(covered);
+    }
+    for (const char* suffix : publishedSuffixes)
+    {
+        std::string topic = topicOf(suffix);
+        for (const std::string& filter : filters)
+        {
+            TEST_ASSERT_FALSE(matches(filter, topic));
+        }
+        TEST_ASSERT_NULL(router.find(topic.c_str(), topic.length()));
+    }
+
+    // Published again: known. A new topic outside the filters, e.g. an error.
+    TEST_ASSERT_FALSE(router.addPublished(topicOf("/alive").c_str()));
+    TEST_ASSERT_FALSE(router.addPublished(topicOf("/error").c_str()));
+
+    // A new topic below a filter: echoed until the filters are renewed, but without handler it is not routed.
+    std::string state = topicOf("/ws2818/0/state");
+    TEST_ASSERT_TRUE(router.addPublished(state.c_str()));
+    TEST_ASSERT_TRUE(matches(filters[0], state));
+    TEST_ASSERT_NULL(router.find(state.c_str(), state.length()));
+
+    filters = router.updateFilters();
+    TEST_ASSERT_EQUAL(5, filters.size());
+    TEST_ASSERT_EQUAL_STRING(topicOf("/ws2818/0/setPixelColor").c_str(), filters[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(topicOf("/ws2818/0/setEffect").c_str(), filters[1].c_str());
+    for (const std::string& filter : filters)
+    {
+        TEST_ASSERT_FALSE(matches(filter, state));
+    }
+
+    // A topic with a handler which is published too is received back, as with a subscription of its own.
+    TEST_ASSERT_TRUE(router.addPublished(topicOf("/status").c_str()));
+    filters = router.updateFilters();
+    TEST_ASSERT_EQUAL_STRING(topicOf("/status").c_str(), filters.back().c_str());
+
+    router.setPrefix(BaseTopic);
+    TEST_ASSERT_EQUAL(0, router.getPublishedCount());
+    TEST_ASSERT_EQUAL(0, router.updateFilters().size());
+}
+
+#ifdef IOTZOO_BENCHMARK
+/// @brief A subscription per topic (the client compares the received topic with every subscribed one) versus the
+/// lookup of the wildcard subscription.
+void test_benchmark_dispatch(void)
+{
+    constexpr int Handlers = 500;
+    constexpr int Messages = 200000;
+
+    TopicRouter<Handler>                         router;
+    std::vector<std::pair<std::string, Handler>> subscriptions;
+    std::vector<std::string>                     topics;
+    router.setPrefix(BaseTopic);
+
+    size_t checksum = 0;
+    for (int i = 0; i < Handlers; i++)
+    {
+        topics.push_back(topicOf(("/device_" + std::to_string(i % 25) + "/" + std::to_string(i / 25) + "/command").c_str()));
+        Handler handler = [&checksum, i](const std::string& message) { checksum += i + message.length(); };
+        router.add(topics.back().c_str(), handler);
+        subscriptions.emplace_back(topics.back(), handler);
+    }
+    // Every 8th message is the echo of an own publication without handler.
+    for (int i = 0; i < Handlers / 8; i++)
+    {
+        topics.push_back(topicOf(("/device_" + std::to_string(i) + "/0/state").c_str()));
+    }
+
+    std::string message = "1";
+    auto        start   = std::chrono::steady_clock::now();
+    for (int i = 0; i < Messages; i++)
+    {
+        const std::string& topic = topics[(i * 7919) % topics.size()];
+        for (auto& subscription : subscriptions)
+        {
+            if (subscription.first == topic)
+            {
+                subscription.second(message);
+                break;
+            }
+        }
+    }
+    auto   linear         = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    size_t linearChecksum = checksum;
+
+    checksum = 0;
+    start    = std::chrono::steady_clock::now();
+    for (int i = 0; i < Messages; i++)
+    {
+        const std::string& topic   = topics[(i * 7919) % topics.size()];
+        Handler*           handler = router.find(topic.c_str(), topic.length());
+        if (nullptr != handler)
+        {
+            (*handler)(message);
+        }
+    }
+    auto routed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%d handlers: linear %.1f ns, routed %.1f ns per message\n", Handlers, linear * 1000.0 / Messages, routed * 1000.0 / Messages);
+    TEST_ASSERT_EQUAL(linearChecksum, checksum);
+    TEST_ASSERT_TRUE(checksum > 0);
+}
+#endif
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_routable_topics);
+    RUN_TEST(test_dispatch);
+    RUN_TEST(test_add_and_remove_many);
+    RUN_TEST(test_echo_is_not_subscribed);
+#ifdef IOTZOO_BENCHMARK
+    RUN_TEST(test_benchmark_dispatch);
+#endif
+    return UNITY_END();
+}
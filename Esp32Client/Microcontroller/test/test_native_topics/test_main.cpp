@@ -0,0 +1,74 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the interned topic table: pio test -e native -f test_native_topics
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/TopicTable.hpp"
+
+#include <unity.h>
+#include <cstring>
+#include <string>
+
+using namespace IotZoo;
+
+static const char* BaseTopic = "iotzoo/playground/esp32/A1:B2:C3:D4:E5:F6";
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_add_and_get(void)
+{
+    TopicTable topics;
+    TopicId    error = topics.add(BaseTopic, "/error");
+    TopicId    alive = topics.add(BaseTopic, "/alive");
+
+    TEST_ASSERT_EQUAL(0, error);
+    TEST_ASSERT_EQUAL(1, alive);
+    TEST_ASSERT_EQUAL_STRING("iotzoo/playground/esp32/A1:B2:C3:D4:E5:F6/error", topics.get(error));
+    TEST_ASSERT_EQUAL_STRING("iotzoo/playground/esp32/A1:B2:C3:D4:E5:F6/alive", topics.get(alive));
+    TEST_ASSERT_EQUAL(strlen(BaseTopic) + 6, topics.getLength(alive));
+}
+
+void test_same_topic_same_id(void)
+{
+    TopicTable topics;
+    TopicId    first = topics.add(BaseTopic, "/ds18b20_manager/0/sensor/0/celsius");
+    std::string full = std::string(BaseTopic) + "/ds18b20_manager/0/sensor/0/celsius";
+
+    // e.g. on reconnect the devices add their topics again.
+    TEST_ASSERT_EQUAL(first, topics.add(full.c_str()));
+    TEST_ASSERT_EQUAL(first, topics.add(BaseTopic, "/ds18b20_manager/0/sensor/0/celsius"));
+    TEST_ASSERT_EQUAL(first, topics.find(full.c_str()));
+    TEST_ASSERT_EQUAL(1, topics.size());
+
+    // same hash input split differently, but a different topic.
+    TEST_ASSERT_NOT_EQUAL(first, topics.add(BaseTopic, "/ds18b20_manager/0/sensor/1/celsius"));
+    TEST_ASSERT_EQUAL(2, topics.size());
+}
+
+void test_invalid_topics(void)
+{
+    TopicTable topics;
+    TEST_ASSERT_EQUAL(InvalidTopicId, topics.add(""));
+    TEST_ASSERT_EQUAL(InvalidTopicId, topics.find("unknown"));
+    TEST_ASSERT_EQUAL_STRING("", topics.get(InvalidTopicId));
+    TEST_ASSERT_EQUAL_STRING("", topics.get(42));
+    TEST_ASSERT_EQUAL(0, topics.getLength(InvalidTopicId));
+
+    topics.add("a");
+    topics.clear();
+    TEST_ASSERT_EQUAL(0, topics.size());
+    TEST_ASSERT_EQUAL(InvalidTopicId, topics.find("a"));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_add_and_get);
+    RUN_TEST(test_same_topic_same_id);
+    RUN_TEST(test_invalid_topics);
+    return UNITY_END();
+}
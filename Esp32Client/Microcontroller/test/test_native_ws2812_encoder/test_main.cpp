@@ -0,0 +1,108 @@
+// --------------------------------------------------------------------------------------------------------------------
+// Host tests of the WS2812 RMT encoder: pio test -e native -f test_native_ws2812_encoder
+// --------------------------------------------------------------------------------------------------------------------
+#include "core/Ws2812Encoder.hpp"
+
+#include <unity.h>
+#include <vector>
+
+using namespace IotZoo;
+
+// 80 MHz APB clock / clk_div 2 = 25 ns per tick.
+static constexpr Ws2812Timing Timing = Ws2812Timing::fromTickNanos(25);
+
+/// @brief Decodes the items back into bytes, like a WS2812 samples the line.
+static std::vector<uint8_t> decode(const std::vector<uint32_t>& items)
+{
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 8 <= items.size(); i += 8)
+    {
+        uint8_t value = 0;
+        for (size_t bit = 0; bit < 8; bit++)
+        {
+            uint16_t highTicks = items[i + bit] & 0x7FFF;
+            value              = (value << 1) | (highTicks * 25 > 600 ? 1 : 0); // sampled after ~600 ns
+        }
+        bytes.push_back(value);
+    }
+    return bytes;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_timing(void)
+{
+    TEST_ASSERT_EQUAL(16, Timing.zeroHigh);
+    TEST_ASSERT_EQUAL(34, Timing.zeroLow);
+    TEST_ASSERT_EQUAL(32, Timing.oneHigh);
+    TEST_ASSERT_EQUAL(18, Timing.oneLow);
+    // every bit is 1.25 µs
+    TEST_ASSERT_EQUAL(50, Timing.zeroHigh + Timing.zeroLow);
+    TEST_ASSERT_EQUAL(50, Timing.oneHigh + Timing.oneLow);
+}
+
+void test_item_layout(void)
+{
+    // duration0 = 32, level0 = 1, duration1 = 18, level1 = 0
+    TEST_ASSERT_EQUAL_HEX32(0x00128020, Ws2812Encoder::makeItem(32, 18));
+
+    uint8_t               value = 0xA5;
+    std::vector<uint32_t> items(8);
+    size_t                translated;
+    size_t                itemCount;
+    Ws2812Encoder::encode(Timing, &value, 1, items.data(), items.size(), translated, itemCount);
+    TEST_ASSERT_EQUAL(1, translated);
+    TEST_ASSERT_EQUAL(8, itemCount);
+
+    uint32_t one  = Ws2812Encoder::makeItem(Timing.oneHigh, Timing.oneLow);
+    uint32_t zero = Ws2812Encoder::makeItem(Timing.zeroHigh, Timing.zeroLow);
+    uint32_t expected[] = {one, zero, one, zero, zero, one, zero, one}; // MSB first
+    for (int i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(expected[i], items[i]);
+    }
+}
+
+void test_translator_chunks(void)
+{
+    // The RMT driver asks for the free items of its memory block, e.g. 64 or 63: only whole bytes are encoded.
+    std::vector<uint8_t> pixels(300);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        pixels[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    std::vector<uint32_t> items;
+    size_t                position = 0;
+    size_t                chunks   = 0;
+    while (position < pixels.size())
+    {
+        uint32_t block[63];
+        size_t   translated;
+        size_t   itemCount;
+        Ws2812Encoder::encode(Timing, pixels.data() + position, pixels.size() - position, block, 63, translated, itemCount);
+        TEST_ASSERT_TRUE(translated <= 7); // 63 items hold 7 whole bytes
+        items.insert(items.end(), block, block + itemCount);
+        position += translated;
+        chunks++;
+    }
+    TEST_ASSERT_EQUAL(43, chunks);
+    std::vector<uint8_t> decoded = decode(items);
+    TEST_ASSERT_EQUAL(pixels.size(), decoded.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(pixels.data(), decoded.data(), pixels.size());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_timing);
+    RUN_TEST(test_item_layout);
+    RUN_TEST(test_translator_chunks);
+    return UNITY_END();
+}